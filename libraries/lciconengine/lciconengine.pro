@@ -11,9 +11,11 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 
 SOURCES += src/lc_svgiconengineplugin.cpp \
-    src/lc_svgiconengine.cpp
+    src/lc_svgiconengine.cpp \
+    src/lc_svgiconatlas.cpp
 
 HEADERS += \
+    src/lc_svgiconatlas.h \
     src/lc_svgiconengine.h
 
 DISTFILES += src/lc_svgicons.json
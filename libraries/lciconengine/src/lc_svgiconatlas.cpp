@@ -0,0 +1,283 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "lc_svgiconatlas.h"
+
+namespace {
+    constexpr quint32 ATLAS_MAGIC = 0x4149434c; // "LCIA"
+    constexpr quint32 ATLAS_VERSION = 1;
+    // magic, version and size of index
+    constexpr qint64 HEADER_SIZE = 16;
+    constexpr qint64 DATA_ALIGNMENT = 16;
+    // larger images are not icons of toolbars and menus, so they are not stored
+    constexpr int MAX_ICON_SIZE = 256;
+
+    qint64 align(qint64 offset){
+        return (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    }
+}
+
+LC_SvgIconAtlas* LC_SvgIconAtlas::instance(){
+    // initialization of the local static is thread safe, methods lock the atlas
+    static LC_SvgIconAtlas atlas;
+    return &atlas;
+}
+
+LC_SvgIconAtlas::LC_SvgIconAtlas(){
+    QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheLocation.isEmpty()) {
+        m_cacheDir = cacheLocation + QLatin1String("/icons");
+    }
+    auto application = QCoreApplication::instance();
+    if (application != nullptr) {
+        QObject::connect(application, &QCoreApplication::aboutToQuit, application, [](){
+            LC_SvgIconAtlas::instance()->save();
+        });
+    }
+}
+
+LC_SvgIconAtlas::~LC_SvgIconAtlas(){
+    close();
+}
+
+QString LC_SvgIconAtlas::atlasFileName() const{
+    QByteArray hash = QCryptographicHash::hash(m_profile.toUtf8(), QCryptographicHash::Sha1);
+    return m_cacheDir + QLatin1Char('/') + QString::fromLatin1(hash.toHex()) + QLatin1String(".lcia");
+}
+
+void LC_SvgIconAtlas::selectProfile(const QString &profile){
+    if (profile == m_profile) {
+        return;
+    }
+    doSave();
+    close();
+    m_profile = profile;
+    load();
+}
+
+bool LC_SvgIconAtlas::find(const QString &profile, const QString &key, QImage &image){
+    if (m_cacheDir.isEmpty()) {
+        return false;
+    }
+    QMutexLocker locker(&m_mutex);
+    selectProfile(profile);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    it->lastUse = ++m_useCounter;
+    // the copy does not refer to the mapped file, so the file may be replaced later
+    image = it->image.copy();
+    return !image.isNull();
+}
+
+void LC_SvgIconAtlas::insert(const QString &profile, const QString &key, const QImage &image){
+    if (m_cacheDir.isEmpty() || image.isNull() || image.width() > MAX_ICON_SIZE || image.height() > MAX_ICON_SIZE) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    selectProfile(profile);
+    addEntry(key, image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+    m_modified = true;
+    evict();
+}
+
+void LC_SvgIconAtlas::addEntry(const QString &key, const QImage &image){
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_bytes -= it->image.sizeInBytes();
+    }
+    m_entries.insert(key, Entry{image, ++m_useCounter});
+    m_bytes += image.sizeInBytes();
+}
+
+/**
+ * Drops least recently used icons down to three quarters of the limits, so that
+ * eviction does not run again on the next insert.
+ */
+void LC_SvgIconAtlas::evict(){
+    if (m_entries.size() <= MAX_ENTRIES && m_bytes <= MAX_BYTES) {
+        return;
+    }
+    std::vector<std::pair<quint64, QString>> uses;
+    uses.reserve(m_entries.size());
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        uses.emplace_back(it->lastUse, it.key());
+    }
+    std::sort(uses.begin(), uses.end());
+    for (const auto &use: uses) {
+        if (m_entries.size() <= MAX_ENTRIES * 3 / 4 && m_bytes <= MAX_BYTES * 3 / 4) {
+            break;
+        }
+        auto it = m_entries.find(use.second);
+        m_bytes -= it->image.sizeInBytes();
+        m_entries.erase(it);
+    }
+    m_modified = true;
+}
+
+void LC_SvgIconAtlas::load(){
+    m_file.setFileName(atlasFileName());
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    qint64 fileSize = m_file.size();
+    if (fileSize >= HEADER_SIZE) {
+        m_mapped = m_file.map(0, fileSize);
+    }
+    if (m_mapped == nullptr) {
+        m_file.close();
+        return;
+    }
+
+    QDataStream header(QByteArray::fromRawData(reinterpret_cast<const char*>(m_mapped), HEADER_SIZE));
+    header.setByteOrder(QDataStream::LittleEndian);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 indexSize = 0;
+    header >> magic >> version >> indexSize;
+    if (magic != ATLAS_MAGIC || version != ATLAS_VERSION || indexSize <= 0 || indexSize > fileSize - HEADER_SIZE) {
+        close();
+        return;
+    }
+
+    QDataStream index(QByteArray::fromRawData(reinterpret_cast<const char*>(m_mapped) + HEADER_SIZE, indexSize));
+    index.setVersion(QDataStream::Qt_6_0);
+    qint32 count = 0;
+    index >> count;
+    for (qint32 i = 0; i < count && index.status() == QDataStream::Ok; i++) {
+        QString key;
+        qint32 width = 0;
+        qint32 height = 0;
+        qint32 bytesPerLine = 0;
+        qint64 offset = 0;
+        index >> key >> width >> height >> bytesPerLine >> offset;
+        if (index.status() != QDataStream::Ok || width <= 0 || height <= 0 || bytesPerLine < width * 4 ||
+            offset < HEADER_SIZE + indexSize || offset + qint64(bytesPerLine) * height > fileSize) {
+            break;
+        }
+        // const data, so the image never writes to the read-only mapping
+        const uchar* data = m_mapped + offset;
+        addEntry(key, QImage(data, width, height, bytesPerLine, QImage::Format_ARGB32_Premultiplied));
+    }
+    if (index.status() != QDataStream::Ok || m_entries.size() != count) {
+        close();
+        return;
+    }
+    // limits may be lowered by a later version, the pruned atlas is written on save
+    evict();
+}
+
+void LC_SvgIconAtlas::close(){
+    m_entries.clear();
+    m_bytes = 0;
+    m_modified = false;
+    if (m_mapped != nullptr) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    m_file.close();
+}
+
+void LC_SvgIconAtlas::save(){
+    QMutexLocker locker(&m_mutex);
+    doSave();
+}
+
+void LC_SvgIconAtlas::doSave(){
+    if (!m_modified || m_cacheDir.isEmpty() || !QDir().mkpath(m_cacheDir)) {
+        return;
+    }
+
+    const QStringList keys = m_entries.keys();
+    auto writeIndex = [this, &keys](qint64 dataStart){
+        QByteArray result;
+        QDataStream index(&result, QIODevice::WriteOnly);
+        index.setVersion(QDataStream::Qt_6_0);
+        index << qint32(keys.size());
+        qint64 offset = dataStart;
+        for (const QString &key: keys) {
+            const QImage &image = m_entries[key].image;
+            index << key << qint32(image.width()) << qint32(image.height()) << qint32(image.bytesPerLine()) << offset;
+            offset = align(offset + image.sizeInBytes());
+        }
+        return result;
+    };
+    // all fields of the index have fixed size, so offsets do not change its size
+    qint64 indexSize = writeIndex(0).size();
+    qint64 dataStart = align(HEADER_SIZE + indexSize);
+    QByteArray index = writeIndex(dataStart);
+
+    QSaveFile out(atlasFileName());
+    if (!out.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QByteArray header;
+    QDataStream headerStream(&header, QIODevice::WriteOnly);
+    headerStream.setByteOrder(QDataStream::LittleEndian);
+    headerStream << ATLAS_MAGIC << ATLAS_VERSION << indexSize;
+    out.write(header);
+    out.write(index);
+    qint64 position = HEADER_SIZE + indexSize;
+    for (const QString &key: keys) {
+        const QImage &image = m_entries[key].image;
+        qint64 start = align(position);
+        out.write(QByteArray(start - position, '\0'));
+        out.write(reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes());
+        position = start + image.sizeInBytes();
+    }
+
+    // the mapping has to be released before the file is replaced
+    close();
+    out.commit();
+    load();
+    removeOldFiles();
+}
+
+/**
+ * Removes atlas files of profiles that were not saved recently, as every change of
+ * colors or of the icons directory creates a new atlas.
+ */
+void LC_SvgIconAtlas::removeOldFiles() const{
+    QDir dir(m_cacheDir);
+    const QFileInfoList files = dir.entryInfoList({QStringLiteral("*.lcia")}, QDir::Files, QDir::Time);
+    const QString current = QFileInfo(atlasFileName()).fileName();
+    int kept = 0;
+    for (const QFileInfo &file: files) {
+        if (file.fileName() == current || ++kept < MAX_FILES) {
+            continue;
+        }
+        QFile::remove(file.absoluteFilePath());
+    }
+}
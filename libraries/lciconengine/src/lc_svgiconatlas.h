@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#ifndef LC_SVGICONATLAS_H
+#define LC_SVGICONATLAS_H
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+
+/**
+ * Persistent cache of rasterized icons.
+ *
+ * Icons are stored in one atlas file per profile. The profile covers everything
+ * that changes the rendering of the same SVG file: the icons override directory,
+ * the replacement colors, the device pixel ratio and the application version.
+ * On later starts the atlas is memory-mapped and icons are taken from it without
+ * parsing SVG. Icons rendered during the session are added to the atlas when the
+ * application quits or the profile changes.
+ *
+ * The atlas keeps at most MAX_ENTRIES icons and MAX_BYTES of pixels, least recently used
+ * icons are dropped first. Only MAX_FILES atlas files of recent profiles are kept on disk.
+ * All methods may be called from any thread.
+ */
+class LC_SvgIconAtlas{
+public:
+    static constexpr int MAX_ENTRIES = 4096;
+    static constexpr qint64 MAX_BYTES = 32 * 1024 * 1024;
+    static constexpr int MAX_FILES = 8;
+
+    static LC_SvgIconAtlas* instance();
+
+    /**
+     * Looks up the icon with given key in the atlas of the profile.
+     * Returned image is detached from the mapped file.
+     */
+    bool find(const QString &profile, const QString &key, QImage &image);
+    /**
+     * Adds rendered icon to the atlas of the profile.
+     */
+    void insert(const QString &profile, const QString &key, const QImage &image);
+    /**
+     * Writes the atlas with icons added during the session.
+     */
+    void save();
+private:
+    LC_SvgIconAtlas();
+    ~LC_SvgIconAtlas();
+
+    struct Entry {
+        QImage image; // either refers to mapped data or owns rendered pixels
+        quint64 lastUse = 0;
+    };
+
+    void selectProfile(const QString &profile);
+    void load();
+    void close();
+    void doSave();
+    void addEntry(const QString &key, const QImage &image);
+    void evict();
+    void removeOldFiles() const;
+    QString atlasFileName() const;
+
+    QString m_cacheDir;
+    QString m_profile;
+    QFile m_file;
+    uchar* m_mapped = nullptr;
+    QHash<QString, Entry> m_entries;
+    qint64 m_bytes = 0;
+    quint64 m_useCounter = 0;
+    bool m_modified = false;
+    QMutex m_mutex;
+};
+
+#endif // LC_SVGICONATLAS_H
@@ -25,6 +25,7 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
+#include <QFileInfo>
 #include <QGuiApplication>
 #include <QPainter>
 #include <QPixmap>
@@ -32,6 +33,7 @@
 #include <QStyleOption>
 #include <QSvgRenderer>
 
+#include "lc_svgiconatlas.h"
 #include "lc_svgiconengine.h"
 
 
@@ -139,9 +141,11 @@ public:
 
     void stepSerialNum() { serialNum = lastSerialNum.fetchAndAddRelaxed(1); }
 
-    bool tryLoad(QSvgRenderer *renderer, QIcon::Mode mode, QIcon::State state);
-    bool tryLoad(QSvgRenderer *renderer, QIcon::Mode baseMode, QIcon::State baseState, QIcon::Mode mode, QIcon::State state, bool &colorsReplaced);
-    QIcon::Mode loadDataForModeAndState(QSvgRenderer *renderer, QIcon::Mode mode, QIcon::State state);
+    bool load(QSvgRenderer *renderer, const LC_SvgFileInfo* fileInfo, QIcon::Mode mode, QIcon::State state);
+    bool render(const LC_SvgFileInfo* fileInfo, const QSize &size, QIcon::Mode mode, QIcon::State state, const QString &profile, QImage &img);
+    QList<QPair<QIcon::Mode, QIcon::State>> fallbackOrder(QIcon::Mode mode, QIcon::State state) const;
+    static QString atlasKey(const LC_SvgFileInfo* fileInfo, const QSize &size, QIcon::Mode mode, QIcon::State state);
+    static QString atlasProfile();
     void checkFileOverride(QIcon::Mode mode, QIcon::State state, FileType fileType, QString plainSVGFileName);
     void checkFileOverride(QString baseName, QIcon::Mode mode, QIcon::State state, FileType fileType);
     void checkFileOverrideForAnyState(QString baseName, QIcon::Mode mode, QIcon::State state, FileType fileType);
@@ -222,16 +226,13 @@ QString getEnrichedFileName(QString baseName, int mode, int state, FileType type
 }
 
 void LC_SvgIconEnginePrivate::checkFileOverride(QIcon::Mode mode, QIcon::State state, FileType fileType, QString plainSVGFileName){
-    QFile plainSVGFile = QFile(plainSVGFileName);
-    if (plainSVGFile.exists()) {
-        QSvgRenderer renderer(plainSVGFileName);
-        if (renderer.isValid()) {
-            LC_SvgFileInfo* info = new LC_SvgFileInfo();
-            info->fileName = plainSVGFileName;
-            info->fileType = fileType;
-            stepSerialNum();
-            svgFiles.insert(hashKey(mode, state), info);
-        }
+    // the file is not parsed there, invalid files are skipped on rendering
+    if (QFile::exists(plainSVGFileName)) {
+        LC_SvgFileInfo* info = new LC_SvgFileInfo();
+        info->fileName = plainSVGFileName;
+        info->fileType = fileType;
+        stepSerialNum();
+        svgFiles.insert(hashKey(mode, state), info);
     }
 }
 
@@ -316,16 +317,12 @@ void LC_SVGIconEngine::addFile(const QString &fileName, const QSize &,
         // no icon override is provided by the user, so just check that provided file exists
         int key = d->hashKey(mode, state);
         if (!d->svgFiles.contains(key)) {
-            QFile plainSVGFile = QFile(fileName);
-            if (plainSVGFile.exists()) {
-                QSvgRenderer renderer(fileName);
-                if (renderer.isValid()) {
-                    LC_SvgFileInfo *info = new LC_SvgFileInfo();
-                    info->fileName = fileName;
-                    info->fileType = TemplateSVG;
-                    d->stepSerialNum();
-                    d->svgFiles.insert(key, info);
-                }
+            if (QFile::exists(fileName)) {
+                LC_SvgFileInfo *info = new LC_SvgFileInfo();
+                info->fileName = fileName;
+                info->fileType = TemplateSVG;
+                d->stepSerialNum();
+                d->svgFiles.insert(key, info);
             }
         }
     }
@@ -373,83 +370,122 @@ QString LC_SvgIconEnginePrivate::replaceColor(QString content, QString baseColor
     return content;
 }
 
-bool LC_SvgIconEnginePrivate::tryLoad(QSvgRenderer *renderer, QIcon::Mode mode, QIcon::State state){
-    bool ok;
-    return tryLoad(renderer, mode, state, mode, state, ok);
-}
+bool LC_SvgIconEnginePrivate::load(QSvgRenderer *renderer, const LC_SvgFileInfo* fileInfo, QIcon::Mode mode, QIcon::State state){
+    switch (fileInfo->fileType) {
+        case TemplateSVG: {
+            QFile file(fileInfo->fileName);
+            if (file.open(QFile::ReadOnly | QFile::Text)) {
+                QTextStream in(&file);
+                QString content = in.readAll();
 
-bool LC_SvgIconEnginePrivate::tryLoad(QSvgRenderer *renderer, QIcon::Mode baseMode, QIcon::State baseState, QIcon::Mode mode, QIcon::State state, bool &colorsReplaced){
-    LC_SvgFileInfo* fileInfo = svgFiles.value(hashKey(baseMode, baseState));
-    if (fileInfo != nullptr) {
-        switch (fileInfo->fileType) {
-            case TemplateSVG: {
-                QFile file(fileInfo->fileName);
-                if (file.open(QFile::ReadOnly | QFile::Text)) {
-                    QTextStream in(&file);
-                    QString content = in.readAll();
-
-                    content = replaceColor(content, LC_SVGIconEngineAPI::KEY_COLOR_MAIN, mode, state, TEMPLATE_COLOR_MAIN);
-                    content = replaceColor(content, LC_SVGIconEngineAPI::KEY_COLOR_ACCENT, mode, state, TEMPLATE_COLOR_ACCENT);
-                    content = replaceColor(content, LC_SVGIconEngineAPI::KEY_COLOR_BG, mode, state, TEMPLATE_COLOR_BACKGROUND_FILL);
-
-                    QByteArray byteArrayContent = content.toUtf8();
-                    renderer->load(byteArrayContent);
-                    colorsReplaced = true;
-                    return true;
-                }
-                break;
-            }
-            case PlainSVG: {
-                QString fileName = fileInfo->fileName;
-                renderer->load(fileName);
-                return true;
+                content = replaceColor(content, LC_SVGIconEngineAPI::KEY_COLOR_MAIN, mode, state, TEMPLATE_COLOR_MAIN);
+                content = replaceColor(content, LC_SVGIconEngineAPI::KEY_COLOR_ACCENT, mode, state, TEMPLATE_COLOR_ACCENT);
+                content = replaceColor(content, LC_SVGIconEngineAPI::KEY_COLOR_BG, mode, state, TEMPLATE_COLOR_BACKGROUND_FILL);
+
+                QByteArray byteArrayContent = content.toUtf8();
+                return renderer->load(byteArrayContent);
             }
+            break;
+        }
+        case PlainSVG: {
+            QString fileName = fileInfo->fileName;
+            return renderer->load(fileName);
         }
     }
     return false;
 }
 
-QIcon::Mode LC_SvgIconEnginePrivate::loadDataForModeAndState(QSvgRenderer *renderer, QIcon::Mode mode, QIcon::State state){
-    if (tryLoad(renderer, mode, state))
-        return mode;
-
-    bool colorsReplaced = false;
+// modes and states of files that are tried for the icon, in order of preference
+QList<QPair<QIcon::Mode, QIcon::State>> LC_SvgIconEnginePrivate::fallbackOrder(QIcon::Mode mode, QIcon::State state) const{
     const QIcon::State oppositeState = (state == QIcon::On) ? QIcon::Off : QIcon::On;
     if (mode == QIcon::Disabled || mode == QIcon::Selected) {
         const QIcon::Mode oppositeMode = (mode == QIcon::Disabled) ? QIcon::Selected : QIcon::Disabled;
+        return {{mode, state},
+                {QIcon::Normal, state},
+                {QIcon::Active, state},
+                {mode, oppositeState},
+                {QIcon::Normal, oppositeState},
+                {QIcon::Active, oppositeState},
+                {oppositeMode, state},
+                {oppositeMode, oppositeState}};
+    }
+    const QIcon::Mode oppositeMode = (mode == QIcon::Normal) ? QIcon::Active : QIcon::Normal;
+    return {{mode, state},
+            {oppositeMode, state},
+            {mode, oppositeState},
+            {oppositeMode, oppositeState},
+            {QIcon::Disabled, state},
+            {QIcon::Selected, state},
+            {QIcon::Disabled, oppositeState},
+            {QIcon::Selected, oppositeState}};
+}
+
+// identifies rendered image within the atlas profile
+QString LC_SvgIconEnginePrivate::atlasKey(const LC_SvgFileInfo* fileInfo, const QSize &size, QIcon::Mode mode, QIcon::State state){
+    QString result = fileInfo->fileName;
+    result.append(QLatin1Char('|')).append(QString::number(fileInfo->fileType));
+    if (!fileInfo->fileName.startsWith(QLatin1Char(':'))) {
+        // user overrides may be edited between starts, resources are covered by application version
+        result.append(QLatin1Char('|')).append(QString::number(QFileInfo(fileInfo->fileName).lastModified().toMSecsSinceEpoch()));
+    }
+    result.append(QLatin1Char('|')).append(QString::number(size.width())).append(QLatin1Char('x')).append(QString::number(size.height()));
+    if (fileInfo->fileType == TemplateSVG) {
+        // colors of templates depend on mode and state
+        result.append(QLatin1Char('|')).append(QString::number(mode)).append(QLatin1Char('|')).append(QString::number(state));
+    }
+    return result;
+}
+
+// settings which affect rendering of the same file
+QString LC_SvgIconEnginePrivate::atlasProfile(){
+    QStringList result;
+    result << QCoreApplication::applicationVersion() << QLatin1String(QT_VERSION_STR);
+    auto guiApplication = qobject_cast<QGuiApplication *>(QCoreApplication::instance());
+    result << QString::number(guiApplication != nullptr ? guiApplication->devicePixelRatio() : 1.0);
+    if (guiApplication != nullptr) {
+        result << guiApplication->property(LC_SVGIconEngineAPI::KEY_ICONS_OVERRIDES_DIR).toString();
+        for (const char* baseKey: {LC_SVGIconEngineAPI::KEY_COLOR_MAIN, LC_SVGIconEngineAPI::KEY_COLOR_ACCENT, LC_SVGIconEngineAPI::KEY_COLOR_BG}) {
+            for (int mode = -1; mode <= QIcon::Selected; mode++) {
+                for (int state = -1; state <= QIcon::Off; state++) {
+                    result << LC_SVGIconEngineAPI::getColorAppProperty(baseKey, mode, state);
+                }
+            }
+        }
+    }
+    return result.join(QLatin1Char('|'));
+}
+
+bool LC_SvgIconEnginePrivate::render(const LC_SvgFileInfo* fileInfo, const QSize &size, QIcon::Mode mode, QIcon::State state,
+                                     const QString &profile, QImage &img){
+    LC_SvgIconAtlas* atlas = LC_SvgIconAtlas::instance();
+    const QString key = atlasKey(fileInfo, size, mode, state);
+    if (atlas->find(profile, key, img)) {
+        return true;
+    }
+
+    QSvgRenderer renderer;
+    if (!load(&renderer, fileInfo, mode, state) || !renderer.isValid()) {
+        return false;
+    }
 
-        if (tryLoad(renderer, QIcon::Normal, state, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Normal;
-        if (tryLoad(renderer, QIcon::Active, state, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Active;
-        if (tryLoad(renderer, mode, oppositeState, mode, state,colorsReplaced))
-            return mode;
-        if (tryLoad(renderer, QIcon::Normal, oppositeState, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Normal;
-        if (tryLoad(renderer, QIcon::Active, oppositeState, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Active;
-        if (tryLoad(renderer, oppositeMode, state, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : oppositeMode;
-        if (tryLoad(renderer, oppositeMode, oppositeState, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : oppositeMode;
-    } else {
-        const QIcon::Mode oppositeMode = (mode == QIcon::Normal) ? QIcon::Active : QIcon::Normal;
-        if (tryLoad(renderer, oppositeMode, state, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : oppositeMode;
-        if (tryLoad(renderer, mode, oppositeState, mode, state,colorsReplaced))
-            return mode;
-        if (tryLoad(renderer, oppositeMode, oppositeState, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : oppositeMode;
-        if (tryLoad(renderer, QIcon::Disabled, state, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Disabled;
-        if (tryLoad(renderer, QIcon::Selected, state, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Selected;
-        if (tryLoad(renderer, QIcon::Disabled, oppositeState, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Disabled;
-        if (tryLoad(renderer, QIcon::Selected, oppositeState, mode, state,colorsReplaced))
-            return colorsReplaced ? mode : QIcon::Selected;
-    }
-    return QIcon::Normal;
+    QSize actualSize = renderer.defaultSize();
+    if (!actualSize.isNull()) {
+        actualSize.scale(size, Qt::KeepAspectRatio);
+    }
+
+    if (actualSize.isEmpty()) {
+        img = QImage();
+        return true;
+    }
+
+    img = QImage(actualSize, QImage::Format_ARGB32_Premultiplied);
+    img.fill(0x00000000);
+    QPainter p(&img);
+    renderer.render(&p);
+    p.end();
+
+    atlas->insert(profile, key, img);
+    return true;
 }
 
 QPixmap LC_SVGIconEngine::pixmap(const QSize &size, QIcon::Mode mode,
@@ -470,27 +506,26 @@ QPixmap LC_SVGIconEngine::pixmap(const QSize &size, QIcon::Mode mode,
         }
     }
 
-    QSvgRenderer renderer;
-    const QIcon::Mode foundMode = d->loadDataForModeAndState(&renderer, mode, state);
-    if (!renderer.isValid()) {
-        return pm;
+    const QString profile = LC_SvgIconEnginePrivate::atlasProfile();
+    QIcon::Mode foundMode = QIcon::Normal;
+    QImage img;
+    bool rendered = false;
+    for (const auto &candidate: d->fallbackOrder(mode, state)) {
+        const LC_SvgFileInfo* fileInfo = d->svgFiles.value(d->hashKey(candidate.first, candidate.second));
+        if (fileInfo != nullptr && d->render(fileInfo, size, mode, state, profile, img)) {
+            // colors of templates are replaced for the requested mode
+            foundMode = (fileInfo->fileType == TemplateSVG) ? mode : candidate.first;
+            rendered = true;
+            break;
+        }
     }
-
-    QSize actualSize = renderer.defaultSize();
-    if (!actualSize.isNull()) {
-        actualSize.scale(size, Qt::KeepAspectRatio);
+    if (!rendered) {
+        return pm;
     }
-
-    if (actualSize.isEmpty()) {
+    if (img.isNull()) {
         return QPixmap();
     }
 
-    QImage img(actualSize, QImage::Format_ARGB32_Premultiplied);
-    img.fill(0x00000000);
-    QPainter p(&img);
-    renderer.render(&p);
-    p.end();
-
     pm = QPixmap::fromImage(img);
     if (qobject_cast<QGuiApplication *>(QCoreApplication::instance())) {
         if (foundMode != mode && mode != QIcon::Normal) {
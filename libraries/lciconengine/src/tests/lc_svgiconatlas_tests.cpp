@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <QColor>
+#include <QImage>
+#include <QStandardPaths>
+#include <QUuid>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_svgiconatlas.h"
+
+namespace {
+LC_SvgIconAtlas* testAtlas() {
+    // keeps atlas files of tests out of the user cache
+    QStandardPaths::setTestModeEnabled(true);
+    return LC_SvgIconAtlas::instance();
+}
+
+QString uniqueProfile() {
+    return QUuid::createUuid().toString();
+}
+
+QImage makeIcon(int size, QRgb color) {
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(color);
+    return image;
+}
+}
+
+TEST_CASE("LC_SvgIconAtlas returns inserted icons after reloading the atlas file", "[LC_SvgIconAtlas]") {
+    LC_SvgIconAtlas* atlas = testAtlas();
+    const QString profile = uniqueProfile();
+    const QImage red = makeIcon(24, qRgba(255, 0, 0, 255));
+    const QImage translucent = makeIcon(16, qPremultiply(qRgba(0, 0, 255, 128)));
+
+    QImage found;
+    REQUIRE(!atlas->find(profile, "red", found));
+    atlas->insert(profile, "red", red);
+    atlas->insert(profile, "blue", translucent);
+    REQUIRE(atlas->find(profile, "red", found));
+    REQUIRE(found == red);
+
+    // switching the profile saves the atlas, switching back maps the written file
+    REQUIRE(!atlas->find(uniqueProfile(), "red", found));
+    REQUIRE(atlas->find(profile, "red", found));
+    REQUIRE(found == red);
+    REQUIRE(atlas->find(profile, "blue", found));
+    REQUIRE(found == translucent);
+}
+
+TEST_CASE("LC_SvgIconAtlas does not store large images", "[LC_SvgIconAtlas]") {
+    LC_SvgIconAtlas* atlas = testAtlas();
+    const QString profile = uniqueProfile();
+    atlas->insert(profile, "large", makeIcon(512, qRgba(0, 255, 0, 255)));
+    QImage found;
+    REQUIRE(!atlas->find(profile, "large", found));
+}
+
+TEST_CASE("LC_SvgIconAtlas drops least recently used icons", "[LC_SvgIconAtlas]") {
+    LC_SvgIconAtlas* atlas = testAtlas();
+    const QString profile = uniqueProfile();
+    const QImage icon = makeIcon(1, qRgba(0, 0, 0, 255));
+    QImage found;
+    atlas->insert(profile, "used", icon);
+    for (int i = 0; i < LC_SvgIconAtlas::MAX_ENTRIES; i++) {
+        atlas->insert(profile, QString::number(i), icon);
+        if (i == LC_SvgIconAtlas::MAX_ENTRIES / 2) {
+            REQUIRE(atlas->find(profile, "used", found));
+        }
+    }
+    REQUIRE(atlas->find(profile, "used", found));
+    REQUIRE(!atlas->find(profile, "0", found));
+    REQUIRE(atlas->find(profile, QString::number(LC_SvgIconAtlas::MAX_ENTRIES - 1), found));
+
+    // the pruned atlas is written as well
+    REQUIRE(!atlas->find(uniqueProfile(), "used", found));
+    REQUIRE(atlas->find(profile, "used", found));
+    REQUIRE(!atlas->find(profile, "0", found));
+}
+
+TEST_CASE("LC_SvgIconAtlas may be used from several threads", "[LC_SvgIconAtlas]") {
+    LC_SvgIconAtlas* atlas = testAtlas();
+    const QString profile = uniqueProfile();
+    std::atomic<int> missing{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([atlas, &profile, &missing, t]() {
+            const QImage icon = makeIcon(8, qRgba(t * 60, 0, 0, 255));
+            for (int i = 0; i < 200; i++) {
+                const QString key = QString("%1-%2").arg(t).arg(i);
+                atlas->insert(profile, key, icon);
+                QImage found;
+                if (!atlas->find(profile, key, found) || found != icon) {
+                    missing++;
+                }
+            }
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    REQUIRE(missing == 0);
+}
@@ -76,7 +76,7 @@ bool LC_ActionLayersExport::collectLayersToExport(LC_LayersExportOptions* export
         // fixme - sand - files - use more generic way for message notify!
         QC_ApplicationWindow::getAppWindow()->statusBar()->showMessage( QObject::tr("No %1 layers found").arg(exportModeString),
                                                                         QC_ApplicationWindow::DEFAULT_STATUS_BAR_MESSAGE_TIMEOUT);
-        RS_DEBUG->print(RS_Debug::D_ERROR, "LC_ActionLayersExport::trigger: No %s layers found", exportModeString.toStdString().c_str());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_ERROR, "LC_ActionLayersExport::trigger: No %s layers found", exportModeString.toStdString().c_str());
         return false;
     }
     return true;
@@ -196,11 +196,11 @@ double RS_ActionDrawPolyline::solveBulge(const RS_Vector &mouse){
         case Tangential:
             if (m_actionData->polyline){
                 if (m_prepend) {
-                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->firstEntity());
+                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->first());
                     direction = RS_Math::correctAngle(lastentity->getDirection1() + M_PI);
                 }
                 else{
-                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->lastEntity());
+                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->last());
                     direction = RS_Math::correctAngle(lastentity->getDirection2() + M_PI);
                 }
 
@@ -237,11 +237,11 @@ double RS_ActionDrawPolyline::solveBulge(const RS_Vector &mouse){
         case TanRad: {
             if (m_actionData->polyline){
                 if (m_prepend){
-                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->firstEntity());
+                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->first());
                     direction = RS_Math::correctAngle(lastentity->getDirection1() + M_PI);
                 }
                 else{
-                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->lastEntity());
+                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->last());
                     direction = RS_Math::correctAngle(lastentity->getDirection2() + M_PI);
                 }
                 suc = arc.createFrom2PDirectionRadius(m_actionData->point, mouse,
@@ -263,11 +263,11 @@ double RS_ActionDrawPolyline::solveBulge(const RS_Vector &mouse){
         case TanAng: {
             if (m_actionData->polyline){
                 if (m_prepend){
-                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->firstEntity());
+                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->first());
                     direction = RS_Math::correctAngle(lastentity->getDirection1() + M_PI);
                 }
                 else{
-                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->lastEntity());
+                    lastentity = dynamic_cast<RS_AtomicEntity *>(m_actionData->polyline->last());
                     direction = RS_Math::correctAngle(lastentity->getDirection2() + M_PI);
                 }
                 suc = arc.createFrom2PDirectionAngle(m_actionData->point, mouse,
@@ -72,8 +72,8 @@ void RS_ActionPolylineAppend::onMouseMoveEvent(int status, LC_MouseEvent *e) {
                 highlightHover(polyline);
 
                 if (m_showRefEntitiesOnPreview) {
-                    auto entFirst = polyline->firstEntity();
-                    auto entLast = polyline->lastEntity();
+                    auto entFirst = polyline->first();
+                    auto entLast = polyline->last();
 
                     RS_Vector endpointToUse;
 
@@ -126,8 +126,8 @@ bool RS_ActionPolylineAppend::setPolylineToModify(RS_Entity* entity, const RS_Ve
         return false;
     } else {
         auto *op = m_originalPolyline;
-        auto entFirst = op->firstEntity();
-        auto entLast = op->lastEntity();
+        auto entFirst = op->first();
+        auto entLast = op->last();
 
         double dist = toGraphDX(m_catchEntityGuiRange) * 0.9;
 
@@ -205,7 +205,7 @@ void RS_ActionPolylineEquidistant::makeContour(RS_Polyline*  originalPolyline, b
                 }
                 //check if the entity are reverted
                 if (fabs(remainder(prevEntity->getStartpoint().angleTo(prevEntity->getEndpoint()) - startAngle, 2. * M_PI)) > 0.785){
-                    prevEntity = newPolyline->lastEntity();
+                    prevEntity = newPolyline->last();
                     RS_Vector v0 = calculateIntersection(prevEntity, currEntity);
                     if (prevEntity->rtti() == RS2::EntityArc){
                         auto arc = static_cast<RS_Arc*>(prevEntity);
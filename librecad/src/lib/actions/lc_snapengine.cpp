@@ -0,0 +1,413 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_snapengine.h"
+
+#include <unordered_map>
+
+#include <QObject>
+
+#include "lc_trace.h"
+#include "rs_entity.h"
+#include "rs_entitycontainer.h"
+
+/**
+ * Deep copies of the visible entities of a container, searched instead of the container.
+ */
+struct LC_SnapEngine::Snapshot {
+    /**
+     * Copy of a visible entity of the source, with the state of the entity when it was copied.
+     */
+    struct Copy {
+        RS_Entity* entity = nullptr;
+        unsigned long long id = 0;
+        // revision of containers, reference points and borders of other entities
+        std::uint64_t revision = 0;
+        RS_VectorSolutions refPoints;
+        RS_Vector min{false};
+        RS_Vector max{false};
+
+        Copy(RS_Entity* copy, const RS_Entity* original);
+        bool isUpToDate(const RS_Entity* original) const;
+    };
+
+    const RS_EntityContainer* source = nullptr;
+    std::uint64_t revision = 0;
+    unsigned freezeRevision = 0;
+    // not changed once built, but borders of containers are calculated lazily by the search
+    mutable RS_EntityContainer container{nullptr, true};
+    // copies to the entities they were created from
+    std::unordered_map<const RS_Entity*, RS_Entity*> originals;
+    // entities of the source to their copies in the container
+    std::unordered_map<const RS_Entity*, Copy> copies;
+
+    void add(RS_Entity* original);
+    bool takeOver(Snapshot& previous, RS_Entity* original);
+    void dropCopies();
+    RS_Entity* toOriginal(const RS_Entity* copy) const;
+private:
+    void append(RS_Entity* original, const Copy& copy);
+    void map(RS_Entity* original, RS_Entity* copy);
+};
+
+namespace {
+bool isSame(const RS_Vector& a, const RS_Vector& b) {
+    return a.valid == b.valid && a.x == b.x && a.y == b.y;
+}
+}
+
+LC_SnapEngine::Snapshot::Copy::Copy(RS_Entity* copy, const RS_Entity* original)
+    : entity{copy}
+    , id{original->getId()} {
+    if (original->isContainer()) {
+        revision = static_cast<const RS_EntityContainer*>(original)->getRevision();
+    }
+    else {
+        refPoints = original->getRefPoints();
+        min = original->getMin();
+        max = original->getMax();
+    }
+}
+
+/**
+ * @return true if the original was not replaced or changed since it was copied. Atomic entities have no revision,
+ * changes of their geometry are found by their reference points and borders.
+ */
+bool LC_SnapEngine::Snapshot::Copy::isUpToDate(const RS_Entity* original) const {
+    if (original->getId() != id) {
+        return false;
+    }
+    if (original->isContainer()) {
+        return static_cast<const RS_EntityContainer*>(original)->getRevision() == revision;
+    }
+    const RS_VectorSolutions points = original->getRefPoints();
+    if (points.size() != refPoints.size() || !isSame(original->getMin(), min) || !isSame(original->getMax(), max)) {
+        return false;
+    }
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (!isSame(points[i], refPoints[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LC_SnapEngine::Snapshot::add(RS_Entity* original) {
+    RS_Entity* copy = original->clone();
+    append(original, Copy{copy, original});
+}
+
+/**
+ * Moves the copy of the original from the previous snapshot, if the original was not changed since.
+ */
+bool LC_SnapEngine::Snapshot::takeOver(Snapshot& previous, RS_Entity* original) {
+    auto it = previous.copies.find(original);
+    if (it == previous.copies.end() || !it->second.isUpToDate(original)) {
+        return false;
+    }
+    const Copy copy = it->second;
+    previous.copies.erase(it);
+    append(original, copy);
+    return true;
+}
+
+/**
+ * Deletes the copies which were not taken over by the next snapshot.
+ */
+void LC_SnapEngine::Snapshot::dropCopies() {
+    container.setOwner(false);
+    container.clear();
+    for (auto& [original, copy] : copies) {
+        delete copy.entity;
+    }
+    copies.clear();
+    originals.clear();
+}
+
+void LC_SnapEngine::Snapshot::append(RS_Entity* original, const Copy& copy) {
+    // not the override of containers, which moves the children to the given parent
+    copy.entity->RS_Entity::reparent(&container);
+    container.appendEntity(copy.entity);
+    copies.emplace(original, copy);
+    map(original, copy.entity);
+}
+
+/**
+ * Restores parents of copied children, takes their visibility from the originals and drops references to
+ * layers, which may be deleted while the snapshot is searched.
+ */
+void LC_SnapEngine::Snapshot::map(RS_Entity* original, RS_Entity* copy) {
+    originals.emplace(copy, original);
+    copy->setLayer(nullptr);
+    if (!original->isContainer() || !copy->isContainer()) {
+        return;
+    }
+    auto* from = static_cast<RS_EntityContainer*>(original);
+    auto* to = static_cast<RS_EntityContainer*>(copy);
+    // containers are cloned with their children in the same order, except temporary ones
+    int index = 0;
+    for (RS_Entity* child : *from) {
+        if (child->getFlag(RS2::FlagTemp)) {
+            continue;
+        }
+        RS_Entity* childCopy = to->entityAt(index++);
+        if (childCopy == nullptr) {
+            break;
+        }
+        childCopy->RS_Entity::reparent(to);
+        if (!child->isVisible()) {
+            childCopy->setVisible(false);
+        }
+        map(child, childCopy);
+    }
+    for (int count = static_cast<int>(to->count()); index < count; ++index) {
+        // not expected, but copies left unmapped must not refer to layers either
+        RS_Entity* childCopy = to->entityAt(index);
+        childCopy->RS_Entity::reparent(to);
+        map(childCopy, childCopy);
+    }
+}
+
+RS_Entity* LC_SnapEngine::Snapshot::toOriginal(const RS_Entity* copy) const {
+    auto it = originals.find(copy);
+    return (it == originals.end() || it->first == it->second) ? nullptr : it->second;
+}
+
+bool LC_SnapEngine::Query::isEmpty() const {
+    return !(endpoint || center || middle || distance || intersection || onEntity);
+}
+
+bool LC_SnapEngine::Query::operator == (const Query& other) const {
+    return coord.valid == other.coord.valid
+           && coord.x == other.coord.x
+           && coord.y == other.coord.y
+           && endpoint == other.endpoint
+           && center == other.center
+           && middle == other.middle
+           && distance == other.distance
+           && intersection == other.intersection
+           && onEntity == other.onEntity
+           && middlePoints == other.middlePoints
+           && snapDistance == other.snapDistance
+           && switchToFreeDistance == other.switchToFreeDistance;
+}
+
+/**
+ * @return true if the container was not changed since the result was computed for it.
+ */
+bool LC_SnapEngine::Result::isUpToDate(const RS_EntityContainer* container) const {
+    return container != nullptr && container->getRevision() == revision
+           && container->getFreezeRevision() == freezeRevision;
+}
+
+LC_SnapEngine::LC_SnapEngine() {
+    m_pool.setMaxThreadCount(1);
+}
+
+LC_SnapEngine::~LC_SnapEngine() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasPending = false;
+        m_runningReceiver = nullptr;
+        m_cancelled.store(true, std::memory_order_relaxed);
+    }
+    m_pool.waitForDone();
+}
+
+LC_SnapEngine* LC_SnapEngine::instance() {
+    static LC_SnapEngine engine;
+    return &engine;
+}
+
+/**
+ * Requests the search on the GUI thread, superseding the previous request of any receiver.
+ * The callback is called on the thread of the receiver.
+ */
+void LC_SnapEngine::request(RS_EntityContainer* container, const Query& query, QObject* receiver,
+                            Callback callback) {
+    if (container == nullptr || receiver == nullptr) {
+        return;
+    }
+    std::shared_ptr<const Snapshot> snapshot = obtainSnapshot(container);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending = Request{query, std::move(snapshot), receiver, std::move(callback)};
+    m_hasPending = true;
+    if (m_running) {
+        m_cancelled.store(true, std::memory_order_relaxed);
+        return;
+    }
+    m_running = true;
+    m_pool.start([this]() {
+        processRequests();
+    });
+}
+
+/**
+ * Drops the request of the receiver, if it's pending or running. The callback is not called after that.
+ */
+void LC_SnapEngine::cancel(const QObject* receiver) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_hasPending && m_pending.receiver == receiver) {
+        m_pending = Request{};
+        m_hasPending = false;
+    }
+    if (m_runningReceiver == receiver) {
+        m_runningReceiver = nullptr;
+        m_cancelled.store(true, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Returns the snapshot of the last request while the container is unchanged. Otherwise a new snapshot is built,
+ * taking over the copies of unchanged entities from the last one, unless the worker may still search it.
+ */
+std::shared_ptr<const LC_SnapEngine::Snapshot> LC_SnapEngine::obtainSnapshot(RS_EntityContainer* container) {
+    const std::uint64_t revision = container->getRevision();
+    const unsigned freezeRevision = container->getFreezeRevision();
+    if (m_snapshot != nullptr && m_snapshot->source == container && m_snapshot->revision == revision
+        && m_snapshot->freezeRevision == freezeRevision) {
+        return m_snapshot;
+    }
+    LC_TRACE_SCOPE("snap", "snapshot");
+    std::shared_ptr<Snapshot> previous;
+    // frozen layers change the visibility of nested copies, so these are not taken over
+    if (m_snapshot != nullptr && m_snapshot->source == container && m_snapshot->freezeRevision == freezeRevision) {
+        // requests are made on this thread only, so the worker doesn't start once found idle
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            previous = std::move(m_snapshot);
+        }
+    }
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->source = container;
+    {
+        // copies get no parent, so cloning doesn't invalidate the container
+        RS_Entity::DetachedCloneGuard detachedClones;
+        for (RS_Entity* entity : *container) {
+            if (entity != nullptr && entity->isVisible()
+                && (previous == nullptr || !snapshot->takeOver(*previous, entity))) {
+                snapshot->add(entity);
+            }
+        }
+    }
+    if (previous != nullptr) {
+        previous->dropCopies();
+    }
+    // read after copying, so the snapshot is never newer than its revision
+    snapshot->revision = container->getRevision();
+    snapshot->freezeRevision = container->getFreezeRevision();
+    m_snapshot = snapshot;
+    return m_snapshot;
+}
+
+void LC_SnapEngine::processRequests() {
+    while (true) {
+        Request request;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_hasPending) {
+                m_running = false;
+                m_runningReceiver = nullptr;
+                return;
+            }
+            request = std::move(m_pending);
+            m_pending = Request{};
+            m_hasPending = false;
+            m_runningReceiver = request.receiver;
+            m_cancelled.store(false, std::memory_order_relaxed);
+        }
+        const Snapshot& snapshot = *request.snapshot;
+        Result result = compute(&snapshot.container, request.query, &m_cancelled);
+        result.keyEntity = snapshot.toOriginal(result.keyEntity);
+        result.revision = snapshot.revision;
+        result.freezeRevision = snapshot.freezeRevision;
+        // the snapshot may be the last reference, released on this thread
+        request.snapshot.reset();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // posted under the lock, so the receiver is not destroyed before cancel() returns
+        if (!result.cancelled && !m_hasPending && m_runningReceiver == request.receiver) {
+            QMetaObject::invokeMethod(request.receiver, [callback = std::move(request.callback), result]() {
+                callback(result);
+            }, Qt::QueuedConnection);
+        }
+        m_runningReceiver = nullptr;
+    }
+}
+
+/**
+ * Finds the closest snap point on entities, checking snap modes in the same order
+ * as RS_Snapper does.
+ */
+LC_SnapEngine::Result LC_SnapEngine::compute(RS_EntityContainer* container, const Query& query,
+                                             const std::atomic<bool>* cancelled) {
+    LC_TRACE_SCOPE("snap", "entity snap");
+    Result result;
+    result.query = query;
+    if (container == nullptr) {
+        return result;
+    }
+    result.revision = container->getRevision();
+    result.freezeRevision = container->getFreezeRevision();
+    const RS_Vector& coord = query.coord;
+    auto isCancelled = [cancelled, &result]() {
+        if (cancelled != nullptr && cancelled->load(std::memory_order_relaxed)) {
+            result.cancelled = true;
+        }
+        return result.cancelled;
+    };
+    auto consider = [&result, &coord](const RS_Vector& t, SnapSource source) {
+        double ds2 = coord.squaredTo(t);
+        if (ds2 < result.distanceSquared) {
+            result.distanceSquared = ds2;
+            result.spot = t;
+            result.source = source;
+        }
+    };
+
+    if (query.endpoint) {
+        RS_Vector t = container->getNearestEndpoint(coord, nullptr);
+        if (t.valid) {
+            consider(t, Endpoint);
+        }
+    }
+    if (query.center && !isCancelled()) {
+        consider(container->getNearestCenter(coord, nullptr), Center);
+    }
+    if (query.middle && !isCancelled()) {
+        consider(container->getNearestMiddle(coord, nullptr, query.middlePoints), Middle);
+    }
+    if (query.distance && !isCancelled()) {
+        consider(container->getNearestDist(query.snapDistance, coord, nullptr), Distance);
+    }
+    if (query.intersection && !isCancelled()) {
+        consider(container->getNearestIntersection(coord, nullptr), Intersection);
+    }
+    if (query.onEntity && result.spot.distanceTo(coord) > query.switchToFreeDistance && !isCancelled()) {
+        RS_Entity* keyEntity = nullptr;
+        consider(container->getNearestPointOnEntity(coord, true, nullptr, &keyEntity), OnEntity);
+        result.keyEntity = keyEntity;
+        result.onEntityChecked = true;
+    }
+    isCancelled();
+    return result;
+}
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_SNAPENGINE_H
+#define LC_SNAPENGINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <QThreadPool>
+
+#include "rs_vector.h"
+
+class QObject;
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Searches snap points on entities on a worker thread. One engine is shared by all snappers.
+ *
+ * The worker never reads the document. It searches an immutable snapshot of the container: deep copies
+ * of its visible entities, built on the GUI thread by the first request made after the content of the
+ * container or the frozen state of layers was changed, and reused by the following requests. A new snapshot
+ * takes over the copies of entities which were not changed since the previous one.
+ *
+ * Only the latest request is searched: a new request supersedes the pending one, and cancels the running
+ * search between snap modes. The result is passed to the callback of the request, which is called on the
+ * thread of the receiver, unless the request was superseded or cancelled, or the receiver was destroyed.
+ */
+class LC_SnapEngine {
+public:
+    struct Query {
+        RS_Vector coord{false};
+        bool endpoint = false;
+        bool center = false;
+        bool middle = false;
+        bool distance = false;
+        bool intersection = false;
+        bool onEntity = false;
+        int middlePoints = 1;
+        double snapDistance = 1.0;
+        double switchToFreeDistance = 5.0;
+
+        bool isEmpty() const;
+        bool operator == (const Query& other) const;
+    };
+
+    enum SnapSource {
+        None,
+        Endpoint,
+        Center,
+        Middle,
+        Distance,
+        Intersection,
+        OnEntity
+    };
+
+    struct Result {
+        Query query;
+        RS_Vector spot{false};
+        SnapSource source = None;
+        // squared distance from the cursor to the spot
+        double distanceSquared = RS_MAXDOUBLE * RS_MAXDOUBLE;
+        // entity of the searched container, valid while the container keeps the revision below
+        RS_Entity* keyEntity = nullptr;
+        bool onEntityChecked = false;
+        bool cancelled = false;
+        std::uint64_t revision = 0;
+        unsigned freezeRevision = 0;
+
+        bool isUpToDate(const RS_EntityContainer* container) const;
+    };
+
+    using Callback = std::function<void(const Result& result)>;
+
+    static LC_SnapEngine* instance();
+    ~LC_SnapEngine();
+
+    void request(RS_EntityContainer* container, const Query& query, QObject* receiver, Callback callback);
+    void cancel(const QObject* receiver);
+
+    static Result compute(RS_EntityContainer* container, const Query& query,
+                          const std::atomic<bool>* cancelled = nullptr);
+private:
+    LC_SnapEngine();
+
+    struct Snapshot;
+    struct Request {
+        Query query;
+        std::shared_ptr<const Snapshot> snapshot;
+        QObject* receiver = nullptr;
+        Callback callback;
+    };
+
+    std::shared_ptr<const Snapshot> obtainSnapshot(RS_EntityContainer* container);
+    void processRequests();
+
+    QThreadPool m_pool;
+    std::mutex m_mutex;
+    Request m_pending;
+    bool m_hasPending = false;
+    bool m_running = false;
+    // receiver of the running search, reset when the search is cancelled
+    const QObject* m_runningReceiver = nullptr;
+    std::atomic<bool> m_cancelled{false};
+    // the snapshot of the last request, used on the GUI thread only
+    std::shared_ptr<Snapshot> m_snapshot;
+};
+
+#endif // LC_SNAPENGINE_H
@@ -34,7 +34,9 @@
 #include "lc_defaults.h"
 #include "lc_graphicviewport.h"
 #include "lc_linemath.h"
+#include "lc_trace.h"
 #include "lc_overlayentitiescontainer.h"
+#include "lc_snapengine.h"
 #include "rs_debug.h"
 #include "rs_graphic.h"
 #include "rs_graphicview.h"
@@ -193,12 +195,38 @@ enum SnapType{
     ANGLE_ON_ENTITY
 };
 
+namespace {
+    int toSnapType(LC_SnapEngine::SnapSource source) {
+        switch (source) {
+            case LC_SnapEngine::Endpoint:
+                return SnapType::ENDPOINT;
+            case LC_SnapEngine::Center:
+                return SnapType::CENTER;
+            case LC_SnapEngine::Middle:
+                return SnapType::MIDDLE;
+            case LC_SnapEngine::Distance:
+                return SnapType::DISTANCE;
+            case LC_SnapEngine::Intersection:
+                return SnapType::INTERSECTION;
+            case LC_SnapEngine::OnEntity:
+                return SnapType::ENTITY;
+            default:
+                return SnapType::FREE;
+        }
+    }
+}
+
 struct RS_Snapper::ImpData {
     RS_Vector snapCoord;
     RS_Vector snapSpot;
     int snapType = 0;
     double angle = 0.;
     int restriction = RS2::RestrictNothing;
+    // entity snaps searched in background: the last request and the last result
+    LC_SnapEngine::Query requestedQuery;
+    bool requested = false;
+    LC_SnapEngine::Result entitySnap;
+    bool hasEntitySnap = false;
 };
 
 /**
@@ -216,7 +244,9 @@ RS_Snapper::RS_Snapper(LC_ActionContext *actionContext)
     m_infoCursorOverlayPrefs = m_graphicView->getInfoCursorOverlayPreferences();
 }
 
-RS_Snapper::~RS_Snapper() = default;
+RS_Snapper::~RS_Snapper() {
+    cancelBackgroundSnap();
+}
 
 
 /**
@@ -277,6 +307,7 @@ void RS_Snapper::initFromSettings() {
         m_distanceBeforeSwitchToFreeSnap = LC_GET_INT("AdvSnapOnEntitySwitchToFreeDistance", 500) / 100.0;
         m_catchEntityGuiRange =  LC_GET_INT("AdvSnapEntityCatchRange", 32);
         m_minGridCellSnapFactor = LC_GET_INT("AdvSnapGridCellSnapFactor", 25) / 100.0;
+        m_backgroundSnap = LC_GET_BOOL("BackgroundSearch", true);
     }
     LC_GROUP_END();
 
@@ -297,6 +328,7 @@ void RS_Snapper::initFromGraphic(RS_Graphic *graphic) {
 
 void RS_Snapper::finish() {
     m_finished = true;
+    cancelBackgroundSnap();
     deleteSnapper();
     deleteInfoCursor();
 
@@ -336,81 +368,26 @@ RS_Vector RS_Snapper::snapFree(QMouseEvent* e) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapPoint(QMouseEvent* e){
-    pImpData->snapSpot = RS_Vector(false);
-    RS_Vector t(false);
-
     if (!e) {
+        pImpData->snapSpot = RS_Vector(false);
         RS_DEBUG->print(RS_Debug::D_WARNING,
                         "RS_Snapper::snapPoint: event is nullptr");
         return pImpData->snapSpot;
     }
+    return snapMouseCoord(toGraph(e), e->type() == QEvent::MouseMove);
+}
 
-    RS_Vector mouseCoord = toGraph(e);
+/**
+ * Snaps the mouse position using the current snap mode.
+ *
+ * @param background whether entity snaps may be searched in background
+ */
+RS_Vector RS_Snapper::snapMouseCoord(const RS_Vector& mouseCoord, bool background) {
+    pImpData->snapSpot = RS_Vector(false);
+    RS_Vector t(false);
     double ds2Min=RS_MAXDOUBLE*RS_MAXDOUBLE;
 
-    if (m_snapMode.snapEndpoint) {
-        t = snapEndpoint(mouseCoord);
-        double ds2=mouseCoord.squaredTo(t);
-
-        if (t.valid && ds2 < ds2Min){
-            ds2Min=ds2;
-            pImpData->snapSpot = t;
-            pImpData->snapType = SnapType::ENDPOINT;
-        }
-    }
-    if (m_snapMode.snapCenter) {
-        t = snapCenter(mouseCoord);
-        double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-            pImpData->snapSpot = t;
-            pImpData->snapType = SnapType::CENTER;
-        }
-    }
-    if (m_snapMode.snapMiddle) {
-        //this is still brutal force
-        //todo: accept value from widget QG_SnapMiddleOptions
-
-        m_actionContext->requestSnapMiddleOptions(&m_middlePoints, m_snapMode.snapMiddle);
-        t = snapMiddle(mouseCoord);
-        double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-            pImpData->snapSpot = t;
-            pImpData->snapType = SnapType::MIDDLE;
-        }
-    }
-    if (m_snapMode.snapDistance) {
-        //this is still brutal force
-        //todo: accept value from widget QG_SnapDistOptions
-        m_actionContext->requestSnapDistOptions(&m_SnapDistance, m_snapMode.snapDistance);
-        t = snapDist(mouseCoord);
-        double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-            pImpData->snapSpot = t;
-            pImpData->snapType = SnapType::DISTANCE;
-        }
-    }
-    if (m_snapMode.snapIntersection) {
-        t = snapIntersection(mouseCoord);
-        double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-            pImpData->snapSpot = t;
-            pImpData->snapType = SnapType::INTERSECTION;
-        }
-    }
-
-    if (m_snapMode.snapOnEntity && pImpData->snapSpot.distanceTo(mouseCoord) > m_distanceBeforeSwitchToFreeSnap) {
-        t = snapOnEntity(mouseCoord);
-        double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-            pImpData->snapSpot = t;
-            pImpData->snapType = SnapType::ENTITY;
-        }
-    }
+    snapToEntities(mouseCoord, background, ds2Min);
 
     if (isSnapToGrid()) {
         t = snapGrid(mouseCoord);
@@ -488,8 +465,97 @@ RS_Vector RS_Snapper::snapPoint(QMouseEvent* e){
     return pImpData->snapCoord;
 }
 
+/**
+ * Finds the closest snap point on entities for enabled snap modes.
+ *
+ * In background mode the search runs on the snap engine. Until it's completed,
+ * the spot found for the previous position is used, and the snap indicator is
+ * updated once the result is delivered. Otherwise the search is performed synchronously.
+ */
+void RS_Snapper::snapToEntities(const RS_Vector& mouseCoord, bool background, double& ds2Min) {
+    LC_SnapEngine::Query query;
+    query.coord = mouseCoord;
+    query.endpoint = m_snapMode.snapEndpoint;
+    query.center = m_snapMode.snapCenter;
+    query.middle = m_snapMode.snapMiddle;
+    query.distance = m_snapMode.snapDistance;
+    query.intersection = m_snapMode.snapIntersection;
+    query.onEntity = m_snapMode.snapOnEntity;
+    query.switchToFreeDistance = m_distanceBeforeSwitchToFreeSnap;
+    if (m_snapMode.snapMiddle) {
+        //todo: accept value from widget QG_SnapMiddleOptions
+        m_actionContext->requestSnapMiddleOptions(&m_middlePoints, m_snapMode.snapMiddle);
+        query.middlePoints = m_middlePoints;
+    }
+    if (m_snapMode.snapDistance) {
+        //todo: accept value from widget QG_SnapDistOptions
+        m_actionContext->requestSnapDistOptions(&m_SnapDistance, m_snapMode.snapDistance);
+        query.snapDistance = m_SnapDistance;
+    }
+    if (query.isEmpty()) {
+        return;
+    }
+
+    ImpData& data = *pImpData;
+    if (data.hasEntitySnap && !data.entitySnap.isUpToDate(m_container)) {
+        data.hasEntitySnap = false;
+    }
+    LC_SnapEngine::Result result;
+    if (data.hasEntitySnap && data.entitySnap.query == query) {
+        result = data.entitySnap;
+    }
+    else if (m_backgroundSnap && background) {
+        if (!data.requested || !(data.requestedQuery == query)) {
+            data.requestedQuery = query;
+            data.requested = true;
+            // called on the GUI thread: snaps the requested position again with the result
+            LC_SnapEngine::instance()->request(m_container, query, this, [this](const LC_SnapEngine::Result& found) {
+                ImpData& impData = *pImpData;
+                if (m_finished || !impData.requested || !(impData.requestedQuery == found.query)) {
+                    return;
+                }
+                impData.requested = false;
+                if (found.isUpToDate(m_container)) {
+                    impData.entitySnap = found;
+                    impData.hasEntitySnap = true;
+                    snapMouseCoord(found.query.coord, false);
+                }
+            });
+        }
+        // provisional snap: keep the point found for the previous position,
+        // the point on entity depends on position, so it's not reused
+        const LC_SnapEngine::Result& previous = data.entitySnap;
+        if (data.hasEntitySnap && previous.source != LC_SnapEngine::OnEntity && previous.spot.valid) {
+            ds2Min = mouseCoord.squaredTo(previous.spot);
+            data.snapSpot = previous.spot;
+            data.snapType = toSnapType(previous.source);
+        }
+        return;
+    }
+    else {
+        result = LC_SnapEngine::compute(m_container, query);
+    }
+
+    if (result.source != LC_SnapEngine::None) {
+        ds2Min = result.distanceSquared;
+        data.snapSpot = result.spot;
+        data.snapType = toSnapType(result.source);
+    }
+    if (result.onEntityChecked) {
+        m_keyEntity = result.keyEntity;
+    }
+}
+
+void RS_Snapper::cancelBackgroundSnap() {
+    if (pImpData != nullptr && pImpData->requested) {
+        pImpData->requested = false;
+        LC_SnapEngine::instance()->cancel(this);
+    }
+}
+
 /**manually set snapPoint*/
 RS_Vector RS_Snapper::snapPoint(const RS_Vector& coord, bool setSpot){
+    LC_TRACE_SCOPE("snap", "snap point");
     if(coord.valid){
         pImpData->snapSpot=coord;
         if(setSpot) pImpData->snapCoord = coord;
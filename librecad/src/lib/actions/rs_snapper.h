@@ -305,11 +305,18 @@ private:
      * @brief updateUnitFormat update format parameters (m_linearFormat etc.) from the current rs_graphic
      */
     void updateUnitFormat( RS_Graphic* graphic);
+    RS_Vector snapMouseCoord(const RS_Vector& mouseCoord, bool background);
+    void snapToEntities(const RS_Vector& mouseCoord, bool background, double& ds2Min);
+    void cancelBackgroundSnap();
 
     struct ImpData;
     std::unique_ptr<ImpData> pImpData;
     struct Indicator;
     std::unique_ptr<Indicator> m_snapIndicator;
+    /**
+     * Searches entity snaps for mouse moves on a worker thread, if enabled
+     */
+    bool m_backgroundSnap = true;
 };
 
 #endif
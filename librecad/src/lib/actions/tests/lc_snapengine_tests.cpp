@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QObject>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_snapengine.h"
+#include "rs_circle.h"
+#include "rs_entitycontainer.h"
+#include "rs_line.h"
+#include "rs_polyline.h"
+
+namespace {
+struct Application {
+    int argc = 1;
+    char name[16] = "librecad_tests";
+    char* argv[2] = {name, nullptr};
+    QCoreApplication application{argc, argv};
+};
+
+// lines, a circle, a polyline with nested segments and an undone line
+void fillDrawing(RS_EntityContainer& container) {
+    container.addEntity(new RS_Line(&container, {0., 0.}, {10., 0.}));
+    container.addEntity(new RS_Line(&container, {0., -2.}, {10., 8.}));
+    container.addEntity(new RS_Circle(&container, {{5., 5.}, 3.}));
+    auto* polyline = new RS_Polyline(&container);
+    polyline->addVertex({12., 0.});
+    polyline->addVertex({14., 4.});
+    polyline->addVertex({16., 0.});
+    container.addEntity(polyline);
+    auto* undone = new RS_Line(&container, {0., 6.}, {10., 6.});
+    container.addEntity(undone);
+    undone->setUndoState(true);
+}
+
+LC_SnapEngine::Query makeQuery(const RS_Vector& coord) {
+    LC_SnapEngine::Query query;
+    query.coord = coord;
+    query.endpoint = true;
+    query.center = true;
+    query.middle = true;
+    query.intersection = true;
+    query.onEntity = true;
+    query.switchToFreeDistance = 0.5;
+    return query;
+}
+
+template <typename Condition>
+bool processEventsUntil(Condition done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// requests the search and waits for the result
+LC_SnapEngine::Result search(RS_EntityContainer& container, const LC_SnapEngine::Query& query) {
+    QObject receiver;
+    LC_SnapEngine::Result result;
+    bool delivered = false;
+    LC_SnapEngine::instance()->request(&container, query, &receiver,
+                                       [&result, &delivered](const LC_SnapEngine::Result& found) {
+                                           result = found;
+                                           delivered = true;
+                                       });
+    REQUIRE(processEventsUntil([&delivered]() {
+        return delivered;
+    }));
+    return result;
+}
+
+// compares the search on the snapshot with the search on the container over the drawing
+void requireSameAsContainerSearch(RS_EntityContainer& container) {
+    for (double x = -1.; x <= 17.; x += 1.5) {
+        for (double y = -3.; y <= 9.; y += 1.5) {
+            const LC_SnapEngine::Query query = makeQuery({x, y});
+            const LC_SnapEngine::Result expected = LC_SnapEngine::compute(&container, query);
+            const LC_SnapEngine::Result result = search(container, query);
+            REQUIRE(result.query == query);
+            REQUIRE(result.source == expected.source);
+            REQUIRE(result.spot.valid == expected.spot.valid);
+            REQUIRE(result.spot.distanceTo(expected.spot) < RS_TOLERANCE);
+            // entities of the snapshot are mapped to the entities of the container
+            REQUIRE(result.keyEntity == expected.keyEntity);
+            // copying the polyline doesn't change the revision of the container
+            REQUIRE(result.isUpToDate(&container));
+        }
+    }
+}
+}
+
+TEST_CASE("LC_SnapEngine finds on the snapshot the snaps of the container") {
+    Application application;
+    RS_EntityContainer container(nullptr, true);
+    fillDrawing(container);
+    requireSameAsContainerSearch(container);
+}
+
+TEST_CASE("LC_SnapEngine takes over unchanged copies to the next snapshot") {
+    Application application;
+    RS_EntityContainer container(nullptr, true);
+    fillDrawing(container);
+    requireSameAsContainerSearch(container);
+
+    SECTION("added entity") {
+        container.addEntity(new RS_Line(&container, {1., 1.}, {3., 7.}));
+        requireSameAsContainerSearch(container);
+    }
+
+    SECTION("removed entity") {
+        container.removeEntity(container.entityAt(0));
+        requireSameAsContainerSearch(container);
+    }
+
+    SECTION("entity moved in place") {
+        container.entityAt(1)->move({0.5, 1.});
+        requireSameAsContainerSearch(container);
+    }
+
+    SECTION("nested entity hidden") {
+        static_cast<RS_Polyline*>(container.entityAt(3))->entityAt(1)->setVisible(false);
+        requireSameAsContainerSearch(container);
+    }
+
+    SECTION("undone and redone entities") {
+        container.entityAt(2)->setUndoState(true);
+        requireSameAsContainerSearch(container);
+        container.entityAt(2)->setUndoState(false);
+        requireSameAsContainerSearch(container);
+    }
+}
+
+TEST_CASE("LC_SnapEngine skips undone entities and nested invisible ones") {
+    Application application;
+    RS_EntityContainer container(nullptr, true);
+    fillDrawing(container);
+
+    // the endpoint of the undone line
+    LC_SnapEngine::Result result = search(container, makeQuery({0., 6.1}));
+    REQUIRE(result.spot.distanceTo({0., 6.}) > RS_TOLERANCE);
+    REQUIRE(result.keyEntity == LC_SnapEngine::compute(&container, makeQuery({0., 6.1})).keyEntity);
+
+    auto* polyline = static_cast<RS_Polyline*>(container.entityAt(3));
+    polyline->entityAt(0)->setVisible(false);
+    result = search(container, makeQuery({13., 2.1}));
+    REQUIRE(result.isUpToDate(&container));
+    REQUIRE(result.keyEntity == LC_SnapEngine::compute(&container, makeQuery({13., 2.1})).keyEntity);
+}
+
+TEST_CASE("LC_SnapEngine rebuilds the snapshot when the container is changed") {
+    Application application;
+    RS_EntityContainer container(nullptr, true);
+    fillDrawing(container);
+
+    const LC_SnapEngine::Query query = makeQuery({20., 20.});
+    LC_SnapEngine::Result result = search(container, query);
+    REQUIRE(result.spot.distanceTo({20., 20.}) > 1.);
+
+    container.addEntity(new RS_Line(&container, {20., 20.1}, {30., 30.}));
+    REQUIRE(!result.isUpToDate(&container));
+    result = search(container, query);
+    REQUIRE(result.isUpToDate(&container));
+    REQUIRE(result.source == LC_SnapEngine::Endpoint);
+    REQUIRE(result.spot.distanceTo({20., 20.1}) < RS_TOLERANCE);
+
+    container.removeEntity(container.entityAt(container.count() - 1));
+    REQUIRE(!result.isUpToDate(&container));
+    result = search(container, query);
+    REQUIRE(result.spot.distanceTo({20., 20.1}) > RS_TOLERANCE);
+}
+
+TEST_CASE("LC_SnapEngine delivers only the latest request") {
+    Application application;
+    RS_EntityContainer container(nullptr, true);
+    fillDrawing(container);
+
+    QObject receiver;
+    std::vector<LC_SnapEngine::Query> delivered;
+    const auto callback = [&delivered](const LC_SnapEngine::Result& found) {
+        delivered.push_back(found.query);
+    };
+    const LC_SnapEngine::Query last = makeQuery({9., 1.});
+    for (int i = 0; i < 20; ++i) {
+        LC_SnapEngine::instance()->request(&container, makeQuery({i * 0.1, 1.}), &receiver, callback);
+    }
+    LC_SnapEngine::instance()->request(&container, last, &receiver, callback);
+    REQUIRE(processEventsUntil([&delivered, &last]() {
+        return !delivered.empty() && delivered.back() == last;
+    }));
+
+    SECTION("destroyed receivers are not called") {
+        bool called = false;
+        {
+            QObject destroyed;
+            LC_SnapEngine::instance()->request(&container, makeQuery({3., 1.}), &destroyed,
+                                               [&called](const LC_SnapEngine::Result&) {
+                                                   called = true;
+                                               });
+            LC_SnapEngine::instance()->cancel(&destroyed);
+        }
+        // the search of the next request starts once the previous one is dropped
+        const LC_SnapEngine::Result result = search(container, last);
+        REQUIRE(result.query == last);
+        QCoreApplication::processEvents();
+        REQUIRE(!called);
+    }
+}
@@ -1065,9 +1065,9 @@ RS_Block* RS_Creation::createBlock(const RS_BlockData* data,
      */
 RS_Insert* RS_Creation::createLibraryInsert(RS_LibraryInsertData& data)
 {
-  RS_DEBUG->print(RS_Debug::D_DEBUGGING,
-                  "createLibraryInsert: file='%s' angle=%.1f° factor=%.3f",
-                  data.file.toLatin1().data(), RS_Math::rad2deg(data.angle), data.factor);
+  LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING,
+                       "createLibraryInsert: file='%s' angle=%.1f° factor=%.3f",
+                       data.file.toLatin1().data(), RS_Math::rad2deg(data.angle), data.factor);
 
   if (data.graphic == nullptr || data.graphic->count() == 0) {
     RS_DEBUG->print(RS_Debug::D_WARNING, "createLibraryInsert: invalid/empty graphic");
@@ -0,0 +1,210 @@
+/***************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * **********************************************************************
+ */
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QFile>
+#include <QTextStream>
+
+#include "lc_trace.h"
+#include "rs_debug.h"
+
+namespace {
+    struct LC_TraceEvent {
+        const char* category = nullptr;
+        const char* name = nullptr;
+        int64_t start = 0;
+        int64_t duration = 0;
+        double value = 0.0;
+        bool counter = false;
+    };
+
+    /**
+     * Events of a single thread, kept in a ring of at most LC_Trace::MAX_EVENTS_PER_THREAD events.
+     * The mutex is contended only while the trace is exported or cleared.
+     */
+    struct LC_TraceThreadBuffer {
+        std::mutex mutex;
+        std::vector<LC_TraceEvent> events;
+        // position of the oldest event once the ring is full
+        std::size_t next = 0;
+        std::size_t dropped = 0;
+        int threadIndex = 0;
+
+        void add(const LC_TraceEvent& event) {
+            if (events.size() < LC_Trace::MAX_EVENTS_PER_THREAD) {
+                events.push_back(event);
+                return;
+            }
+            events[next] = event;
+            next = (next + 1) % events.size();
+            dropped++;
+        }
+
+        void clear() {
+            events.clear();
+            next = 0;
+            dropped = 0;
+        }
+
+        template <typename Visitor>
+        void forEach(Visitor visitor) const {
+            for (std::size_t i = next; i < events.size(); i++) {
+                visitor(events[i]);
+            }
+            for (std::size_t i = 0; i < next; i++) {
+                visitor(events[i]);
+            }
+        }
+    };
+
+    const auto g_traceClockStart = std::chrono::steady_clock::now();
+
+    std::mutex g_buffersMutex;
+    // buffers are kept after owning thread exit, so events of pooled threads are not lost
+    std::vector<std::shared_ptr<LC_TraceThreadBuffer>> g_buffers;
+
+    LC_TraceThreadBuffer& threadBuffer() {
+        thread_local std::shared_ptr<LC_TraceThreadBuffer> buffer;
+        if (buffer == nullptr) {
+            buffer = std::make_shared<LC_TraceThreadBuffer>();
+            std::lock_guard<std::mutex> lock(g_buffersMutex);
+            buffer->threadIndex = static_cast<int>(g_buffers.size()) + 1;
+            g_buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void addEvent(const LC_TraceEvent& event) {
+        LC_TraceThreadBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.add(event);
+    }
+
+    QString escaped(const char* text) {
+        QString result = QString::fromUtf8(text);
+        result.replace('\\', "\\\\");
+        result.replace('"', "\\\"");
+        return result;
+    }
+}
+
+std::atomic<bool> LC_Trace::s_enabled{false};
+
+void LC_Trace::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void LC_Trace::clear() {
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    for (auto& buffer : g_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->clear();
+    }
+}
+
+std::size_t LC_Trace::eventCount() {
+    std::size_t result = 0;
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    for (auto& buffer : g_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        result += buffer->events.size();
+    }
+    return result;
+}
+
+std::size_t LC_Trace::droppedCount() {
+    std::size_t result = 0;
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    for (auto& buffer : g_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        result += buffer->dropped;
+    }
+    return result;
+}
+
+int64_t LC_Trace::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - g_traceClockStart).count();
+}
+
+void LC_Trace::addSpan(const char* category, const char* name, int64_t start, int64_t duration) {
+    addEvent({category, name, start, duration, 0.0, false});
+}
+
+void LC_Trace::addCounter(const char* category, const char* name, double value) {
+    addEvent({category, name, now(), 0, value, true});
+}
+
+/**
+ * Writes collected events in Chrome trace-event JSON format.
+ * @param fileName output file
+ * @return true on success
+ */
+bool LC_Trace::writeChromeTrace(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        LC_ERR << "LC_Trace::writeChromeTrace: can't open file " << fileName;
+        return false;
+    }
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    auto separator = [&out, &first]() -> QTextStream& {
+        if (!first) {
+            out << ",";
+        }
+        first = false;
+        out << "\n";
+        return out;
+    };
+
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    for (auto& buffer : g_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        int tid = buffer->threadIndex;
+        separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+            << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+        if (buffer->dropped > 0) {
+            LC_LOG << "LC_Trace::writeChromeTrace: thread " << tid << " dropped " << buffer->dropped
+                << " oldest events";
+        }
+        buffer->forEach([&separator, tid](const LC_TraceEvent& event) {
+            QTextStream& stream = separator();
+            stream << "{\"name\":\"" << escaped(event.name) << "\",\"cat\":\"" << escaped(event.category)
+                << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << event.start;
+            if (event.counter) {
+                stream << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+            }
+            else {
+                stream << ",\"ph\":\"X\",\"dur\":" << event.duration << "}";
+            }
+        });
+    }
+    out << "\n]}\n";
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
@@ -0,0 +1,109 @@
+/***************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * **********************************************************************
+ */
+
+#ifndef LC_TRACE_H
+#define LC_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class QString;
+
+/**
+ * Runtime toggleable tracing of scoped spans and counters.
+ *
+ * When tracing is disabled, a span costs a single relaxed atomic load. When enabled, events are collected
+ * into per-thread buffers and may be exported as Chrome trace-event JSON (chrome://tracing, Perfetto).
+ * Each buffer holds at most MAX_EVENTS_PER_THREAD events, the oldest events are overwritten after that,
+ * so tracing a long session keeps the most recent part of it in bounded memory.
+ * Category and name of events are expected to be string literals, they are stored as pointers.
+ *
+ * Example:
+ *     LC_TRACE_SCOPE("render", "frame");
+ *     LC_TRACE_COUNTER("render", "entities", count);
+ */
+class LC_Trace {
+public:
+    static constexpr std::size_t MAX_EVENTS_PER_THREAD = 1 << 18;
+
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enabled);
+    static void clear();
+    /**
+     * Time in microseconds since the start of the trace clock
+     */
+    static int64_t now();
+    static void addSpan(const char* category, const char* name, int64_t start, int64_t duration);
+    static void addCounter(const char* category, const char* name, double value);
+    static bool writeChromeTrace(const QString& fileName);
+    /**
+     * Number of events currently kept in all buffers
+     */
+    static std::size_t eventCount();
+    /**
+     * Number of events overwritten since the last clear()
+     */
+    static std::size_t droppedCount();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * Records a span from construction till destruction, if tracing was enabled on construction.
+ */
+class LC_TraceSpan {
+public:
+    LC_TraceSpan(const char* category, const char* name):
+        m_category{category}, m_name{name}, m_start{LC_Trace::isEnabled() ? LC_Trace::now() : -1} {
+    }
+
+    ~LC_TraceSpan() {
+        if (m_start >= 0) {
+            LC_Trace::addSpan(m_category, m_name, m_start, LC_Trace::now() - m_start);
+        }
+    }
+
+    LC_TraceSpan(const LC_TraceSpan&) = delete;
+    LC_TraceSpan& operator=(const LC_TraceSpan&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    int64_t m_start;
+};
+
+#define LC_TRACE_CONCAT_IMPL(a, b) a##b
+#define LC_TRACE_CONCAT(a, b) LC_TRACE_CONCAT_IMPL(a, b)
+#define LC_TRACE_SCOPE(category, name) LC_TraceSpan LC_TRACE_CONCAT(lcTraceSpan, __LINE__){category, name}
+#define LC_TRACE_COUNTER(category, name, value) \
+    do { \
+        if (LC_Trace::isEnabled()) { \
+            LC_Trace::addCounter(category, name, static_cast<double>(value)); \
+        } \
+    } while (false)
+
+#endif // LC_TRACE_H
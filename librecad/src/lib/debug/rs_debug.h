@@ -53,6 +53,22 @@ void debugHeader(char const* file, char const* func, int line);
 #define LC_LOG RS_Debug::Log()
 #define LC_ERR RS_Debug::Log(RS_Debug::D_ERROR)
 
+// printf style logging, the arguments are evaluated only if the message is printed
+// Example: LC_DEBUG_PRINT("file: %s", fileName.toLatin1().data()); // printed at D_DEBUGGING
+//          LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING, "file: %s", fileName.toLatin1().data());
+#define LC_DEBUG_PRINT(...) \
+    do { \
+        if (RS_DEBUG->getLevel() == RS_Debug::D_DEBUGGING) { \
+            RS_DEBUG->print(__VA_ARGS__); \
+        } \
+    } while (false)
+#define LC_DEBUG_PRINT_LEVEL(level, ...) \
+    do { \
+        if (RS_DEBUG->getLevel() >= (level)) { \
+            RS_DEBUG->print((level), __VA_ARGS__); \
+        } \
+    } while (false)
+
 /**
  * Debugging facilities.
  *
@@ -0,0 +1,53 @@
+/***************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * **********************************************************************
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_trace.h"
+
+TEST_CASE("LC_Trace keeps a bounded number of events per thread", "[LC_Trace]") {
+    LC_Trace::clear();
+    LC_Trace::setEnabled(true);
+
+    const std::size_t extra = 10;
+    for (std::size_t i = 0; i < LC_Trace::MAX_EVENTS_PER_THREAD + extra; i++) {
+        LC_TRACE_COUNTER("test", "value", i);
+    }
+    LC_Trace::setEnabled(false);
+
+    REQUIRE(LC_Trace::eventCount() == LC_Trace::MAX_EVENTS_PER_THREAD);
+    REQUIRE(LC_Trace::droppedCount() == extra);
+
+    LC_Trace::clear();
+    REQUIRE(LC_Trace::eventCount() == 0);
+    REQUIRE(LC_Trace::droppedCount() == 0);
+}
+
+TEST_CASE("LC_Trace records nothing while disabled", "[LC_Trace]") {
+    LC_Trace::clear();
+    LC_Trace::setEnabled(false);
+    {
+        LC_TRACE_SCOPE("test", "span");
+        LC_TRACE_COUNTER("test", "value", 1);
+    }
+    REQUIRE(LC_Trace::eventCount() == 0);
+}
@@ -103,14 +103,6 @@ RS_Entity* RS_Clipboard::entityAt(unsigned i) {
     return m_graphic->entityAt(i);
 }
 
-RS_Entity* RS_Clipboard::firstEntity() {
-    return m_graphic->firstEntity();
-}
-
-RS_Entity* RS_Clipboard::nextEntity() {
-    return m_graphic->nextEntity();
-}
-
 RS_Graphic* RS_Clipboard::getGraphic() {
     return m_graphic.get();
 }
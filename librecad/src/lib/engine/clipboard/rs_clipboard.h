@@ -63,8 +63,6 @@ public:
 	void addEntity(RS_Entity* e);
     unsigned count();
     RS_Entity* entityAt(unsigned i);
-    RS_Entity* firstEntity();
-    RS_Entity* nextEntity();
     RS_Graphic* getGraphic();
     friend std::ostream& operator << (std::ostream& os, RS_Clipboard& cb);
 protected:
@@ -30,6 +30,7 @@
 #include "rs_blocklist.h"
 #include "rs_graphic.h"
 #include "rs_insert.h"
+#include "rs_layerlist.h"
 #include "rs_line.h"
 
 RS_BlockData::RS_BlockData(const QString& _name,
@@ -201,3 +202,23 @@ std::ostream& operator << (std::ostream& os, const RS_Block& b) {
     os << " entities: " << (RS_EntityContainer&)b << "\n";
     return os;
 }
+
+void RS_Block::toggle() {
+    data.frozen = !data.frozen;
+    increaseFreezeRevision();
+}
+
+void RS_Block::freeze(bool freeze) {
+    if (data.frozen != freeze) {
+        data.frozen = freeze;
+        increaseFreezeRevision();
+    }
+}
+
+void RS_Block::increaseFreezeRevision() {
+    // inserts of frozen blocks are invisible, like entities on frozen layers
+    RS_LayerList* layerList = getLayerList();
+    if (layerList != nullptr) {
+        layerList->increaseFreezeRevision();
+    }
+}
@@ -126,18 +126,14 @@ public:
      * Toggles the visibility of this block.
      * Freezes the block if it's not frozen, thaws the block otherwise
      */
-    void toggle() {
-        data.frozen = !data.frozen;
-    }
+    void toggle();
 
     /**
      * (De-)freezes this block.
      *
      * @param freeze true: freeze, false: defreeze
      */
-    void freeze(bool freeze) {
-        data.frozen = freeze;
-    }
+    void freeze(bool freeze);
 	
     /**
      * Sets the parent documents modified status to 'm'.
@@ -189,6 +185,7 @@ public:
    void addByBlockEntity(RS_Entity* entity);
 
 protected:
+    void increaseFreezeRevision();
 //! Block data
     RS_BlockData data;
 };
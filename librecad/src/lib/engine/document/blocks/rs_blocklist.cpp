@@ -53,6 +53,9 @@ RS_BlockList::RS_BlockList(bool owner) {
  */
 void RS_BlockList::clear() {
     m_blocks.clear();
+    m_blocksByName.clear();
+    m_blocksByFoldedName.clear();
+    m_foldedNameCounts.clear();
 	m_activeBlock = nullptr;
 	setModified(true);
 }
@@ -98,6 +101,7 @@ bool RS_BlockList::add(RS_Block* block, bool notify) {
     RS_Block* b = find(block->getName());
 	if (!b) {
         m_blocks.append(block);
+        addToIndex(block);
 
         if (notify) {
             addNotification();
@@ -134,7 +138,9 @@ void RS_BlockList::remove(RS_Block* block) {
     RS_DEBUG->print("RS_BlockList::removeBlock()");
 
     // here the block is removed from the list but not deleted
-    m_blocks.removeOne(block);
+    if (m_blocks.removeOne(block)) {
+        removeFromIndex(block, block->getName());
+    }
 
 	for(auto l: m_blockListListeners){
 		l->blockRemoved(block);
@@ -167,7 +173,9 @@ bool RS_BlockList:: rename(RS_Block* block, const QString& name) {
 	if (block) {
 		if (!find(name)) {
 			QString oldName = block->getName();
+			removeFromIndex(block, oldName);
 			block->setName(name);
+			addToIndex(block);
 			setModified(true);
 
 			// when the renamed block is nested within other block, we need to rename its inserts as well
@@ -175,6 +183,10 @@ bool RS_BlockList:: rename(RS_Block* block, const QString& name) {
 				b->renameInserts(oldName, name);
 			}
 
+			for(auto l: m_blockListListeners){
+				l->blockRenamed(block, oldName);
+			}
+
 			return true;
 		}
 	}
@@ -205,40 +217,60 @@ void RS_BlockList::editBlock(RS_Block* block, const RS_Block& source) {
  * \p nullptr if no such block was found.
  */
 RS_Block* RS_BlockList::find(const QString& name) {
-    try {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): %s", name.toLatin1().constData());
+    return m_blocksByName.value(name, nullptr);
+}
+
+/**
+ * @return Pointer to the first block (in list order) which name is equal to the given
+ * one ignoring case or \p nullptr if no such block was found.
+ */
+RS_Block* RS_BlockList::findCaseInsensitive(const QString& name) const {
+    return m_blocksByFoldedName.value(name.toCaseFolded(), nullptr);
+}
+
+void RS_BlockList::addToIndex(RS_Block* block) {
+    QString name = block->getName();
+    m_blocksByName.insert(name, block);
+    QString foldedName = name.toCaseFolded();
+    int& count = m_foldedNameCounts[foldedName];
+    count++;
+    if (count == 1) {
+        m_blocksByFoldedName.insert(foldedName, block);
     }
-    catch(...) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): wrong name to find");
-        return nullptr;
+    else {
+        // a renamed block may precede the block found so far
+        m_blocksByFoldedName.insert(foldedName, findFirstFolded(foldedName, nullptr));
     }
-	// Todo : reduce this from O(N) to O(log(N)) complexity based on sorted list or hash
-	//DFS
-	for(RS_Block* b: m_blocks) {
-		if (b->getName()==name) {
-			return b;
-		}
-	}
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): bad");
-	return nullptr;
 }
 
-RS_Block* RS_BlockList::findCaseInsensitive(const QString& name) const {
-    try {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): %s", name.toLatin1().constData());
+void RS_BlockList::removeFromIndex(RS_Block* block, const QString& name) {
+    auto it = m_blocksByName.find(name);
+    if (it != m_blocksByName.end() && it.value() == block) {
+        m_blocksByName.erase(it);
+    }
+    QString foldedName = name.toCaseFolded();
+    auto count = m_foldedNameCounts.find(foldedName);
+    if (count == m_foldedNameCounts.end()) {
+        return;
     }
-    catch(...) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): wrong name to find");
-        return nullptr;
+    if (--count.value() == 0) {
+        m_foldedNameCounts.erase(count);
+        m_blocksByFoldedName.remove(foldedName);
     }
-    // Todo : reduce this from O(N) to O(log(N)) complexity based on sorted list or hash
-    //DFS
-    for(RS_Block* b: m_blocks) {
-        if (b->getName().compare(name, Qt::CaseInsensitive) == 0) {
+    else if (m_blocksByFoldedName.value(foldedName) == block) {
+        m_blocksByFoldedName.insert(foldedName, findFirstFolded(foldedName, block));
+    }
+}
+
+/**
+ * @return the first block in list order with the given case folded name, other than excluded one.
+ */
+RS_Block* RS_BlockList::findFirstFolded(const QString& foldedName, const RS_Block* excluded) const {
+    for (RS_Block* b: m_blocks) {
+        if (b != excluded && b->getName().toCaseFolded() == foldedName) {
             return b;
         }
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): bad");
     return nullptr;
 }
 
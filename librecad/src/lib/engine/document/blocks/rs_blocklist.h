@@ -28,9 +28,10 @@
 #ifndef RS_BLOCKLIST_H
 #define RS_BLOCKLIST_H
 
+#include <QHash>
 #include <QList>
+#include <QString>
 
-class QString;
 class RS_Block;
 class RS_BlockListListener;
 
@@ -111,6 +112,19 @@ private:
     RS_Block* m_activeBlock = nullptr;
     /** Flag set if the block list was modified and not yet saved. */
     bool m_modified = false;
+    /**
+     * Hashed indexes of blocks by name and by case folded name. Keys share
+     * data with block names, so names are not copied. Both are updated with the
+     * list, so lookups don't modify the list and may run on several threads.
+     */
+    QHash<QString, RS_Block*> m_blocksByName;
+    QHash<QString, RS_Block*> m_blocksByFoldedName;
+    //! number of blocks by case folded name, as names may differ by case only
+    QHash<QString, int> m_foldedNameCounts;
+
+    void addToIndex(RS_Block* block);
+    void removeFromIndex(RS_Block* block, const QString& name);
+    RS_Block* findFirstFolded(const QString& foldedName, const RS_Block* excluded) const;
 };
 
 #endif
@@ -58,6 +58,11 @@ public:
      */
     virtual void blockEdited(RS_Block*) {}
 
+    /**
+     * Called when a block is renamed, oldName is the name the block was known by before.
+     */
+    virtual void blockRenamed(RS_Block*, [[maybe_unused]] const QString& oldName) {}
+
     /**
      * Called when a block's visibility is toggled. 
      */
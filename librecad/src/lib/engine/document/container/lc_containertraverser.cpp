@@ -85,7 +85,7 @@ struct LC_ContainerTraverser::Data {
         case RS2::ResolveAllButInserts:
             return entity->rtti() != RS2::EntityInsert;
         case RS2::ResolveAllButTextImage:
-            return (entity->rtti() != RS2::EntityImage) && isText(*entity);
+            return (entity->rtti() != RS2::EntityImage) && !isText(*entity);
         case RS2::ResolveAllButTexts:
             return !isText(*entity);
         case RS2::ResolveAll:
@@ -125,7 +125,7 @@ void LC_ContainerTraverser::collect(std::vector<RS_Entity*>& items, const RS_Ent
         if (entity == nullptr)
             continue;
 
-        if (entity->isContainer() && m_pImp->canResolve(container)) {
+        if (m_pImp->canResolve(entity)) {
             collect(items, static_cast<RS_EntityContainer*>(entity));
         } else {
             items.push_back(entity);
@@ -148,22 +148,17 @@ RS_Entity* LC_ContainerTraverser::prev()
 {
     // create a traverser with reverted direction
     // so the next traversed node is the previous of the current traverser
-    LC_ContainerTraverser revTraverser{*m_pImp->container, m_pImp->level, LC_ContainerTraverser::Direction::Backword};
-    revTraverser.m_direction = (m_direction == Direction::Forward) ?
-                                   Direction::Backword : Direction::Backword;
+    LC_ContainerTraverser revTraverser{*m_pImp->container, m_pImp->level,
+                                       (m_direction == Direction::Forward) ? Direction::Backword : Direction::Forward};
+    revTraverser.m_pImp->indices = m_pImp->indices;
 
-    // revert the indices
+    // revert the indices.
+    // The index always points to the next candidate, i.e. the current node is at (index - 1), so
+    // the previous candidate is at (index - 2), which is (count - index + 1) in the reverted direction
     for (ParentNode& node: revTraverser.m_pImp->indices) {
-        if (node.isValid())
-            node.index = node.container->count() - 1 - node.index;
+        node.index = int(node.container->count()) - node.index + 1;
     }
 
-    // the previous.
-    // The index always points to the next
-    [[maybe_unused]] RS_Entity* next = revTraverser.get();
-    // current
-    [[maybe_unused]] RS_Entity* current = revTraverser.get();
-    // previous
     return revTraverser.get();
 }
 
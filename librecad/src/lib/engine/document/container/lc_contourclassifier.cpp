@@ -0,0 +1,286 @@
+/*
+**********************************************************************************
+**
+** This file was created for the LibreCAD project (librecad.org), a 2D CAD program.
+**
+** Copyright (C) 2025 librecad (www.librecad.org)
+** Copyright (C) 2025 dxli (github.com/dxli)
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+**********************************************************************************
+*/
+// File: lc_contourclassifier.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "lc_containertraverser.h"
+#include "lc_contourclassifier.h"
+#include "lc_splinepoints.h"
+#include "rs.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_ellipse.h"
+#include "rs_entitycontainer.h"
+#include "rs_math.h"
+
+namespace {
+// upper limit of y buckets, the bucket count follows the number of edges
+constexpr int g_maxBuckets = 4096;
+}
+
+RS_Vector LC_ContourClassifier::Conic::pointAt(double t) const {
+  const double x = major * std::cos(t);
+  const double y = minor * std::sin(t);
+  return {center.x + x * cosRotation - y * sinRotation,
+          center.y + x * sinRotation + y * cosRotation};
+}
+
+double LC_ContourClassifier::Edge::xAt(double y, const std::vector<Conic>& conics) const {
+  if (conic < 0) {
+    // line piece, yMin < yMax is guaranteed for pieces crossed by a ray
+    const double ratio = (y - start.y) / (end.y - start.y);
+    return start.x + ratio * (end.x - start.x);
+  }
+  const Conic& c = conics[conic];
+  const double cosine = std::clamp((y - c.center.y) / c.yAmplitude, -1., 1.);
+  const double base = std::acos(cosine);
+  // y decreases from the half turn start on even half turns, increases on odd ones
+  const double t = c.yPhase + halfTurn * M_PI + ((halfTurn % 2 == 0) ? base : M_PI - base);
+  return c.pointAt(t).x;
+}
+
+LC_ContourClassifier::LC_ContourClassifier(const RS_EntityContainer& contour, double onTolerance)
+    : m_tolerance{onTolerance} {
+  m_minX = m_minY = std::numeric_limits<double>::max();
+  m_maxX = m_maxY = std::numeric_limits<double>::lowest();
+  for (RS_Entity* entity : lc::LC_ContainerTraverser{contour, RS2::ResolveAll}.entities()) {
+    addEntity(entity);
+  }
+  buildBuckets();
+}
+
+LC_ContourClassifier::~LC_ContourClassifier() = default;
+
+void LC_ContourClassifier::addEntity(RS_Entity* entity) {
+  if (entity == nullptr) {
+    return;
+  }
+  switch (entity->rtti()) {
+  case RS2::EntityLine:
+    addLine(entity, entity->getStartpoint(), entity->getEndpoint());
+    break;
+  case RS2::EntityArc: {
+    auto* arc = static_cast<RS_Arc*>(entity);
+    const Conic conic{arc->getCenter(), arc->getRadius(), arc->getRadius()};
+    addConic(entity, conic, arc->isReversed() ? arc->getAngle2() : arc->getAngle1(),
+             arc->getAngleLength());
+    break;
+  }
+  case RS2::EntityCircle: {
+    auto* circle = static_cast<RS_Circle*>(entity);
+    const Conic conic{circle->getCenter(), circle->getRadius(), circle->getRadius()};
+    addConic(entity, conic, 0., 2. * M_PI);
+    break;
+  }
+  case RS2::EntityEllipse: {
+    auto* ellipse = static_cast<RS_Ellipse*>(entity);
+    const double rotation = ellipse->getAngle();
+    const Conic conic{ellipse->getCenter(), ellipse->getMajorRadius(), ellipse->getMinorRadius(),
+                      std::cos(rotation), std::sin(rotation)};
+    // ellipse angles are parametric, as expected by Conic::pointAt()
+    addConic(entity, conic, ellipse->isReversed() ? ellipse->getAngle2() : ellipse->getAngle1(),
+             ellipse->getAngleLength());
+    break;
+  }
+  case RS2::EntitySplinePoints:
+  case RS2::EntityParabola: {
+    auto* spline = static_cast<LC_SplinePoints*>(entity);
+    std::vector<RS_Vector> points = spline->getStrokePoints();
+    if (spline->isClosed() && !points.empty()) {
+      points.push_back(points.front());
+    }
+    for (size_t i = 1; i < points.size(); ++i) {
+      addLine(entity, points[i - 1], points[i]);
+    }
+    break;
+  }
+  default:
+    // other atomic entities are not expected in contours, approximated by their chord
+    addLine(entity, entity->getStartpoint(), entity->getEndpoint());
+    break;
+  }
+}
+
+void LC_ContourClassifier::addLine(RS_Entity* entity, const RS_Vector& start, const RS_Vector& end) {
+  if (!start.valid || !end.valid) {
+    return;
+  }
+  Edge edge;
+  edge.entity = entity;
+  edge.start = start;
+  edge.end = end;
+  edge.xMin = std::min(start.x, end.x);
+  edge.xMax = std::max(start.x, end.x);
+  edge.yMin = std::min(start.y, end.y);
+  edge.yMax = std::max(start.y, end.y);
+  m_minX = std::min(m_minX, edge.xMin);
+  m_maxX = std::max(m_maxX, edge.xMax);
+  m_minY = std::min(m_minY, edge.yMin);
+  m_maxY = std::max(m_maxY, edge.yMax);
+  m_edges.push_back(edge);
+}
+
+void LC_ContourClassifier::addConic(RS_Entity* entity, const Conic& input, double startParam,
+                                    double angleLength) {
+  Conic conic = input;
+  const double yA = conic.major * conic.sinRotation;
+  const double yB = conic.minor * conic.cosRotation;
+  conic.yAmplitude = std::hypot(yA, yB);
+  conic.yPhase = std::atan2(yB, yA);
+  const double endParam = startParam + angleLength;
+  if (conic.yAmplitude < RS_TOLERANCE) {
+    // flat conic: never crossed by a horizontal ray, kept for the on contour test only
+    addLine(entity, conic.pointAt(startParam), conic.pointAt(endParam));
+    return;
+  }
+
+  // x(t) = center.x + xAmplitude * cos(t - xPhase), extremes are at xPhase + k * PI
+  const double xA = conic.major * conic.cosRotation;
+  const double xB = -conic.minor * conic.sinRotation;
+  const double xPhase = std::atan2(xB, xA);
+
+  const int index = static_cast<int>(m_conics.size());
+  m_conics.push_back(conic);
+
+  // split at the top and bottom points: conic.yPhase + j * PI
+  for (long j = static_cast<long>(std::floor((startParam - conic.yPhase) / M_PI));
+       conic.yPhase + j * M_PI < endParam; ++j) {
+    const double from = std::max(startParam, conic.yPhase + j * M_PI);
+    const double to = std::min(endParam, conic.yPhase + (j + 1) * M_PI);
+    if (to <= from) {
+      continue;
+    }
+    const RS_Vector p0 = conic.pointAt(from);
+    const RS_Vector p1 = conic.pointAt(to);
+    Edge edge;
+    edge.entity = entity;
+    edge.conic = index;
+    edge.halfTurn = j;
+    edge.start = p0;
+    edge.end = p1;
+    edge.yMin = std::min(p0.y, p1.y);
+    edge.yMax = std::max(p0.y, p1.y);
+    edge.xMin = std::min(p0.x, p1.x);
+    edge.xMax = std::max(p0.x, p1.x);
+    for (double t = xPhase + std::ceil((from - xPhase) / M_PI) * M_PI; t < to; t += M_PI) {
+      const double x = conic.pointAt(t).x;
+      edge.xMin = std::min(edge.xMin, x);
+      edge.xMax = std::max(edge.xMax, x);
+    }
+    m_minX = std::min(m_minX, edge.xMin);
+    m_maxX = std::max(m_maxX, edge.xMax);
+    m_minY = std::min(m_minY, edge.yMin);
+    m_maxY = std::max(m_maxY, edge.yMax);
+    m_edges.push_back(edge);
+  }
+}
+
+void LC_ContourClassifier::buildBuckets() {
+  if (m_edges.empty()) {
+    return;
+  }
+  const int count = std::clamp(static_cast<int>(m_edges.size()), 1, g_maxBuckets);
+  m_bucketHeight = std::max((m_maxY - m_minY + 2. * m_tolerance) / count, RS_TOLERANCE);
+  m_buckets.resize(count);
+  const double bottom = m_minY - m_tolerance;
+  const auto bucketIndex = [this, bottom, count](double y) {
+    const double index = std::floor((y - bottom) / m_bucketHeight);
+    return static_cast<int>(std::clamp(index, 0., count - 1.));
+  };
+  for (int i = 0; i < static_cast<int>(m_edges.size()); ++i) {
+    const Edge& edge = m_edges[i];
+    const int last = bucketIndex(edge.yMax + m_tolerance);
+    for (int bucket = bucketIndex(edge.yMin - m_tolerance); bucket <= last; ++bucket) {
+      m_buckets[bucket].push_back(i);
+    }
+  }
+}
+
+const std::vector<int>* LC_ContourClassifier::bucketAt(double y) const {
+  if (m_buckets.empty()) {
+    return nullptr;
+  }
+  const double index = std::floor((y - m_minY + m_tolerance) / m_bucketHeight);
+  if (index < 0. || index >= static_cast<double>(m_buckets.size())) {
+    return nullptr;
+  }
+  return &m_buckets[static_cast<size_t>(index)];
+}
+
+LC_ContourClassifier::Location LC_ContourClassifier::classify(const RS_Vector& point) const {
+  if (point.x < m_minX - m_tolerance || point.x > m_maxX + m_tolerance
+      || point.y < m_minY - m_tolerance || point.y > m_maxY + m_tolerance) {
+    return Location::Outside;
+  }
+  const std::vector<int>* bucket = bucketAt(point.y);
+  if (bucket == nullptr) {
+    return Location::Outside;
+  }
+
+  for (int i : *bucket) {
+    const Edge& edge = m_edges[i];
+    if (point.x < edge.xMin - m_tolerance || point.x > edge.xMax + m_tolerance
+        || point.y < edge.yMin - m_tolerance || point.y > edge.yMax + m_tolerance) {
+      continue;
+    }
+    if (edge.entity->isPointOnEntity(point, m_tolerance)) {
+      return Location::OnContour;
+    }
+  }
+
+  // horizontal ray to +x, half-open edges: yMin <= y < yMax
+  int crossings = 0;
+  for (int i : *bucket) {
+    const Edge& edge = m_edges[i];
+    if (point.y < edge.yMin || point.y >= edge.yMax || edge.xMax <= point.x) {
+      continue;
+    }
+    if (edge.xMin > point.x || edge.xAt(point.y, m_conics) > point.x) {
+      ++crossings;
+    }
+  }
+  return (crossings % 2 == 1) ? Location::Inside : Location::Outside;
+}
+
+std::vector<LC_ContourClassifier::Location> LC_ContourClassifier::classify(
+    const std::vector<RS_Vector>& points) const {
+  std::vector<Location> locations;
+  locations.reserve(points.size());
+  for (const RS_Vector& point : points) {
+    locations.push_back(classify(point));
+  }
+  return locations;
+}
+
+bool LC_ContourClassifier::isInside(const RS_Vector& point, bool* onContour) const {
+  const Location location = classify(point);
+  if (onContour != nullptr) {
+    *onContour = location == Location::OnContour;
+  }
+  return location != Location::Outside;
+}
@@ -0,0 +1,135 @@
+/*
+**********************************************************************************
+**
+** This file was created for the LibreCAD project (librecad.org), a 2D CAD program.
+**
+** Copyright (C) 2025 librecad (www.librecad.org)
+** Copyright (C) 2025 dxli (github.com/dxli)
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+**********************************************************************************
+*/
+// File: lc_contourclassifier.h
+#ifndef LC_CONTOURCLASSIFIER_H
+#define LC_CONTOURCLASSIFIER_H
+
+#include <vector>
+
+#include "rs_vector.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * @brief The LC_ContourClassifier class - pre-built point-in-contour test for a closed contour.
+ * Contour entities are split into pieces monotone in y; lines are kept as is, arcs, circles and
+ * ellipses are split at their top and bottom points and solved exactly, splines are stroked.
+ * The pieces are bucketed by y, so a query only solves the pieces crossing its horizontal line.
+ *
+ * Classification counts crossings of the horizontal ray to +x with the half-open rule
+ * yMin <= y < yMax, so rays passing through vertices or touching tops of arcs are counted
+ * consistently, and results are reproducible (unlike random rays).
+ *
+ * The contour entities must be kept alive and unchanged while the classifier is used.
+ */
+class LC_ContourClassifier {
+public:
+  enum class Location {
+    Outside,
+    Inside,
+    OnContour
+  };
+
+  /**
+   * @brief Builds the classifier.
+   * @param contour Closed contour, entities may be in any order.
+   * @param onTolerance Maximum distance to the contour for points classified as on contour.
+   */
+  explicit LC_ContourClassifier(const RS_EntityContainer& contour, double onTolerance = 1.0e-4);
+  ~LC_ContourClassifier();
+
+  /**
+   * @brief Classifies the point relative to the contour.
+   * @param point The point to test.
+   * @return Location of the point.
+   */
+  Location classify(const RS_Vector& point) const;
+  /**
+   * @brief Classifies a batch of points.
+   * @param points Points to test.
+   * @return Locations, in the order of points.
+   */
+  std::vector<Location> classify(const std::vector<RS_Vector>& points) const;
+  /**
+   * @brief Same contract as RS_Information::isPointInsideContour().
+   * @param point The point to test.
+   * @param onContour Set to true if the point is on the contour.
+   * @return True if the point is inside or on the contour.
+   */
+  bool isInside(const RS_Vector& point, bool* onContour = nullptr) const;
+
+private:
+  /**
+   * @brief Conic (circle or ellipse) shared by its monotone pieces.
+   * y(t) = center.y + yAmplitude * cos(t - yPhase).
+   */
+  struct Conic {
+    RS_Vector center;
+    double major = 0.;
+    double minor = 0.;
+    double cosRotation = 1.;
+    double sinRotation = 0.;
+    double yAmplitude = 0.;
+    double yPhase = 0.;
+    RS_Vector pointAt(double t) const;
+  };
+
+  /**
+   * @brief Piece of a contour entity, monotone in y.
+   */
+  struct Edge {
+    RS_Entity* entity = nullptr;
+    double xMin = 0.;
+    double xMax = 0.;
+    double yMin = 0.;
+    double yMax = 0.;
+    // line piece
+    RS_Vector start;
+    RS_Vector end;
+    // conic piece, between conic.yPhase + halfTurn * PI and the next half turn
+    int conic = -1;
+    long halfTurn = 0;
+    double xAt(double y, const std::vector<Conic>& conics) const;
+  };
+
+  void addEntity(RS_Entity* entity);
+  void addLine(RS_Entity* entity, const RS_Vector& start, const RS_Vector& end);
+  void addConic(RS_Entity* entity, const Conic& conic, double startParam, double angleLength);
+  void buildBuckets();
+  const std::vector<int>* bucketAt(double y) const;
+
+  double m_tolerance = 1.0e-4;
+  double m_minX = 0.;
+  double m_minY = 0.;
+  double m_maxX = 0.;
+  double m_maxY = 0.;
+  double m_bucketHeight = 1.;
+  std::vector<Conic> m_conics;
+  std::vector<Edge> m_edges;
+  std::vector<std::vector<int>> m_buckets;
+};
+
+#endif // LC_CONTOURCLASSIFIER_H
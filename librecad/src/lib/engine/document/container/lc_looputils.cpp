@@ -34,6 +34,7 @@
 #include <QPen>
 #include <QPainterPath>
 
+#include "lc_contourclassifier.h"
 #include "lc_looputils.h"
 #include "lc_pathbuilder.h"
 #include "lc_parabola.h"
@@ -496,6 +497,7 @@ bool LoopExtractor::findNext() const {
 struct LoopSorter::Data {
   std::vector<std::unique_ptr<RS_EntityContainer>> loops;  ///< Input loops
   std::shared_ptr<std::vector<LC_Loops>> results;          ///< Output hierarchy
+  std::unordered_map<const RS_EntityContainer*, std::unique_ptr<LC_ContourClassifier>> classifiers;  ///< Built per potential parent
 };
 
 /**
@@ -598,8 +600,10 @@ void LoopSorter::findParent(RS_EntityContainer* loop, const std::multimap<double
 
     if (childBox.numCornersInside(parentBox) != 4)
       continue;  // Quick bbox containment
-    bool onContour = false;
-    if (RS_Information::isPointInsideContour(testPoint, potentialParent, &onContour)) {
+    auto& classifier = m_data->classifiers[potentialParent];
+    if (classifier == nullptr)
+      classifier = std::make_unique<LC_ContourClassifier>(*potentialParent);
+    if (classifier->isInside(testPoint)) {
       loop->setParent(potentialParent);  // Track hierarchy via parent pointer only
       RS_DEBUG->print("LoopSorter: Assigned parent for loop with area %f", childArea);
       return;
@@ -662,11 +666,16 @@ void LC_Loops::addEntity(RS_Entity* entity) {
 }
 
 /**
- * @brief Non-recursive check for point inside outer loop using winding rule.
+ * @brief Non-recursive check for point inside outer loop, by the classifier built on first use.
+ * Copies share the loop container, so entities added by any copy are detected by the count
+ * of loop entities, as entities are only added to loops.
  */
 bool LC_Loops::isInsideOuter(const RS_Vector& point) const {
-  bool onContour = false;
-  return RS_Information::isPointInsideContour(point, m_loop.get(), &onContour);
+  if (m_classifier == nullptr || m_classifierRevision != m_loop->count()) {
+    m_classifier = std::make_shared<LC_ContourClassifier>(*m_loop);
+    m_classifierRevision = m_loop->count();
+  }
+  return m_classifier->isInside(point);
 }
 
 /**
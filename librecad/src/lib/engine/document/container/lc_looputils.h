@@ -30,6 +30,7 @@
 #include <memory>
 #include <vector>
 
+class LC_ContourClassifier;
 class QPainterPath;
 class RS_AtomicEntity;
 class RS_Entity;
@@ -224,6 +225,8 @@ private:
 
   std::shared_ptr<RS_EntityContainer> m_loop;  ///< Outer loop container
   std::vector<LC_Loops> m_children;             ///< Child loops (holes/islands)
+  mutable std::shared_ptr<LC_ContourClassifier> m_classifier;  ///< Point classifier of m_loop, built on demand
+  mutable unsigned m_classifierRevision = 0;  ///< Count of m_loop entities m_classifier was built for
 };
 
 /**
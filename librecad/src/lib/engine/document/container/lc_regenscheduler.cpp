@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_regenscheduler.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <QThread>
+#include <QThreadPool>
+
+#include "lc_dimregencontext.h"
+#include "lc_trace.h"
+#include "rs_block.h"
+#include "rs_blocklist.h"
+#include "rs_dimension.h"
+#include "rs_graphic.h"
+#include "rs_information.h"
+#include "rs_insert.h"
+
+namespace {
+    // a worker thread is started for each this number of entities, at most one per core
+    constexpr size_t ENTITIES_PER_THREAD = 32;
+
+    /**
+     * Runs worker on the calling thread or on several pool threads. Workers take entities one by one
+     * from the shared list by calling takeNext() until it returns nullptr, as regeneration time of entities
+     * varies a lot (compare an insert of a single line and one of a complex block).
+     */
+    template<typename Worker>
+    void runWorkers(const std::vector<RS_Entity*>& entities, Worker worker) {
+        std::atomic<size_t> next{0};
+        auto takeNext = [&entities, &next]() -> RS_Entity* {
+            size_t index = next.fetch_add(1, std::memory_order_relaxed);
+            return index < entities.size() ? entities[index] : nullptr;
+        };
+        size_t threadsCount = std::min(static_cast<size_t>(std::max(QThread::idealThreadCount(), 1)),
+                                       entities.size() / ENTITIES_PER_THREAD);
+        if (threadsCount < 2) {
+            worker(takeNext);
+            return;
+        }
+        QThreadPool pool;
+        pool.setMaxThreadCount(static_cast<int>(threadsCount));
+        for (size_t i = 0; i < threadsCount; i++) {
+            pool.start([&worker, &takeNext]() {
+                worker(takeNext);
+            });
+        }
+        pool.waitForDone();
+    }
+}
+
+LC_RegenScheduler::LC_RegenScheduler(RS_Graphic* graphic):m_graphic{graphic} {}
+
+void LC_RegenScheduler::defer(RS_Entity* entity) {
+    m_deferred.push_back(entity);
+}
+
+void LC_RegenScheduler::run() {
+    {
+        LC_TRACE_SCOPE("regen", "deferred entities");
+        runWorkers(m_deferred, [](const auto& takeNext) {
+            for (RS_Entity* e = takeNext(); e != nullptr; e = takeNext()) {
+                e->update();
+            }
+        });
+        m_deferred.clear();
+    }
+    // workers never write to invalid border caches, so the caches of shared parents are invalidated in advance
+    m_graphic->invalidateBorders();
+    for (RS_Block* block: *m_graphic->getBlockList()) {
+        block->invalidateBorders();
+    }
+
+    regenerateBlockInserts();
+
+    LC_TRACE_SCOPE("regen", "inserts");
+    std::vector<RS_Entity*> inserts;
+    collectInserts(m_graphic, inserts);
+    dropRegenerated(inserts);
+    updateInserts(inserts);
+}
+
+void LC_RegenScheduler::setRegenerated(std::unordered_set<const RS_Entity*> inserts) {
+    m_regenerated = std::move(inserts);
+}
+
+void LC_RegenScheduler::dropRegenerated(std::vector<RS_Entity*>& inserts) const {
+    if (!m_regenerated.empty()) {
+        inserts.erase(std::remove_if(inserts.begin(), inserts.end(), [this](const RS_Entity* e) {
+            return m_regenerated.count(e) != 0;
+        }), inserts.end());
+    }
+}
+
+/**
+ * Updates inserts placed in blocks, starting from blocks that insert no other blocks. After that,
+ * each block contains up-to-date inserts, and the inserts don't have to be updated again for each insert
+ * of the block.
+ */
+void LC_RegenScheduler::regenerateBlockInserts() {
+    LC_TRACE_SCOPE("regen", "block inserts");
+    QHash<RS_Block*, int> levels;
+    std::vector<std::vector<RS_Entity*>> insertsByLevel;
+    for (RS_Block* block: *m_graphic->getBlockList()) {
+        std::vector<RS_Entity*> inserts;
+        collectInserts(block, inserts);
+        dropRegenerated(inserts);
+        if (inserts.empty()) {
+            continue;
+        }
+        size_t level = static_cast<size_t>(blockLevel(block, levels));
+        if (insertsByLevel.size() <= level) {
+            insertsByLevel.resize(level + 1);
+        }
+        auto& levelInserts = insertsByLevel[level];
+        levelInserts.insert(levelInserts.end(), inserts.begin(), inserts.end());
+    }
+    for (const auto& levelInserts: insertsByLevel) {
+        updateInserts(levelInserts);
+    }
+}
+
+/**
+ * @return nesting level of inserts in the block: 0 if the block inserts no other blocks, otherwise
+ * the level of the most nested inserted block plus one.
+ */
+int LC_RegenScheduler::blockLevel(RS_Block* block, QHash<RS_Block*, int>& levels) {
+    auto it = levels.constFind(block);
+    if (it != levels.cend()) {
+        return it.value();
+    }
+    // placeholder breaks cyclic references of blocks
+    levels.insert(block, 0);
+    std::vector<RS_Entity*> inserts;
+    collectInserts(block, inserts);
+    int level = 0;
+    for (RS_Entity* e: inserts) {
+        RS_Block* nested = static_cast<RS_Insert*>(e)->getBlockForInsert();
+        if (nested != nullptr) {
+            level = std::max(level, blockLevel(nested, levels) + 1);
+        }
+    }
+    levels.insert(block, level);
+    return level;
+}
+
+/**
+ * Collects inserts that are updated by RS_EntityContainer::updateInserts().
+ */
+void LC_RegenScheduler::collectInserts(RS_EntityContainer* container, std::vector<RS_Entity*>& inserts) {
+    for (RS_Entity* e: *container) {
+        if (e == nullptr) {
+            continue;
+        }
+        if (e->getId() != 0 && e->rtti() == RS2::EntityInsert) {
+            inserts.push_back(e);
+        }
+        else if (e->isContainer() && e->rtti() != RS2::EntityHatch) {
+            collectInserts(static_cast<RS_EntityContainer*>(e), inserts);
+        }
+    }
+}
+
+void LC_RegenScheduler::updateInserts(const std::vector<RS_Entity*>& inserts) {
+    runWorkers(inserts, [](const auto& takeNext) {
+        // inserts nested in the blocks are shared by all inserts of a block, and are updated on a lower level
+        RS_Insert::NestedInsertsGuard guard;
+        for (RS_Entity* e = takeNext(); e != nullptr; e = takeNext()) {
+            e->update();
+        }
+    });
+}
+
+int LC_RegenScheduler::regenerateDimensions(bool forced) {
+    LC_TRACE_SCOPE("regen", "dimensions");
+    std::vector<RS_Entity*> dimensions;
+    collectDimensions(m_graphic, dimensions);
+    m_graphic->invalidateBorders();
+
+    std::atomic<int> updatedCount{0};
+    runWorkers(dimensions, [this, forced, &updatedCount](const auto& takeNext) {
+        // the context caches resolved styles, so each worker has its own one
+        LC_DimRegenContext context(m_graphic);
+        // arrows may be inserts of custom blocks. Inserts nested in those blocks are entities of the blocks,
+        // shared by dimensions of all workers, so they must not be updated here. They were updated on load.
+        RS_Insert::NestedInsertsGuard guard;
+        for (RS_Entity* e = takeNext(); e != nullptr; e = takeNext()) {
+            if (e->rtti() == RS2::EntityDimLeader) {
+                e->update();
+                updatedCount++;
+            }
+            else if (static_cast<RS_Dimension*>(e)->regenerate(context, forced)) {
+                updatedCount++;
+            }
+        }
+    });
+    return updatedCount;
+}
+
+/**
+ * Collects dimensions and leaders that are regenerated by RS_EntityContainer::updateDimensions().
+ */
+void LC_RegenScheduler::collectDimensions(RS_EntityContainer* container, std::vector<RS_Entity*>& dimensions) {
+    for (RS_Entity* e: *container) {
+        if (e->isUndone()) {
+            continue;
+        }
+        RS2::EntityType rtti = e->rtti();
+        if (rtti == RS2::EntityDimLeader || RS_Information::isDimension(rtti)) {
+            dimensions.push_back(e);
+        }
+        else if (e->isContainer()) {
+            collectDimensions(static_cast<RS_EntityContainer*>(e), dimensions);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#ifndef LC_REGENSCHEDULER_H
+#define LC_REGENSCHEDULER_H
+
+#include <unordered_set>
+#include <vector>
+
+#include <QHash>
+
+class RS_Block;
+class RS_Entity;
+class RS_EntityContainer;
+class RS_Graphic;
+
+/**
+ * Regenerates entities of a loaded drawing on worker threads.
+ *
+ * Inserts depend on the content of their blocks, so blocks are ordered by nesting of inserts: inserts of
+ * a block are regenerated once all blocks inserted into it are done. Inserts of blocks on the same nesting
+ * level, top-level inserts, texts, hatches and dimensions don't depend on each other and are regenerated
+ * in parallel. Each entity rebuilds only its own children, so the result is the same as of a serial
+ * regeneration in document order.
+ */
+class LC_RegenScheduler {
+public:
+    explicit LC_RegenScheduler(RS_Graphic* graphic);
+
+    /**
+     * Defers update of the entity (text or hatch created by the import filter) until run().
+     */
+    void defer(RS_Entity* entity);
+    /**
+     * Updates deferred entities, then inserts of blocks and of the drawing.
+     */
+    void run();
+    /**
+     * Regenerates dimensions and leaders of the drawing. Inserts nested in blocks are expected to be up to date,
+     * as after run(), so inserts of custom arrow blocks don't update them.
+     * @return number of regenerated dimensions
+     */
+    int regenerateDimensions(bool forced = false);
+    /**
+     * Marks inserts that are regenerated already, e.g. restored from the document cache, so run()
+     * doesn't update them.
+     */
+    void setRegenerated(std::unordered_set<const RS_Entity*> inserts);
+    static void collectInserts(RS_EntityContainer* container, std::vector<RS_Entity*>& inserts);
+private:
+    void regenerateBlockInserts();
+    int blockLevel(RS_Block* block, QHash<RS_Block*, int>& levels);
+    void dropRegenerated(std::vector<RS_Entity*>& inserts) const;
+    static void collectDimensions(RS_EntityContainer* container, std::vector<RS_Entity*>& dimensions);
+    static void updateInserts(const std::vector<RS_Entity*>& inserts);
+
+    RS_Graphic* m_graphic = nullptr;
+    std::vector<RS_Entity*> m_deferred;
+    std::unordered_set<const RS_Entity*> m_regenerated;
+};
+
+#endif // LC_REGENSCHEDULER_H
@@ -33,6 +33,7 @@
 #include <QObject>
 
 #include "lc_containertraverser.h"
+#include "lc_dimregencontext.h"
 #include "lc_looputils.h"
 #include "qg_dialogfactory.h"
 #include "rs_constructionline.h"
@@ -41,11 +42,13 @@
 #include "rs_dimension.h"
 #include "rs_ellipse.h"
 #include "rs_entitycontainer.h"
+#include "rs_graphic.h"
 #include "rs_information.h"
 #include "rs_insert.h"
 #include "rs_layer.h"
 #include "rs_line.h"
 #include "rs_painter.h"
+#include "rs_polyline.h"
 #include "rs_solid.h"
 #include "rs_vector.h"
 
@@ -53,6 +56,12 @@ class RS_Dimension;
 
 namespace {
 
+// the source of revisions of all containers
+    std::atomic<std::uint64_t> g_revisionCounter{0};
+// changed by each read of a revision. Revisions changed after the last read are not changed again, as nobody
+// could see their current values
+    std::atomic<std::uint64_t> g_revisionEpoch{1};
+
 // the tolerance used to check topology of contours in hatching
     constexpr double contourTolerance = 1e-8;
 
@@ -71,6 +80,16 @@ namespace {
         }
     }
 
+// Atomic sub-entities of the container that may cross the selection window. Segments of long polylines
+// are taken from the segment index of the polyline instead of checking each of them.
+    std::vector<RS_Entity*> getCrossingCandidates(RS_EntityContainer* container, const RS_Vector& v1,
+                                                  const RS_Vector& v2) {
+        if (container->rtti() == RS2::EntityPolyline) {
+            return static_cast<RS_Polyline*>(container)->getSegmentsInBox(v1, v2);
+        }
+        return lc::LC_ContainerTraverser{*container, RS2::ResolveAll}.entities();
+    }
+
 // Find the nearest distance between the endpoints of an entity to a given point
     double endPointDistance(const RS_Vector &point, const RS_Entity &entity) {
         double distance = RS_MAXDOUBLE;
@@ -89,9 +108,7 @@ RS_EntityContainer::RS_EntityContainer(RS_EntityContainer *parent,  bool owner):
     autoDelete = owner;
     //    RS_DEBUG->print("RS_EntityContainer::RS_EntityContainer: "
     //                    "owner: %d", (int)owner);
-    subContainer = nullptr;
     //autoUpdateBorders = true;
-    entIdx = -1;
 }
 /**
  * Copy constructor. Makes a deep copy of all entities.
@@ -99,10 +116,8 @@ RS_EntityContainer::RS_EntityContainer(RS_EntityContainer *parent,  bool owner):
 
 RS_EntityContainer::RS_EntityContainer(const RS_EntityContainer& other):
     RS_Entity{other}
-    , subContainer{other.subContainer}
     , m_entities{other.m_entities}
     , m_autoUpdateBorders{other.m_autoUpdateBorders}
-    , entIdx{other.entIdx}
     , autoDelete{other.autoDelete}{
     if (autoDelete) { // fixme - sand - check this logic, looks suspicious!
         for(auto it = begin(); it != end(); ++it) {
@@ -115,9 +130,7 @@ RS_EntityContainer::RS_EntityContainer(const RS_EntityContainer& other):
 
 RS_EntityContainer::RS_EntityContainer(const RS_EntityContainer& other, bool copyChildren) :
     RS_Entity{other}{
-    subContainer = nullptr;
     m_autoUpdateBorders = other.m_autoUpdateBorders;
-    entIdx = other.entIdx;
     autoDelete = other.autoDelete;
     if (copyChildren) {
         m_entities = other.m_entities;
@@ -135,10 +148,8 @@ RS_EntityContainer::RS_EntityContainer(const RS_EntityContainer& other, bool cop
 
 RS_EntityContainer& RS_EntityContainer::operator = (const RS_EntityContainer& other){
     this->RS_Entity::operator = (other);
-    subContainer=other.subContainer;
     m_entities = other.m_entities;
     m_autoUpdateBorders = other.m_autoUpdateBorders;
-    entIdx = other.entIdx;
     autoDelete = other.autoDelete;
     if (autoDelete) {
         for(auto it = begin(); it != end(); ++it) {
@@ -147,25 +158,23 @@ RS_EntityContainer& RS_EntityContainer::operator = (const RS_EntityContainer& ot
             }
         }
     }
+    invalidateBorders();
     return *this;
 }
 
 RS_EntityContainer::RS_EntityContainer(RS_EntityContainer&& other):
     RS_Entity{other}
-    , subContainer{other.subContainer}
     , m_entities{std::move(other.m_entities)}
     , m_autoUpdateBorders{other.m_autoUpdateBorders}
-    , entIdx{other.entIdx}
     , autoDelete{other.autoDelete}{
 }
 
 RS_EntityContainer& RS_EntityContainer::operator = (RS_EntityContainer&& other){
     this->RS_Entity::operator = (other);
-    subContainer=other.subContainer;
     m_entities = std::move(other.m_entities);
     m_autoUpdateBorders = other.m_autoUpdateBorders;
-    entIdx = other.entIdx;
     autoDelete = other.autoDelete;
+    invalidateBorders();
     return *this;
 }
 
@@ -261,6 +270,7 @@ void RS_EntityContainer::reparent(RS_EntityContainer *parent) {
 void RS_EntityContainer::setVisible(bool v) {
     //    RS_DEBUG->print("RS_EntityContainer::setVisible: %d", v);
     RS_Entity::setVisible(v);
+    invalidateBorders();
 
     // All sub-entities:
     for (auto e: std::as_const(m_entities)) {
@@ -345,8 +355,10 @@ void RS_EntityContainer::selectWindow(
 
                 if (e->isContainer()) {
                     auto *ec = (RS_EntityContainer *) e;
-                    lc::LC_ContainerTraverser traverser{*ec, RS2::ResolveAll};
-                    for (RS_Entity *se = traverser.first(); se != nullptr && !included; se = traverser.next()){
+                    for (RS_Entity *se: getCrossingCandidates(ec, v1, v2)) {
+                        if (included) {
+                            break;
+                        }
                         if (se->rtti() == RS2::EntitySolid) {
                             included = static_cast<RS_Solid *>(se)->isInCrossWindow(v1, v2);
                         } else {
@@ -410,8 +422,10 @@ void RS_EntityContainer::selectWindow(
 
                 if (e->isContainer()) {
                     auto *ec = (RS_EntityContainer *) e;
-                    lc::LC_ContainerTraverser traverser{*ec, RS2::ResolveAll};
-                    for (RS_Entity* se = traverser.first(); se != nullptr && !included; se = traverser.next()) {
+                    for (RS_Entity* se: getCrossingCandidates(ec, v1, v2)) {
+                        if (included) {
+                            break;
+                        }
                         if (se->rtti() == RS2::EntitySolid) {
                             included = dynamic_cast<RS_Solid *>(se)->isInCrossWindow(v1, v2);
                         } else {
@@ -478,6 +492,7 @@ void RS_EntityContainer::addEntity(RS_Entity *entity) {
     } else {
         m_entities.append(entity);
     }
+    invalidateBorders();
     adjustBordersIfNeeded(entity);
 }
 
@@ -490,6 +505,7 @@ void RS_EntityContainer::appendEntity(RS_Entity *entity) {
         return;
     }
     m_entities.append(entity);
+    invalidateBorders();
     adjustBordersIfNeeded(entity);
 }
 
@@ -502,6 +518,7 @@ void RS_EntityContainer::prependEntity(RS_Entity *entity) {
         return;
     }
     m_entities.prepend(entity);
+    invalidateBorders();
     adjustBordersIfNeeded(entity);
 }
 
@@ -558,6 +575,7 @@ void RS_EntityContainer::insertEntity(int index, RS_Entity *entity) {
     }
 
     m_entities.insert(index, entity);
+    invalidateBorders();
     adjustBordersIfNeeded(entity);
 }
 /**
@@ -565,14 +583,15 @@ void RS_EntityContainer::insertEntity(int index, RS_Entity *entity) {
  * this entity-container if autoUpdateBorders is true.
  */
 bool RS_EntityContainer::removeEntity(RS_Entity *entity) {
-    //RLZ TODO: in Q3PtrList if 'entity' is nullptr remove the current item-> at.(entIdx)
-    //    and sets 'entIdx' in next() or last() if 'entity' is the last item in the list.
     //    in LibreCAD is never called with nullptr
     bool ret = m_entities.removeOne(entity);
 
     if (autoDelete && ret) {
         delete entity;
     }
+    if (ret) {
+        invalidateBorders();
+    }
     calculateBordersIfNeeded();
     return ret;
 }
@@ -589,6 +608,7 @@ void RS_EntityContainer::clear() {
     } else {
         m_entities.clear();
     }
+    invalidateBorders();
     resetBorders();
 }
 
@@ -706,35 +726,34 @@ void RS_EntityContainer::adjustBorders(RS_Entity *entity) {
 
 /**
  * Recalculates the borders of this entity container.
+ * Cached borders of sub-containers are used if they are still valid.
  */
 void RS_EntityContainer::calculateBorders() {
     RS_DEBUG->print("RS_EntityContainer::calculateBorders");
 
     resetBorders();
+    const unsigned freezeRevision = getFreezeRevision();
     for (RS_Entity *e: *this) {
         //        RS_DEBUG->print("RS_EntityContainer::calculateBorders: "
         //                        "isVisible: %d", (int)e->isVisible());
 
         if (e != nullptr && e->isVisible()) {
-            e->calculateBorders();
-            adjustBorders(e);
+            if (!adjustBordersByCache(e, false, freezeRevision)) {
+                e->calculateBorders();
+                if (e->isContainer()) {
+                    // containers that override calculateBorders() don't store the cache themselves
+                    static_cast<RS_EntityContainer*>(e)->storeBordersCache(false, freezeRevision);
+                }
+                adjustBorders(e);
+            }
         }
     }
 
     RS_DEBUG->print("RS_EntityContainer::calculateBorders: size 1: %f,%f",
                     getSize().x, getSize().y);
 
-    // needed for correcting corrupt data (PLANS.dxf)
-    if (minV.x > maxV.x || minV.x > RS_MAXDOUBLE || maxV.x > RS_MAXDOUBLE
-        || minV.x < RS_MINDOUBLE || maxV.x < RS_MINDOUBLE) {
-        minV.x = 0.0;
-        maxV.x = 0.0;
-    }
-    if (minV.y > maxV.y || minV.y > RS_MAXDOUBLE || maxV.y > RS_MAXDOUBLE
-        || minV.y < RS_MINDOUBLE || maxV.y < RS_MINDOUBLE) {
-        minV.y = 0.0;
-        maxV.y = 0.0;
-    }
+    fixInvalidBorders();
+    storeBordersCache(false, freezeRevision);
 
     RS_DEBUG->print("RS_EntityContainer::calculateBorders: size: %f,%f",
                     getSize().x, getSize().y);
@@ -747,12 +766,16 @@ void RS_EntityContainer::calculateBorders() {
 
 /**
  * Recalculates the borders of this entity container including
- * invisible entities.
+ * invisible entities. Sub-containers are recalculated only if their content was changed
+ * since the last calculation.
  */
 void RS_EntityContainer::forcedCalculateBorders() {
     //RS_DEBUG->print("RS_EntityContainer::calculateBorders");
     resetBorders();
     for (RS_Entity* e : *this) {
+        if (adjustBordersByCache(e, true, 0)) {
+            continue;
+        }
         if (e->isContainer()) {
             auto container = static_cast<RS_EntityContainer*>(e);
             container->forcedCalculateBorders();
@@ -763,24 +786,108 @@ void RS_EntityContainer::forcedCalculateBorders() {
         adjustBorders(e);
     }
 
+    fixInvalidBorders();
+    storeBordersCache(true, 0);
+
+    //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
+
+    //printf("borders: %lf/%lf  %lf/%lf\n", minV.x, minV.y, maxV.x, maxV.y);
+    //RS_Entity::calculateBorders();
+}
+
+void RS_EntityContainer::fixInvalidBorders() {
     // needed for correcting corrupt data (PLANS.dxf)
     if (minV.x > maxV.x || minV.x > RS_MAXDOUBLE || maxV.x > RS_MAXDOUBLE
         || minV.x < RS_MINDOUBLE || maxV.x < RS_MINDOUBLE) {
-
         minV.x = 0.0;
         maxV.x = 0.0;
     }
     if (minV.y > maxV.y || minV.y > RS_MAXDOUBLE || maxV.y > RS_MAXDOUBLE
         || minV.y < RS_MINDOUBLE || maxV.y < RS_MINDOUBLE) {
-
         minV.y = 0.0;
         maxV.y = 0.0;
     }
+}
 
-    //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
+/**
+ * Extends borders of this container by cached borders of the given sub-container.
+ * @param forced true if borders of all entities are needed, false for visible entities only
+ * @return false if the entity is not a container or its cached borders are outdated and should be recalculated
+ */
+bool RS_EntityContainer::adjustBordersByCache(RS_Entity* entity, bool forced, unsigned freezeRevision) {
+    if (!entity->isContainer()) {
+        return false;
+    }
+    auto container = static_cast<RS_EntityContainer*>(entity);
+    RS_Vector cachedMin;
+    RS_Vector cachedMax;
+    {
+        std::lock_guard<std::mutex> lock(container->m_bordersCacheMutex);
+        const LC_BordersCache& cache = forced ? container->m_allBordersCache : container->m_visibleBordersCache;
+        if (!cache.valid || (!forced && cache.freezeRevision != freezeRevision)) {
+            return false;
+        }
+        cachedMin = cache.minV;
+        cachedMax = cache.maxV;
+    }
+    // make sure a container is not empty (otherwise the border would get extended to 0/0):
+    if (container->count() > 0) {
+        minV = RS_Vector::minimum(cachedMin, minV);
+        maxV = RS_Vector::maximum(cachedMax, maxV);
+    }
+    return true;
+}
 
-    //printf("borders: %lf/%lf  %lf/%lf\n", minV.x, minV.y, maxV.x, maxV.y);
-    //RS_Entity::calculateBorders();
+/**
+ * Stores current borders of the container as the cache of visible (forced is false) or all entities.
+ */
+void RS_EntityContainer::storeBordersCache(bool forced, unsigned freezeRevision) {
+    std::lock_guard<std::mutex> lock(m_bordersCacheMutex);
+    LC_BordersCache& cache = forced ? m_allBordersCache : m_visibleBordersCache;
+    cache.minV = minV;
+    cache.maxV = maxV;
+    cache.freezeRevision = freezeRevision;
+    cache.valid = true;
+}
+
+/**
+ * The walk stops at the first container which caches are already invalid and which revision was changed after
+ * the last read of any revision. Parents of such container were invalidated by the same earlier walk and were
+ * not recalculated since, as recalculation of a parent recalculates its children. Parents that skipped an invisible
+ * child don't depend on it, and become invalid when the child is shown.
+ */
+void RS_EntityContainer::invalidateBorders() {
+    const std::uint64_t epoch = g_revisionEpoch.load(std::memory_order_acquire);
+    std::uint64_t revision = 0;
+    for (RS_EntityContainer* container = this; container != nullptr; container = container->getParent()) {
+        std::lock_guard<std::mutex> lock(container->m_bordersCacheMutex);
+        bool wasValid = container->m_visibleBordersCache.valid || container->m_allBordersCache.valid;
+        if (!wasValid && container->m_revisionEpoch.load(std::memory_order_relaxed) == epoch) {
+            break;
+        }
+        container->m_visibleBordersCache.valid = false;
+        container->m_allBordersCache.valid = false;
+        if (revision == 0) {
+            revision = nextRevision();
+        }
+        container->m_revision.store(revision, std::memory_order_relaxed);
+        container->m_revisionEpoch.store(epoch, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t RS_EntityContainer::getRevision() const {
+    // changes after this read should change the revision again
+    g_revisionEpoch.fetch_add(1, std::memory_order_acq_rel);
+    return m_revision.load(std::memory_order_relaxed);
+}
+
+unsigned RS_EntityContainer::getFreezeRevision() const {
+    RS_Graphic* graphic = getGraphic();
+    return graphic != nullptr ? graphic->getLayerList()->getFreezeRevision() : 0;
+}
+
+std::uint64_t RS_EntityContainer::nextRevision() {
+    return g_revisionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 /**
@@ -789,8 +896,22 @@ void RS_EntityContainer::forcedCalculateBorders() {
  *
  * @param autoText Automatically reposition the text label bool autoText=true
  */
-int RS_EntityContainer::updateDimensions(bool autoText) {
+int RS_EntityContainer::updateDimensions(bool autoText, bool forced) {
     RS_DEBUG->print("RS_EntityContainer::updateDimensions()");
+    RS_Graphic* graphic = getGraphic();
+    int updatedDimsCount = 0;
+    if (graphic != nullptr) {
+        LC_DimRegenContext context(graphic);
+        updatedDimsCount = doUpdateDimensions(autoText, forced, &context);
+    }
+    else {
+        updatedDimsCount = doUpdateDimensions(autoText, forced, nullptr);
+    }
+    RS_DEBUG->print("RS_EntityContainer::updateDimensions() OK");
+    return updatedDimsCount;
+}
+
+int RS_EntityContainer::doUpdateDimensions(bool autoText, bool forced, LC_DimRegenContext* context) {
     int updatedDimsCount = 0;
 
     for (RS_Entity *e: *this) {
@@ -805,16 +926,19 @@ int RS_EntityContainer::updateDimensions(bool autoText) {
             auto dimension = static_cast<RS_Dimension*>(e);
             // update and reposition label:
             // dimension->updateDim(autoText);
-            dimension->update();
-            updatedDimsCount ++;
+            if (context == nullptr) {
+                dimension->update();
+                updatedDimsCount ++;
+            }
+            else if (dimension->regenerate(*context, forced)) {
+                updatedDimsCount ++;
+            }
         }
         else if (e->isContainer()) {
             auto container = static_cast<RS_EntityContainer*>(e);
-            updatedDimsCount += container->updateDimensions(autoText);
+            updatedDimsCount += container->doUpdateDimensions(autoText, forced, context);
         }
     }
-
-    RS_DEBUG->print("RS_EntityContainer::updateDimensions() OK");
     return updatedDimsCount;
 }
 
@@ -915,6 +1039,7 @@ void RS_EntityContainer::updateSplines() {
  * Updates the sub entities of this container.
  */
 void RS_EntityContainer::update() {
+    invalidateBorders();
     for (RS_Entity *e: *this) {
         e->update();
     }
@@ -934,343 +1059,6 @@ void RS_EntityContainer::addRectangle(RS_Vector const& v0, RS_Vector const& v1,R
     addEntity(new RS_Line(this, v3, v0));
 }
 
-/**
- * Returns the first entity or nullptr if this graphic is empty.
- * @param level
- */
-RS_Entity *RS_EntityContainer::firstEntity(RS2::ResolveLevel level) const {
-    RS_Entity *e = nullptr;
-    entIdx = -1;
-    switch (level) {
-        case RS2::ResolveNone: {
-            if (!m_entities.isEmpty()) {
-                entIdx = 0;
-                return m_entities.first();
-            }
-            break;
-        }
-        case RS2::ResolveAllButInserts: {
-            subContainer = nullptr;
-            if (!m_entities.isEmpty()) {
-                entIdx = 0;
-                e = m_entities.first();
-            }
-            if (e && e->isContainer() && e->rtti() != RS2::EntityInsert) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->firstEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = nextEntity(level);
-                }
-            }
-            return e;
-        }
-        case RS2::ResolveAllButTextImage:
-        case RS2::ResolveAllButTexts: {
-            subContainer = nullptr;
-            if (!m_entities.isEmpty()) {
-                entIdx = 0;
-                e = m_entities.first();
-            }
-            if (e != nullptr && e->isContainer() && e->rtti() != RS2::EntityText && e->rtti() != RS2::EntityMText) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->firstEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = nextEntity(level);
-                }
-            }
-            return e;
-        }
-        case RS2::ResolveAll: {
-            subContainer = nullptr;
-            if (!m_entities.isEmpty()) {
-                entIdx = 0;
-                e = m_entities.first();
-            }
-            if (e != nullptr && e->isContainer()) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->firstEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = nextEntity(level);
-                }
-            }
-            return e;
-        }
-    }
-    return nullptr;
-}
-
-/**
- * Returns the last entity or \p nullptr if this graphic is empty.
- *
- * @param level \li \p 0 Groups are not resolved
- *              \li \p 1 (default) only Groups are resolved
- *              \li \p 2 all Entity Containers are resolved
- */
-RS_Entity *RS_EntityContainer::lastEntity(RS2::ResolveLevel level) const {
-    RS_Entity *e = nullptr;
-    if (m_entities.empty()) {
-        return nullptr;
-    }
-    entIdx = m_entities.size() - 1;
-    switch (level) {
-        case RS2::ResolveNone: {
-            if (!m_entities.isEmpty()) {
-                return m_entities.last();
-            }
-            break;
-        }
-        case RS2::ResolveAllButInserts: {
-            if (!m_entities.isEmpty()) {
-                e = m_entities.last();
-            }
-            subContainer = nullptr;
-            if (e != nullptr && e->isContainer() && e->rtti() != RS2::EntityInsert) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->lastEntity(level);
-            }
-            return e;
-        }
-        case RS2::ResolveAllButTextImage:
-        case RS2::ResolveAllButTexts: {
-            if (!m_entities.isEmpty()) {
-                e = m_entities.last();
-            }
-            subContainer = nullptr;
-            if (e != nullptr && e->isContainer() && e->rtti() != RS2::EntityText && e->rtti() != RS2::EntityMText) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->lastEntity(level);
-            }
-            return e;
-        }
-        case RS2::ResolveAll: {
-            if (!m_entities.isEmpty()) {
-                e = m_entities.last();
-            }
-            subContainer = nullptr;
-            if (e != nullptr && e->isContainer()) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->lastEntity(level);
-            }
-            return e;
-        }
-    }
-    return nullptr;
-}
-
-/**
- * Returns the next entity or container or \p nullptr if the last entity
- * returned by \p next() was the last entity in the container.
- */
-RS_Entity *RS_EntityContainer::nextEntity(RS2::ResolveLevel level) const {
-    //set entIdx pointing in next entity and check if is out of range
-    ++entIdx;
-    switch (level) {
-        case RS2::ResolveNone: {
-            if (entIdx < m_entities.size()) {
-                return m_entities.at(entIdx);
-            }
-            break;
-        }
-        case RS2::ResolveAllButInserts: {
-            RS_Entity *e = nullptr;
-            if (subContainer) {
-                e = subContainer->nextEntity(level);
-                if (e != nullptr) {
-                    --entIdx; //return a sub-entity, index not advanced
-                    return e;
-                } else {
-                    if (entIdx < m_entities.size()) {
-                        e = m_entities.at(entIdx);
-                    }
-                }
-            } else {
-                if (entIdx < m_entities.size()) {
-                    e = m_entities.at(entIdx);
-                }
-            }
-            if (e != nullptr && e->isContainer() && e->rtti() != RS2::EntityInsert) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->firstEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = nextEntity(level);
-                }
-            }
-            return e;
-        }
-            break;
-
-        case RS2::ResolveAllButTextImage:
-        case RS2::ResolveAllButTexts: {
-            RS_Entity *e = nullptr;
-            if (subContainer) {
-                e = subContainer->nextEntity(level);
-                if (e != nullptr) {
-                    --entIdx; //return a sub-entity, index not advanced
-                    return e;
-                } else {
-                    if (entIdx < m_entities.size()) {
-                        e = m_entities.at(entIdx);
-                    }
-                }
-            } else {
-                if (entIdx < m_entities.size()) {
-                    e = m_entities.at(entIdx);
-                }
-            }
-            if (e != nullptr && e->isContainer() && e->rtti() != RS2::EntityText && e->rtti() != RS2::EntityMText) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->firstEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = nextEntity(level);
-                }
-            }
-            return e;
-        }
-        case RS2::ResolveAll: {
-            RS_Entity *e = nullptr;
-            if (subContainer) {
-                e = subContainer->nextEntity(level);
-                if (e != nullptr) {
-                    --entIdx; //return a sub-entity, index not advanced
-                    return e;
-                } else {
-                    if (entIdx < m_entities.size()) {
-                        e = m_entities.at(entIdx);
-                    }
-                }
-            } else {
-                if (entIdx < m_entities.size()) {
-                    e = m_entities.at(entIdx);
-                }
-            }
-            if (e != nullptr && e->isContainer()) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->firstEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = nextEntity(level);
-                }
-            }
-            return e;
-        }
-    }
-    return nullptr;
-}
-
-/**
- * Returns the prev entity or container or \p nullptr if the last entity
- * returned by \p prev() was the first entity in the container.
- */
-RS_Entity *RS_EntityContainer::prevEntity(RS2::ResolveLevel level) const {
-    //set entIdx pointing in prev entity and check if is out of range
-    --entIdx;
-    switch (level) {
-        case RS2::ResolveNone: {
-            if (entIdx >= 0) {
-                return m_entities.at(entIdx);
-            }
-            break;
-        }
-        case RS2::ResolveAllButInserts: {
-            RS_Entity *e = nullptr;
-            if (subContainer) {
-                e = subContainer->prevEntity(level);
-                if (e != nullptr) {
-                    return e;
-                }
-                else {
-                    if (entIdx >= 0) {
-                        e = m_entities.at(entIdx);
-                    }
-                }
-            }
-            else {
-                if (entIdx >= 0) {
-                    e = m_entities.at(entIdx);
-                }
-            }
-            if (e != nullptr && e->isContainer() && e->rtti() != RS2::EntityInsert) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->lastEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = prevEntity(level);
-                }
-            }
-            return e;
-        }
-        case RS2::ResolveAllButTextImage:
-        case RS2::ResolveAllButTexts: {
-            RS_Entity *e = nullptr;
-            if (subContainer != nullptr) {
-                e = subContainer->prevEntity(level);
-                if (e != nullptr) {
-                    return e;
-                } else {
-                    if (entIdx >= 0) {
-                        e = m_entities.at(entIdx);
-                    }
-                }
-            } else {
-                if (entIdx >= 0) {
-                    e = m_entities.at(entIdx);
-                }
-            }
-            if (e != nullptr && e->isContainer() && e->rtti() != RS2::EntityText && e->rtti() != RS2::EntityMText) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->lastEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = prevEntity(level);
-                }
-            }
-            return e;
-        }
-        case RS2::ResolveAll: {
-            RS_Entity *e = nullptr;
-            if (subContainer != nullptr) {
-                e = subContainer->prevEntity(level);
-                if (e != nullptr) {
-                    ++entIdx; //return a sub-entity, index not advanced
-                    return e;
-                } else {
-                    if (entIdx >= 0) {
-                        e = m_entities.at(entIdx);
-                    }
-                }
-            } else {
-                if (entIdx >= 0) {
-                    e = m_entities.at(entIdx);
-                }
-            }
-            if (e != nullptr && e->isContainer()) {
-                subContainer = static_cast<RS_EntityContainer*>(e);
-                e = subContainer->lastEntity(level);
-                // empty container:
-                if (e == nullptr) {
-                    subContainer = nullptr;
-                    e = prevEntity(level);
-                }
-            }
-            return e;
-        }
-    }
-    return nullptr;
-}
-
 /**
  * @return Entity at the given index or nullptr if the index is out of range.
  */
@@ -1288,14 +1076,15 @@ void RS_EntityContainer::setEntityAt(int index, RS_Entity *en) {
         delete m_entities.at(index);
     }
     m_entities[index] = en;
+    invalidateBorders();
 }
 
 /**
- * Finds the given entity and makes it the current entity if found.
+ * Finds the given entity.
+ * @return index of the entity or -1 if the entity is not in this container
  */
 int RS_EntityContainer::findEntity(RS_Entity const *const entity) {
-    entIdx = m_entities.indexOf(const_cast<RS_Entity *>(entity));
-    return entIdx;
+    return m_entities.indexOf(const_cast<RS_Entity *>(entity));
 }
 
 int RS_EntityContainer::findEntityIndex(RS_Entity const *const entity) {
@@ -1439,8 +1228,7 @@ RS_Vector RS_EntityContainer::getNearestIntersection(const RS_Vector &coord, dou
     RS_Entity* closestEntity = getNearestEntity(coord, nullptr, RS2::ResolveAllButTextImage);
 
     if (closestEntity) {
-        // fixme - sand - why not via traverser?
-        for (RS_Entity *en = firstEntity(RS2::ResolveAllButTextImage);en;en = nextEntity(RS2::ResolveAllButTextImage)) {
+        for (RS_Entity *en : lc::LC_ContainerTraverser{*this, RS2::ResolveAllButTextImage}.entities()) {
             auto parent = en->getParent();
             bool ignoredSnap = false;
             if (parent != nullptr) { // may be null in block editing?
@@ -1757,6 +1545,7 @@ bool RS_EntityContainer::hasEndpointsWithinWindow(const RS_Vector &v1, const RS_
 }
 
 void RS_EntityContainer::move(const RS_Vector &offset) {
+    invalidateBorders();
     moveBorders(offset);
     for (RS_Entity *e: *this) {
         e->move(offset);
@@ -1770,6 +1559,7 @@ void RS_EntityContainer::rotate(const RS_Vector &center, double angle) {
 }
 
 void RS_EntityContainer::rotate(const RS_Vector &center, const RS_Vector &angleVector) {
+    invalidateBorders();
     resetBorders();
     for (RS_Entity *e: *this) {
         e->rotate(center, angleVector);
@@ -1780,6 +1570,7 @@ void RS_EntityContainer::rotate(const RS_Vector &center, const RS_Vector &angleV
 
 void RS_EntityContainer::scale(const RS_Vector &center, const RS_Vector &factor) {
     if (std::abs(factor.x) > RS_TOLERANCE && std::abs(factor.y) > RS_TOLERANCE) {
+        invalidateBorders();
         scaleBorders(center, factor);
         for (RS_Entity* e: *this) {
             e->scale(center, factor);
@@ -1791,6 +1582,7 @@ void RS_EntityContainer::scale(const RS_Vector &center, const RS_Vector &factor)
 
 void RS_EntityContainer::mirror(const RS_Vector &axisPoint1, const RS_Vector &axisPoint2) {
     if (axisPoint1.distanceTo(axisPoint2) > RS_TOLERANCE) {
+        invalidateBorders();
         resetBorders();
         for (RS_Entity *e: *this) {
             e->mirror(axisPoint1, axisPoint2);
@@ -1800,6 +1592,7 @@ void RS_EntityContainer::mirror(const RS_Vector &axisPoint1, const RS_Vector &ax
 }
 
 RS_Entity &RS_EntityContainer::shear(double k) {
+    invalidateBorders();
     for (RS_Entity *e: *this) {
         e->shear(k);
     }
@@ -1808,6 +1601,7 @@ RS_Entity &RS_EntityContainer::shear(double k) {
 }
 
 void RS_EntityContainer::stretch(const RS_Vector &firstCorner,const RS_Vector &secondCorner,const RS_Vector &offset) {
+    invalidateBorders();
     if (getMin().isInWindow(firstCorner, secondCorner) && getMax().isInWindow(firstCorner, secondCorner)) {
         move(offset);
     } else {
@@ -1826,6 +1620,7 @@ void RS_EntityContainer::calculateBordersIfNeeded() {
 }
 
 void RS_EntityContainer::moveRef(const RS_Vector &ref,const RS_Vector &offset) {
+    invalidateBorders();
     resetBorders();
     for (RS_Entity *e: *this) {
         e->moveRef(ref, offset);
@@ -1835,6 +1630,7 @@ void RS_EntityContainer::moveRef(const RS_Vector &ref,const RS_Vector &offset) {
 }
 
 void RS_EntityContainer::moveSelectedRef(const RS_Vector &ref,const RS_Vector &offset) {
+    invalidateBorders();
     resetBorders();
     for (RS_Entity *e: *this) {
         e->moveSelectedRef(ref, offset);
@@ -1857,6 +1653,8 @@ void RS_EntityContainer::revertDirection() {
     for (RS_Entity *entity: std::as_const(m_entities)) {
         entity->revertDirection();
     }
+    // borders are the same, but the content is changed
+    invalidateBorders();
 }
 
 /**
@@ -2030,11 +1828,11 @@ std::ostream &operator<<(std::ostream &os, RS_EntityContainer &ec) {
 }
 
 RS_Entity *RS_EntityContainer::first() const {
-    return m_entities.first();
+    return m_entities.isEmpty() ? nullptr : m_entities.first();
 }
 
 RS_Entity *RS_EntityContainer::last() const {
-    return m_entities.last();
+    return m_entities.isEmpty() ? nullptr : m_entities.last();
 }
 
 const QList<RS_Entity *> &RS_EntityContainer::getEntityList() {
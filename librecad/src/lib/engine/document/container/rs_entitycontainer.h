@@ -28,9 +28,14 @@
 #ifndef RS_ENTITYCONTAINER_H
 #define RS_ENTITYCONTAINER_H
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <QList>
 #include "rs_entity.h"
 
+class LC_DimRegenContext;
+
 /**
  * Class representing a tree of entities.
  * Typical entity containers are graphics, polylines, groups, texts, ...)
@@ -119,10 +124,8 @@ public:
     void addRectangle(RS_Vector const& v0, RS_Vector const& v1);
     void addRectangle(RS_Vector const& v0, RS_Vector const& v1,RS_Vector const& v2, RS_Vector const& v3);
 
-    virtual RS_Entity* firstEntity(RS2::ResolveLevel level=RS2::ResolveNone) const;
-    virtual RS_Entity* lastEntity(RS2::ResolveLevel level=RS2::ResolveNone) const;
-    virtual RS_Entity* nextEntity(RS2::ResolveLevel level=RS2::ResolveNone) const;
-    virtual RS_Entity* prevEntity(RS2::ResolveLevel level=RS2::ResolveNone) const;
+    // Traversing of the container doesn't modify its state, so several readers may traverse it at once.
+    // Use range-based loop, first()/last() or lc::LC_ContainerTraverser for resolving of sub-containers.
     virtual RS_Entity* entityAt(int index) const;
     virtual void setEntityAt(int index,RS_Entity* en);
     virtual int findEntity(RS_Entity const* const entity);
@@ -153,7 +156,7 @@ public:
     virtual unsigned countSelected(bool deep=true, QList<RS2::EntityType> const& types = {});
     virtual void collectSelected(std::vector<RS_Entity*> &collect, bool deep, QList<RS2::EntityType> const &types = {});
     virtual double totalSelectedLength();
-    LC_SelectionInfo getSelectionInfo(/*bool deep, */QList<RS2::EntityType> const& types = {});
+    virtual LC_SelectionInfo getSelectionInfo(/*bool deep, */QList<RS2::EntityType> const& types = {});
 
     /**
      * Enables / disables automatic update of borders on entity removals
@@ -168,7 +171,28 @@ public:
     virtual void adjustBorders(RS_Entity* entity);
     void calculateBorders() override;
     void forcedCalculateBorders();
-    int updateDimensions( bool autoText=true);
+    /**
+     * Marks cached borders of this container and of all its parents as outdated.
+     * Borders of sub-containers that are not marked are reused by calculateBorders() and forcedCalculateBorders()
+     * without visiting their children, so any change of the content of the container should invalidate borders.
+     */
+    void invalidateBorders();
+    /**
+     * @return revision of the content of the container. It's changed by invalidateBorders(), so by any change
+     * of the content of this container or of its sub-containers. Revisions are unique among all containers.
+     */
+    std::uint64_t getRevision() const;
+    /**
+     * @return revision of frozen state of layers and blocks of the document of this container, 0 if the container
+     * is not a part of a document. Visible borders depend on it.
+     */
+    unsigned getFreezeRevision() const;
+    /**
+     * Regenerates dimensions and leaders of the container. Unless forced, only dimensions which styles or
+     * dimension variables were changed since their last regeneration are rebuilt.
+     * @return number of regenerated dimensions
+     */
+    int updateDimensions( bool autoText=true, bool forced = false);
     int updateVisibleDimensions( bool autoText=true);
     virtual void updateInserts();
     virtual void updateSplines();
@@ -209,7 +233,7 @@ public:
     RS_Vector getNearestSelectedRef(const RS_Vector& coord,
                                     double* dist = nullptr) const override;
 
-    RefInfo getNearestSelectedRefInfo(const RS_Vector& coord,
+    virtual RefInfo getNearestSelectedRefInfo(const RS_Vector& coord,
                                       double* dist = nullptr) const;
 
     double getDistanceToPoint(const RS_Vector& coord,
@@ -274,8 +298,7 @@ public:
     QList<RS_Entity *>::iterator begin() ;
     QList<RS_Entity *>::iterator end() ;
 //! \{
-//! first and last without resolving into children, assume the container is
-//! not empty
+//! first and last without resolving into children, nullptr if the container is empty
     RS_Entity* last() const;
     RS_Entity* first() const;
 //! \}
@@ -292,10 +315,22 @@ protected:
      * closed loop. Each loop is assumed to be simply closed, and loops never cross each other.
      */
     virtual std::vector<std::unique_ptr<RS_EntityContainer>> getLoops() const;
-
-    /** sub container used only temporarily for iteration. */
-    mutable RS_EntityContainer* subContainer = nullptr;
 private:
+    int doUpdateDimensions(bool autoText, bool forced, LC_DimRegenContext* context);
+    /**
+     * Borders calculated for the content of the container by last calculateBorders() (visible entities only)
+     * or forcedCalculateBorders() (all entities). Reused by the parent container while valid.
+     */
+    struct LC_BordersCache {
+        RS_Vector minV;
+        RS_Vector maxV;
+        bool valid = false;
+        unsigned freezeRevision = 0;
+    };
+
+    bool adjustBordersByCache(RS_Entity* entity, bool forced, unsigned freezeRevision);
+    void storeBordersCache(bool forced, unsigned freezeRevision);
+    void fixInvalidBorders();
 /**
  * @brief ignoredSnap whether snapping is ignored
  * @return true when entity of this container won't be considered for snapping points
@@ -309,8 +344,19 @@ private:
      * are added or removed.
      */
     bool m_autoUpdateBorders = true;
-    mutable int entIdx = 0;
     bool autoDelete = false;
+    /**
+     * Guards both caches, so borders and the valid flag are published together. Borders of sub-containers
+     * are calculated and invalidated by worker threads that regenerate inserts and dimensions.
+     */
+    mutable std::mutex m_bordersCacheMutex;
+    LC_BordersCache m_visibleBordersCache;
+    LC_BordersCache m_allBordersCache;
+    std::atomic<std::uint64_t> m_revision{nextRevision()};
+    // epoch of revision reads in which the revision was changed last time
+    std::atomic<std::uint64_t> m_revisionEpoch{0};
+
+    static std::uint64_t nextRevision();
 };
 
 #endif
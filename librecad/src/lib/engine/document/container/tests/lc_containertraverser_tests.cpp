@@ -0,0 +1,138 @@
+/*
+**********************************************************************************
+**
+** This file was created for the LibreCAD project (librecad.org), a 2D CAD program.
+**
+** Copyright (C) 2025 librecad (www.librecad.org)
+** Copyright (C) 2025 dxli (github.com/dxli)
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+**********************************************************************************
+**/
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_containertraverser.h"
+#include "rs_entitycontainer.h"
+#include "rs_line.h"
+
+namespace {
+RS_Line* addLine(RS_EntityContainer& parent, double y) {
+    auto* line = new RS_Line(&parent, {0., y}, {10., y});
+    parent.addEntity(line);
+    return line;
+}
+
+// lines, with groups of lines in between, nested to the given depth
+std::vector<RS_Entity*> fillNested(RS_EntityContainer& container, int depth) {
+    std::vector<RS_Entity*> lines;
+    for (int i = 0; i < 3; i++) {
+        lines.push_back(addLine(container, depth * 10. + i));
+        if (depth > 0) {
+            auto* group = new RS_EntityContainer(&container);
+            container.addEntity(group);
+            std::vector<RS_Entity*> nested = fillNested(*group, depth - 1);
+            lines.insert(lines.end(), nested.begin(), nested.end());
+        }
+    }
+    return lines;
+}
+
+std::vector<RS_Entity*> walk(const RS_EntityContainer& container, RS2::ResolveLevel level,
+                             lc::LC_ContainerTraverser::Direction direction
+                             = lc::LC_ContainerTraverser::Direction::Forward) {
+    std::vector<RS_Entity*> visited;
+    lc::LC_ContainerTraverser traverser{container, level, direction};
+    for (RS_Entity* e = traverser.first(); e != nullptr; e = traverser.next()) {
+        visited.push_back(e);
+    }
+    return visited;
+}
+}
+
+TEST_CASE("LC_ContainerTraverser walks nested containers in DFS order") {
+    RS_EntityContainer container(nullptr, true);
+    const std::vector<RS_Entity*> lines = fillNested(container, 2);
+    REQUIRE(lines.size() == 3 + 3 * (3 + 3 * 3));
+
+    REQUIRE(walk(container, RS2::ResolveAll) == lines);
+    REQUIRE(lc::LC_ContainerTraverser{container, RS2::ResolveAll}.entities() == lines);
+
+    std::vector<RS_Entity*> reversed(lines.rbegin(), lines.rend());
+    REQUIRE(walk(container, RS2::ResolveAll, lc::LC_ContainerTraverser::Direction::Backword) == reversed);
+
+    // without resolving the groups are returned as they are
+    const std::vector<RS_Entity*> top = walk(container, RS2::ResolveNone);
+    REQUIRE(top.size() == container.count());
+    REQUIRE(top[1]->rtti() == RS2::EntityContainer);
+}
+
+TEST_CASE("LC_ContainerTraverser steps back across containers") {
+    RS_EntityContainer container(nullptr, true);
+    const std::vector<RS_Entity*> lines = fillNested(container, 1);
+
+    lc::LC_ContainerTraverser traverser{container, RS2::ResolveAll};
+    REQUIRE(traverser.last() == lines.back());
+    REQUIRE(traverser.first() == lines.front());
+    REQUIRE(traverser.prev() == nullptr);
+    for (std::size_t i = 1; i < lines.size(); i++) {
+        REQUIRE(traverser.next() == lines[i]);
+        // neither prev() nor last() moves the traverser
+        REQUIRE(traverser.prev() == lines[i - 1]);
+        REQUIRE(traverser.last() == lines.back());
+    }
+    REQUIRE(traverser.next() == nullptr);
+}
+
+TEST_CASE("LC_ContainerTraverser walks do not disturb each other") {
+    RS_EntityContainer container(nullptr, true);
+    const std::vector<RS_Entity*> lines = fillNested(container, 2);
+
+    SECTION("nested walks over the same container") {
+        std::size_t pairs = 0;
+        lc::LC_ContainerTraverser outer{container, RS2::ResolveAll};
+        std::size_t index = 0;
+        for (RS_Entity* e = outer.first(); e != nullptr; e = outer.next(), index++) {
+            REQUIRE(e == lines[index]);
+            REQUIRE(walk(container, RS2::ResolveAll) == lines);
+            pairs += lines.size();
+        }
+        REQUIRE(index == lines.size());
+        REQUIRE(pairs == lines.size() * lines.size());
+    }
+
+    SECTION("walks from several threads") {
+        std::vector<std::vector<RS_Entity*>> visited(4);
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < visited.size(); t++) {
+            workers.emplace_back([&container, &visited, t]() {
+                const RS_EntityContainer& readOnly = container;
+                for (int i = 0; i < 50; i++) {
+                    visited[t] = walk(readOnly, RS2::ResolveAll);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& v : visited) {
+            REQUIRE(v == lines);
+        }
+    }
+}
@@ -0,0 +1,207 @@
+/*
+**********************************************************************************
+**
+** This file was created for the LibreCAD project (librecad.org), a 2D CAD program.
+**
+** Copyright (C) 2025 librecad (www.librecad.org)
+** Copyright (C) 2025 dxli (github.com/dxli)
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+**********************************************************************************
+*/
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_contourclassifier.h"
+#include "lc_looputils.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_ellipse.h"
+#include "rs_entitycontainer.h"
+#include "rs_information.h"
+#include "rs_line.h"
+
+using Location = LC_ContourClassifier::Location;
+
+namespace {
+void addPolygon(RS_EntityContainer& container, const std::vector<RS_Vector>& vertices) {
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    container.addEntity(new RS_Line(&container, vertices[i], vertices[(i + 1) % vertices.size()]));
+  }
+}
+
+// square bottom with a half circle on top, edges added out of order
+void addArch(RS_EntityContainer& container) {
+  container.addEntity(new RS_Arc(&container, {{5., 5.}, 5., 0., M_PI, false}));
+  container.addEntity(new RS_Line(&container, {0., 0.}, {10., 0.}));
+  container.addEntity(new RS_Line(&container, {0., 5.}, {0., 0.}));
+  container.addEntity(new RS_Line(&container, {10., 0.}, {10., 5.}));
+}
+
+std::vector<RS_Vector> makeGrid(double minX, double minY, double maxX, double maxY, int steps) {
+  std::vector<RS_Vector> points;
+  for (int i = 0; i <= steps; ++i) {
+    for (int j = 0; j <= steps; ++j) {
+      points.emplace_back(minX + (maxX - minX) * i / steps, minY + (maxY - minY) * j / steps);
+    }
+  }
+  return points;
+}
+
+// compares to the random ray test, which is reliable away from the contour
+void compareWithInformation(RS_EntityContainer& contour, const std::vector<RS_Vector>& points) {
+  LC_ContourClassifier classifier{contour};
+  for (const RS_Vector& point : points) {
+    if (contour.getDistanceToPoint(point, nullptr, RS2::ResolveAll) < 1e-2)
+      continue;
+    bool onContour = false;
+    const bool expected = RS_Information::isPointInsideContour(point, &contour, &onContour);
+    REQUIRE(classifier.isInside(point) == expected);
+  }
+}
+}
+
+TEST_CASE("LC_ContourClassifier classifies points of a polygon") {
+  RS_EntityContainer contour(nullptr, true);
+  addPolygon(contour, {{0., 0.}, {10., 0.}, {10., 10.}, {5., 5.}, {0., 10.}});
+  LC_ContourClassifier classifier{contour};
+
+  REQUIRE(classifier.classify({5., 2.}) == Location::Inside);
+  REQUIRE(classifier.classify({5., 8.}) == Location::Outside);
+  REQUIRE(classifier.classify({20., 2.}) == Location::Outside);
+  REQUIRE(classifier.classify({5., 0.}) == Location::OnContour);
+  REQUIRE(classifier.classify({7.5, 7.5}) == Location::OnContour);
+  REQUIRE(classifier.classify({10., 10.}) == Location::OnContour);
+
+  // rays through the inner vertex (5, 5) and the outer vertices
+  REQUIRE(classifier.classify({1., 5.}) == Location::Inside);
+  REQUIRE(classifier.classify({6., 5.}) == Location::Inside);
+  REQUIRE(classifier.classify({0.5, 9.4}) == Location::Inside);
+  REQUIRE(classifier.classify({2., 10.}) == Location::Outside);
+
+  compareWithInformation(contour, makeGrid(-1., -1., 11., 11., 37));
+}
+
+TEST_CASE("LC_ContourClassifier solves arcs and full conics") {
+  SECTION("arch") {
+    RS_EntityContainer contour(nullptr, true);
+    addArch(contour);
+    LC_ContourClassifier classifier{contour};
+    REQUIRE(classifier.classify({5., 9.9}) == Location::Inside);
+    REQUIRE(classifier.classify({5., 10.}) == Location::OnContour);
+    // tangent ray at the top of the arc
+    REQUIRE(classifier.classify({1., 10.}) == Location::Outside);
+    REQUIRE(classifier.classify({0.5, 9.}) == Location::Outside);
+    REQUIRE(classifier.classify({9., 0.5}) == Location::Inside);
+    compareWithInformation(contour, makeGrid(-1., -1., 11., 11., 41));
+  }
+
+  SECTION("circle") {
+    RS_EntityContainer contour(nullptr, true);
+    contour.addEntity(new RS_Circle(&contour, {{0., 0.}, 5.}));
+    LC_ContourClassifier classifier{contour};
+    REQUIRE(classifier.classify({0., 0.}) == Location::Inside);
+    REQUIRE(classifier.classify({-4., 5.}) == Location::Outside);
+    REQUIRE(classifier.classify({0., -5.}) == Location::OnContour);
+    REQUIRE(classifier.classify({4.9, 0.}) == Location::Inside);
+    compareWithInformation(contour, makeGrid(-6., -6., 6., 6., 29));
+  }
+
+  SECTION("rotated ellipse") {
+    RS_EntityContainer contour(nullptr, true);
+    const RS_Vector majorP = RS_Vector::polar(6., M_PI / 6.);
+    contour.addEntity(new RS_Ellipse(&contour, {{1., 2.}, majorP, 0.4, 0., 0., false}));
+    LC_ContourClassifier classifier{contour};
+    REQUIRE(classifier.classify({1., 2.}) == Location::Inside);
+    REQUIRE(classifier.classify(RS_Vector{1., 2.} + majorP) == Location::OnContour);
+    compareWithInformation(contour, makeGrid(-6., -3., 8., 7., 43));
+  }
+}
+
+TEST_CASE("LC_ContourClassifier batch and single results agree") {
+  RS_EntityContainer contour(nullptr, true);
+  addArch(contour);
+  LC_ContourClassifier classifier{contour};
+  const std::vector<RS_Vector> points = makeGrid(-1., -1., 11., 11., 24);
+  const std::vector<Location> locations = classifier.classify(points);
+  REQUIRE(locations.size() == points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    REQUIRE(locations[i] == classifier.classify(points[i]));
+  }
+}
+
+TEST_CASE("LC_Loops uses the odd-even rule for holes") {
+  auto outer = std::make_shared<RS_EntityContainer>(nullptr, true);
+  auto hole = std::make_shared<RS_EntityContainer>(nullptr, true);
+  hole->addEntity(new RS_Circle(hole.get(), {{10., 10.}, 5.}));
+
+  LC_LoopUtils::LC_Loops loops{outer};
+  loops.addChild(LC_LoopUtils::LC_Loops{hole});
+  REQUIRE(!loops.isInside({2., 2.}));
+
+  // the classifier built for the empty loop is dropped once edges are added
+  const std::vector<RS_Vector> corners{{0., 0.}, {20., 0.}, {20., 20.}, {0., 20.}};
+  for (size_t i = 0; i < corners.size(); ++i) {
+    loops.addEntity(new RS_Line(outer.get(), corners[i], corners[(i + 1) % corners.size()]));
+  }
+  REQUIRE(loops.isInside({2., 2.}));
+  REQUIRE(!loops.isInside({10., 10.}));
+  REQUIRE(!loops.isInside({30., 10.}));
+
+  // copies share the loop, edges added by one copy are seen by the other one
+  LC_LoopUtils::LC_Loops copy = loops;
+  REQUIRE(copy.isInside({2., 2.}));
+  const std::vector<RS_Vector> island{{30., 0.}, {40., 0.}, {40., 20.}, {30., 20.}};
+  for (size_t i = 0; i < island.size(); ++i) {
+    copy.addEntity(new RS_Line(outer.get(), island[i], island[(i + 1) % island.size()]));
+  }
+  REQUIRE(copy.isInside({35., 10.}));
+  REQUIRE(loops.isInside({35., 10.}));
+  REQUIRE(loops.isInside({2., 2.}));
+}
+
+TEST_CASE("LC_ContourClassifier benchmark", "[!benchmark]") {
+  // a stroked circle, as a contour of many edges
+  RS_EntityContainer contour(nullptr, true);
+  std::vector<RS_Vector> vertices;
+  for (int i = 0; i < 2000; ++i) {
+    vertices.push_back(RS_Vector::polar(50., 2. * M_PI * i / 2000));
+  }
+  addPolygon(contour, vertices);
+  const std::vector<RS_Vector> points = makeGrid(-60., -60., 60., 60., 31);
+
+  BENCHMARK("random rays") {
+    int inside = 0;
+    for (const RS_Vector& point : points) {
+      bool onContour = false;
+      inside += RS_Information::isPointInsideContour(point, &contour, &onContour) ? 1 : 0;
+    }
+    return inside;
+  };
+
+  BENCHMARK("classifier, including build") {
+    LC_ContourClassifier classifier{contour};
+    int inside = 0;
+    for (Location location : classifier.classify(points)) {
+      inside += location == Location::Inside ? 1 : 0;
+    }
+    return inside;
+  };
+}
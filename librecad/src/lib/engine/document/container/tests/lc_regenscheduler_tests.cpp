@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_regenscheduler.h"
+#include "rs_block.h"
+#include "rs_blocklist.h"
+#include "rs_circle.h"
+#include "rs_dimaligned.h"
+#include "rs_filterdxfrw.h"
+#include "rs_graphic.h"
+#include "rs_insert.h"
+#include "rs_line.h"
+#include "rs_settings.h"
+
+namespace {
+// enough entities for several worker threads
+constexpr int ENTITIES_COUNT = 320;
+
+void initSettings() {
+    if (RS_Settings::instance() == nullptr) {
+        // keeps settings of tests out of the user settings
+        QStandardPaths::setTestModeEnabled(true);
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+RS_Block* addBlock(RS_Graphic& graphic, const QString& name) {
+    auto* block = new RS_Block(&graphic, RS_BlockData(name, {0., 0.}, false));
+    REQUIRE(graphic.addBlock(block, false));
+    return block;
+}
+
+// inserts are not updated on creation, as done by the import filter
+void addInsert(RS_EntityContainer& container, const QString& name, const RS_Vector& position, double angle) {
+    container.addEntity(new RS_Insert(&container, RS_InsertData(name, position, {1., 1.}, angle, 1, 1, {0., 0.},
+                                                                nullptr, RS2::NoUpdate)));
+}
+
+/**
+ * Blocks nested on three levels, inserted many times into the drawing, and aligned dimensions with
+ * arrows of a custom block, which inserts another block. The arrow block is referred by name in other case.
+ */
+void buildDrawing(RS_Graphic& graphic) {
+    RS_Block* tick = addBlock(graphic, "Tick");
+    tick->addEntity(new RS_Line(tick, {0., 0.}, {1., 1.}));
+    RS_Block* arrow = addBlock(graphic, "MyArrow");
+    arrow->addEntity(new RS_Line(arrow, {-1., 0.}, {0., 0.}));
+    addInsert(*arrow, "Tick", {-0.5, 0.}, 0.);
+    RS_Block* middle = addBlock(graphic, "Middle");
+    middle->addEntity(new RS_Circle(middle, {{0., 0.}, 2.}));
+    for (int i = 0; i < 4; ++i) {
+        addInsert(*middle, "Tick", RS_Vector::polar(2., i * M_PI / 2.), i * M_PI / 2.);
+    }
+    RS_Block* top = addBlock(graphic, "Top");
+    addInsert(*top, "Middle", {0., 0.}, 0.);
+    addInsert(*top, "Middle", {5., 0.}, M_PI / 4.);
+    addInsert(*top, "Tick", {0., 5.}, 0.);
+
+    for (int i = 0; i < ENTITIES_COUNT; ++i) {
+        addInsert(graphic, (i % 2 == 0) ? "Top" : "Middle", {i * 10., 0.}, i * 0.01);
+    }
+    graphic.addVariable("$DIMBLK", QString("myarrow"), 1);
+    for (int i = 0; i < ENTITIES_COUNT; ++i) {
+        RS_DimensionData data;
+        data.definitionPoint = {i * 10., 20. + i % 7};
+        data.middleOfText = RS_Vector(false);
+        // no text, so no fonts are needed
+        data.text = " ";
+        graphic.addEntity(new RS_DimAligned(&graphic, data, RS_DimAlignedData({i * 10., 10.},
+                                                                               {i * 10. + 3. + i % 5, 10.})));
+    }
+}
+
+void compareEntities(const RS_Entity* parallel, const RS_Entity* serial) {
+    REQUIRE(parallel->rtti() == serial->rtti());
+    REQUIRE(parallel->getMin().distanceTo(serial->getMin()) < RS_TOLERANCE);
+    REQUIRE(parallel->getMax().distanceTo(serial->getMax()) < RS_TOLERANCE);
+    if (!parallel->isContainer()) {
+        REQUIRE(parallel->getStartpoint().distanceTo(serial->getStartpoint()) < RS_TOLERANCE);
+        REQUIRE(parallel->getEndpoint().distanceTo(serial->getEndpoint()) < RS_TOLERANCE);
+        return;
+    }
+    auto* parallelContainer = static_cast<const RS_EntityContainer*>(parallel);
+    auto* serialContainer = static_cast<const RS_EntityContainer*>(serial);
+    REQUIRE(parallelContainer->count() == serialContainer->count());
+    for (unsigned i = 0; i < parallelContainer->count(); ++i) {
+        compareEntities(parallelContainer->entityAt(i), serialContainer->entityAt(i));
+    }
+}
+}
+
+TEST_CASE("LC_RegenScheduler regenerates as a serial update") {
+    initSettings();
+    RS_Graphic parallel;
+    RS_Graphic serial;
+    buildDrawing(parallel);
+    buildDrawing(serial);
+
+    LC_RegenScheduler(&parallel).run();
+    // prepares dimension styles from variables and regenerates dimensions by the scheduler
+    parallel.onLoadingCompleted();
+
+    serial.updateInserts();
+    serial.onLoadingCompleted();
+    REQUIRE(serial.updateDimensions(true, true) == ENTITIES_COUNT);
+
+    REQUIRE(parallel.count() == serial.count());
+    REQUIRE(parallel.countDeep() == serial.countDeep());
+    for (unsigned i = 0; i < parallel.count(); ++i) {
+        compareEntities(parallel.entityAt(i), serial.entityAt(i));
+    }
+
+    // forced regeneration of the dimensions only
+    REQUIRE(LC_RegenScheduler(&parallel).regenerateDimensions(true) == ENTITIES_COUNT);
+    for (unsigned i = 0; i < parallel.count(); ++i) {
+        compareEntities(parallel.entityAt(i), serial.entityAt(i));
+    }
+}
+
+TEST_CASE("RS_FilterDXFRW updates texts of dropped blocks on import") {
+    initSettings();
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("dimensions.dxf");
+    {
+        // every dimension is exported with an unnamed block *D, which holds the text of the dimension
+        RS_Graphic graphic;
+        buildDrawing(graphic);
+        RS_FilterDXFRW filter;
+        REQUIRE(filter.fileExport(graphic, path, RS2::FormatDXFRW));
+    }
+
+    // the texts of the *D blocks must not be deferred, as the blocks are deleted before the end of the file
+    RS_Graphic graphic;
+    RS_FilterDXFRW filter;
+    REQUIRE(filter.fileImport(graphic, path, RS2::FormatDXFRW));
+    REQUIRE(graphic.count() == 2 * ENTITIES_COUNT);
+    REQUIRE(graphic.getBlockList()->find("*D1") == nullptr);
+    REQUIRE(graphic.getBlockList()->find("Top") != nullptr);
+}
+
+TEST_CASE("RS_BlockList finds blocks ignoring case") {
+    RS_BlockList blocks(true);
+    auto* first = new RS_Block(nullptr, RS_BlockData("Arrow", {0., 0.}, false));
+    auto* second = new RS_Block(nullptr, RS_BlockData("ARROW", {0., 0.}, false));
+    auto* other = new RS_Block(nullptr, RS_BlockData("Tick", {0., 0.}, false));
+    REQUIRE(blocks.add(first, false));
+    REQUIRE(blocks.add(second, false));
+    REQUIRE(blocks.add(other, false));
+
+    // the first block in list order
+    REQUIRE(blocks.findCaseInsensitive("arrow") == first);
+    REQUIRE(blocks.findCaseInsensitive("TICK") == other);
+
+    blocks.remove(first);
+    REQUIRE(blocks.findCaseInsensitive("arrow") == second);
+
+    REQUIRE(blocks.rename(other, "arRow"));
+    REQUIRE(blocks.findCaseInsensitive("arrow") == second);
+    REQUIRE(blocks.findCaseInsensitive("tick") == nullptr);
+
+    blocks.remove(second);
+    REQUIRE(blocks.findCaseInsensitive("ARROW") == other);
+    blocks.remove(other);
+    REQUIRE(blocks.findCaseInsensitive("arrow") == nullptr);
+}
@@ -0,0 +1,153 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2025 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <QStandardPaths>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_arrow_box.h"
+#include "rs_graphic.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_settings.h"
+#include "rs_spline.h"
+
+namespace {
+void initSettings() {
+    if (RS_Settings::instance() == nullptr) {
+        // keeps settings of tests out of the user settings
+        QStandardPaths::setTestModeEnabled(true);
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+RS_EntityContainer* addGroup(RS_EntityContainer& parent) {
+    auto* group = new RS_EntityContainer(&parent);
+    parent.addEntity(group);
+    return group;
+}
+}
+
+TEST_CASE("RS_EntityContainer recalculates cached borders of parents of edited entities") {
+    initSettings();
+    RS_Graphic graphic;
+    RS_EntityContainer* outer = addGroup(graphic);
+    RS_EntityContainer* inner = addGroup(*outer);
+    auto* line = new RS_Line(inner, {0., 0.}, {10., 10.});
+    inner->addEntity(line);
+
+    graphic.calculateBorders();
+    REQUIRE(graphic.getMax() == RS_Vector(10., 10.));
+    graphic.forcedCalculateBorders();
+    REQUIRE(graphic.getMax() == RS_Vector(10., 10.));
+
+    SECTION("line edited in place") {
+        line->moveEndpoint({20., 5.});
+        graphic.calculateBorders();
+        REQUIRE(graphic.getMax() == RS_Vector(20., 10.));
+        REQUIRE(outer->getMax() == RS_Vector(20., 10.));
+        line->moveEndpoint({30., 40.});
+        graphic.forcedCalculateBorders();
+        REQUIRE(graphic.getMax() == RS_Vector(30., 40.));
+    }
+
+    SECTION("second edit before recalculation") {
+        line->moveEndpoint({20., 10.});
+        // the walk stops at the already invalid containers, parents are still invalid
+        line->moveEndpoint({50., 10.});
+        graphic.calculateBorders();
+        REQUIRE(graphic.getMax() == RS_Vector(50., 10.));
+    }
+
+    SECTION("spline control points moved") {
+        RS_SplineData data(2, false);
+        data.controlPoints = {{0., 0.}, {5., 20.}, {10., 0.}};
+        auto* spline = new RS_Spline(inner, data);
+        inner->addEntity(spline);
+        graphic.calculateBorders();
+        REQUIRE(graphic.getMax().y == 20.);
+
+        spline->move({100., 0.});
+        graphic.calculateBorders();
+        REQUIRE(graphic.getMax().x == 110.);
+    }
+
+    SECTION("arrow moved") {
+        auto* arrow = new LC_ArrowBox(inner, {0., 0.}, 0., 1., true);
+        inner->addEntity(arrow);
+        graphic.calculateBorders();
+        REQUIRE(graphic.getMax() == RS_Vector(10., 10.));
+
+        arrow->move({100., 100.});
+        graphic.calculateBorders();
+        REQUIRE(graphic.getMax().x > 99.);
+        REQUIRE(graphic.getMax().y > 99.);
+    }
+}
+
+TEST_CASE("RS_EntityContainer changes revisions of parents after each read") {
+    initSettings();
+    RS_Graphic graphic;
+    RS_EntityContainer* group = addGroup(graphic);
+    auto* line = new RS_Line(group, {0., 0.}, {10., 10.});
+    group->addEntity(line);
+
+    const std::uint64_t first = graphic.getRevision();
+    line->moveEndpoint({20., 20.});
+    const std::uint64_t second = graphic.getRevision();
+    REQUIRE(second != first);
+    // nothing was recalculated, yet the change after the read is visible
+    line->moveEndpoint({30., 30.});
+    REQUIRE(graphic.getRevision() != second);
+    REQUIRE(group->getRevision() == graphic.getRevision());
+}
+
+TEST_CASE("RS_EntityContainer keeps frozen state revisions per document") {
+    initSettings();
+    RS_Graphic graphic;
+    RS_Graphic other;
+    auto* layer = new RS_Layer("hidden");
+    graphic.addLayer(layer);
+    RS_EntityContainer* group = addGroup(graphic);
+    auto* line = new RS_Line(group, {0., 0.}, {10., 10.});
+    group->addEntity(line);
+    auto* hiddenLine = new RS_Line(group, {0., 0.}, {100., 100.});
+    hiddenLine->setLayer(layer);
+    group->addEntity(hiddenLine);
+
+    graphic.calculateBorders();
+    REQUIRE(graphic.getMax() == RS_Vector(100., 100.));
+
+    const unsigned otherRevision = other.getFreezeRevision();
+    const unsigned revision = graphic.getFreezeRevision();
+    layer->freeze(true);
+    REQUIRE(graphic.getFreezeRevision() != revision);
+    REQUIRE(group->getFreezeRevision() == graphic.getFreezeRevision());
+    REQUIRE(other.getFreezeRevision() == otherRevision);
+
+    // the cache of the group is valid, but was calculated for the previous frozen state
+    graphic.calculateBorders();
+    REQUIRE(graphic.getMax() == RS_Vector(10., 10.));
+}
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_dimregencontext.h"
+
+#include "lc_dimstyle.h"
+#include "lc_dimstyletovariablesmapper.h"
+#include "lc_textstyle.h"
+#include "lc_textstylelist.h"
+#include "rs_dimension.h"
+#include "rs_fontlist.h"
+#include "rs_graphic.h"
+#include "rs_variabledict.h"
+
+namespace {
+    size_t variableHash(const QString& key, const RS_Variable& variable) {
+        size_t result = qHash(key);
+        result = qHash(static_cast<int>(variable.getType()), result);
+        switch (variable.getType()) {
+            case RS2::VariableString:
+                result = qHash(variable.getString(), result);
+                break;
+            case RS2::VariableInt:
+                result = qHash(variable.getInt(), result);
+                break;
+            case RS2::VariableDouble:
+                result = qHash(variable.getDouble(), result);
+                break;
+            case RS2::VariableVector: {
+                RS_Vector v = variable.getVector();
+                result = qHash(v.x, result);
+                result = qHash(v.y, result);
+                result = qHash(v.z, result);
+                break;
+            }
+            default:
+                break;
+        }
+        return result;
+    }
+
+    // order of iteration over hash is not defined, so entries are combined by commutative sum
+    size_t dictionaryHash(const RS_VariableDict& dict, bool dimensionVariablesOnly) {
+        size_t result = 0;
+        const auto& variables = dict.getVariableDict();
+        for (auto it = variables.cbegin(); it != variables.cend(); ++it) {
+            const QString& key = it.key();
+            if (dimensionVariablesOnly && !key.startsWith(QStringLiteral("$DIM")) &&
+                key != QStringLiteral("$INSUNITS") && key != QStringLiteral("$LUNITS") &&
+                key != QStringLiteral("$LUPREC") && key != QStringLiteral("$AUNITS") &&
+                key != QStringLiteral("$AUPREC")) {
+                continue;
+            }
+            result += variableHash(key, it.value());
+        }
+        return result;
+    }
+}
+
+LC_DimRegenContext::LC_DimRegenContext(RS_Graphic* graphic):m_graphic{graphic} {
+    m_variablesFingerprint = variablesFingerprint(graphic);
+    m_fontsRevision = RS_FONTLIST->getRevision();
+}
+
+LC_DimRegenContext::~LC_DimRegenContext() = default;
+
+/**
+ * Fingerprint of the style content, based on variables the style is mapped to
+ */
+size_t LC_DimRegenContext::fingerprint(const LC_DimStyle* style) {
+    if (style == nullptr) {
+        return 0;
+    }
+    RS_VariableDict dict;
+    LC_DimStyleToVariablesMapper mapper;
+    mapper.toDictionary(style, &dict);
+    return dictionaryHash(dict, false);
+}
+
+/**
+ * Fingerprint of drawing variables which are read by dimensions directly
+ */
+size_t LC_DimRegenContext::variablesFingerprint(RS_Graphic* graphic) {
+    if (graphic == nullptr) {
+        return 0;
+    }
+    return dictionaryHash(*graphic->getVariableDictObjectRef(), true);
+}
+
+LC_DimStyle* LC_DimRegenContext::globalStyleFor(const RS_Dimension* dimension) const {
+    return m_graphic->getResolvedDimStyle(dimension->getStyle(), dimension->rtti());
+}
+
+size_t LC_DimRegenContext::cachedFingerprint(const LC_DimStyle* style) {
+    auto it = m_styleFingerprints.constFind(style);
+    if (it != m_styleFingerprints.cend()) {
+        return it.value();
+    }
+    size_t result = fingerprint(style);
+    m_styleFingerprints.insert(style, result);
+    return result;
+}
+
+size_t LC_DimRegenContext::overrideFingerprint(const LC_DimStyle* styleOverride) {
+    auto it = m_overrideFingerprints.constFind(styleOverride);
+    if (it != m_overrideFingerprints.cend()) {
+        return it.value();
+    }
+    size_t result = fingerprint(styleOverride);
+    m_overrideFingerprints.insert(styleOverride, result);
+    return result;
+}
+
+/**
+ * Fingerprint of the text style with the given name, as it is defined in the drawing. The label is created
+ * with the font requested by the style name, so the name is a part of fingerprint even if there is no such
+ * text style.
+ */
+size_t LC_DimRegenContext::textStyleFingerprint(const QString& styleName) {
+    auto it = m_textStyleFingerprints.constFind(styleName);
+    if (it != m_textStyleFingerprints.cend()) {
+        return it.value();
+    }
+    size_t result = qHash(styleName);
+    LC_TextStyle* textStyle = m_graphic->getTextStyleList()->find(styleName);
+    if (textStyle != nullptr) {
+        result = qHash(textStyle->getFontName(), result);
+        result = qHash(textStyle->getBigFont(), result);
+        result = qHash(textStyle->getFixedTextHeight(), result);
+        result = qHash(textStyle->getWidthFactor(), result);
+        result = qHash(textStyle->getObliqueAngle(), result);
+        result = qHash(textStyle->getGenFlag(), result);
+        result = qHash(textStyle->getFontFamilyItalicBold(), result);
+        result = qHash(textStyle->getFlags(), result);
+    }
+    m_textStyleFingerprints.insert(styleName, result);
+    return result;
+}
+
+size_t LC_DimRegenContext::stampFor(const RS_Dimension* dimension) {
+    size_t result = qHash(m_fontsRevision, m_variablesFingerprint);
+    LC_DimStyle* globalStyle = globalStyleFor(dimension);
+    result = qHash(cachedFingerprint(globalStyle), result);
+    if (globalStyle != nullptr) {
+        result = qHash(textStyleFingerprint(globalStyle->text()->style()), result);
+    }
+    LC_DimStyle* styleOverride = dimension->getDimStyleOverride();
+    if (styleOverride != nullptr) {
+        result = qHash(overrideFingerprint(styleOverride), result);
+        result = qHash(textStyleFingerprint(styleOverride->text()->style()), result);
+    }
+    return result;
+}
+
+/**
+ * @return effective style for the dimension. The instance is owned either by the graphic or by the context,
+ * so it should not be deleted by the caller.
+ */
+LC_DimStyle* LC_DimRegenContext::effectiveStyleFor(const RS_Dimension* dimension) {
+    LC_DimStyle* globalStyle = globalStyleFor(dimension);
+    LC_DimStyle* styleOverride = dimension->getDimStyleOverride();
+    if (styleOverride == nullptr) {
+        return globalStyle;
+    }
+    if (globalStyle == nullptr) {
+        // nothing to merge with, the override is used as it is
+        return styleOverride;
+    }
+    QPair<const LC_DimStyle*, size_t> key{globalStyle, overrideFingerprint(styleOverride)};
+    auto it = m_effectiveStyles.constFind(key);
+    if (it != m_effectiveStyles.cend()) {
+        return it.value().get();
+    }
+    std::shared_ptr<LC_DimStyle> effectiveStyle{styleOverride->getCopy()};
+    effectiveStyle->mergeWith(globalStyle, LC_DimStyle::ModificationAware::UNSET, LC_DimStyle::ModificationAware::UNSET);
+    m_effectiveStyles.insert(key, effectiveStyle);
+    return effectiveStyle.get();
+}
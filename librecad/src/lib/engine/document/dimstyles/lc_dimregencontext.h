@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_DIMREGENCONTEXT_H
+#define LC_DIMREGENCONTEXT_H
+
+#include <memory>
+#include <QHash>
+#include <QPair>
+#include <QString>
+
+class LC_DimStyle;
+class RS_Dimension;
+class RS_Graphic;
+
+/**
+ * State shared by dimensions during one regeneration pass over the drawing.
+ *
+ * Each dimension remembers a stamp of inputs it was built from - fingerprint of its effective dim style
+ * (global style and override), of the text style used by the label, of the list of available fonts and
+ * of dimension-related drawing variables. A dimension is regenerated only if the stamp computed for
+ * current state differs, so changing one dim style, text style or variable rebuilds only dimensions
+ * that depend on it.
+ *
+ * Fingerprints of styles, overrides and text styles, as well as effective styles built for overrides are
+ * cached for the pass, so dimensions with the same style and override share a single resolved style
+ * instead of creating a copy for each one.
+ * As styles may be replaced or changed in place between passes, the context should not outlive the pass.
+ */
+class LC_DimRegenContext {
+public:
+    explicit LC_DimRegenContext(RS_Graphic* graphic);
+    ~LC_DimRegenContext();
+
+    size_t stampFor(const RS_Dimension* dimension);
+    LC_DimStyle* effectiveStyleFor(const RS_Dimension* dimension);
+
+    static size_t fingerprint(const LC_DimStyle* style);
+    static size_t variablesFingerprint(RS_Graphic* graphic);
+private:
+    LC_DimStyle* globalStyleFor(const RS_Dimension* dimension) const;
+    size_t cachedFingerprint(const LC_DimStyle* style);
+    size_t overrideFingerprint(const LC_DimStyle* styleOverride);
+    size_t textStyleFingerprint(const QString& styleName);
+
+    RS_Graphic* m_graphic = nullptr;
+    size_t m_variablesFingerprint = 0;
+    unsigned m_fontsRevision = 0;
+    QHash<const LC_DimStyle*, size_t> m_styleFingerprints;
+    // overrides are owned by dimensions and are not changed or deleted during the pass
+    QHash<const LC_DimStyle*, size_t> m_overrideFingerprints;
+    QHash<QString, size_t> m_textStyleFingerprints;
+    // key is global style and fingerprint of override
+    QHash<QPair<const LC_DimStyle*, size_t>, std::shared_ptr<LC_DimStyle>> m_effectiveStyles;
+};
+
+#endif // LC_DIMREGENCONTEXT_H
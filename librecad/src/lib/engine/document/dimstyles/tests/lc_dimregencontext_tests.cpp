@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include <QStandardPaths>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_dimstyle.h"
+#include "lc_textstyle.h"
+#include "lc_textstylelist.h"
+#include "rs_dimaligned.h"
+#include "rs_graphic.h"
+#include "rs_settings.h"
+
+namespace {
+constexpr int DIMENSIONS_COUNT = 5;
+
+void initSettings() {
+    if (RS_Settings::instance() == nullptr) {
+        // keeps settings of tests out of the user settings
+        QStandardPaths::setTestModeEnabled(true);
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+std::vector<RS_DimAligned*> addDimensions(RS_Graphic& graphic) {
+    std::vector<RS_DimAligned*> result;
+    for (int i = 0; i < DIMENSIONS_COUNT; ++i) {
+        RS_DimensionData data;
+        data.definitionPoint = {i * 10., 20.};
+        data.middleOfText = RS_Vector(false);
+        // no text, so no fonts are needed
+        data.text = " ";
+        auto* dimension = new RS_DimAligned(&graphic, data, RS_DimAlignedData({i * 10., 10.}, {i * 10. + 5., 10.}));
+        graphic.addEntity(dimension);
+        result.push_back(dimension);
+    }
+    return result;
+}
+}
+
+TEST_CASE("RS_EntityContainer::updateDimensions regenerates only changed dimensions", "[LC_DimRegenContext]") {
+    initSettings();
+    RS_Graphic graphic;
+    std::vector<RS_DimAligned*> dimensions = addDimensions(graphic);
+
+    // the stamp is not valid before the first pass
+    REQUIRE(graphic.updateDimensions(false) == DIMENSIONS_COUNT);
+    REQUIRE(graphic.updateDimensions(false) == 0);
+    // the stamp is ignored when forced
+    REQUIRE(graphic.updateDimensions(false, true) == DIMENSIONS_COUNT);
+
+    SECTION("dimension variable") {
+        graphic.addVariable("$DIMSCALE", 2.0, 40);
+        REQUIRE(graphic.updateDimensions(false) == DIMENSIONS_COUNT);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+        // variables that are not used by dimensions don't regenerate them
+        graphic.addVariable("$PDSIZE", 3.0, 40);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+    }
+
+    SECTION("dimension style") {
+        LC_DimStyle* style = graphic.getResolvedDimStyle("", RS2::EntityDimAligned);
+        REQUIRE(style != nullptr);
+        style->arrowhead()->setSize(style->arrowhead()->size() * 2.);
+        REQUIRE(graphic.updateDimensions(false) == DIMENSIONS_COUNT);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+    }
+
+    SECTION("style override") {
+        LC_DimStyle* style = graphic.getResolvedDimStyle("", RS2::EntityDimAligned);
+        std::unique_ptr<LC_DimStyle> styleOverride{style->getCopy()};
+        styleOverride->arrowhead()->setSize(style->arrowhead()->size() * 3.);
+        dimensions.front()->setDimStyleOverride(styleOverride.get());
+        REQUIRE(graphic.updateDimensions(false) == 1);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+
+        dimensions.front()->getDimStyleOverride()->arrowhead()->setSize(style->arrowhead()->size() * 4.);
+        REQUIRE(graphic.updateDimensions(false) == 1);
+
+        // dimensions with the same override
+        for (RS_DimAligned* dimension : dimensions) {
+            dimension->setDimStyleOverride(styleOverride.get());
+        }
+        REQUIRE(graphic.updateDimensions(false) == DIMENSIONS_COUNT);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+    }
+
+    SECTION("text style") {
+        LC_DimStyle* style = graphic.getResolvedDimStyle("", RS2::EntityDimAligned);
+        auto* textStyle = new LC_TextStyle();
+        textStyle->setName(style->text()->style());
+        textStyle->setWidthFactor(1.0);
+        graphic.getTextStyleList()->replace({textStyle});
+        REQUIRE(graphic.updateDimensions(false) == DIMENSIONS_COUNT);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+
+        textStyle->setWidthFactor(0.8);
+        REQUIRE(graphic.updateDimensions(false) == DIMENSIONS_COUNT);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+
+        // other text styles don't regenerate dimensions
+        auto* otherStyle = new LC_TextStyle();
+        otherStyle->setName("other");
+        graphic.getTextStyleList()->addStyle(otherStyle);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+        otherStyle->setWidthFactor(2.0);
+        REQUIRE(graphic.updateDimensions(false) == 0);
+        graphic.getTextStyleList()->replace({});
+    }
+
+    SECTION("direct update") {
+        dimensions.back()->update();
+        REQUIRE(graphic.updateDimensions(false) == 1);
+    }
+}
@@ -1065,6 +1065,7 @@ RS_Vector LC_Hyperbola::getNearestDist(double distance,
 
 void LC_Hyperbola::move(const RS_Vector &offset) {
   data.center += offset;
+  calculateBorders();
 }
 
 void LC_Hyperbola::rotate(const RS_Vector &center, double angle) {
@@ -1075,6 +1076,7 @@ void LC_Hyperbola::rotate(const RS_Vector &center,
                           const RS_Vector &angleVector) {
   data.center.rotate(center, angleVector);
   data.majorP.rotate(angleVector);
+  calculateBorders();
 }
 
 void LC_Hyperbola::scale(const RS_Vector &center, const RS_Vector &factor) {
@@ -1090,6 +1092,7 @@ void LC_Hyperbola::scale(const RS_Vector &center, const RS_Vector &factor) {
   data.angle2 = getParamFromPoint(vpEnd);
   if (data.angle1 > data.angle2)
     std::swap(data.angle1, data.angle2);
+  calculateBorders();
 }
 
 void LC_Hyperbola::mirror(const RS_Vector &axisPoint1,
@@ -1355,6 +1358,7 @@ LC_Quadratic LC_Hyperbola::getQuadratic() const {
 
 //=====================================================================
 void LC_Hyperbola::calculateBorders() {
+  invalidateParentBorders();
   minV = RS_Vector(RS_MAXDOUBLE, RS_MAXDOUBLE);
   maxV = RS_Vector(RS_MINDOUBLE, RS_MINDOUBLE);
 
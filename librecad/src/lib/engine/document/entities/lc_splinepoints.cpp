@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <QPainterPath>
 
 #include "lc_quadratic.h"
+#include "lc_segmentindex.h"
 #include "rs_circle.h"
 #include "rs_information.h"
 #include "rs_line.h"
@@ -542,6 +543,14 @@ void addLineQuadIntersect(RS_VectorSolutions *pVS,
 		}
 	}
 }
+
+// relative tolerance used to collect segments near the box of other entity, candidates are checked exactly
+constexpr double INDEX_BOX_TOLERANCE = 1.0e-6;
+
+double GetIndexTolerance(const RS_Vector& minV, const RS_Vector& maxV)
+{
+	return INDEX_BOX_TOLERANCE*std::max(1.0, (maxV - minV).magnitude());
+}
 }
 
 LC_SplinePointsData::LC_SplinePointsData(bool _closed, bool _cut):
@@ -584,6 +593,50 @@ void LC_SplinePoints::update()
 	calculateBorders();
 }
 
+size_t LC_SplinePoints::getQuadsCount() const
+{
+	size_t n = data.controlPoints.size();
+	if(data.closed)
+	{
+		return n < 3 ? 0 : n;
+	}
+	return n < 4 ? 0 : n - 2;
+}
+
+std::shared_ptr<const LC_SegmentIndex> LC_SplinePoints::getSegmentIndex() const
+{
+	size_t quadsCount = getQuadsCount();
+	if(quadsCount < LC_SegmentIndex::MIN_SEGMENTS)
+	{
+		return nullptr;
+	}
+
+	auto index = std::atomic_load(&m_segmentIndex);
+	if(index != nullptr && index->size() == quadsCount)
+	{
+		return index;
+	}
+
+	std::vector<LC_SegmentIndex::Box> boxes;
+	boxes.reserve(quadsCount);
+	RS_Vector vStart(false), vControl(false), vEnd(false);
+	for(size_t i = 1; i <= quadsCount; ++i)
+	{
+		GetQuadPoints(i, &vStart, &vControl, &vEnd);
+		// control polygon contains the whole quadratic segment
+		boxes.push_back({RS_Vector::minimum(RS_Vector::minimum(vStart, vControl), vEnd),
+			RS_Vector::maximum(RS_Vector::maximum(vStart, vControl), vEnd)});
+	}
+	index = std::make_shared<const LC_SegmentIndex>(std::move(boxes));
+	std::atomic_store(&m_segmentIndex, index);
+	return index;
+}
+
+void LC_SplinePoints::invalidateSegmentIndex()
+{
+	std::atomic_store(&m_segmentIndex, std::shared_ptr<const LC_SegmentIndex>());
+}
+
 void LC_SplinePoints::UpdateQuadExtent(const RS_Vector& x1, const RS_Vector& c1, const RS_Vector& x2)
 {
     RS_Vector locMinV = RS_Vector::minimum(x1, x2);
@@ -618,6 +671,8 @@ void LC_SplinePoints::UpdateQuadExtent(const RS_Vector& x1, const RS_Vector& c1,
 }
 
 void LC_SplinePoints::calculateBorders(){
+    invalidateParentBorders();
+    invalidateSegmentIndex();
     minV = RS_Vector(false);
     maxV = RS_Vector(false);
 
@@ -812,6 +867,27 @@ int LC_SplinePoints::GetQuadPoints(int iSeg, RS_Vector *pvStart, RS_Vector *pvCo
 int LC_SplinePoints::GetNearestQuad(const RS_Vector& coord,
                                     double* dist, double* dt) const
 {
+    auto index = getSegmentIndex();
+    if (index != nullptr) {
+        RS_Vector vStart(false), vControl(false), vEnd(false);
+        double dDist = 0.;
+        int iSeg = index->findNearest(coord, [this, &coord](size_t id) {
+            RS_Vector vS(false), vC(false), vE(false);
+            GetQuadPoints(id + 1, &vS, &vC, &vE);
+            double dQuadDist = 0.;
+            if (GetDistToQuadSquared(coord, vS, vC, vE, &dQuadDist) < 0.) {
+                dQuadDist = (coord - vS).squared();
+            }
+            return std::sqrt(dQuadDist);
+        }, false, &dDist);
+
+        GetQuadPoints(iSeg + 1, &vStart, &vControl, &vEnd);
+        double dQuadDist = 0.;
+        *dt = std::max(0., GetDistToQuadSquared(coord, vStart, vControl, vEnd, &dQuadDist));
+        if (dist) *dist = dDist;
+        return iSeg + 1;
+    }
+
     size_t n = data.controlPoints.size();
 
     RS_Vector vStart(false), vControl(false), vEnd(false), vRes(false);
@@ -1235,6 +1311,7 @@ void LC_SplinePoints::removeLastPoint(){
 }
 
 void LC_SplinePoints::addControlPoint(const RS_Vector& v){
+    invalidateSegmentIndex();
     data.controlPoints.push_back(v);
 }
 
@@ -2707,6 +2784,16 @@ RS_VectorSolutions getLineLineIntersect(
 RS_VectorSolutions LC_SplinePoints::getLineIntersect(const RS_Vector& x1, const RS_Vector& x2) {
 	RS_VectorSolutions ret;
 
+	auto index = getSegmentIndex();
+	if (index != nullptr) {
+		RS_Vector vStart(false), vEnd(false), vControl(false);
+		for (size_t id: index->findInBox(x1, x2, GetIndexTolerance(x1, x2))) {
+			GetQuadPoints(id + 1, &vStart, &vControl, &vEnd);
+			addLineQuadIntersect(&ret, x1, x2, vStart, vControl, vEnd);
+		}
+		return ret;
+	}
+
 	size_t n = data.controlPoints.size();
 	if (n < 2) return ret;
 
@@ -2847,6 +2934,20 @@ void addQuadQuadIntersect(RS_VectorSolutions *pVS,
 void LC_SplinePoints::addQuadIntersect(RS_VectorSolutions *pVS, const RS_Vector& x1,
 	const RS_Vector& c1, const RS_Vector& x2)
 {
+	auto index = getSegmentIndex();
+	if(index != nullptr)
+	{
+		RS_Vector vMin = RS_Vector::minimum(RS_Vector::minimum(x1, c1), x2);
+		RS_Vector vMax = RS_Vector::maximum(RS_Vector::maximum(x1, c1), x2);
+		RS_Vector vStart(false), vEnd(false), vControl(false);
+		for(size_t id: index->findInBox(vMin, vMax, GetIndexTolerance(vMin, vMax)))
+		{
+			GetQuadPoints(id + 1, &vStart, &vControl, &vEnd);
+			addQuadQuadIntersect(pVS, vStart, vControl, vEnd, x1, c1, x2);
+		}
+		return;
+	}
+
 	size_t n = data.controlPoints.size();
 	if(n < 2) return;
 
@@ -3123,6 +3224,19 @@ RS_VectorSolutions LC_SplinePoints::getQuadraticIntersect(RS_Entity const* e1){
     LC_Quadratic lcQuad = e1->getQuadratic();
     std::vector<double> dQuadCoefs = lcQuad.getCoefficients();
 
+    // only a full circle is bounded by its borders, the quadratic of other entities may be wider
+    auto index = e1->rtti() == RS2::EntityCircle ? getSegmentIndex() : nullptr;
+    if(index != nullptr){
+        const RS_Vector& vMin = e1->getMin();
+        const RS_Vector& vMax = e1->getMax();
+        RS_Vector vStart(false), vEnd(false), vControl(false);
+        for(size_t id: index->findInBox(vMin, vMax, GetIndexTolerance(vMin, vMax))){
+            GetQuadPoints(id + 1, &vStart, &vControl, &vEnd);
+            addQuadraticQuadIntersect(&ret, dQuadCoefs, vStart, vControl, vEnd);
+        }
+        return ret;
+    }
+
     RS_Vector vStart(false), vEnd(false), vControl(false);
 
     if(data.closed){
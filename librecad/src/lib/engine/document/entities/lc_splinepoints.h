@@ -25,10 +25,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef LC_SPLINEPOINTS_H
 #define LC_SPLINEPOINTS_H
 
+#include <memory>
 #include <vector>
 #include "rs_atomicentity.h"
 #include "lc_cachedlengthentity.h"
 
+class LC_SegmentIndex;
 class QPolygonF;
 struct RS_LineTypePattern;
 
@@ -82,7 +84,15 @@ private:
     bool offsetSpline(const RS_Vector& coord, const double& distance);
     std::vector<RS_Entity*> offsetTwoSidesSpline(const double& distance) const;
     std::vector<RS_Entity*> offsetTwoSidesCut(const double& distance) const;
+    size_t getQuadsCount() const;
+    /**
+     * @return index of quadratic segments, built on first use; nullptr if spline has too few segments
+     */
+    std::shared_ptr<const LC_SegmentIndex> getSegmentIndex() const;
+    void invalidateSegmentIndex();
     LC_SplinePointsData data;
+    /** shared between clones until geometry of either one is changed */
+    mutable std::shared_ptr<const LC_SegmentIndex> m_segmentIndex;
 
 protected:
     /**
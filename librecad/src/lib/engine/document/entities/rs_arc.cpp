@@ -279,6 +279,7 @@ bool RS_Arc::createFrom2PBulge(const RS_Vector& startPoint, const RS_Vector& end
 }
 
 void RS_Arc::calculateBorders() {
+    invalidateParentBorders();
     m_startPoint = data.center.relative(data.radius, data.angle1);
     m_endPoint = data.center.relative(data.radius, data.angle2);
     LC_Rect const rect{m_startPoint, m_endPoint};
@@ -109,6 +109,7 @@ RS_Entity* RS_Circle::clone() const {
 }
 
 void RS_Circle::calculateBorders() {
+    invalidateParentBorders();
     RS_Vector r{data.radius, data.radius};
     minV = data.center - r;
     maxV = data.center + r;
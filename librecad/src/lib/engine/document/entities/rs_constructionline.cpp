@@ -69,6 +69,7 @@ RS_Entity* RS_ConstructionLine::clone() const {
 }
 
 void RS_ConstructionLine::calculateBorders() {
+    invalidateParentBorders();
     minV = RS_Vector::minimum(data.point1, data.point2);
     maxV = RS_Vector::maximum(data.point1, data.point2);
 }
@@ -262,6 +263,7 @@ void RS_ConstructionLine::scale(const RS_Vector& center, const RS_Vector& factor
 void RS_ConstructionLine::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2) {
     data.point1.mirror(axisPoint1, axisPoint2);
     data.point2.mirror(axisPoint1, axisPoint2);
+    calculateBorders();
 }
 
 RS_Entity& RS_ConstructionLine::shear(double k){
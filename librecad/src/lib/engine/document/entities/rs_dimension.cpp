@@ -30,6 +30,7 @@
 
 #include "lc_align.h"
 #include "lc_dimarrowregistry.h"
+#include "lc_dimregencontext.h"
 #include "lc_linemath.h"
 #include "muParser.h"
 #include "rs_arc.h"
@@ -1226,6 +1227,7 @@ void RS_Dimension::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoin
 }
 
 void RS_Dimension::update() {
+    m_regenStampValid = false;
     clear();
     if (isUndone()) {
         return;
@@ -1234,6 +1236,44 @@ void RS_Dimension::update() {
     calculateBorders();
 }
 
+/**
+ * Draws the dimension. Dimensions that are too small on the screen are drawn with reduced level of detail.
+ */
+void RS_Dimension::draw(RS_Painter* painter) {
+    if (painter->drawContainerReducedDetail(this)) {
+        return;
+    }
+    RS_EntityContainer::draw(painter);
+}
+
+/**
+ * Regenerates the dimension as part of drawing-wide pass, if styles or variables it depends on were changed
+ * since last regeneration.
+ * @param context shared state of the pass
+ * @param forced if true, dimension is regenerated regardless of dependencies state
+ * @return true if dimension was regenerated
+ */
+bool RS_Dimension::regenerate(LC_DimRegenContext& context, bool forced) {
+    size_t stamp = context.stampFor(this);
+    if (!forced && m_regenStampValid && m_regenStamp == stamp && !isEmpty()) {
+        return false;
+    }
+    clear();
+    m_regenStampValid = false;
+    if (isUndone()) {
+        return true;
+    }
+    m_dimStyleTransient = context.effectiveStyleFor(this);
+    if (m_dimStyleTransient != nullptr) {
+        doUpdateDim();
+        m_regenStamp = stamp;
+        m_regenStampValid = true;
+    }
+    m_dimStyleTransient = nullptr;
+    calculateBorders();
+    return true;
+}
+
 LC_DimStyle* RS_Dimension::getGlobalDimStyle() {
     auto dimStyleName = getStyle();
     auto globalDimStyle = getGraphic()->getResolvedDimStyle(dimStyleName, rtti());
@@ -1259,6 +1299,7 @@ void RS_Dimension::resolveEffectiveDimStyleAndUpdateDim() {
 
 void RS_Dimension::updateDim(bool autoText) {
     m_dimGenericData.autoText = autoText;
+    m_regenStampValid = false;
     clear();
     if (isUndone()) {
         return;
@@ -34,6 +34,7 @@
 #include "rs_mtext.h"
 
 struct RS_ArcData;
+class LC_DimRegenContext;
 class RS_Arc;
 class RS_Color;
 class RS_Line;
@@ -144,10 +145,12 @@ public:
      * to update the subentities which make up the dimension entity.
      */
     void update() override;
+    void draw(RS_Painter* painter) override;
     LC_DimStyle* getGlobalDimStyle();
     LC_DimStyle* getEffectiveDimStyle();
     void resolveEffectiveDimStyleAndUpdateDim();
     void updateDim(bool autoText=false);
+    bool regenerate(LC_DimRegenContext& context, bool forced);
 
     RS_Vector getDefinitionPoint() {return m_dimGenericData.definitionPoint;}
     RS_Vector getMiddleOfText() {return m_dimGenericData.middleOfText;}
@@ -235,6 +238,9 @@ protected:
     RS_DimensionData m_dimGenericData;
     // dim style used during updateDim()
     LC_DimStyle* m_dimStyleTransient = nullptr;
+    // stamp of styles and variables the dimension was regenerated with, see LC_DimRegenContext
+    size_t m_regenStamp = 0;
+    bool m_regenStampValid = false;
 
     virtual void doUpdateDim() = 0;
 
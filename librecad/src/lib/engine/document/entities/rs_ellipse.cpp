@@ -246,6 +246,7 @@ RS_Entity* RS_Ellipse::clone() const {
   * @author Dongxu Li
  */
 void RS_Ellipse::calculateBorders() {
+    invalidateParentBorders();
 
 #ifndef EMU_C99
     using std::isnormal;
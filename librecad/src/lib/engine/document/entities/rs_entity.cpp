@@ -26,6 +26,7 @@
 **********************************************************************/
 
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <utility>
@@ -51,8 +52,14 @@
 #include "rs_text.h"
 #include "rs_vector.h"
 #include "lc_quadratic.h"
+#include "lc_selectionregistry.h"
 
 
+namespace {
+    // set by RS_Entity::DetachedCloneGuard
+    thread_local bool t_detachedClones = false;
+}
+
 struct RS_Entity::Impl {
     //! pen (attributes) for this entity
     RS_Pen pen{};
@@ -84,7 +91,7 @@ RS_Entity::RS_Entity(RS_EntityContainer *parent)
 // }
 
 RS_Entity::RS_Entity(const RS_Entity& other):
-                                               parent{other.parent}
+                                               parent{t_detachedClones ? nullptr : other.parent}
                                                , minV {other.minV}
                                                , maxV {other.maxV}
                                                , m_layer {other.m_layer}
@@ -133,7 +140,11 @@ RS_Entity& RS_Entity::operator = (RS_Entity&& other){
   return *this;
 }
 
-RS_Entity::~RS_Entity() = default;
+RS_Entity::~RS_Entity() {
+    if (m_selectionRegistry != nullptr) {
+        m_selectionRegistry->detach(this);
+    }
+}
 
 /**
  * Copy constructor.
@@ -170,10 +181,20 @@ void RS_Entity::init(bool setPenAndLayerToActive) {
  * Gives this entity a new unique m_id.
  */
 void RS_Entity::initId() {
-    static unsigned long long idCounter=0;
+    // atomic, since entities may be cloned by worker threads (see RS_Modification::cloneAndTransform)
+    static std::atomic<unsigned long long> idCounter{0};
     m_id = ++idCounter;
 }
 
+RS_Entity::DetachedCloneGuard::DetachedCloneGuard(bool enabled)
+    : m_previous{t_detachedClones} {
+    t_detachedClones = enabled || m_previous;
+}
+
+RS_Entity::DetachedCloneGuard::~DetachedCloneGuard() {
+    t_detachedClones = m_previous;
+}
+
 RS_Entity *RS_Entity::cloneProxy() const {
     return clone();
 }
@@ -194,11 +215,24 @@ void RS_Entity::resetBorders() {
 void RS_Entity::moveBorders(const RS_Vector& offset){
     minV.move(offset);
     maxV.move(offset);
+    invalidateParentBorders();
 }
 
 void RS_Entity::scaleBorders(const RS_Vector& center, const RS_Vector& factor){
     minV.scale(center,factor);
     maxV.scale(center,factor);
+    invalidateParentBorders();
+}
+
+/**
+ * Marks cached borders of the parent containers as outdated. Should be called by entities that change their
+ * borders in place (atomic entities do that from calculateBorders()), as parents reuse borders of their
+ * sub-containers while these are valid.
+ */
+void RS_Entity::invalidateParentBorders() {
+    if (parent != nullptr) {
+        parent->invalidateBorders();
+    }
 }
 
 /**
@@ -217,10 +251,30 @@ bool RS_Entity::setSelected(bool select) {
     } else {
         delFlag(RS2::FlagSelected);
     }
+    notifySelectionChanged(select);
 
     return true;
 }
 
+/**
+ * Keeps the selection registry of the document up to date.
+ */
+void RS_Entity::notifySelectionChanged(bool select) {
+    if (m_selectionRegistry != nullptr) {
+        m_selectionRegistry->onSelectionChanged(this, select);
+    } else if (select) {
+        // entity nested in a container of the document is selected on its own
+        for (RS_Entity* p = parent; p != nullptr; p = p->parent) {
+            if (p->m_selectionRegistry != nullptr) {
+                if (!p->getFlag(RS2::FlagSelected)) {
+                    p->m_selectionRegistry->onNestedSelection(this);
+                }
+                break;
+            }
+        }
+    }
+}
+
 /**
  * Toggles select on this entity.
  */
@@ -282,6 +336,9 @@ bool RS_Entity::isProcessed() const {
 void RS_Entity::undoStateChanged([[maybe_unused]] bool undone){
     setSelected(false);
     update();
+    if (parent != nullptr) {
+        parent->invalidateBorders();
+    }
 }
 
 /**
@@ -434,6 +491,9 @@ void RS_Entity::setVisible(bool v) {
     } else {
         delFlag(RS2::FlagVisible);
     }
+    if (parent != nullptr) {
+        parent->invalidateBorders();
+    }
 }
 
 /**
@@ -763,6 +823,8 @@ void RS_Entity::setLayer(const QString& name) {
     } else {
         m_layer = nullptr;
     }
+    // visible borders of parents depend on the layer (it may be frozen)
+    invalidateParentBorders();
 }
 
 /**
@@ -770,6 +832,7 @@ void RS_Entity::setLayer(const QString& name) {
  */
 void RS_Entity::setLayer(RS_Layer* l) {
     m_layer = l;
+    invalidateParentBorders();
 }
 
 /**
@@ -785,6 +848,7 @@ void RS_Entity::setLayerToActive() {
     } else {
         m_layer = nullptr;
     }
+    invalidateParentBorders();
 }
 
 RS_Pen RS_Entity::getPenResolved() const {
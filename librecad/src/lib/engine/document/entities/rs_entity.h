@@ -43,6 +43,7 @@ class RS_Block;
 class RS_Graphic;
 class RS_EntityContainer;
 class LC_Quadratic;
+class LC_SelectionRegistry;
 
 /**
  * Base class for an entity (line, arc, circle, ...)
@@ -67,9 +68,23 @@ public:
         this->parent = parent;
     }
 
+    /**
+     * While a guard exists, entities copied by the current thread get no parent, so cloning and transformation of
+     * the copies don't invalidate the containers of the originals. Used for clones made by worker threads, which
+     * are reparented when added to a container.
+     */
+    class DetachedCloneGuard {
+    public:
+        explicit DetachedCloneGuard(bool enabled = true);
+        ~DetachedCloneGuard();
+    private:
+        bool m_previous;
+    };
+
     void resetBorders();
     void moveBorders(const RS_Vector &offset);
     void scaleBorders(const RS_Vector &center, const RS_Vector &factor);
+    void invalidateParentBorders();
 
 
     /**
@@ -601,8 +616,14 @@ protected:
     void initId();
 
 private:
+    friend class LC_SelectionRegistry;
+    void notifySelectionChanged(bool select);
+
     //! Entity m_id
     unsigned long long m_id = 0;
+    //! Registry of selected entities of the document this entity is a direct child of,
+    //! or is nested in and selected on its own
+    LC_SelectionRegistry* m_selectionRegistry = nullptr;
     // pImp to delay pulling in Qt headers
     struct Impl;
     std::unique_ptr<Impl> m_pImpl;
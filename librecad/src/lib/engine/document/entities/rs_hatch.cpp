@@ -256,6 +256,7 @@ void RS_Hatch::update() {
     // Reset caches
     m_solidPath = std::make_shared<std::vector<QPainterPath>>();
     m_area = RS_MAXDOUBLE;
+    m_patternLength = 0.0;
 
     // Validate and optimize loops (moves boundaries to subcontainers)
     if (!validate()) {
@@ -315,8 +316,8 @@ void RS_Hatch::updatePatternHatch(RS_Layer* layer, const RS_Pen& pen) {
     // Request and clone pattern
     std::unique_ptr<RS_Pattern> pattern = RS_PATTERNLIST->requestPattern(data.pattern);
     if (!pattern) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::updatePatternHatch: Pattern '%s' not found",
-                        data.pattern.toUtf8().constData());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_ERROR, "RS_Hatch::updatePatternHatch: Pattern '%s' not found",
+                             data.pattern.toUtf8().constData());
         updateError = HATCH_PATTERN_NOT_FOUND;
         return;
     }
@@ -375,6 +376,7 @@ void RS_Hatch::updatePatternHatch(RS_Layer* layer, const RS_Pen& pen) {
                 entity->reparent(this);  // Reparent to RS_Hatch
                 entity->setFlag(RS2::FlagHatchChild);
                 entity->rotate(center, rotationVector);
+                m_patternLength += std::max(entity->getLength(), 0.0);
                 addEntity(entity);  // Transfers ownership; direct child
                 ++addedCount;
             }
@@ -419,6 +421,9 @@ void RS_Hatch::draw(RS_Painter* painter) {
 
     if (isSolid()) {
         drawSolidFill(painter);
+    } else if (isPatternNotRenderable(painter)) {
+        // pattern lines are too dense to be distinguished on the screen, so halftone fill is drawn instead
+        drawSolidFill(painter, Qt::Dense5Pattern);
     } else {
         drawPatternLines(painter);
     }
@@ -426,10 +431,21 @@ void RS_Hatch::draw(RS_Painter* painter) {
     painter->restore();
 }
 
+/**
+ * Helper: Checks whether the average spacing of pattern lines on the screen is too small for drawing them.
+ * The spacing is estimated as enclosed area divided by total length of pattern entities.
+ */
+bool RS_Hatch::isPatternNotRenderable(RS_Painter* painter) const {
+    if (m_patternLength < RS_TOLERANCE || m_area >= RS_MAXDOUBLE) {
+        return false;
+    }
+    return painter->isHatchPatternNotRenderable(m_area / m_patternLength);
+}
+
 /**
  * Helper: Draws solid fill using cached QPainterPaths.
  */
-void RS_Hatch::drawSolidFill(RS_Painter* painter) {
+void RS_Hatch::drawSolidFill(RS_Painter* painter, Qt::BrushStyle brushStyle) {
     if (!m_orderedLoops || m_orderedLoops->empty()) {
         LC_ERR << __func__ << "(): No cached paths for solid fill";
         return;
@@ -442,7 +458,7 @@ void RS_Hatch::drawSolidFill(RS_Painter* painter) {
     // Use pen color for solid fill
     QBrush fillBrush = originalBrush;
     fillBrush.setColor(originalPen.getColor());
-    fillBrush.setStyle(Qt::SolidPattern);
+    fillBrush.setStyle(brushStyle);
 
     painter->setBrush(fillBrush);
     // Transform loops into painter paths
@@ -173,12 +173,15 @@ protected:
 private:
     void debugOutPath(const QPainterPath& tmpPath) const;
     void drawPatternLines(RS_Painter* painter) const;
-    void drawSolidFill(RS_Painter* painter);
+    void drawSolidFill(RS_Painter* painter, Qt::BrushStyle brushStyle = Qt::SolidPattern);
+    bool isPatternNotRenderable(RS_Painter* painter) const;
     void updatePatternHatch(RS_Layer* layer, const RS_Pen& pen);
     void updateSolidHatch(RS_Layer* layer, const RS_Pen& pen);
     void prepareUpdate();
 
     mutable double m_area = RS_MAXDOUBLE;
+    // total length of pattern entities, used for estimation of pattern density
+    double m_patternLength = 0.0;
     RS_HatchError updateError = HATCH_UNDEFINED;
     bool updateRunning = false;
     bool m_needOptimization = true;
@@ -28,6 +28,7 @@
 #include <QDir>
 #include <QFileInfo>
 
+#include "lc_imagecache.h"
 #include "qc_applicationwindow.h"
 #include "rs_debug.h"
 #include "rs_entitycontainer.h"
@@ -110,6 +111,7 @@ RS_Image::RS_Image(RS_EntityContainer* parent,
 RS_Entity* RS_Image::clone() const {
     auto* i = new RS_Image(*this);
     i->setHandle(getHandle());
+    // the decoded image is taken from the image cache, so the file is not read again while it is in use
     i->update();
     return i;
 }
@@ -128,8 +130,7 @@ void RS_Image::update() {
     // the whole image:
     QString filePathName = imageRelativePathName(data.file);
 
-    //QImage image = QImage(data.file);
-    img = std::make_shared<QImage>(filePathName);
+    img = LC_ImageCache::instance()->acquire(filePathName);
     if (!img->isNull()) {
         data.size = RS_Vector(img->width(), img->height());
         RS_Image::calculateBorders(); // image update need this.
@@ -138,43 +139,10 @@ void RS_Image::update() {
     }
 
     RS_DEBUG->print("RS_Image::update: OK");
-
-    /*
-    // number of small images:
-    nx = image.width()/100;
-    ny = image.height()/100;
-
-    // create small images:
-    img = new QImage*[nx];
-    QPixmap pm;
-    int w,h;
-    for (int x = 0; x<nx; ++x) {
-        img[x] = new QImage[ny];
-        for (int y = 0; y<ny; ++y) {
-                if (x<nx-1) {
-                        w = 100;
-                }
-                else {
-                        w = image.width()%100;
-                }
-
-                if (y<ny-1) {
-                        h = 100;
-                }
-                else {
-                        h = image.height()%100;
-                }
-
-                pm = QPixmap(w, h);
-                RS_PainterQt painter(&pm);
-                painter.drawImage(-x*100, -y*100, image);
-                img[x][y] = pm.convertToImage();
-        }
-    }
-    */
 }
 
 void RS_Image::calculateBorders() {
+    invalidateParentBorders();
     updateRectRegion();
     RS_VectorSolutions sol = getCorners();
     minV =  RS_Vector::minimum(
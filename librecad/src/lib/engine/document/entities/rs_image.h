@@ -29,7 +29,7 @@
 #include "lc_rectregion.h"
 #include "rs_atomicentity.h"
 
-class QImage;
+class LC_CachedImage;
 
 /**
  * Holds the data that defines a line.
@@ -217,7 +217,7 @@ protected:
     bool containsPoint(const RS_Vector& coord) const;
     RS_ImageData data;
     LC_RectRegion rectRegion;
-    std::shared_ptr<QImage> img;
+    std::shared_ptr<LC_CachedImage> img;
 };
 
 #endif
@@ -28,6 +28,7 @@
 
 #include<iostream>
 
+#include "lc_trace.h"
 #include "rs_arc.h"
 #include "rs_block.h"
 #include "rs_circle.h"
@@ -37,6 +38,7 @@
 #include "rs_graphic.h"
 #include "rs_layer.h"
 #include "rs_math.h"
+#include "rs_painter.h"
 #include "rs_pen.h"
 
 class RS_Circle;
@@ -104,6 +106,14 @@ std::ostream& operator <<(std::ostream& os,
     return os;
 }
 
+RS_Insert::NestedInsertsGuard::NestedInsertsGuard():m_previous{s_nestedInsertsUpToDate} {
+    s_nestedInsertsUpToDate = true;
+}
+
+RS_Insert::NestedInsertsGuard::~NestedInsertsGuard() {
+    s_nestedInsertsUpToDate = m_previous;
+}
+
 /**
  * @param parent The graphic this m_block belongs to.
  */
@@ -129,9 +139,8 @@ RS_Entity* RS_Insert::clone() const{
  * needs to be called whenever the block this insert is based on changes.
  */
 void RS_Insert::update() {
-
-    RS_DEBUG->print("RS_Insert::update");
-    RS_DEBUG->print("RS_Insert::update: name: %s", m_data.name.toLatin1().data());
+    LC_TRACE_SCOPE("insert", "insert update");
+    LC_DEBUG_PRINT("RS_Insert::update: name: %s", m_data.name.toLatin1().data());
     //        RS_DEBUG->print("RS_Insert::update: insertionPoint: %f/%f",
     //                data.insertionPoint.x, data.insertionPoint.y);
 
@@ -172,7 +181,7 @@ void RS_Insert::update() {
                         continue;
                     }
                     if (e->rtti()==RS2::EntityInsert &&
-                            m_data.updateMode!=RS2::PreviewUpdate) {
+                            m_data.updateMode!=RS2::PreviewUpdate && !s_nestedInsertsUpToDate) {
 
 //                                        RS_DEBUG->print("RS_Insert::update: updating sub-insert");
                         e->update();
@@ -316,6 +325,16 @@ bool RS_Insert::isVisible() const{
     return RS_Entity::isVisible();
 }
 
+/**
+ * Draws the insert. Inserts that are too small on the screen are drawn with reduced level of detail.
+ */
+void RS_Insert::draw(RS_Painter* painter) {
+    if (painter->drawContainerReducedDetail(this)) {
+        return;
+    }
+    RS_EntityContainer::draw(painter);
+}
+
 RS_VectorSolutions RS_Insert::getRefPoints() const{
     return RS_VectorSolutions{m_data.insertionPoint};
 }
@@ -92,6 +92,20 @@ std::ostream& operator << (std::ostream& os, const RS_InsertData& d);
  */
 class RS_Insert : public RS_EntityContainer {
 public:
+    /**
+     * While a guard exists, inserts updated on the current thread don't update the inserts nested in
+     * their blocks. Those nested inserts are entities of the block itself, shared by every insert of
+     * the block, so updating them from several threads at once would be a data race. The caller has
+     * to update the blocks bottom-up beforehand, so the nested inserts are already up to date.
+     */
+    class NestedInsertsGuard {
+    public:
+        NestedInsertsGuard();
+        ~NestedInsertsGuard();
+    private:
+        bool m_previous = false;
+    };
+
     RS_Insert(RS_EntityContainer* parent,
               const RS_InsertData& d);
 
@@ -116,6 +130,13 @@ public:
     }
 
 	RS_Block* getBlockForInsert() const;
+    /**
+     * Sets the block, so it's not looked up in the block list. Used for letters of texts, as the font
+     * finds letters in a thread-safe way while the letter list may grow.
+     */
+    void setBlockForInsert(RS_Block* block) {
+        m_block = block;
+    }
 
     void update() override;
 
@@ -175,6 +196,7 @@ public:
     }
 
     bool isVisible() const override;
+    void draw(RS_Painter* painter) override;
 
     RS_VectorSolutions getRefPoints() const override;
     RS_Vector getMiddlePoint(void) const  override{
@@ -194,6 +216,8 @@ public:
 protected:
     RS_InsertData m_data{};
     mutable RS_Block* m_block = nullptr;
+private:
+    static inline thread_local bool s_nestedInsertsUpToDate = false;
 };
 
 
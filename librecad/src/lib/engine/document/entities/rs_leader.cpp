@@ -81,7 +81,7 @@ void RS_Leader::update() {
         return;
     }
 
-    RS_Entity* fe = firstEntity();
+    RS_Entity* fe = entityAt(0);
     if (fe && fe->isAtomic()) {
         RS_Vector p1 = static_cast<RS_AtomicEntity*>(fe)->getStartpoint();
         RS_Vector p2 = static_cast<RS_AtomicEntity*>(fe)->getEndpoint();
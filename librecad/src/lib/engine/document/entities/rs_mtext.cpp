@@ -522,11 +522,13 @@ void RS_MText::addLetter(LC_TextLine &oneLine, QChar letter,
                          RS_Font &font, const RS_Vector &letterSpace,
                          RS_Vector &letterPosition) {
     QString letterText{QString(letter)};
-    if (nullptr == font.findLetter(letterText)) {
+    RS_Block* letterBlock = font.findLetter(letterText);
+    if (nullptr == letterBlock) {
         RS_DEBUG->print("RS_MText::update: missing font for letter( %s ), replaced "
                         "it with QChar(0xfffd)",
                         qPrintable(letterText));
         letterText = QChar(0xfffd);
+        letterBlock = font.findLetter(letterText);
     }
 
     LC_LOG << "RS_MText::update: insert a letter at pos:(" << letterPosition.x
@@ -539,6 +541,7 @@ void RS_MText::addLetter(LC_TextLine &oneLine, QChar letter,
                     RS_Vector(0.0, 0.0), font.getLetterList(), RS2::NoUpdate);
 
     RS_Insert *letterEntity{new RS_Insert(this, d)};
+    letterEntity->setBlockForInsert(letterBlock);
     letterEntity->setPen(RS_Pen(RS2::FlagInvalid));
     letterEntity->setLayer(nullptr);
     letterEntity->update();
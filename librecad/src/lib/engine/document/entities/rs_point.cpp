@@ -46,6 +46,7 @@ RS2::EntityType RS_Point::rtti() const{
 }
 
 void RS_Point::calculateBorders () {
+    invalidateParentBorders();
     minV = maxV = data.pos;
 }
 
@@ -31,6 +31,8 @@
 #include <QObject>
 
 #include "lc_containertraverser.h"
+#include "lc_screenpath.h"
+#include "lc_segmentindex.h"
 #include "rs_arc.h"
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
@@ -38,6 +40,7 @@
 #include "rs_dialogfactoryinterface.h"
 #include "rs_ellipse.h"
 #include "rs_information.h"
+#include "rs_layer.h"
 #include "rs_line.h"
 #include "rs_math.h"
 #include "rs_painter.h"
@@ -83,6 +86,15 @@ RS_Entity* RS_Polyline::clone() const {
     auto* p = new RS_Polyline(*this);
     p->setOwner(isOwner());
     p->detach();
+    // segments of the clone are the same, so the index is shared while it is up to date
+    auto entry = std::atomic_load(&m_segmentIndex);
+    if (entry != nullptr && entry->revision == getRevision()) {
+        p->m_segmentIndex = std::make_shared<const SegmentIndexEntry>(
+            SegmentIndexEntry{p->getRevision(), entry->index});
+    }
+    else {
+        p->m_segmentIndex.reset();
+    }
     return p;
 }
 
@@ -359,7 +371,7 @@ void RS_Polyline::setClosed(bool cl) {
 void RS_Polyline::updateEndpoints() {
     using namespace lc;
     LC_ContainerTraverser traverser{*this, RS2::ResolveNone};
-    RS_Entity* e1 = firstEntity();
+    RS_Entity* e1 = traverser.first();
     if (e1 != nullptr && e1->isAtomic()) {
         RS_Vector const& v = e1->getStartpoint();
         setStartpoint(v);
@@ -587,6 +599,80 @@ bool RS_Polyline::offset(const RS_Vector& coord, const double& distance){
     return true;
 }
 
+void RS_Polyline::calculateBorders() {
+    std::atomic_store(&m_segmentIndex, std::shared_ptr<const SegmentIndexEntry>());
+    std::atomic_store(&m_screenPath, std::shared_ptr<const LC_ScreenPath>());
+    RS_EntityContainer::calculateBorders();
+}
+
+std::shared_ptr<const LC_SegmentIndex> RS_Polyline::getSegmentIndex() const {
+    size_t segmentsCount = count();
+    if (segmentsCount < LC_SegmentIndex::MIN_SEGMENTS) {
+        return nullptr;
+    }
+    std::uint64_t revision = getRevision();
+    auto entry = std::atomic_load(&m_segmentIndex);
+    if (entry != nullptr && entry->revision == revision && entry->index->size() == segmentsCount) {
+        return entry->index;
+    }
+    std::vector<LC_SegmentIndex::Box> boxes;
+    boxes.reserve(segmentsCount);
+    for (const RS_Entity* e: *this) {
+        boxes.push_back({e->getMin(), e->getMax()});
+    }
+    auto index = std::make_shared<const LC_SegmentIndex>(std::move(boxes));
+    std::atomic_store(&m_segmentIndex, std::make_shared<const SegmentIndexEntry>(SegmentIndexEntry{revision, index}));
+    return index;
+}
+
+double RS_Polyline::getDistanceToPoint(const RS_Vector& coord, RS_Entity** entity,
+                                       RS2::ResolveLevel level, double solidDist) const {
+    auto index = getSegmentIndex();
+    if (index == nullptr) {
+        return RS_EntityContainer::getDistanceToPoint(coord, entity, level, solidDist);
+    }
+
+    auto isSelectable = [](const RS_Entity* e) {
+        auto entityLayer = e->getLayer();
+        return e->isVisible() && (entityLayer == nullptr || !entityLayer->isLocked());
+    };
+
+    // same as for the container, the last one of equally distant segments is preferred
+    double minDist = RS_MAXDOUBLE;
+    int nearest = index->findNearest(coord, [this, &coord, &isSelectable, level, solidDist](size_t i) {
+        const RS_Entity* e = unsafeEntityAt(static_cast<int>(i));
+        if (!isSelectable(e)) {
+            return RS_MAXDOUBLE;
+        }
+        return e->getDistanceToPoint(coord, nullptr, level, solidDist);
+    }, true, &minDist);
+
+    RS_Entity* closestEntity = nullptr;
+    if (nearest >= 0 && isSelectable(unsafeEntityAt(nearest))) {
+        // segments are atomic, so the segment itself is the closest entity for any resolve level
+        closestEntity = unsafeEntityAt(nearest);
+    }
+    else {
+        minDist = RS_MAXDOUBLE;
+    }
+    if (entity != nullptr) {
+        *entity = closestEntity;
+    }
+    return minDist;
+}
+
+std::vector<RS_Entity*> RS_Polyline::getSegmentsInBox(const RS_Vector& corner1, const RS_Vector& corner2) const {
+    auto index = getSegmentIndex();
+    if (index == nullptr) {
+        return {begin(), end()};
+    }
+    std::vector<RS_Entity*> result;
+    for (size_t i: index->findInBox(corner1, corner2)) {
+        result.push_back(unsafeEntityAt(static_cast<int>(i)));
+    }
+    return result;
+}
+
 void RS_Polyline::move(const RS_Vector& offset) {
     RS_EntityContainer::move(offset);
     data.startpoint.move(offset);
@@ -659,6 +745,9 @@ void RS_Polyline::revertDirection() {
     RS_Vector tmp = data.startpoint;
     data.startpoint = data.endpoint;
     data.endpoint = tmp;
+    // order of segments is reverted, so positions in the index are not valid anymore
+    std::atomic_store(&m_segmentIndex, std::shared_ptr<const SegmentIndexEntry>());
+    std::atomic_store(&m_screenPath, std::shared_ptr<const LC_ScreenPath>());
 }
 
 void RS_Polyline::stretch(const RS_Vector& firstCorner, const RS_Vector& secondCorner, const RS_Vector& offset) {
@@ -687,6 +776,14 @@ void RS_Polyline::drawAsChild(RS_Painter *painter) {
     painter->drawEntityPolyline(this);
 }
 
+std::shared_ptr<const LC_ScreenPath> RS_Polyline::getScreenPath() const {
+    return std::atomic_load(&m_screenPath);
+}
+
+void RS_Polyline::setScreenPath(std::shared_ptr<const LC_ScreenPath> screenPath) const {
+    std::atomic_store(&m_screenPath, std::move(screenPath));
+}
+
 RS_Ellipse* RS_Polyline::convertToEllipse(const std::pair<RS_Arc*, double>& arcPair) {
     RS_Arc* arc = arcPair.first;
     double scaleRatio = arcPair.second;
@@ -28,10 +28,13 @@
 #pragma once
 #ifndef RS_Polyline_INCLUDE_H
 
+#include <memory>
 #include <utility>
 
 #include "rs_entitycontainer.h"
 
+class LC_SegmentIndex;
+struct LC_ScreenPath;
 class RS_Arc;
 class RS_Ellipse;
 
@@ -121,6 +124,16 @@ public:
 
 //void reorder() override;
 
+    void calculateBorders() override;
+    double getDistanceToPoint(const RS_Vector &coord, RS_Entity **entity = nullptr,
+                              RS2::ResolveLevel level = RS2::ResolveNone,
+                              double solidDist = RS_MAXDOUBLE) const override;
+    /**
+     * @return segments which bounding boxes intersect the given box, in the order of the polyline.
+     * All segments are returned for short polylines.
+     */
+    std::vector<RS_Entity*> getSegmentsInBox(const RS_Vector &corner1, const RS_Vector &corner2) const;
+
     bool offset(const RS_Vector &coord, const double &distance) override;
     void move(const RS_Vector &offset) override;
     void rotate(const RS_Vector &center, double angle) override;
@@ -141,6 +154,11 @@ public:
     bool containsArc() const;
     void draw(RS_Painter *painter) override;
     void drawAsChild(RS_Painter *painter) override;
+    /**
+     * @return screen path cached by the painter during the last drawing, or nullptr
+     */
+    std::shared_ptr<const LC_ScreenPath> getScreenPath() const;
+    void setScreenPath(std::shared_ptr<const LC_ScreenPath> screenPath) const;
     friend std::ostream &operator<<(std::ostream &os, const RS_Polyline &l);
     RS_Vector getRefPointAdjacentDirection(bool previousSegment, RS_Vector& refPoint);
     static RS_Ellipse* convertToEllipse(const std::pair<RS_Arc*, double>& arcPair);
@@ -164,10 +182,26 @@ private:
      * @note Relies on static convertToEllipse() for per-arc conversion.
      */
     void convertArcsToElliptic(const RS_Vector &factor);
+    /**
+     * @return index of segments, built on first use; nullptr if polyline has too few segments
+     */
+    std::shared_ptr<const LC_SegmentIndex> getSegmentIndex() const;
 
     RS_PolylineData data;
     RS_Entity *m_closingEntity = nullptr;
     double m_nextBulge = 0.;
+    /**
+     * Segment index together with the revision of the polyline it was built for. Any change of segments,
+     * also done directly on a segment, changes the revision, so an outdated index is never used.
+     */
+    struct SegmentIndexEntry {
+        std::uint64_t revision = 0;
+        std::shared_ptr<const LC_SegmentIndex> index;
+    };
+    /** shared between clones until geometry of either one is changed */
+    mutable std::shared_ptr<const SegmentIndexEntry> m_segmentIndex;
+    /** invalidated together with the segment index, as it depends on geometry of segments */
+    mutable std::shared_ptr<const LC_ScreenPath> m_screenPath;
 };
 
 #endif // RS_Polyline_INCLUDE_H
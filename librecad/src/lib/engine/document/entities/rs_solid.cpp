@@ -175,6 +175,7 @@ void RS_Solid::shapeArrow(const RS_Vector& point,double angle, double arrowSize)
 }
 
 void RS_Solid::calculateBorders(){
+    invalidateParentBorders();
     resetBorders();
 
     for (int i = RS_SolidData::FirstCorner; i < RS_SolidData::MaxCorners; ++i) {
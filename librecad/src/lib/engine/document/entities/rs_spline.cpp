@@ -162,6 +162,8 @@ void RS_Spline::updateKnotWrapping() {
 
 /** Borders */
 void RS_Spline::calculateBorders() {
+  // control points are edited in place, so the borders cached by the spline and its parents are outdated
+  invalidateBorders();
   resetBorders();
   size_t s = getUnwrappedSize();
   if (!s)
@@ -111,6 +111,8 @@ void LC_DimArrow::positionDimLinePointFromZero(const RS_Vector &angleVector) {
 }
 
 void LC_DimArrow::calculateBorders() {
+    // arrows are edited in place by move, rotate, scale and mirror, which end with this call
+    invalidateParentBorders();
     resetBorders();
     minV = RS_Vector::minimum(minV, m_position);
     maxV = RS_Vector::maximum(maxV, m_position);
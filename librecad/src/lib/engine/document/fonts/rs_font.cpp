@@ -103,6 +103,7 @@ RS_Font::RS_Font(const QString& fileName, bool owner)
 bool RS_Font::loadFont() {
     RS_DEBUG->print("RS_Font::loadFont");
 
+    std::lock_guard<std::recursive_mutex> lock(m_loadMutex);
     if (loaded) {
         return true;
     }
@@ -498,6 +499,7 @@ RS_Block* RS_Font::generateLffFont(const QString& key)
 }
 
 RS_Block* RS_Font::findLetter(const QString& name) {
+    std::lock_guard<std::recursive_mutex> lock(m_loadMutex);
     RS_Block* ret= letterList.find(name);
     return (ret != nullptr) ? ret : generateLffFont(name);
 
@@ -28,6 +28,8 @@
 #ifndef RS_FONT_H
 #define RS_FONT_H
 
+#include <mutex>
+
 #include <QMap>
 #include <QStringList>
 
@@ -144,6 +146,9 @@ private:
     //! Is this font currently loaded into memory?
     bool loaded = false;
 
+    //! Guards lazy loading of the font and its letters, documents may be loaded on worker threads
+    std::recursive_mutex m_loadMutex;
+
     //! Default letter spacing for this font
     double letterSpacing = 0.;
 
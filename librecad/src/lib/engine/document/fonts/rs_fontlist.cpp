@@ -58,7 +58,7 @@ void RS_FontList::init() {
     QHash<QString, int> added; //used to remember added fonts (avoid duplication)
 
     for (int i = 0; i < list.size(); ++i) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "font: %s:", list.at(i).toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_ERROR, "font: %s:", list.at(i).toLatin1().data());
 
         QFileInfo fi( list.at(i) );
         if ( !added.contains(fi.baseName()) ) {
@@ -66,8 +66,9 @@ void RS_FontList::init() {
             added.insert(fi.baseName(), 1);
         }
 
-        RS_DEBUG->print(RS_Debug::D_ERROR, "base: %s", fi.baseName().toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_ERROR, "base: %s", fi.baseName().toLatin1().data());
     }
+    m_revision++;
 }
 
 size_t RS_FontList::countFonts() const{
@@ -89,6 +90,7 @@ std::vector<std::unique_ptr<RS_Font> >::const_iterator RS_FontList::end() const
  */
 void RS_FontList::clearFonts() {
     m_fonts.clear();
+    m_revision++;
 }
 
 /**
@@ -97,7 +99,7 @@ void RS_FontList::clearFonts() {
  * memory if it's not already.
  */
 RS_Font* RS_FontList::requestFont(const QString& name) {
-    RS_DEBUG->print("RS_FontList::requestFont %s",  name.toLatin1().data());
+    LC_DEBUG_PRINT("RS_FontList::requestFont %s",  name.toLatin1().data());
 
     QString name2 = name.toLower();
     RS_Font* foundFont = nullptr;
@@ -111,7 +113,7 @@ RS_Font* RS_FontList::requestFont(const QString& name) {
         name2 = name2.left(name2.indexOf('#'));
     }
 
-    RS_DEBUG->print("name2: %s", name2.toLatin1().data());
+    LC_DEBUG_PRINT("name2: %s", name2.toLatin1().data());
 
 	// Search our list of available fonts:
     for( auto const& f: m_fonts){
@@ -54,6 +54,10 @@ public:
     void clearFonts();
     size_t countFonts() const;
     RS_Font* requestFont(const QString& name);
+    /**
+     * @return revision of the list, changed whenever fonts are added or removed
+     */
+    unsigned getRevision() const {return m_revision;}
     std::vector<std::unique_ptr<RS_Font> >::const_iterator begin() const;
     std::vector<std::unique_ptr<RS_Font> >::const_iterator end() const;
     static QString getDefaultFont();
@@ -67,6 +71,7 @@ private:
     static RS_FontList* uniqueInstance;
     //! m_fonts in the graphic
     std::vector<std::unique_ptr<RS_Font>> m_fonts;
+    unsigned m_revision = 0;
 };
 
 #endif
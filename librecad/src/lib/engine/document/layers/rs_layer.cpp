@@ -23,6 +23,11 @@
 #include <iostream>
 #include "rs_layer.h"
 
+namespace {
+	// read by layer lists, which may be searched from worker threads
+	std::atomic<unsigned> g_nameRevision{0};
+}
+
 RS_LayerData::RS_LayerData(const QString& name,
 						   const RS_Pen& pen,
 						   bool frozen,
@@ -49,7 +54,14 @@ RS_Layer* RS_Layer::clone() const{
 
 /** sets a new name for this layer. */
 void RS_Layer::setName(const QString& name) {
-	data.name = name;
+	if (data.name != name) {
+		data.name = name;
+		g_nameRevision++;
+	}
+}
+
+unsigned RS_Layer::getNameRevision() {
+	return g_nameRevision;
 }
 
 /** @return the name of this layer. */
@@ -98,6 +110,9 @@ void RS_Layer::setConverted(bool c) {
 void RS_Layer::toggle() {
 	//toggleFlag(RS2::FlagFrozen);
 	data.frozen = !data.frozen;
+	if (m_freezeRevision != nullptr) {
+		m_freezeRevision->fetch_add(1, std::memory_order_acq_rel);
+	}
 }
 
 /**
@@ -106,7 +121,16 @@ void RS_Layer::toggle() {
  * @param freeze true: freeze, false: defreeze
  */
 void RS_Layer::freeze(bool freeze) {
-	data.frozen = freeze;
+	if (data.frozen != freeze) {
+		data.frozen = freeze;
+		if (m_freezeRevision != nullptr) {
+			m_freezeRevision->fetch_add(1, std::memory_order_acq_rel);
+		}
+	}
+}
+
+void RS_Layer::setFreezeRevision(std::shared_ptr<std::atomic<unsigned>> revision) {
+	m_freezeRevision = std::move(revision);
 }
 
 /**
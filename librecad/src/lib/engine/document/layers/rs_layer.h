@@ -33,7 +33,9 @@
 #include <sys/_size_t.h>
 #endif
 
+#include <atomic>
 #include <iosfwd>
+#include <memory>
 
 #include "rs_pen.h"
 
@@ -78,6 +80,11 @@ public:
 
     /** sets a new name for this layer. */
 	void setName(const QString& name);
+	/**
+	 * @return counter incremented on each rename of any layer, used by layer lists to
+	 * detect that name index is outdated
+	 */
+	static unsigned getNameRevision();
 
     /** @return the name of this layer. */
 	QString getName() const;
@@ -118,6 +125,12 @@ public:
      */
 	void freeze(bool freeze);
 
+    /**
+     * Sets the revision of frozen state of the document, which is changed when this layer is frozen or
+     * thawed. It's shared by all layers of the layer list the layer is added to.
+     */
+    void setFreezeRevision(std::shared_ptr<std::atomic<unsigned>> revision);
+
     /**
      * Toggles the lock of this layer.
      */
@@ -200,6 +213,8 @@ public:
 private:
     //! Layer data
     RS_LayerData data;
+    //! Revision of frozen state of layers of the document, may be null for layers not added to a list
+    std::shared_ptr<std::atomic<unsigned>> m_freezeRevision;
 
 };
 
@@ -26,6 +26,7 @@
 **********************************************************************/
 
 #include<iostream>
+#include <mutex>
 
 #include "rs_debug.h"
 #include "rs_layerlist.h"
@@ -45,6 +46,10 @@ RS_LayerList::RS_LayerList() {
  */
 void RS_LayerList::clear() {
     m_layers.clear();
+    {
+        std::unique_lock<std::shared_mutex> lock(m_nameIndexMutex);
+        rebuildNameIndex();
+    }
     setModified(true);
 }
 
@@ -70,11 +75,11 @@ QList<RS_Layer*>::const_iterator RS_LayerList::end() const {
  * @param notify Notify listeners.
  */
 void RS_LayerList::activate(const QString& name, bool notify) {
-    RS_DEBUG->print("RS_LayerList::activate: %s, notify: %d begin",
-                    name.toLatin1().data(), notify);
+    LC_DEBUG_PRINT("RS_LayerList::activate: %s, notify: %d begin",
+                   name.toLatin1().data(), notify);
 
     activate(find(name), notify);
-    RS_DEBUG->print("RS_LayerList::activate: %s end", name.toLatin1().data());
+    LC_DEBUG_PRINT("RS_LayerList::activate: %s end", name.toLatin1().data());
 }
 
 /**
@@ -128,6 +133,11 @@ void RS_LayerList::add(RS_Layer* layerToAdd) {
     RS_Layer* existingLayer = find(layerToAdd->getName());
     if (existingLayer == nullptr) {
         m_layers.append(layerToAdd);
+        layerToAdd->setFreezeRevision(m_freezeRevision);
+        {
+            std::unique_lock<std::shared_mutex> lock(m_nameIndexMutex);
+            m_layersByName.insert(layerToAdd->getName(), layerToAdd);
+        }
         this->sort();
         // notify listeners
         fireLayerAdded(layerToAdd);
@@ -177,6 +187,14 @@ void RS_LayerList::remove(RS_Layer* layerToRemove) {
 
     // here the layer is removed from the list but not deleted
     m_layers.removeOne(layerToRemove);
+    if (layerToRemove->isFrozen()) {
+        increaseFreezeRevision();
+    }
+    {
+        // another layer with the same name may exist after direct rename, so the index is rebuilt
+        std::unique_lock<std::shared_mutex> lock(m_nameIndexMutex);
+        rebuildNameIndex();
+    }
 
     fireLayerRemoved(layerToRemove);
 
@@ -201,6 +219,10 @@ void RS_LayerList::edit(RS_Layer* layer, const RS_Layer& source) {
         return;
     }
     *layer = source;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_nameIndexMutex);
+        rebuildNameIndex();
+    }
     fireEdit(layer);
 }
 
@@ -216,14 +238,33 @@ void RS_LayerList::fireEdit(RS_Layer* layer) {
  * \p nullptr if no such layer was found.
  */
 RS_Layer* RS_LayerList::find(const QString& name) {
-    RS_Layer* ret = nullptr;
+    // the index is searched under the shared lock. If some layer was renamed since the index
+    // was built, the index is rebuilt under the exclusive lock first.
+    {
+        std::shared_lock<std::shared_mutex> lock(m_nameIndexMutex);
+        if (m_nameIndexRevision == RS_Layer::getNameRevision()) {
+            return m_layersByName.value(name, nullptr);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(m_nameIndexMutex);
+    rebuildNameIndex();
+    return m_layersByName.value(name, nullptr);
+}
+
+/**
+ * Rebuilds the name index, the caller holds the exclusive lock.
+ * For duplicated names the first layer in the list wins, as with linear search.
+ */
+void RS_LayerList::rebuildNameIndex() {
+    m_nameIndexRevision = RS_Layer::getNameRevision();
+    m_layersByName.clear();
+    m_layersByName.reserve(m_layers.size());
     for (auto l : m_layers) {
-        if (l->getName() == name) {
-            ret = l;
-            break;
+        const QString& layerName = l->getName();
+        if (!m_layersByName.contains(layerName)) {
+            m_layersByName.insert(layerName, l);
         }
     }
-    return ret;
 }
 
 /**
@@ -231,16 +272,8 @@ RS_Layer* RS_LayerList::find(const QString& name) {
  * was not found.
  */
 int RS_LayerList::getIndex(const QString& name) {
-    int ret = 0;
-    for (auto l : m_layers) {
-        if (l->getName() == name) {
-            return ret;
-        }
-        else {
-            ret++;
-        }
-    }
-    return -1;
+    RS_Layer* layer = find(name);
+    return layer == nullptr ? -1 : m_layers.indexOf(layer);
 }
 
 /**
@@ -354,6 +387,14 @@ void RS_LayerList::freezeAll(bool freeze) {
     fireLayerToggled();
 }
 
+unsigned RS_LayerList::getFreezeRevision() const {
+    return m_freezeRevision->load(std::memory_order_acquire);
+}
+
+void RS_LayerList::increaseFreezeRevision() {
+    m_freezeRevision->fetch_add(1, std::memory_order_acq_rel);
+}
+
 void RS_LayerList::fireLayerActivated() {
     for (auto l : m_layerListListeners) {
         l->layerActivated(m_activeLayer);
@@ -29,7 +29,13 @@
 #ifndef RS_LAYERLIST_H
 #define RS_LAYERLIST_H
 
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+
+#include <QHash>
 #include <QList>
+#include <QString>
 
 class RS_Layer;
 class RS_LayerListListener;
@@ -85,6 +91,13 @@ public:
     void toggleConstruction(RS_Layer* layer);
     void freezeAll(bool freeze);
     void lockAll(bool lock);
+    /**
+     * @return revision of frozen state of layers and blocks of the document. It is changed each time when
+     * a layer of the list or a block of the document is frozen or thawed, so caches that depend on
+     * visibility of entities may detect that they are outdated.
+     */
+    unsigned getFreezeRevision() const;
+    void increaseFreezeRevision();
 
     void toggleLockMulti(QList<RS_Layer*> layers);
     void togglePrintMulti(QList<RS_Layer*> layers);
@@ -125,8 +138,20 @@ private:
     //! List of registered LayerListListeners
     QList<RS_LayerListListener*> m_layerListListeners;
     RS_Layer *m_activeLayer = nullptr;
+    //! shared with the layers of the list, which change it when frozen or thawed
+    std::shared_ptr<std::atomic<unsigned>> m_freezeRevision = std::make_shared<std::atomic<unsigned>>(0);
     /** Flag set if the layer list was modified and not yet saved. */
     bool m_modified = false;
+    /**
+     * Hashed index of layers by name. The index is rebuilt as the list changes. As layers may be
+     * renamed directly, lookups also compare the rename revision the index was built for and
+     * catch up under the exclusive lock, so that lookups from worker threads are safe.
+     */
+    QHash<QString, RS_Layer*> m_layersByName;
+    unsigned m_nameIndexRevision = 0;
+    std::shared_mutex m_nameIndexMutex;
+
+    void rebuildNameIndex();
 };
 
 #endif
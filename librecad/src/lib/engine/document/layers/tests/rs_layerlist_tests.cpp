@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2025 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rs_layer.h"
+#include "rs_layerlist.h"
+
+namespace {
+/**
+ * Layer list of the test, layers left in the list are deleted with it
+ */
+struct TestLayerList : RS_LayerList {
+    ~TestLayerList() override {
+        QList<RS_Layer*> layers;
+        for (RS_Layer* layer : *this) {
+            layers.append(layer);
+        }
+        clear();
+        qDeleteAll(layers);
+    }
+};
+}
+
+TEST_CASE("RS_LayerList finds layers by name through the index", "[RS_LayerList]") {
+    TestLayerList list;
+    const int count = 1000;
+    for (int i = 0; i < count; i++) {
+        list.add(new RS_Layer(QString("layer%1").arg(i)));
+    }
+    REQUIRE(list.count() == static_cast<unsigned>(count));
+
+    for (int i = 0; i < count; i++) {
+        const QString name = QString("layer%1").arg(i);
+        RS_Layer* layer = list.find(name);
+        REQUIRE(layer != nullptr);
+        REQUIRE(layer->getName() == name);
+    }
+    REQUIRE(list.find("missing") == nullptr);
+    // names are compared as they are
+    REQUIRE(list.find("LAYER1") == nullptr);
+
+    // a layer with an existing name is not added twice
+    list.add(new RS_Layer("layer1"));
+    REQUIRE(list.count() == static_cast<unsigned>(count));
+}
+
+TEST_CASE("RS_LayerList finds renamed layers", "[RS_LayerList]") {
+    TestLayerList list;
+    auto* walls = new RS_Layer("walls");
+    auto* doors = new RS_Layer("doors");
+    list.add(walls);
+    list.add(doors);
+    REQUIRE(list.find("walls") == walls);
+
+    SECTION("direct rename") {
+        walls->setName("outline");
+        REQUIRE(list.find("walls") == nullptr);
+        REQUIRE(list.find("outline") == walls);
+        REQUIRE(list.find("doors") == doors);
+    }
+
+    SECTION("rename by edit") {
+        RS_Layer source = *doors;
+        source.setName("windows");
+        list.edit(doors, source);
+        REQUIRE(list.find("doors") == nullptr);
+        REQUIRE(list.find("windows") == doors);
+        REQUIRE(list.find("walls") == walls);
+    }
+}
+
+TEST_CASE("RS_LayerList doesn't find removed layers", "[RS_LayerList]") {
+    TestLayerList list;
+    auto* zero = new RS_Layer("0");
+    auto* walls = new RS_Layer("walls");
+    auto* doors = new RS_Layer("doors");
+    list.add(zero);
+    list.add(walls);
+    list.add(doors);
+
+    list.remove(walls);
+    REQUIRE(list.find("walls") == nullptr);
+    REQUIRE(list.find("doors") == doors);
+    REQUIRE(list.find("0") == zero);
+
+    // after a direct rename two layers share the name, the remaining one is found after removal
+    doors->setName("0");
+    list.remove(zero);
+    REQUIRE(list.find("0") == doors);
+}
+
+TEST_CASE("RS_LayerList lookups from several threads", "[RS_LayerList]") {
+    TestLayerList list;
+    const int count = 100;
+    for (int i = 0; i < count; i++) {
+        list.add(new RS_Layer(QString("layer%1").arg(i)));
+    }
+    // the index has to catch up with the rename in one of the workers
+    list.find("layer0")->setName("renamed");
+
+    std::vector<int> found(4, 0);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < found.size(); t++) {
+        workers.emplace_back([&list, &found, t, count]() {
+            for (int i = 1; i < count; i++) {
+                if (list.find(QString("layer%1").arg(i)) != nullptr) {
+                    found[t]++;
+                }
+            }
+            if (list.find("renamed") != nullptr) {
+                found[t]++;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (int f : found) {
+        REQUIRE(f == count);
+    }
+}
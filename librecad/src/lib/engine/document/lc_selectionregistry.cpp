@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include "lc_selectionregistry.h"
+
+#include "rs_entity.h"
+#include "rs_entitycontainer.h"
+
+LC_SelectionRegistry& LC_SelectionRegistry::operator = (const LC_SelectionRegistry& other) {
+    if (this != &other) {
+        m_selected.clear();
+        m_exact = false;
+    }
+    return *this;
+}
+
+bool LC_SelectionRegistry::isOwnerThread() const {
+    QCoreApplication* application = QCoreApplication::instance();
+    return application == nullptr || QThread::currentThread() == application->thread();
+}
+
+void LC_SelectionRegistry::markStale() {
+    m_stale = true;
+}
+
+/**
+ * Starts tracking of the entity added to the document.
+ */
+void LC_SelectionRegistry::attach(RS_Entity* entity) {
+    if (entity == nullptr) {
+        return;
+    }
+    if (entity->m_selectionRegistry != nullptr && entity->m_selectionRegistry != this) {
+        // the entity is shared with another document, its selection is reported there
+        m_exact = false;
+        return;
+    }
+    if (!isOwnerThread()) {
+        entity->m_selectionRegistry = this;
+        markStale();
+        return;
+    }
+    if (entity->m_selectionRegistry == this && m_nested.erase(entity) == 0) {
+        return;
+    }
+    // a nested entity may be moved to the document itself
+    entity->m_selectionRegistry = this;
+    if (entity->getFlag(RS2::FlagSelected)) {
+        m_selected.insert(entity);
+    }
+}
+
+/**
+ * Stops tracking of the entity removed from the document or deleted.
+ */
+void LC_SelectionRegistry::detach(RS_Entity* entity) {
+    if (entity == nullptr || entity->m_selectionRegistry != this) {
+        return;
+    }
+    entity->m_selectionRegistry = nullptr;
+    if (isOwnerThread()) {
+        m_selected.erase(entity);
+        m_nested.erase(entity);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingDetach.push_back(entity);
+    }
+    markStale();
+}
+
+void LC_SelectionRegistry::onSelectionChanged(RS_Entity* entity, bool selected) {
+    if (!isOwnerThread()) {
+        markStale();
+        return;
+    }
+    if (m_nested.count(entity) > 0) {
+        if (!selected) {
+            m_nested.erase(entity);
+            entity->m_selectionRegistry = nullptr;
+        }
+    } else if (selected) {
+        m_selected.insert(entity);
+    } else {
+        m_selected.erase(entity);
+    }
+}
+
+/**
+ * Called as an entity nested in an unselected container of the document gets selected.
+ */
+void LC_SelectionRegistry::onNestedSelection(RS_Entity* entity) {
+    if (!isOwnerThread()) {
+        markStale();
+        return;
+    }
+    entity->m_selectionRegistry = this;
+    m_nested.insert(entity);
+}
+
+/**
+ * Called as all entities are detached from the document.
+ */
+void LC_SelectionRegistry::reset() {
+    release();
+    m_selected.clear();
+    m_exact = true;
+    m_stale = false;
+}
+
+void LC_SelectionRegistry::release() {
+    applyPendingDetach();
+    for (RS_Entity* e: m_nested) {
+        e->m_selectionRegistry = nullptr;
+    }
+    m_nested.clear();
+}
+
+void LC_SelectionRegistry::applyPendingDetach() {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    for (RS_Entity* e: m_pendingDetach) {
+        m_selected.erase(e);
+        m_nested.erase(e);
+    }
+    m_pendingDetach.clear();
+}
+
+void LC_SelectionRegistry::sync(const RS_EntityContainer& document) {
+    if (!m_stale || !isOwnerThread()) {
+        return;
+    }
+    m_stale = false;
+    release();
+    m_selected.clear();
+    for (RS_Entity* e: document) {
+        if (e->m_selectionRegistry == nullptr) {
+            e->m_selectionRegistry = this;
+        }
+        if (e->m_selectionRegistry != this) {
+            continue;
+        }
+        if (e->getFlag(RS2::FlagSelected)) {
+            m_selected.insert(e);
+        } else if (e->isContainer()) {
+            collectNested(*static_cast<RS_EntityContainer*>(e));
+        }
+    }
+}
+
+void LC_SelectionRegistry::collectNested(const RS_EntityContainer& container) {
+    for (RS_Entity* e: container) {
+        if (e->m_selectionRegistry != nullptr) {
+            continue;
+        }
+        if (e->getFlag(RS2::FlagSelected)) {
+            // children of a selected container are covered by it
+            e->m_selectionRegistry = this;
+            m_nested.insert(e);
+        } else if (e->isContainer()) {
+            collectNested(*static_cast<RS_EntityContainer*>(e));
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_SELECTIONREGISTRY_H
+#define LC_SELECTIONREGISTRY_H
+
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Set of selected entities of a document, kept up to date as entities are
+ * selected, deselected, added to or removed from the document.
+ *
+ * Direct children of the document are tracked, each of them keeps a pointer
+ * to the registry of the document it belongs to. Entities that are selected,
+ * but currently not visible (undone or on frozen layer) stay in the registry,
+ * so queries must check RS_Entity::isSelected().
+ *
+ * An entity nested in an unselected container that gets selected on its own is
+ * tracked as nested selection until it is deselected or deleted. The registry is
+ * not exact while there are nested selections, or if an entity is added to the
+ * document while tracked by another registry; the document falls back to full
+ * traversal then.
+ *
+ * The registry is changed on the GUI thread only. Changes reported from other
+ * threads mark the registry stale, and the document rebuilds it by sync() on the
+ * GUI thread before it's queried.
+ */
+class LC_SelectionRegistry {
+public:
+    LC_SelectionRegistry() = default;
+    ~LC_SelectionRegistry() = default;
+    // entities of a copied document are not attached to the copy, so its registry can't be exact
+    LC_SelectionRegistry(const LC_SelectionRegistry&): m_exact{false} {}
+    LC_SelectionRegistry& operator = (const LC_SelectionRegistry&);
+
+    void attach(RS_Entity* entity);
+    void detach(RS_Entity* entity);
+    void onSelectionChanged(RS_Entity* entity, bool selected);
+    void onNestedSelection(RS_Entity* entity);
+    void reset();
+    /**
+     * Releases nested entities, called as the document is deleted.
+     */
+    void release();
+    /**
+     * Rebuilds the registry from the document if changes were reported from other threads.
+     */
+    void sync(const RS_EntityContainer& document);
+
+    bool isExact() const {return m_exact && m_nested.empty() && !m_stale;}
+    bool isEmpty() const {return m_selected.empty();}
+    const std::unordered_set<RS_Entity*>& getSelected() const {return m_selected;}
+private:
+    bool isOwnerThread() const;
+    void markStale();
+    void applyPendingDetach();
+    void collectNested(const RS_EntityContainer& container);
+
+    std::unordered_set<RS_Entity*> m_selected;
+    //! entities selected on their own in unselected containers
+    std::unordered_set<RS_Entity*> m_nested;
+    bool m_exact = true;
+    std::atomic<bool> m_stale{false};
+    //! entities detached on other threads, only compared as they may be deleted already
+    std::vector<RS_Entity*> m_pendingDetach;
+    std::mutex m_pendingMutex;
+};
+
+#endif // LC_SELECTIONREGISTRY_H
@@ -85,12 +85,12 @@ bool RS_Pattern::loadPattern() {
         foreach (const QString& path0, RS_SYSTEM->getPatternList()) {
             if (QFileInfo(path0).baseName().toLower()==fileName.toLower()) {
                 path = path0;
-                RS_DEBUG->print("Pattern found: %s", path.toLatin1().data());
+                LC_DEBUG_PRINT("Pattern found: %s", path.toLatin1().data());
                 break;
             }
         }
         if (path.isEmpty()) {
-                RS_DEBUG->print("Pattern not found: %s", fileName.toLatin1().data());
+                LC_DEBUG_PRINT("Pattern not found: %s", fileName.toLatin1().data());
         }
     }
 
@@ -101,7 +101,7 @@ bool RS_Pattern::loadPattern() {
 
     // No pattern paths found:
     if (path.isEmpty()) {
-        RS_DEBUG->print("No pattern \"%s\"available.", fileName.toLatin1().data());
+        LC_DEBUG_PRINT("No pattern \"%s\"available.", fileName.toLatin1().data());
         return false;
     }
 
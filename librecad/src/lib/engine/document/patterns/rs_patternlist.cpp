@@ -55,12 +55,12 @@ void RS_PatternList::init() {
 	patterns.clear();
 
     foreach(auto const& s, list) {
-        RS_DEBUG->print("pattern: %s:", s.toLatin1().data());
+        LC_DEBUG_PRINT("pattern: %s:", s.toLatin1().data());
 
         QString const name = QFileInfo(s).baseName().toLower();
         patterns.emplace(name, std::unique_ptr<RS_Pattern>{});
 
-        RS_DEBUG->print("base: %s", name.toLatin1().data());
+        LC_DEBUG_PRINT("base: %s", name.toLatin1().data());
     }
     if (patterns.empty())
         RS_DIALOGFACTORY->commandMessage(QObject::tr("Hatch:: no pattern found. Please set pattern path in application preferences"));
@@ -73,10 +73,11 @@ void RS_PatternList::init() {
  * memory if it's not already.
  */
 std::unique_ptr<RS_Pattern> RS_PatternList::requestPattern(const QString& name) {
-    RS_DEBUG->print("RS_PatternList::requestPattern %s", name.toLatin1().data());
+    LC_DEBUG_PRINT("RS_PatternList::requestPattern %s", name.toLatin1().data());
 
     QString name2 = name.toLower();
-    RS_DEBUG->print("Pattern: name2: %s", name2.toLatin1().data());
+    LC_DEBUG_PRINT("Pattern: name2: %s", name2.toLatin1().data());
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (patterns.count(name2) == 0 || patterns.at(name2) == nullptr) {
         auto p = std::make_unique<RS_Pattern>(name2);
         if (p!=nullptr) {
@@ -96,8 +97,8 @@ std::unique_ptr<RS_Pattern> RS_PatternList::requestPattern(const QString& name)
     }
 
     if (patterns.count(name2) == 1) {
-        RS_DEBUG->print("name2: %s, size= %d", name2.toLatin1().data(),
-                        patterns[name2]->countDeep());
+        LC_DEBUG_PRINT("name2: %s, size= %d", name2.toLatin1().data(),
+                       patterns[name2]->countDeep());
         return std::unique_ptr<RS_Pattern>{static_cast<RS_Pattern*>(patterns[name2]->clone())};
 	}
 
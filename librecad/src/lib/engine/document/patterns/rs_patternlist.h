@@ -29,6 +29,7 @@
 #define RS_PATTERNLIST_H
 #include <map>
 #include <memory>
+#include <mutex>
 
 class RS_Pattern;
 class QString;
@@ -88,6 +89,8 @@ public:
 private:
     //! patterns in the graphic
     PTN_MAP patterns;
+    //! guards lazy loading of patterns, hatches may be updated on worker threads
+    std::mutex m_mutex;
 };
 
 #endif
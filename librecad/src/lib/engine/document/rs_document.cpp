@@ -26,6 +26,8 @@
 **********************************************************************/
 
 
+#include <set>
+
 #include "rs_document.h"
 #include "rs_debug.h"
 
@@ -41,6 +43,177 @@ RS_Document::RS_Document(RS_EntityContainer* parent)
     RS_DEBUG->print("RS_Document::RS_Document() ");
 }
 
+RS_Document::~RS_Document() {
+    // entities may outlive the document if it doesn't own them
+    for (RS_Entity* e: *this) {
+        m_selection.detach(e);
+    }
+    m_selection.release();
+}
+
+void RS_Document::syncSelection() const {
+    m_selection.sync(*this);
+}
+
+void RS_Document::addEntity(RS_Entity* entity) {
+    RS_EntityContainer::addEntity(entity);
+    m_selection.attach(entity);
+}
+
+void RS_Document::appendEntity(RS_Entity* entity) {
+    RS_EntityContainer::appendEntity(entity);
+    m_selection.attach(entity);
+}
+
+void RS_Document::prependEntity(RS_Entity* entity) {
+    RS_EntityContainer::prependEntity(entity);
+    m_selection.attach(entity);
+}
+
+void RS_Document::insertEntity(int index, RS_Entity* entity) {
+    RS_EntityContainer::insertEntity(index, entity);
+    m_selection.attach(entity);
+}
+
+bool RS_Document::removeEntity(RS_Entity* entity) {
+    // detach first, as the container may delete the entity
+    m_selection.detach(entity);
+    return RS_EntityContainer::removeEntity(entity);
+}
+
+void RS_Document::setEntityAt(int index, RS_Entity* entity) {
+    m_selection.detach(entityAt(index));
+    RS_EntityContainer::setEntityAt(index, entity);
+    m_selection.attach(entity);
+}
+
+void RS_Document::clear() {
+    for (RS_Entity* e: *this) {
+        m_selection.detach(e);
+    }
+    m_selection.reset();
+    RS_EntityContainer::clear();
+}
+
+unsigned RS_Document::countSelected(bool deep, QList<RS2::EntityType> const &types) {
+    syncSelection();
+    if (!m_selection.isExact()) {
+        return RS_EntityContainer::countSelected(deep, types);
+    }
+    unsigned count = 0;
+    std::set<RS2::EntityType> type{types.cbegin(), types.cend()};
+    for (RS_Entity* e: m_selection.getSelected()) {
+        if (e->isSelected()) {
+            if (types.empty() || type.count(e->rtti())) {
+                count++;
+            }
+        }
+        if (e->isContainer()) {
+            count += static_cast<RS_EntityContainer*>(e)->countSelected(deep);
+        }
+    }
+    return count;
+}
+
+/**
+ * Collects selected entities in the order of the document. The traversal stops as soon
+ * as all selected entities known to the registry are found.
+ */
+void RS_Document::collectSelected(std::vector<RS_Entity*> &collect, bool deep, QList<RS2::EntityType> const &types) {
+    syncSelection();
+    if (!m_selection.isExact()) {
+        RS_EntityContainer::collectSelected(collect, deep, types);
+        return;
+    }
+    size_t remaining = 0;
+    for (RS_Entity* e: m_selection.getSelected()) {
+        if (e->isSelected()) {
+            remaining++;
+        }
+    }
+    if (remaining == 0) {
+        return;
+    }
+    std::set<RS2::EntityType> type{types.cbegin(), types.cend()};
+    for (RS_Entity* e: *this) {
+        if (e != nullptr && e->isSelected()) {
+            if (types.empty() || type.count(e->rtti())) {
+                collect.push_back(e);
+            }
+            if (deep && e->isContainer()) {
+                static_cast<RS_EntityContainer*>(e)->collectSelected(collect, false);
+            }
+            if (--remaining == 0) {
+                break;
+            }
+        }
+    }
+}
+
+double RS_Document::totalSelectedLength() {
+    syncSelection();
+    if (!m_selection.isExact()) {
+        return RS_EntityContainer::totalSelectedLength();
+    }
+    double ret(0.0);
+    for (RS_Entity* e: m_selection.getSelected()) {
+        if (e->isVisible() && e->isSelected()) {
+            double l = e->getLength();
+            if (l >= 0.) {
+                ret += l;
+            }
+        }
+    }
+    return ret;
+}
+
+RS_EntityContainer::LC_SelectionInfo RS_Document::getSelectionInfo(QList<RS2::EntityType> const &types) {
+    syncSelection();
+    if (!m_selection.isExact()) {
+        return RS_EntityContainer::getSelectionInfo(types);
+    }
+    LC_SelectionInfo result;
+    std::set<RS2::EntityType> type{types.cbegin(), types.cend()};
+    for (RS_Entity* e: m_selection.getSelected()) {
+        if (e->isSelected()) {
+            if (types.empty() || type.count(e->rtti())) {
+                result.count++;
+                double entityLength = e->getLength();
+                if (entityLength >= 0.) {
+                    result.length += entityLength;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+RS_EntityContainer::RefInfo RS_Document::getNearestSelectedRefInfo(const RS_Vector &coord, double *dist) const {
+    syncSelection();
+    if (!m_selection.isExact()) {
+        return RS_EntityContainer::getNearestSelectedRefInfo(coord, dist);
+    }
+    double minDist = RS_MAXDOUBLE;
+    RS_Vector closestPoint(false);
+    RS_Entity *closestPointEntity = nullptr;
+
+    for (RS_Entity* en: m_selection.getSelected()) {
+        if (en->isVisible() && en->isSelected() && !en->isParentSelected()) {
+            double curDist = 0.;
+            RS_Vector point = en->getNearestSelectedRef(coord, &curDist);
+            if (point.valid && curDist < minDist) {
+                closestPoint = point;
+                closestPointEntity = en;
+                minDist = curDist;
+                if (dist) {
+                    *dist = minDist;
+                }
+            }
+        }
+    }
+    return {closestPoint, closestPointEntity};
+}
+
 /**
  * Overwritten to set modified flag when undo cycle finished with undoable(s).
  */
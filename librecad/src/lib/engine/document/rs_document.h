@@ -29,6 +29,7 @@
 #ifndef RS_DOCUMENT_H
 #define RS_DOCUMENT_H
 
+#include "lc_selectionregistry.h"
 #include "rs_entitycontainer.h"
 #include "rs_pen.h"
 #include "rs_undo.h"
@@ -53,6 +54,7 @@ class RS_Document : public RS_EntityContainer,
     public RS_Undo {
 public:
 	RS_Document(RS_EntityContainer* parent=nullptr);
+    ~RS_Document() override;
 
     virtual RS_LayerList* getLayerList()= 0;
     virtual RS_BlockList* getBlockList() = 0;
@@ -106,6 +108,25 @@ public:
      */
      void endUndoCycle() override;
 
+    void addEntity(RS_Entity* entity) override;
+    void appendEntity(RS_Entity* entity) override;
+    void prependEntity(RS_Entity* entity) override;
+    void insertEntity(int index, RS_Entity* entity) override;
+    bool removeEntity(RS_Entity* entity) override;
+    void setEntityAt(int index, RS_Entity* entity) override;
+    void clear() override;
+
+    /*
+     * Selection queries below rely on the selection registry and so take time
+     * proportional to the number of selected entities rather than to the
+     * size of the document.
+     */
+    unsigned countSelected(bool deep = true, QList<RS2::EntityType> const& types = {}) override;
+    void collectSelected(std::vector<RS_Entity*> &collect, bool deep, QList<RS2::EntityType> const &types = {}) override;
+    double totalSelectedLength() override;
+    LC_SelectionInfo getSelectionInfo(QList<RS2::EntityType> const& types = {}) override;
+    RefInfo getNearestSelectedRefInfo(const RS_Vector& coord, double* dist = nullptr) const override;
+
     void setGraphicView(RS_GraphicView * g) {gv = g;}
     RS_GraphicView* getGraphicView() {return gv;} // fixme - sand -- REALLY BAD DEPENDANCE TO UI here, REWORK!
 
@@ -118,5 +139,11 @@ protected:
     //used to read/save current view
     RS_GraphicView * gv = nullptr; // fixme - sand -- REALLY BAD DEPENDANCE TO UI here, REWORK!
 
+private:
+    void syncSelection() const;
+
+    //! synced on queries, as selection may be changed on other threads
+    mutable LC_SelectionRegistry m_selection;
+
 };
 #endif
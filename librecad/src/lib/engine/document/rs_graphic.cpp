@@ -33,6 +33,7 @@
 #include "lc_dimstyletovariablesmapper.h"
 #include "lc_defaults.h"
 #include "lc_dimarrowregistry.h"
+#include "lc_regenscheduler.h"
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
 #include "rs_dialogfactoryinterface.h"
@@ -173,7 +174,7 @@ void RS_Graphic::onLoadingCompleted() {
         // from base style.
         dimstyleList.mergeStyles();
     }
-    updateDimensions(true);
+    LC_RegenScheduler(this).regenerateDimensions();
 }
 
 /**
@@ -753,7 +754,7 @@ bool RS_Graphic::isBiggerThanPaper() {
 }
 
 void RS_Graphic::addEntity(RS_Entity *entity) {
-    RS_EntityContainer::addEntity(entity);
+    RS_Document::addEntity(entity);
     if (entity->rtti() == RS2::EntityBlock ||
         entity->rtti() == RS2::EntityContainer) {
         auto *e = dynamic_cast<RS_EntityContainer *>(entity);
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <thread>
+
+#include <QCoreApplication>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_selectionregistry.h"
+#include "rs_block.h"
+#include "rs_entitycontainer.h"
+#include "rs_line.h"
+
+namespace {
+// plain container with the registry attached to its children, as done by RS_Document
+struct Document {
+    RS_EntityContainer container{nullptr, true};
+    LC_SelectionRegistry registry;
+
+    ~Document() {
+        for (RS_Entity* e: container) {
+            registry.detach(e);
+        }
+        registry.release();
+    }
+
+    RS_Line* addLine(double y) {
+        auto line = new RS_Line{&container, {0., y}, {10., y}};
+        container.addEntity(line);
+        registry.attach(line);
+        return line;
+    }
+
+    // container with two lines, the second one is returned by nested
+    RS_EntityContainer* addGroup(RS_Line** nested) {
+        auto group = new RS_EntityContainer{&container, true};
+        group->addEntity(new RS_Line{group, {0., 0.}, {1., 1.}});
+        *nested = new RS_Line{group, {1., 1.}, {2., 0.}};
+        group->addEntity(*nested);
+        container.addEntity(group);
+        registry.attach(group);
+        return group;
+    }
+};
+}
+
+TEST_CASE("LC_SelectionRegistry tracks selection of document entities") {
+    Document doc;
+    RS_Line* first = doc.addLine(0.);
+    RS_Line* second = doc.addLine(1.);
+    REQUIRE(doc.registry.isEmpty());
+
+    first->setSelected(true);
+    second->setSelected(true);
+    REQUIRE(doc.registry.getSelected().size() == 2);
+    second->setSelected(false);
+    REQUIRE(doc.registry.getSelected().size() == 1);
+    REQUIRE(doc.registry.getSelected().count(first) == 1);
+
+    doc.registry.detach(first);
+    REQUIRE(doc.registry.isEmpty());
+    REQUIRE(doc.registry.isExact());
+}
+
+TEST_CASE("LC_SelectionRegistry is exact again once nested selection is cleared") {
+    Document doc;
+    RS_Line* nested = nullptr;
+    RS_EntityContainer* group = doc.addGroup(&nested);
+    REQUIRE(doc.registry.isExact());
+
+    SECTION("deselected") {
+        nested->setSelected(true);
+        REQUIRE(!doc.registry.isExact());
+        nested->setSelected(false);
+        REQUIRE(doc.registry.isExact());
+    }
+
+    SECTION("selected with the container and deselected with it") {
+        nested->setSelected(true);
+        group->setSelected(true);
+        REQUIRE(!doc.registry.isExact());
+        group->setSelected(false);
+        REQUIRE(doc.registry.isExact());
+        REQUIRE(doc.registry.isEmpty());
+    }
+
+    SECTION("deleted") {
+        nested->setSelected(true);
+        REQUIRE(!doc.registry.isExact());
+        group->removeEntity(nested);
+        REQUIRE(doc.registry.isExact());
+    }
+
+    SECTION("container selected as a whole") {
+        group->setSelected(true);
+        REQUIRE(doc.registry.isExact());
+        REQUIRE(doc.registry.getSelected().count(group) == 1);
+    }
+}
+
+TEST_CASE("LC_SelectionRegistry defers changes made on other threads to sync") {
+    int argc = 1;
+    char name[] = "librecad_tests";
+    char* argv[] = {name, nullptr};
+    QCoreApplication application(argc, argv);
+
+    Document doc;
+    RS_Line* line = doc.addLine(0.);
+    RS_Line* nested = nullptr;
+    doc.addGroup(&nested);
+
+    std::thread worker([line, nested]() {
+        line->setSelected(true);
+        nested->setSelected(true);
+    });
+    worker.join();
+    REQUIRE(!doc.registry.isExact());
+    REQUIRE(doc.registry.isEmpty());
+
+    doc.registry.sync(doc.container);
+    REQUIRE(doc.registry.getSelected().size() == 1);
+    REQUIRE(doc.registry.getSelected().count(line) == 1);
+    // the nested selection found by sync is tracked as one reported on the GUI thread
+    REQUIRE(!doc.registry.isExact());
+    nested->setSelected(false);
+    REQUIRE(doc.registry.isExact());
+}
+
+TEST_CASE("RS_Document counts selected entities with nested selection") {
+    RS_Block block{nullptr, {"block", {0., 0.}, false}};
+    auto line = new RS_Line{&block, {0., 0.}, {1., 0.}};
+    block.addEntity(line);
+    auto group = new RS_EntityContainer{&block, true};
+    auto nested = new RS_Line{group, {0., 1.}, {1., 1.}};
+    group->addEntity(nested);
+    block.addEntity(group);
+
+    line->setSelected(true);
+    REQUIRE(block.countSelected() == 1);
+    nested->setSelected(true);
+    REQUIRE(block.countSelected() == 2);
+    nested->setSelected(false);
+    REQUIRE(block.countSelected() == 1);
+    line->setSelected(false);
+    REQUIRE(block.countSelected() == 0);
+}
@@ -235,7 +235,7 @@ RS_Vector RS_VariableDict::getVector(const QString& key, const RS_Vector& def) c
 QString RS_VariableDict::getString(const QString& key, const QString& def) const {
     QString ret;
 
-    RS_DEBUG->print("RS_VariableDict::getString: key: '%s'", key.toLatin1().data());
+    LC_DEBUG_PRINT("RS_VariableDict::getString: key: '%s'", key.toLatin1().data());
 
     auto i = variables.find(key);
     if (variables.end() != i && RS2::VariableString == i.value().getType()) {
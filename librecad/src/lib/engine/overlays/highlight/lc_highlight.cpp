@@ -21,68 +21,94 @@
  ******************************************************************************/
 
 #include "lc_highlight.h"
-#include "rs_debug.h"
+
+#include "rs_document.h"
 #include "rs_pen.h"
 
-LC_Highlight::LC_Highlight()= default;
+LC_Highlight::LC_Highlight(RS_Document* document):RS_EntityContainer(nullptr, false)
+    , m_document{document}
+    , m_undoRevision{document != nullptr ? document->getUndoRevision() : 0} {
+}
+
+LC_Highlight::~LC_Highlight() {
+    clear();
+}
 
 void LC_Highlight::addEntity(RS_Entity* entity, bool selected) {
     if (entity == nullptr || entity->isUndone()) {
         return;
     }
-    RS_Entity *duplicatedEntity = entity->clone();
-    RS_Pen pen = entity->getPen(true);
-    duplicatedEntity->setPen(pen);
-
-    duplicatedEntity->setHighlighted(true);
+    validate();
+    RS_Entity* drawnEntity = m_highlightedEntities.value(entity, nullptr);
+    if (drawnEntity == nullptr) {
+        drawnEntity = isTopLevel(entity) ? entity : createClone(entity);
+        m_highlightedEntities.insert(entity, drawnEntity);
+        push_back(drawnEntity);
+    }
     if (selected) {
-        duplicatedEntity->setSelected(true);
+        m_refPointsEntities.insert(drawnEntity);
     }
-
-    entitiesMap.insert(entity, duplicatedEntity);
-//    entity->setTransparent(true);
-    push_back(duplicatedEntity);
 }
 
 bool LC_Highlight::removeEntity(RS_Entity *entity){
-    bool result = false;
-    if (entity != nullptr){
-        RS_Entity *duplicate = entitiesMap.value(entity, nullptr);
-        if (duplicate != nullptr){
-            entity->setTransparent(false);
-            bool ret = removeEntity(duplicate);
-            if (ret) {
-                delete duplicate;
-            }
-            entitiesMap.remove(entity);
-            if (entity->getParent() == this){
-                delete entity;
-            }
-            result = true;
-        }
+    validate();
+    RS_Entity* drawnEntity = m_highlightedEntities.take(entity);
+    if (drawnEntity == nullptr) {
+        return false;
+    }
+    m_refPointsEntities.remove(drawnEntity);
+    bool result = RS_EntityContainer::removeEntity(drawnEntity);
+    if (drawnEntity != entity) {
+        delete drawnEntity;
     }
     return result;
 }
+
 // fixme - return bool value if actually cleared
 void LC_Highlight::clear(){
-    for (auto it = entitiesMap.keyValueBegin(); it != entitiesMap.keyValueEnd(); ++it) {
-        RS_Entity *entity = it->first;
-        entity->setTransparent(false);
-        if (entity->getParent() == this){
-            delete entity;
+    RS_EntityContainer::clear();
+    for (auto it = m_highlightedEntities.cbegin(); it != m_highlightedEntities.cend(); ++it) {
+        if (it.key() != it.value()) {
+            delete it.value();
         }
     }
-    entitiesMap.clear();
-    while (!isEmpty()) {
-        delete last();
-        pop_back();
+    m_highlightedEntities.clear();
+    m_refPointsEntities.clear();
+}
+
+/**
+ * Clears the highlight if the undo state of the document was changed since entities were added, as
+ * referenced entities may be deleted since that.
+ * @return true if there are entities to draw
+ */
+bool LC_Highlight::validate() {
+    std::uint64_t undoRevision = m_document != nullptr ? m_document->getUndoRevision() : 0;
+    if (undoRevision != m_undoRevision) {
+        clear();
+        m_undoRevision = undoRevision;
     }
+    return !isEmpty();
+}
+
+bool LC_Highlight::isTopLevel(RS_Entity* entity) const {
+    return m_document != nullptr && entity->getParent() == m_document;
+}
+
+RS_Entity* LC_Highlight::createClone(RS_Entity* entity) const {
+    RS_Entity* clone = entity->clone();
+    // pen is resolved while parents of the entity are alive
+    clone->setPen(entity->getPen(true));
+    // the clone of container keeps its own entities, so only the clone itself is moved to the document
+    clone->RS_Entity::reparent(m_document);
+    return clone;
 }
 
+/**
+ * Adds highlight to the overlay container. Highlighted entities are drawn by the renderer
+ * as they are, so the container should not own them.
+ */
 void LC_Highlight::addEntitiesToContainer(RS_EntityContainer *container){
-    // fixme - sand - review foreach cycles and replace to range-based
-    for (RS_Entity* e: *this) {
-        e->reparent(container);
-        container->addEntity(e);
+    if (!isEmpty()) {
+        container->addEntity(this);
     }
 }
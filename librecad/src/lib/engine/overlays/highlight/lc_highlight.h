@@ -23,19 +23,42 @@
 #ifndef LC_HIGHLIGHT_H
 #define LC_HIGHLIGHT_H
 
-#include <QMap>
+#include <cstdint>
+#include <QHash>
+#include <QSet>
 #include "rs_entitycontainer.h"
 
+class RS_Document;
+
+/**
+ * Set of entities that are highlighted in overlay (on hover or as already selected by action).
+ * Top-level entities of the document are not copied - the highlight only refers to them, and the renderer draws
+ * original entities with highlight pen. So highlighting does not depend on the size of the entity.
+ * Other entities (segments of polylines, entities of inserts) may be deleted by update of their parent,
+ * so they are highlighted by clones.
+ * Undone entities are deleted when the redo history is dropped, so the highlight is cleared by any change of
+ * the undo state of the document.
+ */
 class LC_Highlight: public RS_EntityContainer{
 public:
-    LC_Highlight();
+    explicit LC_Highlight(RS_Document* document);
+    ~LC_Highlight() override;
     void addEntity([[maybe_unused]]RS_Entity *entity) override {}
     void addEntity(RS_Entity *entity, bool selected = false);
     bool removeEntity(RS_Entity *entity) override;
     void clear() override;
     void addEntitiesToContainer(RS_EntityContainer* container);
+    bool isDrawRefPoints(RS_Entity* entity) const {return m_refPointsEntities.contains(entity);}
+    bool validate();
 protected:
-   QMap<RS_Entity*, RS_Entity*> entitiesMap;
+   bool isTopLevel(RS_Entity* entity) const;
+   RS_Entity* createClone(RS_Entity* entity) const;
+
+   RS_Document* m_document = nullptr;
+   std::uint64_t m_undoRevision = 0;
+   // highlighted entity - entity that is drawn for it
+   QHash<RS_Entity*, RS_Entity*> m_highlightedEntities;
+   QSet<RS_Entity*> m_refPointsEntities;
 };
 
 #endif // LC_HIGHLIGHT_H
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2024 LibreCAD.org
+ Copyright (C) 2024 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QStandardPaths>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_highlight.h"
+#include "rs_graphic.h"
+#include "rs_line.h"
+#include "rs_polyline.h"
+#include "rs_settings.h"
+
+namespace {
+void initSettings() {
+    if (RS_Settings::instance() == nullptr) {
+        // keeps settings of tests out of the user settings
+        QStandardPaths::setTestModeEnabled(true);
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+RS_Polyline* addPolyline(RS_Graphic& graphic) {
+    auto* polyline = new RS_Polyline(&graphic);
+    polyline->addVertex({0., 0.});
+    polyline->addVertex({10., 0.});
+    polyline->addVertex({10., 10.});
+    graphic.addEntity(polyline);
+    return polyline;
+}
+}
+
+TEST_CASE("LC_Highlight refers to top-level entities and clones nested ones") {
+    initSettings();
+    RS_Graphic graphic;
+    auto* line = new RS_Line(&graphic, {0., 5.}, {10., 5.});
+    graphic.addEntity(line);
+    RS_Polyline* polyline = addPolyline(graphic);
+    RS_Entity* segment = polyline->entityAt(0);
+    REQUIRE(segment != nullptr);
+
+    LC_Highlight highlight(&graphic);
+    highlight.addEntity(line, false);
+    highlight.addEntity(segment, true);
+    // entities are highlighted once
+    highlight.addEntity(line, true);
+    REQUIRE(highlight.count() == 2);
+    REQUIRE(highlight.entityAt(0) == line);
+    RS_Entity* clone = highlight.entityAt(1);
+    REQUIRE(clone != segment);
+    REQUIRE(highlight.isDrawRefPoints(line));
+    REQUIRE(highlight.isDrawRefPoints(clone));
+
+    // segments are deleted by changes of the polyline, the clone stays valid
+    polyline->clear();
+    REQUIRE(highlight.validate());
+    REQUIRE(clone->getStartpoint().distanceTo({0., 0.}) < RS_TOLERANCE);
+    REQUIRE(clone->getEndpoint().distanceTo({10., 0.}) < RS_TOLERANCE);
+
+    REQUIRE(highlight.removeEntity(segment));
+    REQUIRE(!highlight.removeEntity(segment));
+    REQUIRE(highlight.count() == 1);
+    REQUIRE(!highlight.isDrawRefPoints(clone));
+}
+
+TEST_CASE("LC_Highlight is cleared by changes of the undo state") {
+    initSettings();
+    RS_Graphic graphic;
+    auto* line = new RS_Line(&graphic, {0., 0.}, {10., 0.});
+    graphic.addEntity(line);
+    RS_Polyline* polyline = addPolyline(graphic);
+
+    LC_Highlight highlight(&graphic);
+    highlight.addEntity(line, true);
+    highlight.addEntity(polyline->entityAt(0), false);
+    REQUIRE(highlight.validate());
+
+    SECTION("new undo cycle") {
+        // a new cycle drops the redo history, which deletes undone entities
+        graphic.startUndoCycle();
+        graphic.endUndoCycle();
+    }
+
+    SECTION("undo and redo") {
+        graphic.startUndoCycle();
+        line->setUndoState(true);
+        graphic.addUndoable(line);
+        graphic.endUndoCycle();
+        highlight.addEntity(polyline, false);
+        REQUIRE(highlight.validate());
+        REQUIRE(graphic.undo());
+        REQUIRE(!highlight.validate());
+        highlight.addEntity(line, false);
+        REQUIRE(highlight.count() == 1);
+        REQUIRE(graphic.redo());
+    }
+
+    REQUIRE(!highlight.validate());
+    REQUIRE(highlight.isEmpty());
+    REQUIRE(!highlight.isDrawRefPoints(line));
+}
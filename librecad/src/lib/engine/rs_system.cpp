@@ -65,13 +65,13 @@ void RS_System::init(const QString& appName,
         // in AppImage QCoreApplication::applicationDirPath() directs to /lib64 of mounted AppImage
         // thus use argv[0] to extract the correct path to librecad executable
         appDir = QFileInfo( QFile::decodeName( arg0)).absoluteFilePath();
-        RS_DEBUG->print("%s\n", (QString("arg0:")+ QString(arg0)).toUtf8().constData());
-        RS_DEBUG->print("%s\n", (QString("appDir:")+ appDir).toUtf8().constData());
+        LC_DEBUG_PRINT("%s\n", (QString("arg0:")+ QString(arg0)).toUtf8().constData());
+        LC_DEBUG_PRINT("%s\n", (QString("appDir:")+ appDir).toUtf8().constData());
     }
     else {
         // in regular application QCoreApplication::applicationDirPath() is preferred, see GitHub #1488
         appDir = QCoreApplication::applicationDirPath();
-        RS_DEBUG->print("%s\n", (QString("appDir2:")+ appDir).toUtf8().constData());
+        LC_DEBUG_PRINT("%s\n", (QString("appDir2:")+ appDir).toUtf8().constData());
     }
 
     // when appDir is not HOME or CURRENT dir, search appDir too in getDirectoryList()
@@ -80,8 +80,8 @@ void RS_System::init(const QString& appName,
                    && getHomeDir() != appDir
                    && getCurrentDir() != appDir);
 
-    RS_DEBUG->print("RS_System::init: System %s initialized.", appName.toLatin1().data());
-    RS_DEBUG->print("RS_System::init: App dir: %s", appDir.toLatin1().data());
+    LC_DEBUG_PRINT("RS_System::init: System %s initialized.", appName.toLatin1().data());
+    LC_DEBUG_PRINT("RS_System::init: App dir: %s", appDir.toLatin1().data());
     initialized = true;
 
     initAllLanguagesList();
@@ -117,8 +117,8 @@ void RS_System::initLanguageList() {
          it != lst.end();
          ++it) {
 
-        RS_DEBUG->print("RS_System::initLanguageList: qm file: %s",
-                        (*it).toLatin1().data());
+        LC_DEBUG_PRINT("RS_System::initLanguageList: qm file: %s",
+                       (*it).toLatin1().data());
 
         int i0 = (*it).lastIndexOf(QString("librecad"),-1,Qt::CaseInsensitive);
         int i1 = (*it).indexOf('_',i0);
@@ -129,8 +129,8 @@ void RS_System::initLanguageList() {
         QString l = (*it).mid(i1+1, i2-i1-1);
 
         if (!(languageList.contains(l)) ) {
-            RS_DEBUG->print("RS_System::initLanguageList: append language: %s",
-                            l.toLatin1().data());
+            LC_DEBUG_PRINT("RS_System::initLanguageList: append language: %s",
+                           l.toLatin1().data());
             languageList.append(l);
         }
     }
@@ -532,7 +532,7 @@ QString RS_System::getAppDataDir() const
         if (!dir.mkpath( appData))
             return QString();
     }
-    RS_DEBUG->print("%s\n", (QString("appData: ") + appData).toUtf8().constData());
+    LC_DEBUG_PRINT("%s\n", (QString("appData: ") + appData).toUtf8().constData());
     return appData;
 }
 
@@ -548,9 +548,9 @@ QStringList RS_System::getFileList(const QString& subDirectory,
 {
     checkInit();
 
-    RS_DEBUG->print( "RS_System::getFileList: subdirectory %s ", subDirectory.toLatin1().data());
-    RS_DEBUG->print( "RS_System::getFileList: appDirName %s ", appDirName.toLatin1().data());
-    RS_DEBUG->print( "RS_System::getFileList: getCurrentDir %s ", getCurrentDir().toLatin1().data());
+    LC_DEBUG_PRINT( "RS_System::getFileList: subdirectory %s ", subDirectory.toLatin1().data());
+    LC_DEBUG_PRINT( "RS_System::getFileList: appDirName %s ", appDirName.toLatin1().data());
+    LC_DEBUG_PRINT( "RS_System::getFileList: getCurrentDir %s ", getCurrentDir().toLatin1().data());
 
     QStringList fileList;
 
@@ -606,7 +606,7 @@ QStringList RS_System::getDirectoryList(const QString& _subDirectory) const
         }
     }
 
-    RS_DEBUG->print("%s\n", QString("%1(): line %2: dir=%3").arg(__func__).arg(__LINE__).arg(appDir).toUtf8().constData());
+    LC_DEBUG_PRINT("%s\n", QString("%1(): line %2: dir=%3").arg(__func__).arg(__LINE__).arg(appDir).toUtf8().constData());
 
 #if (defined(Q_OS_WIN32) || defined(Q_OS_WIN64) || defined(Q_OS_UNIX))
     // for AppImage use relative paths from executable
@@ -627,7 +627,7 @@ QStringList RS_System::getDirectoryList(const QString& _subDirectory) const
 #endif
     for (auto& dir: dirList) {
 
-        RS_DEBUG->print("%s\n", QString("%1(): line %2: dir=%3\n").arg(__func__).arg(__LINE__).arg(dir).toUtf8().constData());
+        LC_DEBUG_PRINT("%s\n", QString("%1(): line %2: dir=%3\n").arg(__func__).arg(__LINE__).arg(dir).toUtf8().constData());
     }
 
 #ifdef Q_OS_MAC
@@ -651,7 +651,7 @@ QStringList RS_System::getDirectoryList(const QString& _subDirectory) const
 
             if (subDirectory == "fonts") {
                 QString savedFonts = LC_GET_STR("Fonts", "");
-                RS_DEBUG->print("saved fonts: %s\n", savedFonts.toUtf8().constData());
+                LC_DEBUG_PRINT("saved fonts: %s\n", savedFonts.toUtf8().constData());
                 dirList += (LC_GET_STR("Fonts", "")).split(QRegularExpression("[;]"),
                                                            option);
             } else if (subDirectory == "patterns") {
@@ -680,7 +680,7 @@ QStringList RS_System::getDirectoryList(const QString& _subDirectory) const
     }
 
     for (const QString& dir: std::as_const(ret)) {
-        RS_DEBUG->print("%s\n", QString("%1(): line %2: dir=%3").arg(__func__).arg(__LINE__).arg(dir).toUtf8().constData());
+        LC_DEBUG_PRINT("%s\n", QString("%1(): line %2: dir=%3").arg(__func__).arg(__LINE__).arg(dir).toUtf8().constData());
     }
 
     return ret;
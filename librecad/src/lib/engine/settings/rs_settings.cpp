@@ -69,7 +69,6 @@ void RS_Settings::init(const QString &companyKey,const QString &appKey) {
 
 RS_Settings::RS_Settings(QSettings *qsettings) {
     settings = qsettings;
-    m_group = "";
 }
 
 RS_Settings::~RS_Settings() {
@@ -159,15 +158,19 @@ bool RS_Settings::writeEntrySingle(const QString& group, const QString &key, con
     // Skip writing operations if the key is found in the cache and
     // its value is the same as the new one (it was already written).
 
-    QVariant ret = readEntryCache(fullName);
-    if (ret.isValid() && ret == value) {
-        return true;
-    }
+    QVariant ret;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        ret = readEntryCache(fullName);
+        if (ret.isValid() && ret == value) {
+            return true;
+        }
 
-    // RVT_PORT not supported anymore s.insertSearchPath(QSettings::Windows, companyKey);
+        // RVT_PORT not supported anymore s.insertSearchPath(QSettings::Windows, companyKey);
 
-    settings->setValue(fullName, value);
-    cache[fullName] = value;
+        settings->setValue(fullName, value);
+        cache[fullName] = value;
+    }
 
     // basically, that's a shortcut that we put value from cache as old value (instead of actual reading of it).
     // however, in most cases, properties will be read before modification, so that's fine
@@ -178,11 +181,7 @@ bool RS_Settings::writeEntrySingle(const QString& group, const QString &key, con
 
 QString RS_Settings::readStrSingle(const QString& group, const QString &key,const QString &def) {
     QString fullName = getFullName(group, key);
-    QVariant value = readEntryCache(fullName);
-    if (!value.isValid()) {
-        value = settings->value(fullName, QVariant(def)).toString();
-        cache[fullName] = value;
-    }
+    QVariant value = readEntry(fullName, QVariant(def));
     return value.toString();
 }
 
@@ -210,11 +209,7 @@ void RS_Settings::remove(const QString& key) const {
 
 int RS_Settings::readColorSingle(const QString& group, const QString &key, int def) {
     QString fullName = getFullName(group, key);
-    QVariant value = readEntryCache(fullName);
-    if (!value.isValid()) {
-        value = settings->value(fullName, QVariant(def));
-        cache[fullName] = value;
-    }
+    QVariant value = readEntry(fullName, QVariant(def));
     unsigned long long uValue = value.toULongLong();
     uValue = uValue % 0x80000000ull;
     int result = int(uValue);
@@ -227,11 +222,7 @@ int RS_Settings::readInt(const QString &key, int def) {
 
 int RS_Settings::readIntSingle(const QString& group, const QString &key, int def) {
     QString fullName = getFullName(group, key);
-    QVariant value = readEntryCache(fullName);
-    if (!value.isValid()) {
-        value = settings->value(fullName, QVariant(def));
-        cache[fullName] = value;
-    }
+    QVariant value = readEntry(fullName, QVariant(def));
     int result = value.toInt();
     return result;
 }
@@ -242,9 +233,11 @@ QByteArray RS_Settings::readByteArray(const QString &key) {
 
 QByteArray RS_Settings::readByteArraySingle(const QString& group, const QString &key) {
     QString fullName = getFullName(group, key);
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
     return settings->value(fullName, "").toByteArray();
 }
 
+// cache should be locked by caller
 QVariant RS_Settings::readEntryCache(const QString &key) {
     if (cache.count(key) == 0) {
         return QVariant();
@@ -252,13 +245,25 @@ QVariant RS_Settings::readEntryCache(const QString &key) {
     return cache[key];
 }
 
+QVariant RS_Settings::readEntry(const QString &fullName, const QVariant &def) {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    QVariant value = readEntryCache(fullName);
+    if (!value.isValid()) {
+        value = settings->value(fullName, def);
+        cache[fullName] = value;
+    }
+    return value;
+}
+
 void RS_Settings::clear_all() {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
     settings->clear();
     cache.clear();
     save_is_allowed = false;
 }
 
 void RS_Settings::clear_geometry() {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
     settings->remove("/Geometry");
     cache.clear();
     save_is_allowed = false;
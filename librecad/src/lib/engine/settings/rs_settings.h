@@ -28,6 +28,9 @@
 #ifndef RS_SETTINGS_H
 #define RS_SETTINGS_H
 
+#include <map>
+#include <mutex>
+
 #include <QObject>
 #include <QVariant>
 
@@ -179,10 +182,14 @@ signals:
 private:
     explicit RS_Settings(QSettings *qsettings);
     QVariant readEntryCache(const QString& key);
+    QVariant readEntry(const QString& fullName, const QVariant& def);
 
 protected:
     std::map<QString, QVariant> cache;
-    QString m_group;
+    //! guards cache and settings, entities read settings while documents are loaded on worker threads
+    std::mutex m_cacheMutex;
+    //! group selected by beginGroup(), tracked per thread as settings are also read from worker threads
+    static inline thread_local QString m_group;
     QSettings *settings = nullptr;
     static inline RS_Settings* INSTANCE;
 
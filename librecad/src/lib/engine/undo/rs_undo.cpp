@@ -28,6 +28,7 @@
 #include<iostream>
 #include "rs_undo.h"
 #include <unordered_set>
+#include "lc_trace.h"
 #include "rs_debug.h"
 #include "rs_undocycle.h"
 
@@ -83,6 +84,7 @@ void RS_Undo::startUndoCycle(){
         // only the first fresh top call starts a new cycle
         return;
     }
+    ++m_undoRevision;
 
     // anything after the current existing undoCycle will be removed
     // if there are undo cycles behind undoPointer
@@ -162,6 +164,7 @@ void RS_Undo::endUndoCycle(){
  * Undoes the last undo cycle.
  */
 bool RS_Undo::undo() {
+    LC_TRACE_SCOPE("undo", "undo");
     RS_DEBUG->print("RS_Undo::undo");
 
     if (m_redoPointer == undoList.cbegin())
@@ -169,6 +172,7 @@ bool RS_Undo::undo() {
 
     m_redoPointer = std::prev(m_redoPointer);
     std::shared_ptr<RS_UndoCycle> uc = *m_redoPointer;
+    ++m_undoRevision;
 
 	updateUndoState();
 	uc->changeUndoState();
@@ -179,12 +183,14 @@ bool RS_Undo::undo() {
  * Redoes the undo cycle which was at last undone.
  */
 bool RS_Undo::redo() {
+    LC_TRACE_SCOPE("undo", "redo");
     RS_DEBUG->print("RS_Undo::redo");
 
     if (m_redoPointer != undoList.cend()) {
 
         std::shared_ptr<RS_UndoCycle> uc = *m_redoPointer;
         m_redoPointer = std::next(m_redoPointer);
+        ++m_undoRevision;
 
 		updateUndoState();
 		uc->changeUndoState();
@@ -30,6 +30,7 @@
 #ifndef RS_UNDO_H
 #define RS_UNDO_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -71,6 +72,11 @@ public:
       **/
 	void updateUndoState() const;
     void collectUndoState(bool &undoAvailable, bool &redoAvailable) const;
+    /**
+     * @return counter of undo, redo and started undo cycles. Undone entities may be deleted
+     * by any of them, so references to entities are valid only while the counter is the same.
+     */
+    std::uint64_t getUndoRevision() const {return m_undoRevision;}
     friend std::ostream& operator << (std::ostream& os, RS_Undo& a);
     static bool test();
 protected:
@@ -94,6 +100,7 @@ private:
     std::shared_ptr<RS_UndoCycle> currentCycle;
 
     int refCount {0}; ///< reference counter for nested start/end calls
+    std::uint64_t m_undoRevision {0};
 };
 
 
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_imagecache.h"
+
+#include <algorithm>
+
+#include <QFileInfo>
+#include <QImageReader>
+
+#include "lc_trace.h"
+
+LC_CachedImage::LC_CachedImage(const QString& filePath, const QDateTime& lastModified, const QImage& image)
+    :m_filePath{filePath}, m_lastModified{lastModified},
+     m_width{image.width()}, m_height{image.height()} {
+    int w = m_width;
+    int h = m_height;
+    while (w > 1 && h > 1) {
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+        m_levelsCount++;
+    }
+    m_levels.resize(m_levelsCount);
+    m_levels.front() = image;
+}
+
+int LC_CachedImage::levelFor(double scale) const {
+    if (scale >= 0.5 || scale <= 0.) {
+        return 0;
+    }
+    int level = 0;
+    while (scale * 2. <= 1. && level + 1 < m_levelsCount) {
+        scale *= 2.;
+        level++;
+    }
+    return level;
+}
+
+QImage LC_CachedImage::getLevel(int level) {
+    if (level <= 0 || isNull()) {
+        return m_levels.front();
+    }
+    level = std::min(level, m_levelsCount - 1);
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_levels[level].isNull()) {
+        LC_TRACE_SCOPE("image", "buildLevel");
+        int built = level - 1;
+        while (m_levels[built].isNull()) {
+            built--;
+        }
+        for (int i = built + 1; i <= level; i++) {
+            const QImage& source = m_levels[i - 1];
+            m_levels[i] = source.scaled((source.width() + 1) / 2, (source.height() + 1) / 2,
+                                        Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        }
+    }
+    return m_levels[level];
+}
+
+LC_ImageCache* LC_ImageCache::instance() {
+    static LC_ImageCache cache;
+    return &cache;
+}
+
+std::shared_ptr<LC_CachedImage> LC_ImageCache::acquire(const QString& filePath) {
+    QFileInfo fileInfo(filePath);
+    QString key = fileInfo.canonicalFilePath();
+    if (key.isEmpty()) {
+        return std::make_shared<LC_CachedImage>(filePath, QDateTime(), QImage());
+    }
+    QDateTime lastModified = fileInfo.lastModified();
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it = m_images.constFind(key);
+        if (it != m_images.cend()) {
+            auto image = it.value().lock();
+            if (image != nullptr && image->getLastModified() == lastModified) {
+                return image;
+            }
+        }
+    }
+
+    // decoding is done outside of the lock, so other files are not blocked by a large image
+    LC_TRACE_SCOPE("image", "decode");
+    QImageReader reader(key);
+    QImage decoded = reader.read();
+    auto image = std::make_shared<LC_CachedImage>(key, lastModified, decoded);
+    if (decoded.isNull()) {
+        return image;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto existing = m_images.value(key).lock();
+    if (existing != nullptr && existing->getLastModified() == lastModified) {
+        // decoded concurrently by other thread, share the one already published
+        return existing;
+    }
+    m_images.insert(key, image);
+    // drop entries of images that are not used anymore
+    for (auto it = m_images.begin(); it != m_images.end();) {
+        if (it.value().expired()) {
+            it = m_images.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    return image;
+}
+
+void LC_ImageCache::clear() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_images.clear();
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_IMAGECACHE_H
+#define LC_IMAGECACHE_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QDateTime>
+#include <QHash>
+#include <QImage>
+#include <QString>
+
+/**
+ * Decoded raster image shared by all image entities referring to the same file.
+ *
+ * Level 0 is the full resolution image, each next level halves the previous one. Levels are built
+ * lazily on the first request, so the pyramid costs nothing until the image is drawn zoomed out.
+ * Levels are returned as implicitly shared QImage copies and may be requested from any thread.
+ */
+class LC_CachedImage {
+public:
+    LC_CachedImage(const QString& filePath, const QDateTime& lastModified, const QImage& image);
+
+    const QString& getFilePath() const {return m_filePath;}
+    const QDateTime& getLastModified() const {return m_lastModified;}
+    bool isNull() const {return m_levels.front().isNull();}
+    int width() const {return m_width;}
+    int height() const {return m_height;}
+    int getLevelsCount() const {return m_levelsCount;}
+
+    /**
+     * Smallest level that still has at least one image pixel per device pixel for the given scale
+     * (device pixels per pixel of full resolution image).
+     */
+    int levelFor(double scale) const;
+    QImage getLevel(int level);
+
+private:
+    QString m_filePath;
+    QDateTime m_lastModified;
+    int m_width = 0;
+    int m_height = 0;
+    int m_levelsCount = 1;
+    std::mutex m_mutex;
+    std::vector<QImage> m_levels;
+};
+
+/**
+ * Process-wide cache of decoded images, keyed by canonical file path and modification time.
+ *
+ * The cache keeps weak references only - images are released once no entity uses them anymore. A file
+ * modified on disk is decoded again on the next acquire, entities holding the old image keep it alive.
+ */
+class LC_ImageCache {
+public:
+    static LC_ImageCache* instance();
+
+    /**
+     * Returns shared image for the file. If file could not be read, returned image is null and
+     * is not cached.
+     */
+    std::shared_ptr<LC_CachedImage> acquire(const QString& filePath);
+    void clear();
+
+private:
+    LC_ImageCache() = default;
+
+    std::mutex m_mutex;
+    QHash<QString, std::weak_ptr<LC_CachedImage>> m_images;
+};
+
+#endif // LC_IMAGECACHE_H
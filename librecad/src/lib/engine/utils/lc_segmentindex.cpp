@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_segmentindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+    constexpr unsigned LEAF_SIZE = 8;
+}
+
+LC_SegmentIndex::LC_SegmentIndex(std::vector<Box> boxes)
+    :m_boxes{std::move(boxes)} {
+    m_ids.resize(m_boxes.size());
+    std::iota(m_ids.begin(), m_ids.end(), 0u);
+    if (!m_boxes.empty()) {
+        m_nodes.reserve(2 * m_boxes.size() / LEAF_SIZE + 1);
+        build(0, static_cast<unsigned>(m_ids.size()));
+    }
+}
+
+unsigned LC_SegmentIndex::build(unsigned first, unsigned last) {
+    unsigned nodeIndex = static_cast<unsigned>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    Box box = m_boxes[m_ids[first]];
+    RS_Vector centerMin = (box.minV + box.maxV) * 0.5;
+    RS_Vector centerMax = centerMin;
+    for (unsigned i = first + 1; i < last; i++) {
+        const Box& b = m_boxes[m_ids[i]];
+        box.minV = RS_Vector::minimum(box.minV, b.minV);
+        box.maxV = RS_Vector::maximum(box.maxV, b.maxV);
+        RS_Vector center = (b.minV + b.maxV) * 0.5;
+        centerMin = RS_Vector::minimum(centerMin, center);
+        centerMax = RS_Vector::maximum(centerMax, center);
+    }
+    m_nodes[nodeIndex].box = box;
+
+    if (last - first <= LEAF_SIZE) {
+        m_nodes[nodeIndex].first = first;
+        m_nodes[nodeIndex].count = last - first;
+        return nodeIndex;
+    }
+
+    // split by median of centers along the longer extent
+    bool byX = centerMax.x - centerMin.x >= centerMax.y - centerMin.y;
+    unsigned middle = first + (last - first) / 2;
+    std::nth_element(m_ids.begin() + first, m_ids.begin() + middle, m_ids.begin() + last,
+                     [this, byX](unsigned a, unsigned b) {
+                         const Box& ba = m_boxes[a];
+                         const Box& bb = m_boxes[b];
+                         return byX ? ba.minV.x + ba.maxV.x < bb.minV.x + bb.maxV.x
+                                    : ba.minV.y + ba.maxV.y < bb.minV.y + bb.maxV.y;
+                     });
+
+    unsigned left = build(first, middle);
+    unsigned right = build(middle, last);
+    m_nodes[nodeIndex].first = left;
+    m_nodes[nodeIndex].right = right;
+    return nodeIndex;
+}
+
+double LC_SegmentIndex::distanceToBox(const Box& box, const RS_Vector& coord) {
+    double dx = std::max({box.minV.x - coord.x, 0., coord.x - box.maxV.x});
+    double dy = std::max({box.minV.y - coord.y, 0., coord.y - box.maxV.y});
+    return std::hypot(dx, dy);
+}
+
+int LC_SegmentIndex::findNearest(const RS_Vector& coord, const std::function<double(size_t)>& distanceTo,
+                                 bool preferLast, double* distance) const {
+    int best = -1;
+    double bestDistance = RS_MAXDOUBLE;
+    if (!m_nodes.empty()) {
+        findNearest(0, coord, distanceTo, preferLast, best, bestDistance);
+    }
+    if (distance != nullptr) {
+        *distance = bestDistance;
+    }
+    return best;
+}
+
+void LC_SegmentIndex::findNearest(unsigned node, const RS_Vector& coord,
+                                  const std::function<double(size_t)>& distanceTo,
+                                  bool preferLast, int& best, double& bestDistance) const {
+    const Node& n = m_nodes[node];
+    if (n.count > 0) {
+        for (unsigned i = n.first; i < n.first + n.count; i++) {
+            unsigned id = m_ids[i];
+            double d = distanceTo(id);
+            bool better = best < 0 || d < bestDistance
+                          || (d == bestDistance && best >= 0 && (preferLast ? id > unsigned(best) : id < unsigned(best)));
+            if (better) {
+                bestDistance = d;
+                best = static_cast<int>(id);
+            }
+        }
+        return;
+    }
+
+    // visit closer child first, it most likely tightens the bound for the other one.
+    // Nodes at exactly the best distance are still visited, as they may win the tie.
+    unsigned children[2] = {n.first, n.right};
+    double distances[2] = {distanceToBox(m_nodes[n.first].box, coord),
+                           distanceToBox(m_nodes[n.right].box, coord)};
+    if (distances[1] < distances[0]) {
+        std::swap(children[0], children[1]);
+        std::swap(distances[0], distances[1]);
+    }
+    for (int i = 0; i < 2; i++) {
+        if (distances[i] <= bestDistance) {
+            findNearest(children[i], coord, distanceTo, preferLast, best, bestDistance);
+        }
+    }
+}
+
+std::vector<size_t> LC_SegmentIndex::findInBox(const RS_Vector& corner1, const RS_Vector& corner2,
+                                               double tolerance) const {
+    std::vector<size_t> result;
+    if (m_nodes.empty()) {
+        return result;
+    }
+    RS_Vector minV = RS_Vector::minimum(corner1, corner2) - RS_Vector(tolerance, tolerance);
+    RS_Vector maxV = RS_Vector::maximum(corner1, corner2) + RS_Vector(tolerance, tolerance);
+    auto overlaps = [&minV, &maxV](const Box& box) {
+        return box.minV.x <= maxV.x && box.maxV.x >= minV.x && box.minV.y <= maxV.y && box.maxV.y >= minV.y;
+    };
+
+    std::vector<unsigned> stack{0};
+    while (!stack.empty()) {
+        const Node& n = m_nodes[stack.back()];
+        stack.pop_back();
+        if (!overlaps(n.box)) {
+            continue;
+        }
+        if (n.count > 0) {
+            for (unsigned i = n.first; i < n.first + n.count; i++) {
+                if (overlaps(m_boxes[m_ids[i]])) {
+                    result.push_back(m_ids[i]);
+                }
+            }
+        }
+        else {
+            stack.push_back(n.first);
+            stack.push_back(n.right);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
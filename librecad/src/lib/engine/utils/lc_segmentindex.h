@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_SEGMENTINDEX_H
+#define LC_SEGMENTINDEX_H
+
+#include <functional>
+#include <vector>
+
+#include "rs.h"
+#include "rs_vector.h"
+
+/**
+ * Bounding volume hierarchy over segments of a single entity (sub-entities of a polyline, quadratic
+ * segments of a spline through points).
+ *
+ * Segments are identified by their position in the vector of bounding boxes passed on construction.
+ * The index is immutable, so it is rebuilt by the owner as soon as geometry of the owner is changed.
+ * The index pays off only for entities with many segments, see MIN_SEGMENTS.
+ */
+class LC_SegmentIndex {
+public:
+    struct Box {
+        RS_Vector minV;
+        RS_Vector maxV;
+    };
+
+    static constexpr size_t MIN_SEGMENTS = 32;
+
+    explicit LC_SegmentIndex(std::vector<Box> boxes);
+
+    size_t size() const {return m_boxes.size();}
+
+    /**
+     * Finds the segment nearest to the given point. The distance function is called only for segments
+     * which bounding boxes are not farther than the best distance found so far.
+     * @param distanceTo returns distance from coord to the segment with given id
+     * @param preferLast if distances are equal, the segment with larger id wins; otherwise the first one
+     * @param distance optional, set to distance to the found segment
+     * @return id of the nearest segment, or -1 if the index is empty
+     */
+    int findNearest(const RS_Vector& coord, const std::function<double(size_t)>& distanceTo,
+                    bool preferLast, double* distance = nullptr) const;
+    /**
+     * @return ids of segments which bounding boxes intersect the given box, in ascending order
+     */
+    std::vector<size_t> findInBox(const RS_Vector& corner1, const RS_Vector& corner2,
+                                  double tolerance = RS_TOLERANCE) const;
+
+private:
+    struct Node {
+        Box box;
+        // leaf: range in m_ids; internal node: indexes of the left (first) and right children
+        unsigned first = 0;
+        unsigned count = 0;
+        unsigned right = 0;
+    };
+
+    unsigned build(unsigned first, unsigned last);
+    static double distanceToBox(const Box& box, const RS_Vector& coord);
+    void findNearest(unsigned node, const RS_Vector& coord, const std::function<double(size_t)>& distanceTo,
+                     bool preferLast, int& best, double& bestDistance) const;
+
+    std::vector<Box> m_boxes;
+    std::vector<unsigned> m_ids;
+    std::vector<Node> m_nodes;
+};
+
+#endif // LC_SEGMENTINDEX_H
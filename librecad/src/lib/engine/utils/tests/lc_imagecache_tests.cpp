@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_imagecache.h"
+
+namespace {
+QString writeImage(const QTemporaryDir& dir, const QString& name, int width, int height) {
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(Qt::darkCyan);
+    QString path = dir.filePath(name);
+    REQUIRE(image.save(path, "PNG"));
+    return path;
+}
+}
+
+TEST_CASE("LC_ImageCache shares decoded images of the same file", "[LC_ImageCache]") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString path = writeImage(dir, "shared.png", 100, 60);
+
+    auto first = LC_ImageCache::instance()->acquire(path);
+    REQUIRE_FALSE(first->isNull());
+    REQUIRE(first->width() == 100);
+    REQUIRE(first->height() == 60);
+
+    // same file, also by a path that is not canonical
+    auto second = LC_ImageCache::instance()->acquire(dir.path() + "/./shared.png");
+    REQUIRE(second == first);
+
+    SECTION("modified file is decoded again") {
+        writeImage(dir, "shared.png", 40, 20);
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::ReadWrite));
+        REQUIRE(file.setFileTime(first->getLastModified().addSecs(10), QFileDevice::FileModificationTime));
+        file.close();
+
+        auto modified = LC_ImageCache::instance()->acquire(path);
+        REQUIRE(modified != first);
+        REQUIRE(modified->width() == 40);
+        // holders of the old image keep it
+        REQUIRE(first->width() == 100);
+    }
+
+    SECTION("missing file") {
+        auto missing = LC_ImageCache::instance()->acquire(dir.filePath("missing.png"));
+        REQUIRE(missing->isNull());
+        REQUIRE(LC_ImageCache::instance()->acquire(dir.filePath("missing.png")) != missing);
+    }
+}
+
+TEST_CASE("LC_CachedImage selects pyramid level by scale", "[LC_ImageCache]") {
+    QImage source(100, 60, QImage::Format_RGB32);
+    source.fill(Qt::white);
+    LC_CachedImage image("test.png", QDateTime(), source);
+    // 100x60, 50x30, 25x15, 13x8, 7x4, 4x2, 2x1
+    REQUIRE(image.getLevelsCount() == 7);
+
+    // at least one image pixel per device pixel
+    REQUIRE(image.levelFor(2.0) == 0);
+    REQUIRE(image.levelFor(1.0) == 0);
+    REQUIRE(image.levelFor(0.5) == 0);
+    REQUIRE(image.levelFor(0.3) == 1);
+    REQUIRE(image.levelFor(0.25) == 2);
+    REQUIRE(image.levelFor(0.1) == 3);
+    // limited by the smallest level
+    REQUIRE(image.levelFor(1e-6) == 6);
+    REQUIRE(image.levelFor(0.) == 0);
+    REQUIRE(image.levelFor(-1.) == 0);
+
+    // levels are built on request, also skipping levels in between
+    QImage level2 = image.getLevel(2);
+    REQUIRE(level2.width() == 25);
+    REQUIRE(level2.height() == 15);
+    QImage level1 = image.getLevel(1);
+    REQUIRE(level1.width() == 50);
+    REQUIRE(level1.height() == 30);
+    REQUIRE(image.getLevel(0).width() == 100);
+    // requests beyond the last level return the last one
+    REQUIRE(image.getLevel(100).width() == 2);
+    REQUIRE(image.getLevel(100).height() == 1);
+}
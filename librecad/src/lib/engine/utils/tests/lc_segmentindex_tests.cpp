@@ -0,0 +1,217 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_segmentindex.h"
+#include "rs_line.h"
+#include "rs_polyline.h"
+
+namespace {
+struct Segment {
+    RS_Vector start;
+    RS_Vector end;
+};
+
+std::vector<Segment> makeSegments(size_t count, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<double> position{-100., 100.};
+    std::uniform_real_distribution<double> offset{-5., 5.};
+    std::vector<Segment> segments;
+    for (size_t i = 0; i < count; ++i) {
+        RS_Vector start{position(generator), position(generator)};
+        segments.push_back({start, start + RS_Vector{offset(generator), offset(generator)}});
+    }
+    return segments;
+}
+
+std::vector<LC_SegmentIndex::Box> makeBoxes(const std::vector<Segment>& segments) {
+    std::vector<LC_SegmentIndex::Box> boxes;
+    for (const Segment& s : segments) {
+        boxes.push_back({RS_Vector::minimum(s.start, s.end), RS_Vector::maximum(s.start, s.end)});
+    }
+    return boxes;
+}
+
+double distanceToSegment(const Segment& segment, const RS_Vector& coord) {
+    const RS_Vector direction = segment.end - segment.start;
+    const double length2 = direction.squared();
+    double t = length2 > 0. ? RS_Vector::dotP(coord - segment.start, direction) / length2 : 0.;
+    t = std::max(0., std::min(1., t));
+    return (segment.start + direction * t).distanceTo(coord);
+}
+
+void zigzag(RS_Polyline& polyline) {
+    for (int i = 1; i <= 200; ++i) {
+        // zigzag, so that segment boxes overlap in x only partly
+        polyline.addVertex({i * 1., (i % 2) * 3.});
+    }
+    polyline.calculateBorders();
+    REQUIRE(polyline.count() >= LC_SegmentIndex::MIN_SEGMENTS);
+}
+
+void requireSameAsContainerSearch(const RS_Polyline& polyline, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<double> x{-10., 210.};
+    std::uniform_real_distribution<double> y{-10., 13.};
+    for (int i = 0; i < 100; ++i) {
+        const RS_Vector coord{x(generator), y(generator)};
+        RS_Entity* nearest = nullptr;
+        const double distance = polyline.getDistanceToPoint(coord, &nearest, RS2::ResolveNone);
+        RS_Entity* expected = nullptr;
+        const double expectedDistance = polyline.RS_EntityContainer::getDistanceToPoint(coord, &expected,
+                                                                                       RS2::ResolveNone);
+        REQUIRE(distance == expectedDistance);
+        REQUIRE(nearest == expected);
+    }
+}
+}
+
+TEST_CASE("LC_SegmentIndex finds the same nearest segment as linear search") {
+    const std::vector<Segment> segments = makeSegments(500, 1);
+    const LC_SegmentIndex index{makeBoxes(segments)};
+    REQUIRE(index.size() == segments.size());
+
+    std::mt19937 generator{2};
+    std::uniform_real_distribution<double> position{-120., 120.};
+    for (int i = 0; i < 200; ++i) {
+        const RS_Vector coord{position(generator), position(generator)};
+        int expected = -1;
+        double expectedDistance = RS_MAXDOUBLE;
+        for (size_t j = 0; j < segments.size(); ++j) {
+            const double d = distanceToSegment(segments[j], coord);
+            if (d < expectedDistance) {
+                expectedDistance = d;
+                expected = static_cast<int>(j);
+            }
+        }
+        size_t calls = 0;
+        double distance = RS_MAXDOUBLE;
+        const int nearest = index.findNearest(coord, [&segments, &coord, &calls](size_t j) {
+            ++calls;
+            return distanceToSegment(segments[j], coord);
+        }, false, &distance);
+        REQUIRE(nearest == expected);
+        REQUIRE(distance == expectedDistance);
+        // boxes farther than the best distance are pruned
+        REQUIRE(calls < segments.size());
+    }
+}
+
+TEST_CASE("LC_SegmentIndex resolves equal distances by preferLast") {
+    const Segment segment{{0., 0.}, {10., 0.}};
+    std::vector<Segment> segments = makeSegments(100, 3);
+    segments[17] = segment;
+    segments[63] = segment;
+    const LC_SegmentIndex index{makeBoxes(segments)};
+    const RS_Vector coord{5., 1.};
+    const auto distanceTo = [&segments, &coord](size_t j) {
+        return distanceToSegment(segments[j], coord);
+    };
+    REQUIRE(index.findNearest(coord, distanceTo, false) == 17);
+    REQUIRE(index.findNearest(coord, distanceTo, true) == 63);
+}
+
+TEST_CASE("LC_SegmentIndex finds boxes intersecting a window in ascending order") {
+    const std::vector<Segment> segments = makeSegments(400, 4);
+    const std::vector<LC_SegmentIndex::Box> boxes = makeBoxes(segments);
+    const LC_SegmentIndex index{boxes};
+
+    std::mt19937 generator{5};
+    std::uniform_real_distribution<double> position{-110., 110.};
+    for (int i = 0; i < 100; ++i) {
+        // corners are given in any order
+        const RS_Vector corner1{position(generator), position(generator)};
+        const RS_Vector corner2{position(generator), position(generator)};
+        const RS_Vector minV = RS_Vector::minimum(corner1, corner2);
+        const RS_Vector maxV = RS_Vector::maximum(corner1, corner2);
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < boxes.size(); ++j) {
+            if (boxes[j].maxV.x >= minV.x - RS_TOLERANCE && boxes[j].minV.x <= maxV.x + RS_TOLERANCE
+                && boxes[j].maxV.y >= minV.y - RS_TOLERANCE && boxes[j].minV.y <= maxV.y + RS_TOLERANCE) {
+                expected.push_back(j);
+            }
+        }
+        REQUIRE(index.findInBox(corner1, corner2) == expected);
+    }
+}
+
+TEST_CASE("LC_SegmentIndex handles an empty index") {
+    const LC_SegmentIndex index{{}};
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.findNearest({0., 0.}, [](size_t) {return 0.;}, false) == -1);
+    REQUIRE(index.findInBox({-1., -1.}, {1., 1.}).empty());
+}
+
+TEST_CASE("RS_Polyline with a segment index matches the container search") {
+    RS_Polyline polyline{nullptr, {{0., 0.}, {0., 0.}, false}};
+    zigzag(polyline);
+    requireSameAsContainerSearch(polyline, 6);
+
+    const std::vector<RS_Entity*> inBox = polyline.getSegmentsInBox({50.5, -1.}, {52.5, 4.});
+    // segment i runs from x = i to x = i + 1
+    REQUIRE(inBox.size() == 3);
+    REQUIRE(inBox.front() == polyline.entityAt(50));
+    REQUIRE(inBox.back() == polyline.entityAt(52));
+}
+
+TEST_CASE("RS_Polyline segment index follows in-place changes") {
+    RS_Polyline polyline{nullptr, {{0., 0.}, {0., 0.}, false}};
+    zigzag(polyline);
+    // builds the index
+    requireSameAsContainerSearch(polyline, 7);
+
+    SECTION("reverted direction") {
+        polyline.revertDirection();
+        requireSameAsContainerSearch(polyline, 8);
+        const std::vector<RS_Entity*> inBox = polyline.getSegmentsInBox({50.5, -1.}, {52.5, 4.});
+        REQUIRE(inBox.size() == 3);
+        REQUIRE(inBox.front() == polyline.entityAt(147));
+        REQUIRE(inBox.back() == polyline.entityAt(149));
+    }
+
+    SECTION("segment moved directly") {
+        RS_Entity* segment = polyline.entityAt(10);
+        segment->move({0., 100.});
+        RS_Entity* nearest = nullptr;
+        polyline.getDistanceToPoint({10.5, 101.5}, &nearest, RS2::ResolveNone);
+        REQUIRE(nearest == segment);
+        const std::vector<RS_Entity*> inBox = polyline.getSegmentsInBox({10., 99.}, {11., 105.});
+        REQUIRE(inBox.size() == 1);
+        REQUIRE(inBox.front() == segment);
+        requireSameAsContainerSearch(polyline, 9);
+    }
+
+    SECTION("clone") {
+        std::unique_ptr<RS_Entity> clone{polyline.clone()};
+        auto* clonedPolyline = static_cast<RS_Polyline*>(clone.get());
+        requireSameAsContainerSearch(*clonedPolyline, 10);
+        clonedPolyline->entityAt(0)->move({0., 50.});
+        requireSameAsContainerSearch(*clonedPolyline, 11);
+        requireSameAsContainerSearch(polyline, 11);
+    }
+}
@@ -0,0 +1,546 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_documentcache.h"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QThreadPool>
+
+#include "lc_importmonitor.h"
+#include "lc_regenscheduler.h"
+#include "lc_trace.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_blocklist.h"
+#include "rs_circle.h"
+#include "rs_debug.h"
+#include "rs_ellipse.h"
+#include "rs_fileio.h"
+#include "rs_filterdxfrw.h"
+#include "rs_graphic.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_point.h"
+#include "rs_polyline.h"
+#include "rs_settings.h"
+
+namespace {
+    // should be increased if the filter changes the way drawings are imported, so older copies are not used
+    constexpr char const* CACHE_VERSION = "2";
+    constexpr qint64 HASH_BLOCK_SIZE = 1 << 20;
+    // copies of documents that were not opened recently are removed
+    constexpr int MAX_CACHED_DOCUMENTS = 32;
+    constexpr quint32 REGEN_MAGIC = 0x47524c4c; // "LLRG"
+    constexpr quint32 REGEN_VERSION = 1;
+    constexpr qint64 REGEN_HEADER_SIZE = 12;
+
+    void removeOldCopies(const QDir &cacheDir) {
+        QFileInfoList copies = cacheDir.entryInfoList({"*.dxf"}, QDir::Files, QDir::Time);
+        for (int i = MAX_CACHED_DOCUMENTS; i < copies.size(); i++) {
+            QString copy = copies.at(i).absoluteFilePath();
+            QFile::remove(copy);
+            QFile::remove(copy.chopped(4) + QLatin1String(".regen"));
+        }
+    }
+
+    /**
+     * @return inserts in the order of their records: inserts of blocks, then inserts of the drawing.
+     * A copy read from the cache has the same order of inserts as the drawing it was written from.
+     */
+    std::vector<RS_Entity*> collectInserts(RS_Graphic &graphic) {
+        std::vector<RS_Entity*> inserts;
+        for (RS_Block* block: *graphic.getBlockList()) {
+            LC_RegenScheduler::collectInserts(block, inserts);
+        }
+        LC_RegenScheduler::collectInserts(&graphic, inserts);
+        return inserts;
+    }
+
+    /**
+     * @return true if the entity and all its children may be restored. Letters of texts are inserts of
+     * font blocks, which are not in the drawing, so texts are not restored.
+     */
+    bool isRestorable(const RS_Entity* entity) {
+        switch (entity->rtti()) {
+            case RS2::EntityPoint:
+            case RS2::EntityLine:
+            case RS2::EntityArc:
+            case RS2::EntityCircle:
+            case RS2::EntityEllipse:
+                return true;
+            case RS2::EntityInsert:
+                if (static_cast<const RS_Insert*>(entity)->getData().blockSource != nullptr) {
+                    return false;
+                }
+                [[fallthrough]];
+            case RS2::EntityPolyline: {
+                auto container = static_cast<const RS_EntityContainer*>(entity);
+                return std::all_of(container->begin(), container->end(), isRestorable);
+            }
+            default:
+                return false;
+        }
+    }
+
+    void writeVector(QDataStream &stream, const RS_Vector &v) {
+        stream << v.x << v.y << v.valid;
+    }
+
+    RS_Vector readVector(QDataStream &stream) {
+        RS_Vector v;
+        stream >> v.x >> v.y >> v.valid;
+        return v;
+    }
+
+    void writePen(QDataStream &stream, const RS_Pen &pen) {
+        RS_Color color = pen.getColor();
+        stream << static_cast<qint32>(pen.getLineType()) << static_cast<qint32>(pen.getWidth())
+               << color.toQColor() << color.getFlags() << pen.getFlags() << pen.getAlpha() << pen.dashOffset();
+    }
+
+    RS_Pen readPen(QDataStream &stream) {
+        qint32 lineType = 0;
+        qint32 width = 0;
+        QColor qcolor;
+        quint32 colorFlags = 0;
+        quint32 penFlags = 0;
+        float alpha = 1.f;
+        double dashOffset = 0.;
+        stream >> lineType >> width >> qcolor >> colorFlags >> penFlags >> alpha >> dashOffset;
+        RS_Color color(qcolor);
+        color.setFlags(colorFlags);
+        RS_Pen pen(color, static_cast<RS2::LineWidth>(width), static_cast<RS2::LineType>(lineType));
+        pen.setFlags(penFlags);
+        pen.setAlpha(alpha);
+        pen.setDashOffset(dashOffset);
+        return pen;
+    }
+
+    void writeChildren(QDataStream &stream, const RS_EntityContainer &container);
+
+    void writeEntity(QDataStream &stream, const RS_Entity* entity) {
+        const RS_Layer* layer = entity->getLayer(false);
+        stream << static_cast<qint32>(entity->rtti()) << (layer != nullptr ? layer->getName() : QString());
+        writePen(stream, entity->getPen(false));
+        stream << entity->getFlag(RS2::FlagVisible);
+        switch (entity->rtti()) {
+            case RS2::EntityPoint:
+                writeVector(stream, static_cast<const RS_Point*>(entity)->getPos());
+                break;
+            case RS2::EntityLine:
+                writeVector(stream, entity->getStartpoint());
+                writeVector(stream, entity->getEndpoint());
+                break;
+            case RS2::EntityArc: {
+                const RS_ArcData &data = static_cast<const RS_Arc*>(entity)->getData();
+                writeVector(stream, data.center);
+                stream << data.radius << data.angle1 << data.angle2 << data.reversed;
+                break;
+            }
+            case RS2::EntityCircle: {
+                const RS_CircleData &data = static_cast<const RS_Circle*>(entity)->getData();
+                writeVector(stream, data.center);
+                stream << data.radius;
+                break;
+            }
+            case RS2::EntityEllipse: {
+                const RS_EllipseData &data = static_cast<const RS_Ellipse*>(entity)->getData();
+                writeVector(stream, data.center);
+                writeVector(stream, data.majorP);
+                stream << data.ratio << data.angle1 << data.angle2 << data.reversed;
+                break;
+            }
+            case RS2::EntityPolyline: {
+                auto polyline = static_cast<const RS_Polyline*>(entity);
+                writeVector(stream, polyline->getStartpoint());
+                writeVector(stream, polyline->getEndpoint());
+                stream << polyline->isClosed();
+                writeChildren(stream, *polyline);
+                break;
+            }
+            case RS2::EntityInsert: {
+                auto insert = static_cast<const RS_Insert*>(entity);
+                RS_InsertData data = insert->getData();
+                stream << data.name;
+                writeVector(stream, data.insertionPoint);
+                writeVector(stream, data.scaleFactor);
+                stream << data.angle << static_cast<qint32>(data.cols) << static_cast<qint32>(data.rows);
+                writeVector(stream, data.spacing);
+                writeChildren(stream, *insert);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void writeChildren(QDataStream &stream, const RS_EntityContainer &container) {
+        stream << static_cast<quint32>(container.count());
+        for (const RS_Entity* child: container) {
+            writeEntity(stream, child);
+        }
+    }
+
+    bool readChildren(QDataStream &stream, RS_EntityContainer &container, RS_Graphic &graphic);
+
+    /**
+     * @return the entity read from the stream, or nullptr if the stream is invalid
+     */
+    RS_Entity* readEntity(QDataStream &stream, RS_EntityContainer* parent, RS_Graphic &graphic) {
+        qint32 rtti = 0;
+        QString layerName;
+        stream >> rtti >> layerName;
+        RS_Pen pen = readPen(stream);
+        bool visible = false;
+        stream >> visible;
+
+        std::unique_ptr<RS_Entity> entity;
+        switch (rtti) {
+            case RS2::EntityPoint:
+                entity = std::make_unique<RS_Point>(parent, RS_PointData(readVector(stream)));
+                break;
+            case RS2::EntityLine: {
+                RS_Vector start = readVector(stream);
+                RS_Vector end = readVector(stream);
+                entity = std::make_unique<RS_Line>(parent, start, end);
+                break;
+            }
+            case RS2::EntityArc: {
+                RS_ArcData data;
+                data.center = readVector(stream);
+                stream >> data.radius >> data.angle1 >> data.angle2 >> data.reversed;
+                entity = std::make_unique<RS_Arc>(parent, data);
+                break;
+            }
+            case RS2::EntityCircle: {
+                RS_CircleData data;
+                data.center = readVector(stream);
+                stream >> data.radius;
+                entity = std::make_unique<RS_Circle>(parent, data);
+                break;
+            }
+            case RS2::EntityEllipse: {
+                RS_EllipseData data;
+                data.center = readVector(stream);
+                data.majorP = readVector(stream);
+                stream >> data.ratio >> data.angle1 >> data.angle2 >> data.reversed;
+                entity = std::make_unique<RS_Ellipse>(parent, data);
+                break;
+            }
+            case RS2::EntityPolyline: {
+                RS_Vector start = readVector(stream);
+                RS_Vector end = readVector(stream);
+                bool closed = false;
+                stream >> closed;
+                entity = std::make_unique<RS_Polyline>(parent, RS_PolylineData(start, end, closed));
+                break;
+            }
+            case RS2::EntityInsert: {
+                QString name;
+                stream >> name;
+                RS_Vector insertionPoint = readVector(stream);
+                RS_Vector scaleFactor = readVector(stream);
+                double angle = 0.;
+                qint32 cols = 0;
+                qint32 rows = 0;
+                stream >> angle >> cols >> rows;
+                RS_Vector spacing = readVector(stream);
+                entity = std::make_unique<RS_Insert>(parent, RS_InsertData(name, insertionPoint, scaleFactor, angle,
+                                                                           cols, rows, spacing, nullptr,
+                                                                           RS2::NoUpdate));
+                break;
+            }
+            default:
+                return nullptr;
+        }
+        if (stream.status() != QDataStream::Ok) {
+            return nullptr;
+        }
+        entity->setLayer(layerName.isNull() ? nullptr : graphic.findLayer(layerName));
+        entity->setPen(pen);
+        entity->setVisible(visible);
+        if (entity->isContainer() && !readChildren(stream, *static_cast<RS_EntityContainer*>(entity.get()), graphic)) {
+            return nullptr;
+        }
+        return entity.release();
+    }
+
+    bool readChildren(QDataStream &stream, RS_EntityContainer &container, RS_Graphic &graphic) {
+        quint32 count = 0;
+        stream >> count;
+        for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+            RS_Entity* child = readEntity(stream, &container, graphic);
+            if (child == nullptr) {
+                return false;
+            }
+            container.appendEntity(child);
+        }
+        container.calculateBorders();
+        return stream.status() == QDataStream::Ok;
+    }
+
+    /**
+     * Writes the children of inserts of the regenerated graphic. Each insert has a record with its name,
+     * and with its children if they may be restored.
+     */
+    bool writeRegenerated(RS_Graphic &graphic, const QString &fileName) {
+        LC_TRACE_SCOPE("import", "store regenerated inserts");
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return false;
+        }
+        std::vector<RS_Entity*> inserts = collectInserts(graphic);
+        QDataStream header(&file);
+        header.setByteOrder(QDataStream::LittleEndian);
+        header << REGEN_MAGIC << REGEN_VERSION << static_cast<quint32>(inserts.size());
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_6_0);
+        for (RS_Entity* e: inserts) {
+            auto insert = static_cast<RS_Insert*>(e);
+            bool restorable = isRestorable(insert);
+            stream << insert->getName() << restorable;
+            if (restorable) {
+                writeChildren(stream, *insert);
+            }
+        }
+        return header.status() == QDataStream::Ok && stream.status() == QDataStream::Ok && file.flush();
+    }
+
+    /**
+     * Restores children of inserts of the graphic read from the copy.
+     * @return restored inserts. If the records don't match the inserts, none is restored, and children
+     * read so far are dropped when the inserts are regenerated.
+     */
+    std::unordered_set<const RS_Entity*> restoreRegenerated(RS_Graphic &graphic, const QString &fileName) {
+        LC_TRACE_SCOPE("import", "restore regenerated inserts");
+        std::unordered_set<const RS_Entity*> restored;
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly) || file.size() < REGEN_HEADER_SIZE) {
+            return restored;
+        }
+        // the file is mapped, so records are read without copying the file
+        uchar* mapped = file.map(0, file.size());
+        if (mapped == nullptr) {
+            return restored;
+        }
+        QDataStream header(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), REGEN_HEADER_SIZE));
+        header.setByteOrder(QDataStream::LittleEndian);
+        quint32 magic = 0;
+        quint32 version = 0;
+        quint32 count = 0;
+        header >> magic >> version >> count;
+        std::vector<RS_Entity*> inserts = collectInserts(graphic);
+        if (magic != REGEN_MAGIC || version != REGEN_VERSION || count != inserts.size()) {
+            return restored;
+        }
+
+        QDataStream stream(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped) + REGEN_HEADER_SIZE,
+                                                   file.size() - REGEN_HEADER_SIZE));
+        stream.setVersion(QDataStream::Qt_6_0);
+        for (RS_Entity* e: inserts) {
+            auto insert = static_cast<RS_Insert*>(e);
+            QString name;
+            bool restorable = false;
+            stream >> name >> restorable;
+            bool valid = stream.status() == QDataStream::Ok && name == insert->getName();
+            if (valid && restorable) {
+                valid = readChildren(stream, *insert, graphic);
+                restored.insert(insert);
+            }
+            if (!valid) {
+                LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING, "LC_DocumentCache: invalid regenerated inserts '%s'",
+                                     fileName.toLatin1().data());
+                return {};
+            }
+        }
+        return restored;
+    }
+
+    /**
+     * Writes copies of documents one by one on a background thread. Pending copies are dropped and
+     * the running import is cancelled when the application quits.
+     */
+    class BackgroundStore {
+    public:
+        static BackgroundStore& instance() {
+            static BackgroundStore store;
+            return store;
+        }
+
+        ~BackgroundStore() {
+            cancel();
+        }
+
+        void start(const QString &fileName, RS2::FormatType type, std::shared_ptr<RS_Graphic> graphic) {
+            m_pool.start([this, fileName, type, graphic]() {
+                QString errorMessage;
+                if (!m_monitor.isCancelled() &&
+                    RS_FileIO::instance()->importFile(*graphic, fileName, type, errorMessage, &m_monitor)) {
+                    LC_DocumentCache(fileName).store(*graphic);
+                }
+            });
+        }
+
+    private:
+        BackgroundStore() {
+            m_pool.setMaxThreadCount(1);
+            if (QCoreApplication::instance() != nullptr) {
+                QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, [this]() {
+                    cancel();
+                });
+            }
+        }
+
+        void cancel() {
+            m_pool.clear();
+            m_monitor.cancel();
+            m_pool.waitForDone();
+        }
+
+        QThreadPool m_pool;
+        LC_ImportMonitor m_monitor;
+    };
+}
+
+LC_DocumentCache::LC_DocumentCache(const QString &fileName):m_fileName{fileName} {}
+
+bool LC_DocumentCache::isEnabled() const {
+    if (!LC_GET_ONE_BOOL("Defaults", "DocumentCache", false)) {
+        return false;
+    }
+    RS2::FormatType type = RS_FileIO::detectFormat(m_fileName, false);
+    return type == RS2::FormatDXFRW || type == RS2::FormatDWG;
+}
+
+/**
+ * @return name of the cached copy for the current content of the file, empty if the file can't be read
+ */
+QString LC_DocumentCache::cacheFileName() {
+    if (m_hashed) {
+        return m_cacheFileName;
+    }
+    m_hashed = true;
+
+    QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QFile file(m_fileName);
+    if (cacheLocation.isEmpty() || !file.open(QIODevice::ReadOnly)) {
+        return m_cacheFileName;
+    }
+    LC_TRACE_SCOPE("import", "document hash");
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray(CACHE_VERSION));
+    while (!file.atEnd()) {
+        QByteArray block = file.read(HASH_BLOCK_SIZE);
+        if (block.isEmpty()) {
+            return m_cacheFileName;
+        }
+        hash.addData(block);
+    }
+    m_cacheFileName = cacheLocation + QLatin1String("/documents/") + QString::fromLatin1(hash.result().toHex()) +
+                      QLatin1String(".dxf");
+    return m_cacheFileName;
+}
+
+/**
+ * @return name of the file with regenerated inserts of the cached copy
+ */
+QString LC_DocumentCache::regenFileName(const QString &cacheFile) {
+    return cacheFile.chopped(4) + QLatin1String(".regen");
+}
+
+bool LC_DocumentCache::load(RS_Graphic &graphic, LC_ImportMonitor* monitor) {
+    QString cacheFile = cacheFileName();
+    if (cacheFile.isEmpty() || !QFileInfo::exists(cacheFile)) {
+        return false;
+    }
+    LC_TRACE_SCOPE("import", "cached document");
+    QString regenFile = regenFileName(cacheFile);
+    // relative paths of images are resolved against the original file, not against the copy
+    graphic.setFilename(m_fileName);
+    RS_FilterDXFRW filter;
+    filter.setImportMonitor(monitor);
+    filter.setInsertsRestorer([&regenFile](RS_Graphic &g) {
+        return restoreRegenerated(g, regenFile);
+    });
+    if (filter.fileImport(graphic, cacheFile, RS2::FormatDXFRW)) {
+        // keeps recently used copies from removal
+        QFile copy(cacheFile);
+        if (copy.open(QIODevice::ReadWrite)) {
+            copy.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        }
+        LC_DEBUG_PRINT("LC_DocumentCache::load: '%s' is loaded from cache", m_fileName.toLatin1().data());
+        return true;
+    }
+    if (monitor == nullptr || !monitor->isCancelled()) {
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING, "LC_DocumentCache::load: removing invalid cached copy '%s'",
+                             cacheFile.toLatin1().data());
+        QFile::remove(cacheFile);
+        QFile::remove(regenFile);
+    }
+    return false;
+}
+
+bool LC_DocumentCache::store(RS_Graphic &graphic) {
+    QString cacheFile = cacheFileName();
+    if (cacheFile.isEmpty() || QFileInfo::exists(cacheFile) || !QDir().mkpath(QFileInfo(cacheFile).absolutePath())) {
+        return false;
+    }
+    LC_TRACE_SCOPE("import", "store cached document");
+    // files are written under temporary names, and the copy is renamed last, so a partially written
+    // copy is never loaded
+    QString tempFile = cacheFile + QLatin1String(".tmp");
+    QString regenFile = regenFileName(cacheFile);
+    QString tempRegenFile = regenFile + QLatin1String(".tmp");
+    RS_FilterDXFRW filter;
+    filter.setBinaryExport(true);
+    QFile::remove(regenFile);
+    if (!filter.fileExport(graphic, tempFile, RS2::FormatDXFRW2018) || !writeRegenerated(graphic, tempRegenFile) ||
+        !QFile::rename(tempRegenFile, regenFile) || !QFile::rename(tempFile, cacheFile)) {
+        QFile::remove(tempFile);
+        QFile::remove(tempRegenFile);
+        QFile::remove(regenFile);
+        return false;
+    }
+    removeOldCopies(QFileInfo(cacheFile).dir());
+    return true;
+}
+
+void LC_DocumentCache::storeInBackground(const QString &fileName, RS2::FormatType type) {
+    // the graphic is created on the GUI thread, as it reads defaults from settings
+    auto graphic = std::make_shared<RS_Graphic>();
+    graphic->newDoc();
+    BackgroundStore::instance().start(fileName, type, std::move(graphic));
+}
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#ifndef LC_DOCUMENTCACHE_H
+#define LC_DOCUMENTCACHE_H
+
+#include <QByteArray>
+#include <QString>
+
+#include "rs.h"
+
+class LC_ImportMonitor;
+class RS_Graphic;
+
+/**
+ * Optional cache that speeds up reopening of unchanged drawings.
+ *
+ * A copy of the drawing as it was imported is written in binary DXF to the cache directory of the
+ * application. The name of the copy is derived from a hash of the content of the original file, so
+ * a changed file never matches a stale copy. Binary DXF stores numbers as is, so reading it skips
+ * conversion of text that takes most of the parse time of large drawings, and the copy contains only
+ * data that LibreCAD supports.
+ *
+ * Next to the copy, the regenerated content of inserts is stored in a memory mapped file. Inserts
+ * restored from it are not regenerated when the copy is read. Inserts that contain entities other than
+ * points, lines, arcs, circles, ellipses, polylines and nested inserts are regenerated as usual, as are
+ * texts, hatches and dimensions.
+ *
+ * If the copy can't be read, it is removed and the original file is imported as usual.
+ */
+class LC_DocumentCache {
+public:
+    explicit LC_DocumentCache(const QString &fileName);
+
+    /**
+     * @return true if caching of documents is enabled in settings and supported for the file
+     */
+    bool isEnabled() const;
+    /**
+     * Imports the cached copy of the file into the graphic.
+     * @return false if there is no valid copy. The graphic may be partially filled in this case.
+     */
+    bool load(RS_Graphic &graphic, LC_ImportMonitor* monitor);
+    /**
+     * Writes the graphic imported from the file to the cache.
+     */
+    bool store(RS_Graphic &graphic);
+    /**
+     * Imports the file once more on a background thread and writes it to the cache. The document that
+     * is open is not used, so opening of the file is not delayed by writing and the document may be
+     * edited meanwhile. Must be called on the GUI thread.
+     */
+    static void storeInBackground(const QString &fileName, RS2::FormatType type);
+private:
+    QString cacheFileName();
+    static QString regenFileName(const QString &cacheFile);
+
+    QString m_fileName;
+    QString m_cacheFileName;
+    bool m_hashed = false;
+};
+
+#endif // LC_DOCUMENTCACHE_H
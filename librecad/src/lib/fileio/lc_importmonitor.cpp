@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_importmonitor.h"
+
+#include <QObject>
+
+QString LC_ImportMonitor::getSectionName() const {
+    switch (getSection()) {
+        case Preparing:
+            return QObject::tr("Preparing");
+        case Header:
+            return QObject::tr("Reading header");
+        case Tables:
+            return QObject::tr("Reading tables");
+        case Blocks:
+            return QObject::tr("Reading blocks");
+        case Entities:
+            return QObject::tr("Reading entities");
+        case Objects:
+            return QObject::tr("Reading objects");
+        case Finishing:
+            return QObject::tr("Finishing");
+        default:
+            return QString();
+    }
+}
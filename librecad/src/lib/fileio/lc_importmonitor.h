@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_IMPORTMONITOR_H
+#define LC_IMPORTMONITOR_H
+
+#include <atomic>
+#include <cstddef>
+
+#include <QString>
+
+/**
+ * Shared state of a file import running on a worker thread.
+ *
+ * The filter reports the section of the file it reads and counts imported
+ * entities, the GUI thread polls the progress and may request cancellation.
+ * A filter that finds the import cancelled throws LC_ImportCancelled out of its
+ * reader callbacks and returns false from fileImport().
+ */
+class LC_ImportMonitor {
+public:
+    enum Section {
+        Preparing,
+        Header,
+        Tables,
+        Blocks,
+        Entities,
+        Objects,
+        Finishing
+    };
+
+    void setSection(Section section) {
+        m_section.store(section, std::memory_order_relaxed);
+    }
+
+    Section getSection() const {
+        return m_section.load(std::memory_order_relaxed);
+    }
+
+    void entityImported() {
+        m_entitiesCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t getEntitiesCount() const {
+        return m_entitiesCount.load(std::memory_order_relaxed);
+    }
+
+    void cancel() {
+        m_cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool isCancelled() const {
+        return m_cancelled.load(std::memory_order_relaxed);
+    }
+
+    QString getSectionName() const;
+private:
+    std::atomic<Section> m_section {Preparing};
+    std::atomic<size_t> m_entitiesCount {0};
+    std::atomic<bool> m_cancelled {false};
+};
+
+/**
+ * Thrown by filters from reader callbacks to abort cancelled import.
+ */
+struct LC_ImportCancelled {};
+
+#endif // LC_IMPORTMONITOR_H
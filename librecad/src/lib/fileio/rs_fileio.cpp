@@ -38,6 +38,7 @@
 #include "rs_filterjww.h"
 #include "rs_filterlff.h"
 #include "rs_filterdxfrw.h"
+#include "lc_trace.h"
 #include "rs_debug.h"
 
 /**
@@ -51,8 +52,27 @@
  */
 bool RS_FileIO::fileImport(RS_Graphic& graphic, const QString& file,
                            RS2::FormatType type) {
+    showImportWarning(file);
+    QString errorMessage;
+    bool bImported = importFile(graphic, file, type, errorMessage);
+    if (!bImported && !errorMessage.isNull()) {
+        return reportImportError(graphic, file, errorMessage);
+    }
+    return bImported;
+}
 
-    RS_DEBUG->print("Trying to import file '%s'...", file.toLatin1().data());
+/**
+ * Imports the file without any interaction with the user, so it may be
+ * called on a worker thread for a graphic which is not shown yet.
+ *
+ * @param errorMessage receives the error of the filter if the filter failed,
+ *        stays null if there is no filter for the file.
+ * @param monitor optional progress and cancellation of the import.
+ */
+bool RS_FileIO::importFile(RS_Graphic& graphic, const QString& file, RS2::FormatType type,
+                           QString& errorMessage, LC_ImportMonitor* monitor) {
+    LC_TRACE_SCOPE("import", "file import");
+    LC_DEBUG_PRINT("Trying to import file '%s'...", file.toLatin1().data());
 
     RS2::FormatType t;
     if (type == RS2::FormatUnknown) {
@@ -65,84 +85,102 @@ bool RS_FileIO::fileImport(RS_Graphic& graphic, const QString& file,
     if (RS2::FormatUnknown != t) {
         std::unique_ptr<RS_FilterInterface>&& filter(getImportFilter(file, t));
         if (filter){
+            filter->setImportMonitor(monitor);
+            bool bImported {filter->fileImport(graphic, file, t)};
+            if (!bImported) {
+                errorMessage = filter->lastError();
+            }
+            return bImported;
+        }
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING,
+                             "RS_FileIO::fileImport: failed to import file: %s",
+                             file.toLatin1().data());
+    }
+    else {
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING,
+                             "RS_FileIO::fileImport: failed to detect file format: %s",
+                             file.toLatin1().data());
+    }
+
+    return false;
+}
+
+/**
+ * Informs the user about limitations of the format before the file is imported.
+ */
+void RS_FileIO::showImportWarning([[maybe_unused]] const QString& file) {
 #ifdef DWGSUPPORT
-            bool isDwg {file.endsWith( ".dwg", Qt::CaseInsensitive)};
-            if (isDwg) {
-                QApplication::restoreOverrideCursor();  // disable WaitCursor for massagebox
+    bool isDwg {file.endsWith( ".dwg", Qt::CaseInsensitive)};
+    if (isDwg) {
+        QApplication::restoreOverrideCursor();  // disable WaitCursor for massagebox
 
-                // use QStringList to avoid "\n" in translation strings
-                QStringList info { QObject::tr("DWG support is not complete!"),
-                                   "",
-                                   QObject::tr("If this file fails to open try an older DWG format"),
-                                   QObject::tr("or try to find a converter to make it a DXF file.") };
+        // use QStringList to avoid "\n" in translation strings
+        QStringList info { QObject::tr("DWG support is not complete!"),
+                           "",
+                           QObject::tr("If this file fails to open try an older DWG format"),
+                           QObject::tr("or try to find a converter to make it a DXF file.") };
 
-                QMessageBox::information( qApp->activeWindow(),
-                                          QObject::tr("Information"),
-                                          info.join( "\n"),
-                                          QMessageBox::Ok,
-                                          QMessageBox::NoButton);
-                QApplication::setOverrideCursor( QCursor(Qt::WaitCursor));
-            }
+        QMessageBox::information( qApp->activeWindow(),
+                                  QObject::tr("Information"),
+                                  info.join( "\n"),
+                                  QMessageBox::Ok,
+                                  QMessageBox::NoButton);
+        QApplication::setOverrideCursor( QCursor(Qt::WaitCursor));
+    }
 #endif
-            bool bImported {filter->fileImport(graphic, file, t)};
-            if (!bImported) {
-                QApplication::restoreOverrideCursor();  // disable WaitCursor for massagebox
+}
+
+/**
+ * Shows the error of failed import.
+ *
+ * @return true if the user decided to open partially imported file anyway.
+ */
+bool RS_FileIO::reportImportError([[maybe_unused]] const RS_Graphic& graphic, [[maybe_unused]] const QString& file,
+                                  const QString& errorMessage) {
+    QApplication::restoreOverrideCursor();  // disable WaitCursor for massagebox
 
-                QString strTitle {QObject::tr("Error", "fileImport")};
-                QString strError {QObject::tr("Import error:", "fileImport")};
-                QString strLastError( "    %1");
+    QString strTitle {QObject::tr("Error", "fileImport")};
+    QString strError {QObject::tr("Import error:", "fileImport")};
+    QString strLastError( "    %1");
 #ifdef DWGSUPPORT
-                if (isDwg) {
-                    if (graphic.isEmpty()) {
-                        QMessageBox::critical( qApp->activeWindow(),
-                                               strTitle,
-                                               QStringList( {strError, strLastError}).join( "\n").arg( filter->lastError()),
-                                               QMessageBox::Ok,
-                                               QMessageBox::NoButton);
-                    }
-                    else {
-                        QStringList message { strError,
-                                              strLastError,
-                                              "",
-                                              QObject::tr("Anyhow, there are some entities identified.", "dwgImport"),
-                                              QObject::tr("If you open the file now, the drawing may be not complete or unusable.", "dwgImport"),
-                                              "",
-                                              QObject::tr("Ignore error and open the file?", "dwgImport"),
-                        };
-                        QMessageBox::StandardButton answer = QMessageBox::warning( qApp->activeWindow(),
-                                                                                   QObject::tr("Warning"),
-                                                                                   message.join( "\n").arg( filter->lastError()),
-                                                                                   QMessageBox::Yes | QMessageBox::No,
-                                                                                   QMessageBox::NoButton);
-                        if (QMessageBox::Yes == answer) {
-                            return true;   // open the file anyhow
-                        }
-                    }
-                }
-                else
-#endif
-                {
-                    QMessageBox::critical( qApp->activeWindow(),
-                                           strTitle,
-                                           QStringList( {strError, strLastError}).join( "\n").arg( filter->lastError()),
-                                           QMessageBox::Ok,
-                                           QMessageBox::NoButton);
-                }
-                QApplication::setOverrideCursor( QCursor(Qt::WaitCursor));
+    bool isDwg {file.endsWith( ".dwg", Qt::CaseInsensitive)};
+    if (isDwg) {
+        if (graphic.isEmpty()) {
+            QMessageBox::critical( qApp->activeWindow(),
+                                   strTitle,
+                                   QStringList( {strError, strLastError}).join( "\n").arg( errorMessage),
+                                   QMessageBox::Ok,
+                                   QMessageBox::NoButton);
+        }
+        else {
+            QStringList message { strError,
+                                  strLastError,
+                                  "",
+                                  QObject::tr("Anyhow, there are some entities identified.", "dwgImport"),
+                                  QObject::tr("If you open the file now, the drawing may be not complete or unusable.", "dwgImport"),
+                                  "",
+                                  QObject::tr("Ignore error and open the file?", "dwgImport"),
+            };
+            QMessageBox::StandardButton answer = QMessageBox::warning( qApp->activeWindow(),
+                                                                       QObject::tr("Warning"),
+                                                                       message.join( "\n").arg( errorMessage),
+                                                                       QMessageBox::Yes | QMessageBox::No,
+                                                                       QMessageBox::NoButton);
+            if (QMessageBox::Yes == answer) {
+                return true;   // open the file anyhow
             }
-
-            return bImported;
         }
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_FileIO::fileImport: failed to import file: %s",
-                        file.toLatin1().data());
     }
-    else {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_FileIO::fileImport: failed to detect file format: %s",
-                        file.toLatin1().data());
+    else
+#endif
+    {
+        QMessageBox::critical( qApp->activeWindow(),
+                               strTitle,
+                               QStringList( {strError, strLastError}).join( "\n").arg( errorMessage),
+                               QMessageBox::Ok,
+                               QMessageBox::NoButton);
     }
-
+    QApplication::setOverrideCursor( QCursor(Qt::WaitCursor));
     return false;
 }
 
@@ -174,17 +212,17 @@ RS2::FormatType RS_FileIO::detectFormat(QString const& file, bool forRead)
 
         if (!f.open(QIODevice::ReadOnly)) {
 // Error opening file:
-            RS_DEBUG->print(RS_Debug::D_WARNING,
-                            "%s:"
-                            "Cannot open file: %s",
-                            __func__,
-                            file.toLatin1().data());
+            LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING,
+                                 "%s:"
+                                 "Cannot open file: %s",
+                                 __func__,
+                                 file.toLatin1().data());
             type = RS2::FormatUnknown;
         } else {
-            RS_DEBUG->print("%s:"
-                            "Successfully opened DXF file: %s",
-                            __func__,
-                            file.toLatin1().data());
+            LC_DEBUG_PRINT("%s:"
+                           "Successfully opened DXF file: %s",
+                           __func__,
+                           file.toLatin1().data());
 
             QTextStream ts(&f);
             QString line;
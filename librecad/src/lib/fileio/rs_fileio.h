@@ -32,6 +32,8 @@
 #include <memory>
 #include "rs_filterinterface.h"
 
+class LC_ImportMonitor;
+
 //RLZ: TODO destructor for clear filterList
 /**
  * API Class for importing files. 
@@ -67,6 +69,12 @@ public:
 
     bool fileImport(RS_Graphic& graphic, const QString& file,
 		RS2::FormatType type = RS2::FormatUnknown);
+
+    bool importFile(RS_Graphic& graphic, const QString& file, RS2::FormatType type,
+        QString& errorMessage, LC_ImportMonitor* monitor = nullptr);
+
+    static void showImportWarning(const QString& file);
+    static bool reportImportError(const RS_Graphic& graphic, const QString& file, const QString& errorMessage);
 		
     bool fileExport(RS_Graphic& graphic, const QString& file,
 		RS2::FormatType type = RS2::FormatUnknown);
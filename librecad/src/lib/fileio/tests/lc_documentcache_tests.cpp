@@ -0,0 +1,244 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_documentcache.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_fileio.h"
+#include "rs_filterdxfrw.h"
+#include "rs_graphic.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_settings.h"
+
+namespace {
+void initSettings() {
+    // keeps settings and cached copies of tests out of the user directories
+    QStandardPaths::setTestModeEnabled(true);
+    if (RS_Settings::instance() == nullptr) {
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+QDir cacheDir() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/documents"));
+}
+
+QStringList cachedCopies() {
+    return cacheDir().entryList({"*.dxf"}, QDir::Files);
+}
+
+QStringList regeneratedInserts() {
+    return cacheDir().entryList({"*.regen"}, QDir::Files);
+}
+
+// writes a drawing with a layer, a block and its insert as ASCII DXF
+void writeDrawing(const QString& path, double size) {
+    RS_Graphic graphic;
+    graphic.addLayer(new RS_Layer("Outline"));
+    auto* block = new RS_Block(&graphic, RS_BlockData("Part", {0., 0.}, false));
+    block->addEntity(new RS_Circle(block, {{0., 0.}, 1.}));
+    REQUIRE(graphic.addBlock(block, false));
+    for (int i = 0; i < 20; ++i) {
+        auto* line = new RS_Line(&graphic, {i * size, 0.}, {i * size, size});
+        line->setLayer("Outline");
+        graphic.addEntity(line);
+        graphic.addEntity(new RS_Arc(&graphic, {{i * size, size}, size / 2., 0., M_PI, false}));
+        graphic.addEntity(new RS_Insert(&graphic, RS_InsertData("Part", {i * size, -size}, {1., 1.}, 0., 1, 1,
+                                                                {0., 0.})));
+    }
+    RS_FilterDXFRW filter;
+    REQUIRE(filter.fileExport(graphic, path, RS2::FormatDXFRW));
+}
+
+void importDrawing(RS_Graphic& graphic, const QString& path) {
+    QString errorMessage;
+    REQUIRE(RS_FileIO::instance()->importFile(graphic, path, RS2::FormatDXFRW, errorMessage));
+}
+
+QString layerName(const RS_Entity* entity) {
+    const RS_Layer* layer = entity->getLayer();
+    return layer != nullptr ? layer->getName() : QString();
+}
+
+void compareEntities(const RS_Entity* cached, const RS_Entity* imported) {
+    REQUIRE(cached->rtti() == imported->rtti());
+    REQUIRE(cached->getMin().distanceTo(imported->getMin()) < RS_TOLERANCE);
+    REQUIRE(cached->getMax().distanceTo(imported->getMax()) < RS_TOLERANCE);
+    REQUIRE(layerName(cached) == layerName(imported));
+}
+
+RS_Insert* firstInsert(RS_Graphic& graphic) {
+    for (RS_Entity* e: graphic) {
+        if (e->rtti() == RS2::EntityInsert) {
+            return static_cast<RS_Insert*>(e);
+        }
+    }
+    return nullptr;
+}
+
+RS_Vector circleCenter(const RS_Insert* insert) {
+    REQUIRE(insert != nullptr);
+    REQUIRE(insert->count() == 1);
+    const RS_Entity* circle = insert->entityAt(0);
+    REQUIRE(circle->rtti() == RS2::EntityCircle);
+    return static_cast<const RS_Circle*>(circle)->getCenter();
+}
+
+void compareGraphics(RS_Graphic& cached, RS_Graphic& imported) {
+    REQUIRE(cached.count() == imported.count());
+    REQUIRE(cached.countDeep() == imported.countDeep());
+    for (unsigned i = 0; i < cached.count(); ++i) {
+        compareEntities(cached.entityAt(i), imported.entityAt(i));
+    }
+    REQUIRE(cached.getLayerList()->find("Outline") != nullptr);
+    RS_Block* block = cached.getBlockList()->find("Part");
+    REQUIRE(block != nullptr);
+    REQUIRE(block->count() == 1);
+}
+}
+
+TEST_CASE("LC_DocumentCache reopens a stored drawing") {
+    initSettings();
+    cacheDir().removeRecursively();
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("drawing.dxf");
+    writeDrawing(path, 10.);
+
+    RS_Graphic imported;
+    importDrawing(imported, path);
+    {
+        LC_DocumentCache cache(path);
+        RS_Graphic graphic;
+        REQUIRE(!cache.load(graphic, nullptr));
+        REQUIRE(cache.store(imported));
+        // a copy of the same content is written once
+        REQUIRE(!cache.store(imported));
+    }
+    REQUIRE(cachedCopies().size() == 1);
+
+    SECTION("unchanged file is loaded from the copy") {
+        LC_DocumentCache cache(path);
+        RS_Graphic cached;
+        REQUIRE(cache.load(cached, nullptr));
+        compareGraphics(cached, imported);
+    }
+
+    SECTION("changed file doesn't match the copy") {
+        writeDrawing(path, 12.);
+        LC_DocumentCache cache(path);
+        RS_Graphic cached;
+        REQUIRE(!cache.load(cached, nullptr));
+        REQUIRE(cachedCopies().size() == 1);
+    }
+
+    SECTION("invalid copy is removed") {
+        QFile copy(cacheDir().filePath(cachedCopies().constFirst()));
+        REQUIRE(copy.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        REQUIRE(copy.write("0\nSECTION\n2\nENTITIES\n") > 0);
+        copy.close();
+
+        LC_DocumentCache cache(path);
+        RS_Graphic cached;
+        REQUIRE(!cache.load(cached, nullptr));
+        REQUIRE(cachedCopies().isEmpty());
+        REQUIRE(regeneratedInserts().isEmpty());
+    }
+    cacheDir().removeRecursively();
+}
+
+TEST_CASE("LC_DocumentCache restores regenerated inserts") {
+    initSettings();
+    cacheDir().removeRecursively();
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("drawing.dxf");
+    writeDrawing(path, 10.);
+
+    RS_Graphic imported;
+    importDrawing(imported, path);
+    RS_Insert* insert = firstInsert(imported);
+    REQUIRE(circleCenter(insert).distanceTo({0., -10.}) < RS_TOLERANCE);
+    // children are stored as they are, so a moved child shows that the insert is restored, not regenerated
+    insert->entityAt(0)->move({0., 100.});
+    {
+        LC_DocumentCache cache(path);
+        REQUIRE(cache.store(imported));
+    }
+    REQUIRE(cachedCopies().size() == 1);
+    REQUIRE(regeneratedInserts().size() == 1);
+
+    SECTION("inserts are restored") {
+        LC_DocumentCache cache(path);
+        RS_Graphic cached;
+        REQUIRE(cache.load(cached, nullptr));
+        REQUIRE(circleCenter(firstInsert(cached)).distanceTo({0., 90.}) < RS_TOLERANCE);
+        REQUIRE(cached.countDeep() == imported.countDeep());
+    }
+
+    SECTION("inserts are regenerated if the records are invalid") {
+        QFile regen(cacheDir().filePath(regeneratedInserts().constFirst()));
+        REQUIRE(regen.open(QIODevice::ReadWrite));
+        REQUIRE(regen.resize(regen.size() / 2));
+        regen.close();
+
+        LC_DocumentCache cache(path);
+        RS_Graphic cached;
+        REQUIRE(cache.load(cached, nullptr));
+        REQUIRE(circleCenter(firstInsert(cached)).distanceTo({0., -10.}) < RS_TOLERANCE);
+        REQUIRE(cached.countDeep() == imported.countDeep());
+    }
+
+    SECTION("inserts are regenerated without records") {
+        REQUIRE(QFile::remove(cacheDir().filePath(regeneratedInserts().constFirst())));
+
+        LC_DocumentCache cache(path);
+        RS_Graphic cached;
+        REQUIRE(cache.load(cached, nullptr));
+        REQUIRE(circleCenter(firstInsert(cached)).distanceTo({0., -10.}) < RS_TOLERANCE);
+    }
+    cacheDir().removeRecursively();
+}
+
+TEST_CASE("LC_DocumentCache is enabled for DXF files in settings") {
+    initSettings();
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("drawing.dxf");
+    writeDrawing(path, 10.);
+
+    LC_SET_ONE("Defaults", "DocumentCache", false);
+    REQUIRE(!LC_DocumentCache(path).isEnabled());
+    LC_SET_ONE("Defaults", "DocumentCache", true);
+    REQUIRE(LC_DocumentCache(path).isEnabled());
+    LC_SET_ONE("Defaults", "DocumentCache", false);
+}
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <thread>
+
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_importmonitor.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_fileio.h"
+#include "rs_filterdxfrw.h"
+#include "rs_graphic.h"
+#include "rs_insert.h"
+#include "rs_line.h"
+#include "rs_settings.h"
+
+namespace {
+void initSettings() {
+    if (RS_Settings::instance() == nullptr) {
+        // keeps settings of tests out of the user settings
+        QStandardPaths::setTestModeEnabled(true);
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+constexpr int PARTS_COUNT = 20;
+
+// writes a block with a circle and PARTS_COUNT lines, arcs and inserts of the block
+void writeDrawing(const QString& path) {
+    RS_Graphic graphic;
+    auto* block = new RS_Block(&graphic, RS_BlockData("Part", {0., 0.}, false));
+    block->addEntity(new RS_Circle(block, {{0., 0.}, 1.}));
+    REQUIRE(graphic.addBlock(block, false));
+    for (int i = 0; i < PARTS_COUNT; ++i) {
+        graphic.addEntity(new RS_Line(&graphic, {i * 10., 0.}, {i * 10., 10.}));
+        graphic.addEntity(new RS_Arc(&graphic, {{i * 10., 10.}, 5., 0., M_PI, false}));
+        graphic.addEntity(new RS_Insert(&graphic, RS_InsertData("Part", {i * 10., -10.}, {1., 1.}, 0., 1, 1,
+                                                                {0., 0.})));
+    }
+    RS_FilterDXFRW filter;
+    REQUIRE(filter.fileExport(graphic, path, RS2::FormatDXFRW));
+}
+}
+
+TEST_CASE("LC_ImportMonitor reports the progress of an import on a worker thread", "[LC_ImportMonitor]") {
+    initSettings();
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("drawing.dxf");
+    writeDrawing(path);
+
+    LC_ImportMonitor monitor;
+    REQUIRE(monitor.getSection() == LC_ImportMonitor::Preparing);
+    REQUIRE(monitor.getEntitiesCount() == 0);
+
+    // the graphic is detached, as documents loaded by LC_DocumentLoader
+    RS_Graphic graphic;
+    QString errorMessage;
+    bool imported = false;
+    std::thread worker([&]() {
+        imported = RS_FileIO::instance()->importFile(graphic, path, RS2::FormatDXFRW, errorMessage, &monitor);
+    });
+    worker.join();
+
+    REQUIRE(imported);
+    REQUIRE(errorMessage.isEmpty());
+    REQUIRE(!monitor.isCancelled());
+    REQUIRE(monitor.getSection() == LC_ImportMonitor::Finishing);
+    // the circle of the block is counted once, not once per insert
+    REQUIRE(monitor.getEntitiesCount() == 3 * PARTS_COUNT + 1);
+    REQUIRE(graphic.count() == 3 * PARTS_COUNT);
+    REQUIRE(graphic.getBlockList()->find("Part") != nullptr);
+}
+
+TEST_CASE("LC_ImportMonitor cancels an import", "[LC_ImportMonitor]") {
+    initSettings();
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("drawing.dxf");
+    writeDrawing(path);
+
+    LC_ImportMonitor monitor;
+    monitor.cancel();
+    REQUIRE(monitor.isCancelled());
+
+    RS_Graphic graphic;
+    QString errorMessage;
+    REQUIRE(!RS_FileIO::instance()->importFile(graphic, path, RS2::FormatDXFRW, errorMessage, &monitor));
+    // the reader stops at the first section
+    REQUIRE(monitor.getEntitiesCount() == 0);
+    REQUIRE(graphic.count() == 0);
+}
+
+TEST_CASE("LC_ImportMonitor names every section", "[LC_ImportMonitor]") {
+    LC_ImportMonitor monitor;
+    for (LC_ImportMonitor::Section section: {LC_ImportMonitor::Preparing, LC_ImportMonitor::Header,
+                                             LC_ImportMonitor::Tables, LC_ImportMonitor::Blocks,
+                                             LC_ImportMonitor::Entities, LC_ImportMonitor::Objects,
+                                             LC_ImportMonitor::Finishing}) {
+        monitor.setSection(section);
+        REQUIRE(monitor.getSection() == section);
+        REQUIRE(!monitor.getSectionName().isEmpty());
+    }
+}
@@ -56,7 +56,7 @@ RS_FilterCXF::RS_FilterCXF() : RS_FilterInterface() {
  * taken to be stored in a file.
  */
 bool RS_FilterCXF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
-    RS_DEBUG->print("CXF Filter: importing file '%s'...", file.toLatin1().data());
+    LC_DEBUG_PRINT("CXF Filter: importing file '%s'...", file.toLatin1().data());
 
     //this->graphic = &g;
     bool success = false;
@@ -67,8 +67,8 @@ bool RS_FilterCXF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
     success = font.loadFont();
 
     if (success==false) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "Cannot open CXF file '%s'.", file.toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING,
+                             "Cannot open CXF file '%s'.", file.toLatin1().data());
 		return false;
     }
 
@@ -115,7 +115,7 @@ bool RS_FilterCXF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
  */
 bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
 
-    RS_DEBUG->print("CXF Filter: exporting file '%s'...", file.toLatin1().data());
+    LC_DEBUG_PRINT("CXF Filter: exporting file '%s'...", file.toLatin1().data());
 
     // crashes under windoze xp:
     //std::ofstream fout;
@@ -167,7 +167,7 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                 g.getVariableDouble("LineSpacingFactor", 1.0));
 
         QString sa = g.getVariableString("Authors", "");
-        RS_DEBUG->print("authors: %s", sa.toLocal8Bit().data());
+        LC_DEBUG_PRINT("authors: %s", sa.toLocal8Bit().data());
         if (!sa.isEmpty()) {
             QStringList authors = sa.split(',');
             RS_DEBUG->print("006");
@@ -180,7 +180,7 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                 RS_DEBUG->print("006a");
                 a = QString(*it2);
                 RS_DEBUG->print("006b");
-                RS_DEBUG->print("string is: %s", a.toLatin1().data());
+                LC_DEBUG_PRINT("string is: %s", a.toLatin1().data());
                 RS_DEBUG->print("006b0");
                 fprintf(fp, "# Author:            ");
                 RS_DEBUG->print("006b1");
@@ -202,8 +202,8 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
 
             if (blk && !blk->isUndone()) {
                 RS_DEBUG->print("002");
-                RS_DEBUG->print("002a: %s",
-                                (blk->getName().toLocal8Bit().data()));
+                LC_DEBUG_PRINT("002a: %s",
+                               (blk->getName().toLocal8Bit().data()));
 
                 fprintf(fp, "\n%s\n",
                         (blk->getName().toLocal8Bit().data()));
@@ -32,6 +32,7 @@
 #include "dl_attributes.h"
 #include "dl_codes.h"
 #include "dl_writer_ascii.h"
+#include "lc_containertraverser.h"
 
 #include "rs_dimaligned.h"
 #include "rs_dimangular.h"
@@ -1062,8 +1063,7 @@ void RS_FilterDXF::linkImage(const DL_ImageDefData& data) {
     }
 
     // Also link images in subcontainers (e.g. inserts):
-    for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-            e!=NULL; e=graphic->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e : *graphic) {
         if (e->rtti()==RS2::EntityImage) {
             RS_Image* img = (RS_Image*)e;
             if (img->getHandle()==handle) {
@@ -1077,8 +1077,7 @@ void RS_FilterDXF::linkImage(const DL_ImageDefData& data) {
     // update images in blocks:
     for (uint i=0; i<graphic->countBlocks(); ++i) {
         RS_Block* b = graphic->blockAt(i);
-        for (RS_Entity* e=b->firstEntity(RS2::ResolveNone);
-                e!=NULL; e=b->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e : *b) {
             if (e->rtti()==RS2::EntityImage) {
                 RS_Image* img = (RS_Image*)e;
                 if (img->getHandle()==handle) {
@@ -1357,9 +1356,7 @@ bool RS_FilterDXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
     // Section ENTITIES:
     RS_DEBUG->print("writing section ENTITIES...");
     dw->sectionEntities();
-    for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-            e!=NULL;
-            e=graphic->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e : *graphic) {
 
         writeEntity(*dw, e);
     }
@@ -1374,9 +1371,7 @@ bool RS_FilterDXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         QStringList written;
         for (uint i=0; i<graphic->countBlocks(); ++i) {
             RS_Block* block = graphic->blockAt(i);
-            for (RS_Entity* e=block->firstEntity(RS2::ResolveAll);
-                    e!=NULL;
-                    e=block->nextEntity(RS2::ResolveAll)) {
+            for (RS_Entity* e : lc::LC_ContainerTraverser{*block, RS2::ResolveAll}.entities()) {
 
                 if (e->rtti()==RS2::EntityImage) {
                     RS_Image* img = ((RS_Image*)e);
@@ -1387,9 +1382,7 @@ bool RS_FilterDXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                 }
             }
         }
-        for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-                e!=NULL;
-                e=graphic->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e : *graphic) {
 
             if (e->rtti()==RS2::EntityImage) {
                 RS_Image* img = ((RS_Image*)e);
@@ -1486,7 +1479,7 @@ void RS_FilterDXF::writeLayer(DL_WriterA& dw, RS_Layer* l) {
         return;
     }
 
-    RS_DEBUG->print("RS_FilterDXF::writeLayer %s", l->getName().toLatin1().data());
+    LC_DEBUG_PRINT("RS_FilterDXF::writeLayer %s", l->getName().toLatin1().data());
 
     dxf.writeLayer(
         dw,
@@ -1535,7 +1528,7 @@ void RS_FilterDXF::writeBlock(DL_WriterA& dw, RS_Block* blk) {
         return;
     }
 
-    RS_DEBUG->print("writing block: %s", (const char*)blk->getName().toLocal8Bit());
+    LC_DEBUG_PRINT("writing block: %s", (const char*)blk->getName().toLocal8Bit());
 
     dxf.writeBlock(dw,
                    DL_BlockData((const char*)blk->getName().toLocal8Bit(), 0,
@@ -1546,9 +1539,7 @@ void RS_FilterDXF::writeBlock(DL_WriterA& dw, RS_Block* blk) {
 #else
                                 blk->getBasePoint().z));
 #endif
-    for (RS_Entity* e=blk->firstEntity(RS2::ResolveNone);
-            e!=NULL;
-            e=blk->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e : *blk) {
         writeEntity(dw, e);
     }
     dxf.writeEndBlock(dw, (const char*)blk->getName().toLocal8Bit());
@@ -1696,12 +1687,13 @@ void RS_FilterDXF::writePolyline(DL_WriterA& dw,
     bool first = true;
     RS_Entity* nextEntity = 0;
     RS_AtomicEntity* ae = NULL;
-        RS_Entity* lastEntity = l->lastEntity(RS2::ResolveNone);
-    for (RS_Entity* v=l->firstEntity(RS2::ResolveNone);
+    lc::LC_ContainerTraverser traverser{*l, RS2::ResolveNone};
+        RS_Entity* lastEntity = traverser.last();
+    for (RS_Entity* v=traverser.first();
             v!=NULL;
             v=nextEntity) {
 
-        nextEntity = l->nextEntity(RS2::ResolveNone);
+        nextEntity = traverser.next();
 
         if (!v->isAtomic()) {
             continue;
@@ -2191,9 +2183,7 @@ void RS_FilterDXF::writeLeader(DL_WriterA& dw, RS_Leader* l,
                           l->count()),
             attrib);
         bool first = true;
-        for (RS_Entity* v=l->firstEntity(RS2::ResolveNone);
-                v!=NULL;
-                v=l->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* v : *l) {
 
             // Write line verties:
             if (v->rtti()==RS2::EntityLine) {
@@ -2232,9 +2222,7 @@ void RS_FilterDXF::writeHatch(DL_WriterA& dw, RS_Hatch* h,
     bool writeIt = true;
     if (h->countLoops()>0) {
         // check if all of the loops contain entities:
-        for (RS_Entity* l=h->firstEntity(RS2::ResolveNone);
-                l!=NULL;
-                l=h->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* l : *h) {
 
             if (l->isContainer() && !l->getFlag(RS2::FlagTemp)) {
                 if (l->count()==0) {
@@ -2257,9 +2245,7 @@ void RS_FilterDXF::writeHatch(DL_WriterA& dw, RS_Hatch* h,
                           (const char*)h->getPattern().toLocal8Bit());
         dxf.writeHatch1(dw, data, attrib);
 
-        for (RS_Entity* l=h->firstEntity(RS2::ResolveNone);
-                l!=NULL;
-                l=h->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* l : *h) {
 
             // Write hatch loops:
             if (l->isContainer() && !l->getFlag(RS2::FlagTemp)) {
@@ -2267,9 +2253,7 @@ void RS_FilterDXF::writeHatch(DL_WriterA& dw, RS_Hatch* h,
                 DL_HatchLoopData lData(loop->count());
                 dxf.writeHatchLoop1(dw, lData);
 
-                for (RS_Entity* ed=loop->firstEntity(RS2::ResolveNone);
-                        ed!=NULL;
-                        ed=loop->nextEntity(RS2::ResolveNone)) {
+                for (RS_Entity* ed : *loop) {
 
                     // Write hatch loop edges:
                     if (ed->rtti()==RS2::EntityLine) {
@@ -2405,8 +2389,7 @@ void RS_FilterDXF::writeEntityContainer(DL_WriterA& dw, RS_EntityContainer* con,
 
     RS_Block* blk = new RS_Block(graphic, blkdata);
 
-    for (RS_Entity* e1 = con->firstEntity(); e1 != NULL;
-            e1 = con->nextEntity() ) {
+    for (RS_Entity* e1 : *con) {
         blk->addEntity(e1);
     }
     writeBlock(dw, blk);
@@ -2423,9 +2406,7 @@ void RS_FilterDXF::writeAtomicEntities(DL_WriterA& dw, RS_EntityContainer* c,
                                        const DL_Attributes& attrib,
                                        RS2::ResolveLevel level) {
 
-    for (RS_Entity* e=c->firstEntity(level);
-            e!=NULL;
-            e=c->nextEntity(level)) {
+    for (RS_Entity* e : lc::LC_ContainerTraverser{*c, level}.entities()) {
 
         writeEntity(dw, e, attrib);
     }
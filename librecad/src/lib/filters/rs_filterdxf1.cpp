@@ -64,7 +64,7 @@ RS_FilterDXF1::RS_FilterDXF1()
  * taken to be stored in a file.
  */
 bool RS_FilterDXF1::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
-    RS_DEBUG->print("DXF1 Filter: importing file '%s'...", file.toLatin1().data());
+    LC_DEBUG_PRINT("DXF1 Filter: importing file '%s'...", file.toLatin1().data());
 
 	this->graphic = &g;
 
@@ -142,7 +142,7 @@ bool RS_FilterDXF1::readFromBuffer() {
             pen = RS_Pen(RS_Color(RS2::FlagByLayer), RS2::WidthByLayer, RS2::LineByLayer);
 
             RS_DEBUG->print( "\ndxfLine: " );
-            RS_DEBUG->print( dxfLine.toLatin1().data() );
+            LC_DEBUG_PRINT( dxfLine.toLatin1().data() );
 
             // $-Setting in the header of DXF found
             // RVT_PORT changed all occurenses of if (dxfline && ....) to if (dxfline.size() ......)
@@ -30,14 +30,18 @@
 #include <QRegularExpression>
 #include <QStringList>
 #include <QStringConverter>
+#include <QCoreApplication>
 #include <QFile>
 #include <QFileInfo>
+#include <QThread>
 
 #include "rs_filterdxfrw.h"
 #include "lc_containertraverser.h"
+#include "lc_trace.h"
 #include "lc_hyperbola.h"
 #include "lc_hyperbolaspline.h"
 #include "lc_parabola.h"
+#include "lc_regenscheduler.h"
 #include "rs_arc.h"
 #include "rs_circle.h"
 #include "rs_dimaligned.h"
@@ -121,6 +125,9 @@ RS_FilterDXFRW::~RS_FilterDXFRW() {
 }
 
 QString RS_FilterDXFRW::lastError() const{
+    if (m_importCancelled) {
+        return QObject::tr("import cancelled", "RS_FilterDXFRW");
+    }
     switch (errorCode) {
     case DRW::BAD_NONE:
         return (QObject::tr( "no DXF/DWG error", "RS_FilterDXFRW"));
@@ -172,6 +179,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
     m_graphic = &g;
     m_currentContainer = m_graphic;
     m_dummyContainer = new RS_EntityContainer(nullptr, true);
+    m_regenScheduler = std::make_unique<LC_RegenScheduler>(m_graphic);
 
     this->m_file = file;
     // add some variables that need to be there for DXF drawings:
@@ -182,6 +190,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
     //reset library version
     m_isLibDxfRw = false;
     m_libDxfRwVersion = 0;
+    m_importCancelled = false;
 
 #ifdef DWGSUPPORT
     if (type == RS2::FormatDWG) {
@@ -189,9 +198,18 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file");
         if (RS_DEBUG->getLevel()== RS_Debug::D_DEBUGGING)
             dwgr.setDebug(DRW::DebugLevel::Debug);
-        bool success = dwgr.read(this, true);
+        bool success = false;
+        try {
+            LC_TRACE_SCOPE("import", "dwg read");
+            success = dwgr.read(this, true);
+        } catch (const LC_ImportCancelled&) {
+            m_importCancelled = true;
+            delete m_dummyContainer;
+            m_dummyContainer = nullptr;
+            return false;
+        }
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file: OK");
-        RS_DIALOGFACTORY->commandMessage(QObject::tr("Opened dwg file version %1.").arg(printDwgVersion(dwgr.getVersion())));
+        commandMessage(QObject::tr("Opened dwg file version %1.").arg(printDwgVersion(dwgr.getVersion())));
         int  lastError = dwgr.getError();
         if (false == success) {
             printDwgError(lastError);
@@ -209,17 +227,28 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
             m_dxfR->setDebug(DRW::DebugLevel::Debug);
         }
         bool success {false};
-        if (file.startsWith(":")) { // load content from resources. It SHOULD be present in resource!
-            QFile resourceFile(file);
-            if (resourceFile.open(QIODevice::ReadOnly)) {
-                QByteArray contentString = resourceFile.readAll();
-                resourceFile.close();
-                std::string content = contentString.toStdString();
-                success = m_dxfR->readAscii(this, true, content);
+        try {
+            if (file.startsWith(":")) { // load content from resources. It SHOULD be present in resource!
+                QFile resourceFile(file);
+                if (resourceFile.open(QIODevice::ReadOnly)) {
+                    QByteArray contentString = resourceFile.readAll();
+                    resourceFile.close();
+                    std::string content = contentString.toStdString();
+                    success = m_dxfR->readAscii(this, true, content);
+                }
             }
-        }
-        else {
-            success = m_dxfR->read(this, true);
+            else {
+                LC_TRACE_SCOPE("import", "dxf read");
+                success = m_dxfR->read(this, true);
+            }
+        } catch (const LC_ImportCancelled&) {
+            // entities read so far stay in the graphic, which is discarded by the caller
+            m_importCancelled = true;
+            delete m_dxfR;
+            m_dxfR = nullptr;
+            delete m_dummyContainer;
+            m_dummyContainer = nullptr;
+            return false;
         }
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading file: OK");
         //graphic->setAutoUpdateBorders(true);
@@ -244,17 +273,43 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
         //require to notify
         m_graphic->getLayerList()->activate(cl, true);
     }
+    if (m_importMonitor != nullptr) {
+        m_importMonitor->setSection(LC_ImportMonitor::Finishing);
+    }
     RS_DEBUG->print("RS_FilterDXFRW::fileImport: updating inserts");
-    m_graphic->updateInserts();
+    {
+        LC_TRACE_SCOPE("import", "update inserts");
+        if (m_insertsRestorer) {
+            m_regenScheduler->setRegenerated(m_insertsRestorer(*m_graphic));
+        }
+        m_regenScheduler->run();
+        m_regenScheduler.reset();
+    }
 
     RS_DEBUG->print("RS_FilterDXFRW::fileImport OK");
     return true;
 }
 
+/**
+ * Updates of entities that are expensive to regenerate are deferred until the whole file is read,
+ * so they may be done in parallel. Entities of orphan containers and of unnamed *D blocks are
+ * deleted before the file is read completely, so they are updated at once.
+ */
+void RS_FilterDXFRW::updateOrDefer(RS_Entity* entity) {
+    if (m_regenScheduler != nullptr && m_currentContainer != m_dummyContainer
+            && !isDroppedBlock(m_currentContainer)) {
+        m_regenScheduler->defer(entity);
+    }
+    else {
+        entity->update();
+    }
+}
+
 /**
  * Implementation of the method which handles layers.
  */
 void RS_FilterDXFRW::addLayer(const DRW_Layer &data) {
+    reportImportProgress(LC_ImportMonitor::Tables);
     RS_DEBUG->print("RS_FilterDXF::addLayer");
     RS_DEBUG->print("  adding layer: %s", data.name.c_str());
 
@@ -279,7 +334,7 @@ void RS_FilterDXFRW::addLayer(const DRW_Layer &data) {
 
     //parse extended data to read construction flag
     if (!data.extData.empty()){
-        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s have extended data", layer->getName().toStdString().c_str());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s have extended data", layer->getName().toStdString().c_str());
         bool isLCdata = false;
         for (std::vector<DRW_Variant*>::const_iterator it=data.extData.begin(); it!=data.extData.end(); ++it){
             if ((*it)->code() == 1001){
@@ -302,7 +357,7 @@ void RS_FilterDXFRW::addLayer(const DRW_Layer &data) {
     }
 
     if (layer->isConstruction()) {
-        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s is construction layer", layer->getName().toStdString().c_str());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s is construction layer", layer->getName().toStdString().c_str());
     }
 
     RS_DEBUG->print("RS_FilterDXF::addLayer: add layer to graphic");
@@ -314,6 +369,7 @@ void RS_FilterDXFRW::addLayer(const DRW_Layer &data) {
  * Implementation of the method which handles dimension styles.
  */
 void RS_FilterDXFRW::addDimStyle(const DRW_Dimstyle& data){
+    reportImportProgress(LC_ImportMonitor::Tables);
     RS_DEBUG->print("RS_FilterDXFRW::addLayer");
     QString dimStyleName = m_graphic->getVariableString("$DIMSTYLE", "standard");
 
@@ -340,6 +396,7 @@ void RS_FilterDXFRW::addDimStyle(const DRW_Dimstyle& data){
  * Implementation of the method which handles vports.
  */
 void RS_FilterDXFRW::addVport(const DRW_Vport &data) {
+    reportImportProgress(LC_ImportMonitor::Tables);
     QString name = QString::fromStdString(data.name);
     if (name.toLower() == "*active") {
         data.grid == 1? m_graphic->setGridOn(true):m_graphic->setGridOn(false);
@@ -362,6 +419,7 @@ void RS_FilterDXFRW::addVport(const DRW_Vport &data) {
 }
 
 void RS_FilterDXFRW::addUCS(const DRW_UCS &data) {
+    reportImportProgress(LC_ImportMonitor::Tables);
     RS_DEBUG->print("RS_FilterDXF::addUCS");
     RS_DEBUG->print("  adding ucs: %s", data.name.c_str());
     RS_DEBUG->print("RS_FilterDXF::addUCS: creating ucs");
@@ -393,6 +451,7 @@ void RS_FilterDXFRW::addUCS(const DRW_UCS &data) {
 }
 
 void RS_FilterDXFRW::addView(const DRW_View &data) {
+    reportImportProgress(LC_ImportMonitor::Tables);
     RS_DEBUG->print("RS_FilterDXF::addView");
     RS_DEBUG->print("  adding view: %s", data.name.c_str());
     RS_DEBUG->print("RS_FilterDXF::addView: creating view");
@@ -452,6 +511,7 @@ void RS_FilterDXFRW::addView(const DRW_View &data) {
  * @todo Adding blocks to blocks (stack for m_currentContainer)
  */
 void RS_FilterDXFRW::addBlock(const DRW_Block& data) {
+    reportImportProgress(LC_ImportMonitor::Blocks);
     RS_DEBUG->print("RS_FilterDXF::addBlock");
     RS_DEBUG->print("  adding block: %s", data.name.c_str());
 /*TODO correct handle of model-space*/
@@ -490,22 +550,25 @@ void RS_FilterDXFRW::setBlock(const int handle){
  * Implementation of the method which closes blocks.
  */
 void RS_FilterDXFRW::endBlock() {
-    if (m_currentContainer->rtti() == RS2::EntityBlock) {
-        auto bk = static_cast<RS_Block*>(m_currentContainer);
-        //remove unnamed blocks *D only if version != R12
-        if (m_version!=1009) {
-            if (bk->getName().startsWith("*D") ) {
-                m_graphic->removeBlock(bk);
-            }
-        }
+    if (isDroppedBlock(m_currentContainer)) {
+        m_graphic->removeBlock(static_cast<RS_Block*>(m_currentContainer));
     }
     m_currentContainer = m_graphic;
 }
 
+/**
+ * @return true for unnamed blocks *D, they are removed at the end of the block unless version is R12.
+ */
+bool RS_FilterDXFRW::isDroppedBlock(RS_EntityContainer* container) const {
+    return container->rtti() == RS2::EntityBlock && m_version != 1009
+           && static_cast<RS_Block*>(container)->getName().startsWith("*D");
+}
+
 /**
  * Implementation of the method which handles point entities.
  */
 void RS_FilterDXFRW::addPoint(const DRW_Point& data) {
+    reportEntityImported();
     RS_Vector v(data.basePoint.x, data.basePoint.y);
     RS_Point* entity = new RS_Point(m_currentContainer,RS_PointData(v));
     setEntityAttributes(entity, &data);
@@ -516,6 +579,7 @@ void RS_FilterDXFRW::addPoint(const DRW_Point& data) {
  * Implementation of the method which handles line entities.
  */
 void RS_FilterDXFRW::addLine(const DRW_Line& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addLine");
 
     RS_Vector v1(data.basePoint.x, data.basePoint.y);
@@ -544,6 +608,7 @@ void RS_FilterDXFRW::addLine(const DRW_Line& data) {
  * Implementation of the method which handles ray entities.
  */
 void RS_FilterDXFRW::addRay(const DRW_Ray& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addRay");
 
 	RS_Vector v1{data.basePoint.x, data.basePoint.y};
@@ -573,6 +638,7 @@ void RS_FilterDXFRW::addRay(const DRW_Ray& data) {
  * Implementation of the method which handles line entities.
  */
 void RS_FilterDXFRW::addXline(const DRW_Xline& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addXline");
 
     RS_Vector v1(data.basePoint.x, data.basePoint.y);
@@ -601,6 +667,7 @@ void RS_FilterDXFRW::addXline(const DRW_Xline& data) {
  * Implementation of the method which handles circle entities.
  */
 void RS_FilterDXFRW::addCircle(const DRW_Circle& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addCircle");
 
 	RS_Vector v{data.basePoint.x, data.basePoint.y};
@@ -616,6 +683,7 @@ void RS_FilterDXFRW::addCircle(const DRW_Circle& data) {
  * @param angle2 End angle in deg (!)
  */
 void RS_FilterDXFRW::addArc(const DRW_Arc& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addArc");
     RS_Vector v(data.basePoint.x, data.basePoint.y);
     RS_ArcData d(v, data.radious,
@@ -634,6 +702,7 @@ void RS_FilterDXFRW::addArc(const DRW_Arc& data) {
  * @param angle2 End angle in rad (!)
  */
 void RS_FilterDXFRW::addEllipse(const DRW_Ellipse& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addEllipse");
 
 	RS_Vector v1(data.basePoint.x, data.basePoint.y);
@@ -652,6 +721,7 @@ void RS_FilterDXFRW::addEllipse(const DRW_Ellipse& data) {
  * Implementation of the method which handles trace entities.
  */
 void RS_FilterDXFRW::addTrace(const DRW_Trace& data) {
+    reportEntityImported();
     RS_Solid* entity;
 	RS_Vector v1{data.basePoint.x, data.basePoint.y};
 	RS_Vector v2{data.secPoint.x, data.secPoint.y};
@@ -669,6 +739,7 @@ void RS_FilterDXFRW::addTrace(const DRW_Trace& data) {
 }
 
 void RS_FilterDXFRW::addTolerance(const DRW_Tolerance& data) {
+    reportEntityImported();
     RS_Vector insertionPoint{data.insertionPoint.x, data.insertionPoint.y};
     RS_Vector axisDirectionVector{data.xAxisDirectionVector.x, data.xAxisDirectionVector.y};
 
@@ -692,6 +763,7 @@ void RS_FilterDXFRW::addTolerance(const DRW_Tolerance& data) {
  * Implementation of the method which handles solid entities.
  */
 void RS_FilterDXFRW::addSolid(const DRW_Solid& data) {
+    // counted by addTrace()
     addTrace(data);
 }
 
@@ -699,6 +771,7 @@ void RS_FilterDXFRW::addSolid(const DRW_Solid& data) {
  * Implementation of the method which handles lightweight polyline entities.
  */
 void RS_FilterDXFRW::addLWPolyline(const DRW_LWPolyline& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addLWPolyline");
     if (data.vertlist.empty()) {
         return;
@@ -722,6 +795,7 @@ void RS_FilterDXFRW::addLWPolyline(const DRW_LWPolyline& data) {
  * Implementation of the method which handles polyline entities.
  */
 void RS_FilterDXFRW::addPolyline(const DRW_Polyline& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addPolyline");
     if (data.flags & 0x10) {
         // the polyline is a polygon mesh
@@ -867,6 +941,7 @@ bool RS_FilterDXFRW::handleQuadraticConicSpline(const DRW_Spline* data) {
  * Implementation of the method which handles splines.
  */
 void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addSpline: degree: %d", data->degree);
 
     // Special case: rational quadratic conic (hyperbola or parabola)
@@ -958,6 +1033,7 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
  * Implementation of the method which handles inserts.
  */
 void RS_FilterDXFRW::addInsert(const DRW_Insert& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addInsert");
 
     RS_Vector ip(data.basePoint.x, data.basePoint.y);
@@ -996,6 +1072,7 @@ void RS_FilterDXFRW::prepareTextStyleName(QString& sty) const {
  * multi texts (MTEXT).
  */
 void RS_FilterDXFRW::addMText(const DRW_MText& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addMText: %s", data.text.c_str());
 
     RS_MTextData::VAlign valign;
@@ -1089,7 +1166,7 @@ void RS_FilterDXFRW::addMText(const DRW_MText& data) {
     }
     auto entity = new RS_MText(m_currentContainer, d);
     setEntityAttributes(entity, &data);
-    entity->update();
+    updateOrDefer(entity);
     m_currentContainer->addEntity(entity);
 }
 
@@ -1098,6 +1175,7 @@ void RS_FilterDXFRW::addMText(const DRW_MText& data) {
  * texts (TEXT).
  */
 void RS_FilterDXFRW::addText(const DRW_Text& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addText");
     RS_Vector refPoint = RS_Vector(data.basePoint.x, data.basePoint.y);;
     RS_Vector secPoint = RS_Vector(data.secPoint.x, data.secPoint.y);;
@@ -1137,7 +1215,7 @@ void RS_FilterDXFRW::addText(const DRW_Text& data) {
     auto* entity = new RS_Text(m_currentContainer, d);
 
     setEntityAttributes(entity, &data);
-    entity->update();
+    updateOrDefer(entity);
     m_currentContainer->addEntity(entity);
 }
 
@@ -2094,6 +2172,7 @@ LC_DimStyle* RS_FilterDXFRW::parseDimStyleOverride(LC_ExtEntityData* extEntityDa
  * aligned dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimAlign(const DRW_DimAligned *data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimAligned");
 
     RS_DimensionData dimensionData = convDimensionData(data);
@@ -2114,6 +2193,7 @@ void RS_FilterDXFRW::addDimAlign(const DRW_DimAligned *data) {
  * linear dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimLinear(const DRW_DimLinear *data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimLinear");
 
     RS_DimensionData dimensionData = convDimensionData(data);
@@ -2135,6 +2215,7 @@ void RS_FilterDXFRW::addDimLinear(const DRW_DimLinear *data) {
  * radial dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimRadial(const DRW_DimRadial* data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimRadial");
 
     RS_DimensionData dimensionData = convDimensionData(data);
@@ -2153,6 +2234,7 @@ void RS_FilterDXFRW::addDimRadial(const DRW_DimRadial* data) {
  * diametric dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimDiametric(const DRW_DimDiametric* data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimDiametric");
 
     RS_DimensionData dimensionData = convDimensionData(data);
@@ -2171,6 +2253,7 @@ void RS_FilterDXFRW::addDimDiametric(const DRW_DimDiametric* data) {
  * angular dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimAngular(const DRW_DimAngular* data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimAngular");
 
     RS_DimensionData dimensionData = convDimensionData(data);
@@ -2193,6 +2276,7 @@ void RS_FilterDXFRW::addDimAngular(const DRW_DimAngular* data) {
  * angular dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimAngular3P(const DRW_DimAngular3p* data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimAngular3P");
 
     RS_DimensionData dimensionData = convDimensionData(data);
@@ -2212,6 +2296,7 @@ void RS_FilterDXFRW::addDimAngular3P(const DRW_DimAngular3p* data) {
 }
 
 void RS_FilterDXFRW::addDimOrdinate(const DRW_DimOrdinate* data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimOrdinate(const DL_DimensionData&, const DL_DimOrdinateData&) not yet implemented");
     RS_DimensionData dimensionData = convDimensionData(data);
 
@@ -2234,6 +2319,7 @@ void RS_FilterDXFRW::addDimOrdinate(const DRW_DimOrdinate* data) {
  * Implementation of the method which handles leader entities.
  */
 void RS_FilterDXFRW::addLeader(const DRW_Leader *data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::addDimLeader");
     RS_LeaderData d(data->arrow!=0, QString::fromUtf8(data->style.c_str()));
     auto leader = new RS_Leader(m_currentContainer, d);
@@ -2251,6 +2337,7 @@ void RS_FilterDXFRW::addLeader(const DRW_Leader *data) {
  * Implementation of the method which handles hatch entities.
  */
 void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addHatch()");
     RS_EntityContainer* hatchLoop;
     auto hatch = new RS_Hatch(m_currentContainer,
@@ -2371,7 +2458,7 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
 
     RS_DEBUG->print("hatch->update()");
     if (hatch->validate()) {
-        hatch->update();
+        updateOrDefer(hatch);
     } else {
         m_graphic->removeEntity(hatch);
         RS_DEBUG->print(RS_Debug::D_ERROR,"RS_FilterDXFRW::endEntity(): updating hatch failed: invalid hatch area");
@@ -2382,6 +2469,7 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
  * Implementation of the method which handles image entities.
  */
 void RS_FilterDXFRW::addImage(const DRW_Image *data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXF::addImage");
 
     RS_Vector ip(data->basePoint.x, data->basePoint.y);
@@ -2402,11 +2490,13 @@ void RS_FilterDXFRW::addImage(const DRW_Image *data) {
  * Implementation of the method which links image entities to image files.
  */
 void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
+    reportImportProgress(LC_ImportMonitor::Objects);
     RS_DEBUG->print("RS_FilterDXFRW::linkImage");
 
     int handle = data->handle;
     QString sfile(QString::fromUtf8(data->name.c_str()));
-    QFileInfo fiDxf(m_file);
+    // a graphic read from a copy of the drawing (see LC_DocumentCache) is named after the original file
+    QFileInfo fiDxf(m_graphic->getFilename().isEmpty() ? m_file : m_graphic->getFilename());
     QFileInfo fiBitmap(sfile);
 
     // try to find the image file:
@@ -2464,6 +2554,7 @@ using std::map;
  * Sets the header variables from the DXF file.
  */
 void RS_FilterDXFRW::addHeader(const DRW_Header* data){
+    reportImportProgress(LC_ImportMonitor::Header);
 	RS_Graphic* container = nullptr;
     if (m_currentContainer->rtti()==RS2::EntityGraphic) {
         container = static_cast<RS_Graphic*>(m_currentContainer);
@@ -2617,11 +2708,7 @@ bool RS_FilterDXFRW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatT
      * fixme - sand - files - RESTORE!!! Under win, encodeName() prevents using unicode file names!!! Due to that, blocks/files may be saved incorrectly if name is localized
      */
     m_dxfW = new dxfRW(QFile::encodeName(file));
-    // fixme - sand - save to binary format enabling/disabling!!
-    bool binary = false;
-
-//    bool success = m_dxfW->write(this, exportVersion, false); //ascii
-    bool success = m_dxfW->write(this, exportVersion, binary); //binary
+    bool success = m_dxfW->write(this, exportVersion, m_binaryExport);
     delete m_dxfW;
 
     if (!success) {
@@ -2717,7 +2804,7 @@ void RS_FilterDXFRW::writeBlockRecords(){
     for (unsigned i = 0; i < m_graphic->countBlocks(); i++) {
         blk = m_graphic->blockAt(i);
         if (!blk->isUndone()){
-            RS_DEBUG->print("writing block record: %s", (const char*)blk->getName().toLocal8Bit());
+            LC_DEBUG_PRINT("writing block record: %s", (const char*)blk->getName().toLocal8Bit());
             m_dxfW->writeBlockRecord(blk->getName().toUtf8().data());
         }
     }
@@ -2752,7 +2839,7 @@ void RS_FilterDXFRW::writeBlocks() {
     for (unsigned i = 0; i < m_graphic->countBlocks(); i++) {
         blk = m_graphic->blockAt(i);
         if (!blk->isUndone()) {
-            RS_DEBUG->print("writing block: %s", (const char*)blk->getName().toLocal8Bit());
+            LC_DEBUG_PRINT("writing block: %s", (const char*)blk->getName().toLocal8Bit());
 
             DRW_Block block;
             block.name = blk->getName().toUtf8().data();
@@ -3728,7 +3815,7 @@ void RS_FilterDXFRW::writeLWPolyline(RS_Polyline* l) {
         return;
     }
     bool has_ellipse = false;
-    for (RS_Entity* e=l->firstEntity(RS2::ResolveNone); e; e=l->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e : *l) {
         if (e->rtti() == RS2::EntityEllipse) {
             has_ellipse = true;
             break;
@@ -3791,8 +3878,9 @@ void RS_FilterDXFRW::writePolyline(RS_Polyline* p) {
     }
 
     RS_Entity* nextEntity = nullptr;
-    for (RS_Entity* e=p->firstEntity(RS2::ResolveNone); e != nullptr; e=nextEntity) {
-        nextEntity = p->nextEntity(RS2::ResolveNone);
+    lc::LC_ContainerTraverser traverser{*p, RS2::ResolveNone};
+    for (RS_Entity* e=traverser.first(); e != nullptr; e=nextEntity) {
+        nextEntity = traverser.next();
 
         if (!e->isAtomic()) {
             continue;
@@ -4412,9 +4500,7 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
     }
     ha.loopsnum = h->countLoops();
 
-    for (RS_Entity* l=h->firstEntity(RS2::ResolveNone);
-         l;
-         l=h->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* l : *h) {
 
         // Write hatch loops:
         if (l->isContainer() && !l->getFlag(RS2::FlagTemp)) {
@@ -4579,8 +4665,7 @@ void RS_FilterDXFRW::writeImage(RS_Image * i) {
 
     RS_Block* blk = new RS_Block(graphic, blkdata);
 
-	for (RS_Entity* e1 = con->firstEntity(); e1 ;
-            e1 = con->nextEntity() ) {
+	for (RS_Entity* e1 : *con) {
         blk->addEntity(e1);
     }
     writeBlock(dw, blk);
@@ -4596,9 +4681,7 @@ void RS_FilterDXFRW::writeImage(RS_Image * i) {
                                        const DRW_Entity& attrib,
                                        RS2::ResolveLevel level) {
 
-    for (RS_Entity* e=c->firstEntity(level);
-            e;
-            e=c->nextEntity(level)) {
+    for (RS_Entity* e : lc::LC_ContainerTraverser{*c, level}.entities()) {
 
         writeEntity(dw, e, attrib);
     }
@@ -4609,6 +4692,45 @@ void RS_FilterDXFRW::writeImage(RS_Image * i) {
  * Sets the entities attributes according to the attributes
  * that come from a DXF file.
  */
+/**
+ * Reports section of the file being read to the import monitor.
+ * Throws LC_ImportCancelled if the import was cancelled.
+ */
+void RS_FilterDXFRW::reportImportProgress(LC_ImportMonitor::Section section) {
+    if (m_importMonitor != nullptr) {
+        if (m_importMonitor->isCancelled()) {
+            throw LC_ImportCancelled();
+        }
+        m_importMonitor->setSection(section);
+    }
+}
+
+/**
+ * Reports an entity to the import monitor, called before the entity is created.
+ */
+void RS_FilterDXFRW::reportEntityImported() {
+    if (m_importMonitor != nullptr) {
+        reportImportProgress(m_currentContainer == m_graphic ? LC_ImportMonitor::Entities : LC_ImportMonitor::Blocks);
+        m_importMonitor->entityImported();
+    }
+}
+
+/**
+ * Shows message in the command widget. Files may be imported on worker threads,
+ * so the message is passed to the GUI thread in that case.
+ */
+void RS_FilterDXFRW::commandMessage(const QString& message) const {
+    QCoreApplication* application = QCoreApplication::instance();
+    if (application == nullptr || QThread::currentThread() == application->thread()) {
+        RS_DIALOGFACTORY->commandMessage(message);
+    }
+    else {
+        QMetaObject::invokeMethod(application, [message]() {
+            RS_DIALOGFACTORY->commandMessage(message);
+        }, Qt::QueuedConnection);
+    }
+}
+
 void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
                                        const DRW_Entity* attrib) {
     RS_DEBUG->print("RS_FilterDXF::setEntityAttributes");
@@ -4785,6 +4907,7 @@ int RS_FilterDXFRW::colorToNumber(const RS_Color& col, int *rgb) {
 }
 
 void RS_FilterDXFRW::add3dFace(const DRW_3Dface& data) {
+    reportEntityImported();
     RS_DEBUG->print("RS_FilterDXFRW::add3dFace");
     RS_PolylineData d(RS_Vector(false),
                       RS_Vector(false),
@@ -4809,6 +4932,7 @@ void RS_FilterDXFRW::addComment(const char*) {
 }
 
 void RS_FilterDXFRW::addPlotSettings(const DRW_PlotSettings *data) {
+    reportImportProgress(LC_ImportMonitor::Objects);
     m_graphic->setPagesNum(QString::fromStdString(data->plotViewName));
     m_graphic->setMargins(data->marginLeft, data->marginTop,
                         data->marginRight, data->marginBottom);
@@ -5464,51 +5588,51 @@ QString RS_FilterDXFRW::printDwgVersion(int v){
 void RS_FilterDXFRW::printDwgError(int le){
     switch (le) {
         case DRW::BAD_UNKNOWN:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("unknown error opening dwg file"));
+            commandMessage(QObject::tr("unknown error opening dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_UNKNOWN");
             break;
         case DRW::BAD_OPEN:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("can't open this dwg file"));
+            commandMessage(QObject::tr("can't open this dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_OPEN");
             break;
         case DRW::BAD_VERSION:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("unsupported dwg version"));
+            commandMessage(QObject::tr("unsupported dwg version"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_VERSION");
             break;
         case DRW::BAD_READ_METADATA:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading file metadata in dwg file"));
+            commandMessage(QObject::tr("error reading file metadata in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_FILE_HEADER");
             break;
         case DRW::BAD_READ_FILE_HEADER:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading file header in dwg file"));
+            commandMessage(QObject::tr("error reading file header in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_FILE_HEADER");
             break;
         case DRW::BAD_READ_HEADER:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading header vars in dwg file"));
+            commandMessage(QObject::tr("error reading header vars in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_HEADER");
             break;
         case DRW::BAD_READ_CLASSES:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading classes in dwg file"));
+            commandMessage(QObject::tr("error reading classes in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_CLASSES");
             break;
         case DRW::BAD_READ_HANDLES:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading offsets in dwg file"));
+            commandMessage(QObject::tr("error reading offsets in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OFFSETS");
             break;
         case DRW::BAD_READ_TABLES:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading tables in dwg file"));
+            commandMessage(QObject::tr("error reading tables in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_TABLES");
             break;
         case DRW::BAD_READ_BLOCKS:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading blocks in dwg file"));
+            commandMessage(QObject::tr("error reading blocks in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OFFSETS");
             break;
         case DRW::BAD_READ_ENTITIES:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading entities in dwg file"));
+            commandMessage(QObject::tr("error reading entities in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_ENTITIES");
             break;
         case DRW::BAD_READ_OBJECTS:
-            RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading objects in dwg file"));
+            commandMessage(QObject::tr("error reading objects in dwg file"));
             RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OBJECTS");
             break;
         default:
@@ -27,16 +27,22 @@
 #ifndef RS_FILTERDXFRW_H
 #define RS_FILTERDXFRW_H
 
+#include <functional>
+#include <memory>
+#include <unordered_set>
+
 #include "rs_filterinterface.h"
 
 #include "rs_color.h"
 #include "rs_dimension.h"
 #include "drw_interface.h"
 #include "lc_extentitydata.h"
+#include "lc_importmonitor.h"
 #include "libdxfrw.h"
 
 class LC_DimStyle;
 class LC_Hyperbola;
+class LC_RegenScheduler;
 class RS_Point;
 class RS_Line;
 class RS_Circle;
@@ -136,6 +142,20 @@ public:
 
     // Export:
     bool fileExport(RS_Graphic& g, const QString& file, RS2::FormatType type) override;
+    /**
+     * Files are exported in binary DXF if set, otherwise in ASCII DXF.
+     */
+    void setBinaryExport(bool binary) {
+        m_binaryExport = binary;
+    }
+    /**
+     * Restores regenerated inserts once the file is read, e.g. from the document cache.
+     * Returns the restored inserts, only the others are regenerated on import.
+     */
+    using InsertsRestorer = std::function<std::unordered_set<const RS_Entity*>(RS_Graphic&)>;
+    void setInsertsRestorer(InsertsRestorer restorer) {
+        m_insertsRestorer = std::move(restorer);
+    }
 
     void writeHeader(DRW_Header& data) override;
     void writeLType(const std::string& lTypeName, const std::string& ltDescription, int ltSize, double ltLength,
@@ -237,6 +257,9 @@ protected:
 private:
     void prepareBlocks();
     void writeEntity(RS_Entity* e);
+    void reportImportProgress(LC_ImportMonitor::Section section);
+    void reportEntityImported();
+    void commandMessage(const QString& message) const;
 #ifdef DWGSUPPORT
     void printDwgError(int le);
     QString strVal(DRW_Variant* var);
@@ -275,6 +298,14 @@ private:
     QHash<int, RS_EntityContainer*> m_blockHash;
     /** Pointer to entity container to store possible orphan entities like paper space */
     RS_EntityContainer* m_dummyContainer = nullptr;
+    bool m_binaryExport = false;
+    /** Import was aborted by the import monitor */
+    bool m_importCancelled = false;
+    /** Regenerates texts, hatches and inserts once all entities are read */
+    std::unique_ptr<LC_RegenScheduler> m_regenScheduler;
+    InsertsRestorer m_insertsRestorer;
+    void updateOrDefer(RS_Entity* entity);
+    bool isDroppedBlock(RS_EntityContainer* container) const;
     void applyParsedDimStyleExtData(LC_DimStyle* dimStyle, const QString& appName, const std::vector<DRW_Variant>& vector);
     LC_DimStyle *createDimStyle(const DRW_Dimstyle &s);
     void addPolylineSegment(RS_Polyline& polyline, RS_Vector prev_pos, RS_Vector curr_pos, double bulge, const std::vector<std::shared_ptr<DRW_Variant>>& extData, bool isClosedSegment);
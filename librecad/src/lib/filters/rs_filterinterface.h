@@ -33,6 +33,8 @@
 
 #include <QObject>
 
+class LC_ImportMonitor;
+
 /**
  * This is the interface that must be implemented for all 
  * format filter classes. The RS_FileIO class 
@@ -100,10 +102,19 @@ public:
         return errorCode;
     };
 
+    /**
+     * Sets monitor for progress and cancellation of the next import.
+     * Filters which do not support it ignore the monitor.
+     */
+    void setImportMonitor(LC_ImportMonitor* monitor) {
+        m_importMonitor = monitor;
+    }
+
     static RS_FilterInterface * createFilter(){return NULL;}
 
 protected:
     int errorCode {0};  //< error code for last import/export action
+    LC_ImportMonitor* m_importMonitor = nullptr;
 };
 
 #endif
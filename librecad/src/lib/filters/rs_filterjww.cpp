@@ -1061,8 +1061,7 @@ void RS_FilterJWW::linkImage(const DL_ImageDefData& data) {
         }
 
         // Also link images in subcontainers (e.g. inserts):
-        for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-                        e; e=graphic->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e : *graphic) {
                 if (e->rtti()==RS2::EntityImage) {
                         RS_Image* img = (RS_Image*)e;
                         if (img->getHandle()==handle) {
@@ -1076,8 +1075,7 @@ void RS_FilterJWW::linkImage(const DL_ImageDefData& data) {
         // update images in blocks:
         for (unsigned i=0; i<graphic->countBlocks(); ++i) {
                 RS_Block* b = graphic->blockAt(i);
-                for (RS_Entity* e=b->firstEntity(RS2::ResolveNone);
-                                e; e=b->nextEntity(RS2::ResolveNone)) {
+                for (RS_Entity* e : *b) {
                         if (e->rtti()==RS2::EntityImage) {
                                 RS_Image* img = (RS_Image*)e;
                                 if (img->getHandle()==handle) {
@@ -1362,9 +1360,7 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         // Section ENTITIES:
         RS_DEBUG->print("writing section ENTITIES...");
         dw->sectionEntities();
-        for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-                        e;
-                        e=graphic->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e : *graphic) {
 
                 writeEntity(*dw, e);
         }
@@ -1379,9 +1375,7 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                 QStringList written;
                 for (unsigned i=0; i<graphic->countBlocks(); ++i) {
                         RS_Block* block = graphic->blockAt(i);
-                        for (RS_Entity* e=block->firstEntity(RS2::ResolveAll);
-                                        e;
-                                        e=block->nextEntity(RS2::ResolveAll)) {
+                        for (RS_Entity* e : lc::LC_ContainerTraverser{*block, RS2::ResolveAll}.entities()) {
 
                                 if (e->rtti()==RS2::EntityImage) {
                                         RS_Image* img = ((RS_Image*)e);
@@ -1392,9 +1386,7 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                                 }
                         }
                 }
-                for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-                                e;
-                                e=graphic->nextEntity(RS2::ResolveNone)) {
+                for (RS_Entity* e : *graphic) {
 
                         if (e->rtti()==RS2::EntityImage) {
                                 RS_Image* img = ((RS_Image*)e);
@@ -1503,7 +1495,7 @@ void RS_FilterJWW::writeLayer(DL_WriterA& dw, RS_Layer* l) {
                 return;
         }
 
-        RS_DEBUG->print("RS_FilterJWW::writeLayer %s", l->getName().toLatin1().constData());
+        LC_DEBUG_PRINT("RS_FilterJWW::writeLayer %s", l->getName().toLatin1().constData());
 
         jww.writeLayer(
                 dw,
@@ -1552,16 +1544,14 @@ void RS_FilterJWW::writeBlock(DL_WriterA& dw, RS_Block* blk) {
                 return;
         }
 
-        RS_DEBUG->print("writing block: %s", (const char*)blk->getName().toLocal8Bit().data());
+        LC_DEBUG_PRINT("writing block: %s", (const char*)blk->getName().toLocal8Bit().data());
 
         jww.writeBlock(dw,
                                    DL_BlockData((const char*)blk->getName().toLocal8Bit().data(), 0,
                                                                 blk->getBasePoint().x,
                                                                 blk->getBasePoint().y,
                                                                 blk->getBasePoint().z));
-        for (RS_Entity* e=blk->firstEntity(RS2::ResolveNone);
-                        e;
-                        e=blk->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e : *blk) {
                 writeEntity(dw, e);
         }
         jww.writeEndBlock(dw, (const char*)blk->getName().toLocal8Bit().data());
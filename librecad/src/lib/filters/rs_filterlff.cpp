@@ -61,7 +61,7 @@ RS_FilterLFF::RS_FilterLFF() : RS_FilterInterface() {
  * taken to be stored in a file.
  */
 bool RS_FilterLFF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
-    RS_DEBUG->print("LFF Filter: importing file '%s'...", file.toLatin1().data());
+    LC_DEBUG_PRINT("LFF Filter: importing file '%s'...", file.toLatin1().data());
 
     //this->graphic = &g;
     bool success = false;
@@ -72,8 +72,8 @@ bool RS_FilterLFF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
     success = font.loadFont();
 
     if (success==false) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "Cannot open LFF file '%s'.", file.toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING,
+                             "Cannot open LFF file '%s'.", file.toLatin1().data());
 		return false;
     }
 
@@ -134,7 +134,7 @@ QString clearZeros(double num, int prec){
  */
 bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
 
-    RS_DEBUG->print("LFF Filter: exporting file '%s'...", file.toLatin1().data());
+    LC_DEBUG_PRINT("LFF Filter: exporting file '%s'...", file.toLatin1().data());
     RS_DEBUG->print("RS_FilterLFF::fileExport: open");
 
     QFile f(file);
@@ -175,7 +175,7 @@ bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         ts << QString("# Last modified:     %1\n").arg(dateline);
 
         QString sa = g.getVariableString("Authors", "");
-        RS_DEBUG->print("authors: %s", sa.toLocal8Bit().data());
+        LC_DEBUG_PRINT("authors: %s", sa.toLocal8Bit().data());
         if (!sa.isEmpty()) {
             QStringList authors = sa.split(',');
             LC_LOG<<"count: " << authors.count();
@@ -200,8 +200,8 @@ bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
             RS_DEBUG->print("block: %d", i);
 
             if (blk && !blk->isUndone()) {
-                RS_DEBUG->print("002a: %s",
-                                (blk->getName().toLocal8Bit().data()));
+                LC_DEBUG_PRINT("002a: %s",
+                               (blk->getName().toLocal8Bit().data()));
 
                 ts << QString("\n%1\n").arg(blk->getName());
 
@@ -25,12 +25,20 @@
 
 #include <QImageWriter>
 #include <QSvgGenerator>
+#include <algorithm>
 
 #include "lc_graphicviewport.h"
+#include "lc_pngstripwriter.h"
 #include "lc_printviewportrenderer.h"
+#include "lc_tiffstripwriter.h"
 #include "rs_graphic.h"
 #include "rs_painter.h"
 
+namespace {
+    // default size of the band, in bytes of RGB32 image
+    constexpr qint64 DEFAULT_BAND_BYTES = 32 * 1024 * 1024;
+}
+
 LC_ImageExporter::LC_ImageExporter(QObject* parent)
     : QObject{parent} {
 }
@@ -64,6 +72,9 @@ bool LC_ImageExporter::exportGraphicToSVG(RS_Graphic* graphic, const ExportOptio
 }
 
 bool LC_ImageExporter::exportGraphicToImage(RS_Graphic* graphic, const ExportOptions& options) {
+    if (isBandedExport(options)) {
+        return exportGraphicToImageBanded(graphic, options);
+    }
     QSize size = options.size;
     auto pixMap = QPixmap(size);
     QPaintDevice* buffer = &pixMap;
@@ -127,3 +138,115 @@ void LC_ImageExporter::prepareViewport(RS_Graphic* graphic, const ExportOptions&
     viewport.zoomAuto(false);
     viewport.loadSettings();
 }
+
+bool LC_ImageExporter::isStreamingFormat(const ExportOptions& options) const {
+    QString format = options.format.toLower();
+    return format == "tif" || format == "tiff" || format == "png";
+}
+
+/**
+ * Only formats that may be written band by band are exported by bands. Qt's writers for JPEG and other
+ * formats need the entire image in memory, so banding them would not limit the peak memory anyway.
+ */
+bool LC_ImageExporter::isBandedExport(const ExportOptions& options) const {
+    return isStreamingFormat(options);
+}
+
+/**
+ * Streams the image to TIFF or PNG file band by band, so the peak memory is limited by the size of one band.
+ */
+bool LC_ImageExporter::exportGraphicToImageBanded(RS_Graphic* graphic, const ExportOptions& options) {
+    const int width = options.size.width();
+    const int height = options.size.height();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    int bandHeight = options.bandHeight;
+    if (bandHeight <= 0) {
+        bandHeight = static_cast<int>(std::max<qint64>(1, DEFAULT_BAND_BYTES / (static_cast<qint64>(width) * 4)));
+    }
+    bandHeight = std::min(bandHeight, height);
+
+    if (options.format.toLower() == "png") {
+        LC_PngStripWriter pngWriter;
+        if (!pngWriter.open(options.fileName, width, height)) {
+            return false;
+        }
+        bool rendered = renderBands(graphic, options, bandHeight, [&pngWriter](const QImage& band) {
+            return pngWriter.writeStrip(band);
+        });
+        return pngWriter.close() && rendered;
+    }
+
+    LC_TiffStripWriter tiffWriter;
+    if (!tiffWriter.open(options.fileName, width, height, bandHeight)) {
+        return false;
+    }
+    bool rendered = renderBands(graphic, options, bandHeight, [&tiffWriter](const QImage& band) {
+        return tiffWriter.writeStrip(band);
+    });
+    return tiffWriter.close() && rendered;
+}
+
+/**
+ * Renders the image by horizontal bands. Each band uses own viewport that has the same factor and offset as the viewport
+ * for the full image would have, so only entities that intersect the band are painted.
+ * Each band is passed to the writer as soon as it is rendered. Bands are rendered one after another, as rendering of the
+ * same graphic from several threads is not safe.
+ */
+bool LC_ImageExporter::renderBands(RS_Graphic* graphic, const ExportOptions& options, int bandHeight,
+                                   const std::function<bool(const QImage&)>& writeBand) {
+    const int width = options.size.width();
+    const int height = options.size.height();
+
+    LC_GraphicViewport fullViewport;
+    prepareViewport(graphic, options, fullViewport);
+
+    QImage band(width, bandHeight, QImage::Format_RGB32);
+    if (band.isNull()) {
+        return false;
+    }
+    for (int bandTop = 0; bandTop < height; bandTop += bandHeight) {
+        int h = std::min(bandHeight, height - bandTop);
+        if (h != band.height()) {
+            band = QImage(width, h, QImage::Format_RGB32);
+        }
+        renderBand(graphic, options, fullViewport, bandTop, band);
+        if (!writeBand(band)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LC_ImageExporter::renderBand(RS_Graphic* graphic, const ExportOptions& options,
+                                  const LC_GraphicViewport& fullViewport, int bandTop, QImage& band) {
+    const int bandHeight = band.height();
+    auto borderWidth = options.borders.width();
+    auto borderHeight = options.borders.height();
+
+    LC_GraphicViewport viewport;
+    viewport.setSize(band.width(), bandHeight);
+    viewport.setBorders(borderWidth, borderHeight, borderWidth, borderHeight);
+    viewport.setContainer(graphic);
+    // shift vertical offset so that toGuiY() of the band is toGuiY() of the full image minus band top
+    viewport.justSetOffsetAndFactor(fullViewport.getOffsetX(),
+                                    fullViewport.getOffsetY() + bandTop + bandHeight - fullViewport.getHeight(),
+                                    fullViewport.getFactor().x);
+    viewport.loadSettings();
+
+    RS_Painter painter(&band);
+    bool black = options.backgroundBlack;
+    painter.setBackground(black ? Qt::black : Qt::white);
+    if (options.blackAndWhite) {
+        painter.setDrawingMode(black ? RS2::ModeWB : RS2::ModeBW);
+    }
+    painter.eraseRect(0, 0, band.width(), bandHeight);
+
+    LC_PrintViewportRenderer renderer(&viewport, &painter);
+    renderer.loadSettings();
+    renderer.setBackground(black ? Qt::black : Qt::white);
+    renderer.render();
+    painter.end();
+}
@@ -24,7 +24,9 @@
 #define LC_IMAGEEXPORTER_H
 
 #include <QSvgGenerator>
+#include <functional>
 
+class QImage;
 class RS_Painter;
 class LC_GraphicViewport;
 class RS_Graphic;
@@ -39,6 +41,8 @@ public:
         QSize borders;
         bool backgroundBlack;
         bool blackAndWhite;
+        // height (in pixels) of the horizontal band used for banded export, 0 - default
+        int bandHeight = 0;
     };
     explicit LC_ImageExporter(QObject* parent = nullptr);
     bool exportToImage(RS_Graphic* graphic, const ExportOptions& options);
@@ -50,5 +54,12 @@ protected:
     bool savePixmapToImage(const ExportOptions& options, const QPixmap &pixMap);
     bool exportGraphicToImage(RS_Graphic* graphic, const ExportOptions& options);
     void renderGraphic(RS_Graphic* graphic, const ExportOptions& options, QPaintDevice* buffer);
+    bool isBandedExport(const ExportOptions& options) const;
+    bool isStreamingFormat(const ExportOptions& options) const;
+    bool exportGraphicToImageBanded(RS_Graphic* graphic, const ExportOptions& options);
+    bool renderBands(RS_Graphic* graphic, const ExportOptions& options, int bandHeight,
+                     const std::function<bool(const QImage&)>& writeBand);
+    void renderBand(RS_Graphic* graphic, const ExportOptions& options, const LC_GraphicViewport& fullViewport,
+                    int bandTop, QImage& band);
 };
 #endif // LC_IMAGEEXPORTER_H
@@ -0,0 +1,435 @@
+/*
+ * **************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * *********************************************************************
+ */
+
+#include "lc_pngstripwriter.h"
+
+#include <QImage>
+#include <QtEndian>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    constexpr int WINDOW_SIZE = 32768;
+    constexpr int WINDOW_MASK = WINDOW_SIZE - 1;
+    constexpr int HASH_BITS = 15;
+    constexpr int MIN_MATCH = 3;
+    constexpr int MAX_MATCH = 258;
+    // longer chains find longer matches, but make compression slower
+    constexpr int MAX_CHAIN = 32;
+    // input is deflated by chunks, so the buffer keeps the window and one chunk only
+    constexpr int CHUNK_SIZE = 65536;
+    constexpr quint32 ADLER_BASE = 65521;
+    // the largest count of bytes that may be summed before adler sums overflow
+    constexpr int ADLER_MAX_BYTES = 5552;
+    constexpr int BYTES_PER_PIXEL = 3;
+
+    // base values and extra bits of length codes 257..285 and of distance codes 0..29
+    constexpr std::array<quint16, 29> LENGTH_BASE{3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43,
+                                                  51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    constexpr std::array<quint8, 29> LENGTH_EXTRA{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3,
+                                                  3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    constexpr std::array<quint16, 30> DISTANCE_BASE{1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257,
+                                                    385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289,
+                                                    16385, 24577};
+    constexpr std::array<quint8, 30> DISTANCE_EXTRA{0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9,
+                                                    9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    // Huffman codes are packed starting from the most significant bit, other data from the least significant one
+    quint32 reverseBits(quint32 code, int length) {
+        quint32 result = 0;
+        for (int i = 0; i < length; i++) {
+            result = (result << 1) | (code & 1);
+            code >>= 1;
+        }
+        return result;
+    }
+
+    quint32 crc32(const char* data, qsizetype size, quint32 crc) {
+        static const std::array<quint32, 256> table = [] {
+            std::array<quint32, 256> result{};
+            for (quint32 i = 0; i < 256; i++) {
+                quint32 c = i;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                result[i] = c;
+            }
+            return result;
+        }();
+        for (qsizetype i = 0; i < size; i++) {
+            crc = table[(crc ^ static_cast<uchar>(data[i])) & 0xff] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    int paethPredictor(int left, int up, int upLeft) {
+        int p = left + up - upLeft;
+        int pa = std::abs(p - left);
+        int pb = std::abs(p - up);
+        int pc = std::abs(p - upLeft);
+        if (pa <= pb && pa <= pc) {
+            return left;
+        }
+        return pb <= pc ? up : upLeft;
+    }
+}
+
+/**
+ * Deflate encoder for a zlib stream that is produced piece by piece. Each piece of input is written as one
+ * block with fixed Huffman codes, and matches are searched by hash chains within the last 32 KB of input.
+ * That compresses rendered drawings (large areas of the same color, filtered to zeros) nearly as well as
+ * dynamic codes would.
+ */
+class LC_PngDeflater {
+public:
+    LC_PngDeflater():m_head(1 << HASH_BITS, -1), m_prev(WINDOW_SIZE, -1) {}
+
+    /**
+     * Appends compressed input to the output, as a block which is not the last one.
+     */
+    void deflate(const QByteArray& input, QByteArray& output) {
+        if (input.isEmpty()) {
+            return;
+        }
+        writeHeader(output);
+        // not the final block, fixed codes
+        writeBits(0, 1, output);
+        writeBits(1, 2, output);
+        auto data = reinterpret_cast<const uchar*>(input.constData());
+        for (qsizetype offset = 0; offset < input.size(); offset += CHUNK_SIZE) {
+            int size = static_cast<int>(std::min<qsizetype>(CHUNK_SIZE, input.size() - offset));
+            deflateChunk(data + offset, size, output);
+        }
+        writeSymbol(256, output);
+    }
+
+    /**
+     * Appends the final empty block and the checksum of the stream.
+     */
+    void finish(QByteArray& output) {
+        writeHeader(output);
+        writeBits(1, 1, output);
+        writeBits(1, 2, output);
+        writeSymbol(256, output);
+        if (m_bitCount > 0) {
+            writeBits(0, 8 - m_bitCount, output);
+        }
+        quint32 adler = (m_adlerB << 16) | m_adlerA;
+        uchar buf[4];
+        qToBigEndian(adler, buf);
+        output.append(reinterpret_cast<const char*>(buf), 4);
+    }
+private:
+    void writeHeader(QByteArray& output) {
+        if (!m_headerWritten) {
+            // deflate with 32 KB window, fastest compression level
+            output.append('\x78');
+            output.append('\x01');
+            m_headerWritten = true;
+        }
+    }
+
+    void writeBits(quint32 value, int count, QByteArray& output) {
+        m_bitBuffer |= value << m_bitCount;
+        m_bitCount += count;
+        while (m_bitCount >= 8) {
+            output.append(static_cast<char>(m_bitBuffer & 0xff));
+            m_bitBuffer >>= 8;
+            m_bitCount -= 8;
+        }
+    }
+
+    void writeSymbol(int symbol, QByteArray& output) {
+        if (symbol < 144) {
+            writeBits(reverseBits(0x30 + symbol, 8), 8, output);
+        }
+        else if (symbol < 256) {
+            writeBits(reverseBits(0x190 + symbol - 144, 9), 9, output);
+        }
+        else if (symbol < 280) {
+            writeBits(reverseBits(symbol - 256, 7), 7, output);
+        }
+        else {
+            writeBits(reverseBits(0xC0 + symbol - 280, 8), 8, output);
+        }
+    }
+
+    void writeMatch(int length, int distance, QByteArray& output) {
+        int lengthCode = static_cast<int>(LENGTH_BASE.size()) - 1;
+        while (LENGTH_BASE[lengthCode] > length) {
+            lengthCode--;
+        }
+        writeSymbol(257 + lengthCode, output);
+        if (LENGTH_EXTRA[lengthCode] > 0) {
+            writeBits(length - LENGTH_BASE[lengthCode], LENGTH_EXTRA[lengthCode], output);
+        }
+        int distanceCode = static_cast<int>(DISTANCE_BASE.size()) - 1;
+        while (DISTANCE_BASE[distanceCode] > distance) {
+            distanceCode--;
+        }
+        writeBits(reverseBits(distanceCode, 5), 5, output);
+        if (DISTANCE_EXTRA[distanceCode] > 0) {
+            writeBits(distance - DISTANCE_BASE[distanceCode], DISTANCE_EXTRA[distanceCode], output);
+        }
+    }
+
+    void updateAdler(const uchar* data, int size) {
+        while (size > 0) {
+            int count = std::min(size, ADLER_MAX_BYTES);
+            for (int i = 0; i < count; i++) {
+                m_adlerA += data[i];
+                m_adlerB += m_adlerA;
+            }
+            m_adlerA %= ADLER_BASE;
+            m_adlerB %= ADLER_BASE;
+            data += count;
+            size -= count;
+        }
+    }
+
+    int hashAt(int index) const {
+        quint32 value = m_buffer[index] | (m_buffer[index + 1] << 8) | (m_buffer[index + 2] << 16);
+        return static_cast<int>((value * 2654435761u) >> (32 - HASH_BITS));
+    }
+
+    void insert(int index, int end) {
+        if (index + MIN_MATCH <= end) {
+            int hash = hashAt(index);
+            qint64 position = m_bufferStart + index;
+            m_prev[position & WINDOW_MASK] = m_head[hash];
+            m_head[hash] = position;
+        }
+    }
+
+    void deflateChunk(const uchar* data, int size, QByteArray& output) {
+        // only the window is kept from previous input
+        if (m_buffer.size() > static_cast<size_t>(WINDOW_SIZE)) {
+            size_t dropped = m_buffer.size() - WINDOW_SIZE;
+            m_buffer.erase(m_buffer.begin(), m_buffer.begin() + dropped);
+            m_bufferStart += dropped;
+        }
+        int index = static_cast<int>(m_buffer.size());
+        m_buffer.insert(m_buffer.end(), data, data + size);
+        updateAdler(data, size);
+        const int end = static_cast<int>(m_buffer.size());
+
+        while (index < end) {
+            int bestLength = 0;
+            int bestDistance = 0;
+            if (index + MIN_MATCH <= end) {
+                const qint64 position = m_bufferStart + index;
+                const int maxLength = std::min(MAX_MATCH, end - index);
+                qint64 candidate = m_head[hashAt(index)];
+                // entries of the chain are not overwritten while they are within the window
+                for (int chain = 0; chain < MAX_CHAIN && candidate >= m_bufferStart
+                                    && position - candidate <= WINDOW_SIZE; chain++) {
+                    int from = static_cast<int>(candidate - m_bufferStart);
+                    if (m_buffer[from + bestLength] == m_buffer[index + bestLength]) {
+                        int length = 0;
+                        while (length < maxLength && m_buffer[from + length] == m_buffer[index + length]) {
+                            length++;
+                        }
+                        if (length > bestLength) {
+                            bestLength = length;
+                            bestDistance = static_cast<int>(position - candidate);
+                            if (length == maxLength) {
+                                break;
+                            }
+                        }
+                    }
+                    qint64 next = m_prev[candidate & WINDOW_MASK];
+                    if (next >= candidate) {
+                        break;
+                    }
+                    candidate = next;
+                }
+            }
+            if (bestLength >= MIN_MATCH) {
+                writeMatch(bestLength, bestDistance, output);
+                for (int i = 0; i < bestLength; i++) {
+                    insert(index + i, end);
+                }
+                index += bestLength;
+            }
+            else {
+                writeSymbol(m_buffer[index], output);
+                insert(index, end);
+                index++;
+            }
+        }
+    }
+
+    std::vector<uchar> m_buffer;
+    // position of the first byte of the buffer within the stream
+    qint64 m_bufferStart = 0;
+    // the last position of each hash, and the previous position with the same hash for positions in the window
+    std::vector<qint64> m_head;
+    std::vector<qint64> m_prev;
+    quint32 m_adlerA = 1;
+    quint32 m_adlerB = 0;
+    quint32 m_bitBuffer = 0;
+    int m_bitCount = 0;
+    bool m_headerWritten = false;
+};
+
+LC_PngStripWriter::LC_PngStripWriter() = default;
+
+LC_PngStripWriter::~LC_PngStripWriter() {
+    if (m_file.isOpen()) {
+        close();
+    }
+}
+
+bool LC_PngStripWriter::open(const QString& fileName, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+    m_rowsWritten = 0;
+    m_failed = false;
+    m_previousRow = QByteArray(static_cast<qsizetype>(width) * BYTES_PER_PIXEL, '\0');
+    m_currentRow = QByteArray(m_previousRow.size(), '\0');
+    m_deflater = std::make_unique<LC_PngDeflater>();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    if (m_file.write("\x89PNG\r\n\x1a\n", 8) != 8) {
+        m_failed = true;
+    }
+    QByteArray header(13, '\0');
+    qToBigEndian<quint32>(static_cast<quint32>(width), header.data());
+    qToBigEndian<quint32>(static_cast<quint32>(height), header.data() + 4);
+    header[8] = 8; // bit depth
+    header[9] = 2; // RGB, compression, filter and interlace methods are 0
+    writeChunk("IHDR", header);
+    return !m_failed;
+}
+
+bool LC_PngStripWriter::writeStrip(const QImage& strip) {
+    if (!m_file.isOpen() || m_failed) {
+        return false;
+    }
+    int rows = std::min(strip.height(), m_height - m_rowsWritten);
+    if (rows <= 0 || strip.width() < m_width) {
+        return false;
+    }
+    QImage rgb = strip.format() == QImage::Format_RGB32 ? strip : strip.convertToFormat(QImage::Format_RGB32);
+    QByteArray filtered;
+    filtered.reserve((m_currentRow.size() + 1) * rows);
+    for (int y = 0; y < rows; y++) {
+        auto line = reinterpret_cast<const QRgb*>(rgb.constScanLine(y));
+        char* dst = m_currentRow.data();
+        for (int x = 0; x < m_width; x++) {
+            QRgb pixel = line[x];
+            *dst++ = static_cast<char>(qRed(pixel));
+            *dst++ = static_cast<char>(qGreen(pixel));
+            *dst++ = static_cast<char>(qBlue(pixel));
+        }
+        filterRow(reinterpret_cast<const uchar*>(m_currentRow.constData()), filtered);
+        std::swap(m_previousRow, m_currentRow);
+    }
+    QByteArray compressed;
+    m_deflater->deflate(filtered, compressed);
+    writeChunk("IDAT", compressed);
+    m_rowsWritten += rows;
+    return !m_failed;
+}
+
+/**
+ * Appends the row with the filter that gives the smallest sum of absolute differences, as libpng does.
+ */
+void LC_PngStripWriter::filterRow(const uchar* row, QByteArray& output) {
+    auto up = reinterpret_cast<const uchar*>(m_previousRow.constData());
+    const int size = static_cast<int>(m_previousRow.size());
+    auto predicted = [row, up](int filter, int i) -> int {
+        int left = i >= BYTES_PER_PIXEL ? row[i - BYTES_PER_PIXEL] : 0;
+        int upLeft = i >= BYTES_PER_PIXEL ? up[i - BYTES_PER_PIXEL] : 0;
+        switch (filter) {
+            case 1:
+                return left;
+            case 2:
+                return up[i];
+            case 4:
+                return paethPredictor(left, up[i], upLeft);
+            default:
+                return 0;
+        }
+    };
+    // filters none, sub, up and paeth; average is rarely the best for drawings
+    constexpr std::array<int, 4> filters{0, 1, 2, 4};
+    int bestFilter = 0;
+    qint64 bestSum = -1;
+    for (int filter : filters) {
+        qint64 sum = 0;
+        for (int i = 0; i < size && (bestSum < 0 || sum < bestSum); i++) {
+            auto value = static_cast<uchar>(row[i] - predicted(filter, i));
+            sum += value < 128 ? value : 256 - value;
+        }
+        if (bestSum < 0 || sum < bestSum) {
+            bestSum = sum;
+            bestFilter = filter;
+        }
+    }
+    output.append(static_cast<char>(bestFilter));
+    for (int i = 0; i < size; i++) {
+        output.append(static_cast<char>(row[i] - predicted(bestFilter, i)));
+    }
+}
+
+void LC_PngStripWriter::writeChunk(const char* type, const QByteArray& data) {
+    uchar length[4];
+    qToBigEndian<quint32>(static_cast<quint32>(data.size()), length);
+    quint32 crc = crc32(type, 4, 0xffffffffu);
+    crc = crc32(data.constData(), data.size(), crc) ^ 0xffffffffu;
+    uchar checksum[4];
+    qToBigEndian(crc, checksum);
+    if (m_file.write(reinterpret_cast<const char*>(length), 4) != 4 || m_file.write(type, 4) != 4
+        || m_file.write(data) != data.size() || m_file.write(reinterpret_cast<const char*>(checksum), 4) != 4) {
+        m_failed = true;
+    }
+}
+
+bool LC_PngStripWriter::close() {
+    if (!m_file.isOpen()) {
+        return false;
+    }
+    bool result = !m_failed && m_rowsWritten == m_height;
+    if (result) {
+        QByteArray compressed;
+        m_deflater->finish(compressed);
+        writeChunk("IDAT", compressed);
+        writeChunk("IEND", QByteArray());
+        result = !m_failed && m_file.flush();
+    }
+    m_file.close();
+    m_deflater.reset();
+    if (!result) {
+        m_file.remove();
+    }
+    return result;
+}
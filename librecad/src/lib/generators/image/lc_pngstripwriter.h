@@ -0,0 +1,63 @@
+/***************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * **********************************************************************
+ */
+
+#ifndef LC_PNGSTRIPWRITER_H
+#define LC_PNGSTRIPWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <memory>
+
+class QImage;
+class LC_PngDeflater;
+
+/**
+ * Minimal streaming writer of RGB PNG files.
+ * PNG keeps the whole image in one zlib stream, so each strip is filtered, deflated as a block of
+ * that stream and written as an IDAT chunk right away. Only the strip that is currently encoded and
+ * the last row of the previous strip (used by filters) are kept in memory. Strips must be added from
+ * top to bottom.
+ */
+class LC_PngStripWriter {
+public:
+    LC_PngStripWriter();
+    ~LC_PngStripWriter();
+    bool open(const QString& fileName, int width, int height);
+    bool writeStrip(const QImage& strip);
+    bool close();
+    bool isOpen() const {return m_file.isOpen();}
+protected:
+    void writeChunk(const char* type, const QByteArray& data);
+    void filterRow(const uchar* row, QByteArray& output);
+private:
+    QFile m_file;
+    int m_width = 0;
+    int m_height = 0;
+    int m_rowsWritten = 0;
+    bool m_failed = false;
+    // previous row of RGB bytes, the first row is filtered against zeros
+    QByteArray m_previousRow;
+    QByteArray m_currentRow;
+    std::unique_ptr<LC_PngDeflater> m_deflater;
+};
+
+#endif // LC_PNGSTRIPWRITER_H
@@ -0,0 +1,337 @@
+/*
+ * **************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * *********************************************************************
+ */
+
+#include "lc_tiffstripwriter.h"
+
+#include <QImage>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+
+namespace {
+    // TIFF field types
+    constexpr quint16 TYPE_SHORT = 3;
+    constexpr quint16 TYPE_LONG = 4;
+    constexpr quint16 TYPE_RATIONAL = 5;
+    constexpr quint16 TYPE_LONG8 = 16;
+
+    constexpr quint16 COMPRESSION_DEFLATE = 8;
+    constexpr quint16 PHOTOMETRIC_RGB = 2;
+    constexpr quint16 RESOLUTION_UNIT_INCH = 2;
+    constexpr quint32 DEFAULT_DPI = 72;
+
+    constexpr quint16 VERSION_CLASSIC = 42;
+    constexpr quint16 VERSION_BIG = 43;
+    // offset of the first IFD offset within the header
+    constexpr qint64 HEADER_IFD_OFFSET_CLASSIC = 4;
+    constexpr qint64 HEADER_IFD_OFFSET_BIG = 8;
+
+    // qCompress() prepends 4 bytes of uncompressed size to the zlib stream
+    constexpr int QCOMPRESS_HEADER_SIZE = 4;
+
+    // room left for deflate overhead of incompressible strips and for the IFD
+    constexpr quint64 RESERVED_SIZE = 1024 * 1024;
+    constexpr quint64 STRIP_OVERHEAD = 64;
+
+    int typeSize(quint16 type) {
+        switch (type) {
+            case TYPE_SHORT:
+                return 2;
+            case TYPE_LONG:
+                return 4;
+            default:
+                return 8;
+        }
+    }
+
+    void append16(QByteArray& data, quint16 value) {
+        uchar buf[2];
+        qToLittleEndian(value, buf);
+        data.append(reinterpret_cast<const char*>(buf), 2);
+    }
+
+    void append32(QByteArray& data, quint32 value) {
+        uchar buf[4];
+        qToLittleEndian(value, buf);
+        data.append(reinterpret_cast<const char*>(buf), 4);
+    }
+
+    void append64(QByteArray& data, quint64 value) {
+        uchar buf[8];
+        qToLittleEndian(value, buf);
+        data.append(reinterpret_cast<const char*>(buf), 8);
+    }
+}
+
+LC_TiffStripWriter::~LC_TiffStripWriter() {
+    if (m_file.isOpen()) {
+        close();
+    }
+}
+
+/**
+ * Estimates whether the file may exceed offsets of classic TIFF. The estimate assumes the worst case,
+ * when strips are not compressed at all.
+ */
+bool LC_TiffStripWriter::requiresBigTiff(int width, int height, int rowsPerStrip) {
+    if (width <= 0 || height <= 0 || rowsPerStrip <= 0) {
+        return false;
+    }
+    const quint64 rawSize = static_cast<quint64>(width) * static_cast<quint64>(height) * 3;
+    const quint64 stripsCount = (static_cast<quint64>(height) + rowsPerStrip - 1) / rowsPerStrip;
+    const quint64 estimate = rawSize + rawSize / 1000 + stripsCount * STRIP_OVERHEAD + RESERVED_SIZE;
+    return estimate > std::numeric_limits<quint32>::max();
+}
+
+bool LC_TiffStripWriter::open(const QString& fileName, int width, int height, int rowsPerStrip) {
+    return open(fileName, width, height, rowsPerStrip, requiresBigTiff(width, height, rowsPerStrip));
+}
+
+bool LC_TiffStripWriter::open(const QString& fileName, int width, int height, int rowsPerStrip, bool bigTiff) {
+    if (width <= 0 || height <= 0 || rowsPerStrip <= 0) {
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+    m_rowsPerStrip = rowsPerStrip;
+    m_rowsWritten = 0;
+    m_failed = false;
+    m_bigTiff = bigTiff;
+    m_stripOffsets.clear();
+    m_stripByteCounts.clear();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    // little-endian header, offset of IFD is patched on close
+    if (m_file.write("II", 2) != 2) {
+        m_failed = true;
+    }
+    if (m_bigTiff) {
+        write16(VERSION_BIG);
+        write16(8); // size of offsets
+        write16(0);
+        write64(0);
+    }
+    else {
+        write16(VERSION_CLASSIC);
+        write32(0);
+    }
+    return !m_failed;
+}
+
+bool LC_TiffStripWriter::writeStrip(const QImage& strip) {
+    if (!m_file.isOpen() || m_failed) {
+        return false;
+    }
+    int rows = std::min(strip.height(), m_height - m_rowsWritten);
+    if (rows <= 0 || strip.width() < m_width) {
+        return false;
+    }
+
+    QImage rgb = strip.format() == QImage::Format_RGB888 ? strip : strip.convertToFormat(QImage::Format_RGB888);
+    const qsizetype rowSize = static_cast<qsizetype>(m_width) * 3;
+    QByteArray raw;
+    raw.resize(rowSize * rows);
+    char* dst = raw.data();
+    for (int y = 0; y < rows; y++) {
+        memcpy(dst, rgb.constScanLine(y), rowSize);
+        dst += rowSize;
+    }
+
+    QByteArray compressed = qCompress(raw);
+    const char* data = compressed.constData() + QCOMPRESS_HEADER_SIZE;
+    const qint64 size = compressed.size() - QCOMPRESS_HEADER_SIZE;
+
+    qint64 offset = m_file.pos();
+    if (!m_bigTiff && static_cast<quint64>(offset + size) > std::numeric_limits<quint32>::max()) {
+        // classic TIFF is limited by 32-bit offsets
+        m_failed = true;
+        return false;
+    }
+    if (m_file.write(data, size) != size) {
+        m_failed = true;
+        return false;
+    }
+    m_stripOffsets.push_back(static_cast<quint64>(offset));
+    m_stripByteCounts.push_back(static_cast<quint64>(size));
+    m_rowsWritten += rows;
+    return true;
+}
+
+bool LC_TiffStripWriter::close() {
+    if (!m_file.isOpen()) {
+        return false;
+    }
+    bool result = !m_failed && m_rowsWritten == m_height && writeIFD();
+    m_file.close();
+    if (!result) {
+        m_file.remove();
+    }
+    return result;
+}
+
+void LC_TiffStripWriter::write16(quint16 value) {
+    uchar buf[2];
+    qToLittleEndian(value, buf);
+    if (m_file.write(reinterpret_cast<const char*>(buf), 2) != 2) {
+        m_failed = true;
+    }
+}
+
+void LC_TiffStripWriter::write32(quint32 value) {
+    uchar buf[4];
+    qToLittleEndian(value, buf);
+    if (m_file.write(reinterpret_cast<const char*>(buf), 4) != 4) {
+        m_failed = true;
+    }
+}
+
+void LC_TiffStripWriter::write64(quint64 value) {
+    uchar buf[8];
+    qToLittleEndian(value, buf);
+    if (m_file.write(reinterpret_cast<const char*>(buf), 8) != 8) {
+        m_failed = true;
+    }
+}
+
+/**
+ * Writes an offset or a count of the IFD, which are 32-bit in classic TIFF and 64-bit in BigTIFF.
+ */
+void LC_TiffStripWriter::writeOffset(quint64 value) {
+    if (m_bigTiff) {
+        write64(value);
+    }
+    else if (value > std::numeric_limits<quint32>::max()) {
+        m_failed = true;
+    }
+    else {
+        write32(static_cast<quint32>(value));
+    }
+}
+
+bool LC_TiffStripWriter::writeIFD() {
+    // word alignment of the data following the strips
+    if (m_file.pos() % 2 != 0 && m_file.write("\0", 1) != 1) {
+        m_failed = true;
+    }
+
+    const quint16 offsetType = m_bigTiff ? TYPE_LONG8 : TYPE_LONG;
+    QByteArray bitsPerSample;
+    for (int i = 0; i < 3; i++) {
+        append16(bitsPerSample, 8);
+    }
+    QByteArray resolution;
+    append32(resolution, DEFAULT_DPI);
+    append32(resolution, 1);
+    QByteArray stripOffsets;
+    QByteArray stripByteCounts;
+    for (size_t i = 0; i < m_stripOffsets.size(); i++) {
+        if (m_bigTiff) {
+            append64(stripOffsets, m_stripOffsets[i]);
+            append64(stripByteCounts, m_stripByteCounts[i]);
+        }
+        else {
+            append32(stripOffsets, static_cast<quint32>(m_stripOffsets[i]));
+            append32(stripByteCounts, static_cast<quint32>(m_stripByteCounts[i]));
+        }
+    }
+    auto shortValue = [](quint16 value) {
+        QByteArray result;
+        append16(result, value);
+        return result;
+    };
+    auto longValue = [](quint32 value) {
+        QByteArray result;
+        append32(result, value);
+        return result;
+    };
+    const quint64 stripsCount = m_stripOffsets.size();
+
+    // entries must be sorted by tag
+    std::vector<IFDEntry> entries{
+        {256, TYPE_LONG, 1, longValue(static_cast<quint32>(m_width))}, // ImageWidth
+        {257, TYPE_LONG, 1, longValue(static_cast<quint32>(m_height))}, // ImageLength
+        {258, TYPE_SHORT, 3, bitsPerSample}, // BitsPerSample
+        {259, TYPE_SHORT, 1, shortValue(COMPRESSION_DEFLATE)}, // Compression
+        {262, TYPE_SHORT, 1, shortValue(PHOTOMETRIC_RGB)}, // PhotometricInterpretation
+        {273, offsetType, stripsCount, stripOffsets}, // StripOffsets
+        {277, TYPE_SHORT, 1, shortValue(3)}, // SamplesPerPixel
+        {278, TYPE_LONG, 1, longValue(static_cast<quint32>(m_rowsPerStrip))}, // RowsPerStrip
+        {279, offsetType, stripsCount, stripByteCounts}, // StripByteCounts
+        {282, TYPE_RATIONAL, 1, resolution}, // XResolution
+        {283, TYPE_RATIONAL, 1, resolution}, // YResolution
+        {284, TYPE_SHORT, 1, shortValue(1)}, // PlanarConfiguration - chunky
+        {296, TYPE_SHORT, 1, shortValue(RESOLUTION_UNIT_INCH)} // ResolutionUnit
+    };
+
+    // values which don't fit into the value field of the entry go before the IFD
+    const int valueFieldSize = m_bigTiff ? 8 : 4;
+    std::vector<quint64> valueOffsets(entries.size(), 0);
+    for (size_t i = 0; i < entries.size(); i++) {
+        const IFDEntry& entry = entries[i];
+        if (entry.count * typeSize(entry.type) > static_cast<quint64>(valueFieldSize)) {
+            valueOffsets[i] = static_cast<quint64>(m_file.pos());
+            if (m_file.write(entry.value) != entry.value.size()) {
+                m_failed = true;
+            }
+            if (m_file.pos() % 2 != 0 && m_file.write("\0", 1) != 1) {
+                m_failed = true;
+            }
+        }
+    }
+
+    const quint64 ifdOffset = static_cast<quint64>(m_file.pos());
+    if (m_bigTiff) {
+        write64(entries.size());
+    }
+    else {
+        write16(static_cast<quint16>(entries.size()));
+    }
+    for (size_t i = 0; i < entries.size(); i++) {
+        const IFDEntry& entry = entries[i];
+        write16(entry.tag);
+        write16(entry.type);
+        writeOffset(entry.count);
+        if (entry.count * typeSize(entry.type) > static_cast<quint64>(valueFieldSize)) {
+            writeOffset(valueOffsets[i]);
+        }
+        else {
+            // values are left-justified within the value field
+            QByteArray value = entry.value;
+            value.append(QByteArray(valueFieldSize - value.size(), '\0'));
+            if (m_file.write(value) != value.size()) {
+                m_failed = true;
+            }
+        }
+    }
+    writeOffset(0); // no next IFD
+
+    // patch offset of the IFD in the header
+    if (!m_file.seek(m_bigTiff ? HEADER_IFD_OFFSET_BIG : HEADER_IFD_OFFSET_CLASSIC)) {
+        return false;
+    }
+    writeOffset(ifdOffset);
+    return !m_failed && m_file.flush();
+}
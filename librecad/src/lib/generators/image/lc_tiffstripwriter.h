@@ -0,0 +1,76 @@
+/***************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * **********************************************************************
+ */
+
+#ifndef LC_TIFFSTRIPWRITER_H
+#define LC_TIFFSTRIPWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <vector>
+
+class QImage;
+
+/**
+ * Minimal streaming writer of baseline RGB TIFF files.
+ * The image is written strip by strip (each strip is deflate-compressed independently), so
+ * only the strip that is currently encoded should be kept in memory. Strips must be added
+ * from top to bottom, and all strips except the last one should have the same height that
+ * was passed to open().
+ * Classic TIFF is limited to 4 GB by 32-bit offsets, so images that may exceed that size are
+ * written as BigTIFF with 64-bit offsets.
+ */
+class LC_TiffStripWriter {
+public:
+    LC_TiffStripWriter() = default;
+    ~LC_TiffStripWriter();
+    bool open(const QString& fileName, int width, int height, int rowsPerStrip);
+    bool open(const QString& fileName, int width, int height, int rowsPerStrip, bool bigTiff);
+    bool writeStrip(const QImage& strip);
+    bool close();
+    bool isOpen() const {return m_file.isOpen();}
+    bool isBigTiff() const {return m_bigTiff;}
+    static bool requiresBigTiff(int width, int height, int rowsPerStrip);
+protected:
+    struct IFDEntry {
+        quint16 tag;
+        quint16 type;
+        quint64 count;
+        QByteArray value;
+    };
+    void write16(quint16 value);
+    void write32(quint32 value);
+    void write64(quint64 value);
+    void writeOffset(quint64 value);
+    bool writeIFD();
+private:
+    QFile m_file;
+    int m_width = 0;
+    int m_height = 0;
+    int m_rowsPerStrip = 0;
+    int m_rowsWritten = 0;
+    bool m_failed = false;
+    bool m_bigTiff = false;
+    std::vector<quint64> m_stripOffsets;
+    std::vector<quint64> m_stripByteCounts;
+};
+
+#endif // LC_TIFFSTRIPWRITER_H
@@ -0,0 +1,116 @@
+/*
+ * **************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * *********************************************************************
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "lc_pngstripwriter.h"
+
+namespace {
+    // mix of flat areas, gradients and noise, so that all row filters and both literals and matches are used
+    QImage makeStrip(int width, int height, int top) {
+        QImage image(width, height, QImage::Format_RGB32);
+        quint32 noise = 12345u + top;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int row = top + y;
+                QRgb color = qRgb(255, 255, 255);
+                if (x % 50 < 10) {
+                    color = qRgb(x % 256, row % 256, (x * row) % 256);
+                }
+                else if (row % 40 < 5) {
+                    noise = noise * 1103515245u + 12345u;
+                    color = qRgb((noise >> 16) & 0xff, (noise >> 8) & 0xff, noise & 0xff);
+                }
+                image.setPixel(x, y, color);
+            }
+        }
+        return image;
+    }
+
+    void checkImage(const QString& fileName, const std::vector<QImage>& strips) {
+        QImage image(fileName, "PNG");
+        REQUIRE_FALSE(image.isNull());
+        image = image.convertToFormat(QImage::Format_RGB32);
+        int top = 0;
+        for (const QImage& strip : strips) {
+            for (int y = 0; y < strip.height(); y++) {
+                for (int x = 0; x < strip.width(); x++) {
+                    REQUIRE(image.pixel(x, top + y) == strip.pixel(x, y));
+                }
+            }
+            top += strip.height();
+        }
+        REQUIRE(image.height() == top);
+    }
+}
+
+TEST_CASE("LC_PngStripWriter writes strips readable by Qt") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    SECTION("small strips") {
+        const std::vector<QImage> strips{makeStrip(37, 8, 0), makeStrip(37, 8, 8), makeStrip(37, 3, 16)};
+        const QString fileName = dir.filePath("small.png");
+        LC_PngStripWriter writer;
+        REQUIRE(writer.open(fileName, 37, 19));
+        for (const QImage& strip : strips) {
+            REQUIRE(writer.writeStrip(strip));
+        }
+        REQUIRE(writer.close());
+        checkImage(fileName, strips);
+    }
+
+    SECTION("strips larger than the deflate window") {
+        // each strip is about 180 KB of filtered data
+        const std::vector<QImage> strips{makeStrip(600, 100, 0), makeStrip(600, 100, 100), makeStrip(600, 57, 200)};
+        const QString fileName = dir.filePath("large.png");
+        LC_PngStripWriter writer;
+        REQUIRE(writer.open(fileName, 600, 257));
+        for (const QImage& strip : strips) {
+            REQUIRE(writer.writeStrip(strip));
+        }
+        REQUIRE(writer.close());
+        checkImage(fileName, strips);
+        // flat areas are compressed
+        REQUIRE(QFile(fileName).size() < 600 * 257 * 3 / 2);
+    }
+}
+
+TEST_CASE("LC_PngStripWriter fails incomplete images") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("incomplete.png");
+
+    LC_PngStripWriter writer;
+    REQUIRE(writer.open(fileName, 10, 16));
+    REQUIRE_FALSE(writer.writeStrip(makeStrip(9, 8, 0)));
+    REQUIRE(writer.writeStrip(makeStrip(10, 8, 0)));
+    REQUIRE_FALSE(writer.close());
+    REQUIRE_FALSE(QFile::exists(fileName));
+
+    REQUIRE_FALSE(writer.open(fileName, 0, 16));
+}
@@ -0,0 +1,218 @@
+/*
+ * **************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * *********************************************************************
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <QByteArray>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <cstring>
+#include <map>
+
+#include "lc_tiffstripwriter.h"
+
+namespace {
+    struct IFDEntry {
+        quint16 type = 0;
+        quint64 count = 0;
+        // position of the values, either the value field itself or the offset stored there
+        quint64 valuesPosition = 0;
+    };
+
+    quint16 read16(const QByteArray& data, quint64 offset) {
+        return qFromLittleEndian<quint16>(data.constData() + offset);
+    }
+
+    quint32 read32(const QByteArray& data, quint64 offset) {
+        return qFromLittleEndian<quint32>(data.constData() + offset);
+    }
+
+    quint64 read64(const QByteArray& data, quint64 offset) {
+        return qFromLittleEndian<quint64>(data.constData() + offset);
+    }
+
+    int typeSize(quint16 type) {
+        return type == 3 ? 2 : type == 4 ? 4 : 8;
+    }
+
+    bool isBigTiff(const QByteArray& data) {
+        return read16(data, 2) == 43;
+    }
+
+    std::map<quint16, IFDEntry> readIFD(const QByteArray& data) {
+        const bool big = isBigTiff(data);
+        const quint64 fieldSize = big ? 8 : 4;
+        std::map<quint16, IFDEntry> entries;
+        quint64 ifd = big ? read64(data, 8) : read32(data, 4);
+        quint64 count = big ? read64(data, ifd) : read16(data, ifd);
+        quint64 first = ifd + (big ? 8 : 2);
+        for (quint64 i = 0; i < count; i++) {
+            quint64 entry = first + i * (big ? 20 : 12);
+            IFDEntry e;
+            e.type = read16(data, entry + 2);
+            e.count = big ? read64(data, entry + 4) : read32(data, entry + 4);
+            quint64 field = entry + (big ? 12 : 8);
+            if (e.count * typeSize(e.type) <= fieldSize) {
+                e.valuesPosition = field;
+            }
+            else {
+                e.valuesPosition = big ? read64(data, field) : read32(data, field);
+            }
+            entries[read16(data, entry)] = e;
+        }
+        return entries;
+    }
+
+    std::vector<quint64> readValues(const QByteArray& data, const IFDEntry& entry) {
+        std::vector<quint64> values;
+        const int size = typeSize(entry.type);
+        for (quint64 i = 0; i < entry.count; i++) {
+            quint64 position = entry.valuesPosition + i * size;
+            values.push_back(size == 2 ? read16(data, position) : size == 4 ? read32(data, position) : read64(data, position));
+        }
+        return values;
+    }
+
+    quint64 readValue(const QByteArray& data, const IFDEntry& entry) {
+        return readValues(data, entry).front();
+    }
+
+    QImage makeStrip(int width, int height, int seed) {
+        QImage image(width, height, QImage::Format_RGB32);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                image.setPixel(x, y, qRgb((x * 7 + seed) % 256, (y * 13 + seed) % 256, (x + y + seed) % 256));
+            }
+        }
+        return image;
+    }
+
+    QByteArray writeImage(const QString& fileName, const std::vector<QImage>& strips, int rowsPerStrip, bool bigTiff) {
+        int height = 0;
+        for (const QImage& strip : strips) {
+            height += strip.height();
+        }
+        LC_TiffStripWriter writer;
+        REQUIRE(writer.open(fileName, strips.front().width(), height, rowsPerStrip, bigTiff));
+        REQUIRE(writer.isBigTiff() == bigTiff);
+        for (const QImage& strip : strips) {
+            REQUIRE(writer.writeStrip(strip));
+        }
+        REQUIRE(writer.close());
+        QFile file(fileName);
+        REQUIRE(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    }
+
+    void checkStrips(const QByteArray& data, const std::vector<QImage>& strips) {
+        auto ifd = readIFD(data);
+        const int width = strips.front().width();
+        REQUIRE(readValue(data, ifd.at(256)) == static_cast<quint64>(width));
+        REQUIRE(readValues(data, ifd.at(258)) == std::vector<quint64>{8, 8, 8});
+        REQUIRE(readValues(data, ifd.at(282)) == std::vector<quint64>{(quint64(1) << 32) | 72});
+        const std::vector<quint64> offsets = readValues(data, ifd.at(273));
+        const std::vector<quint64> sizes = readValues(data, ifd.at(279));
+        REQUIRE(offsets.size() == strips.size());
+        REQUIRE(sizes.size() == strips.size());
+
+        const int rowSize = width * 3;
+        for (size_t i = 0; i < strips.size(); i++) {
+            const QImage rgb = strips[i].convertToFormat(QImage::Format_RGB888);
+            // qUncompress() expects the size of uncompressed data before the zlib stream
+            QByteArray compressed(4, '\0');
+            qToBigEndian<quint32>(rowSize * rgb.height(), compressed.data());
+            compressed.append(data.mid(offsets[i], sizes[i]));
+            const QByteArray raw = qUncompress(compressed);
+            REQUIRE(raw.size() == rowSize * rgb.height());
+            for (int y = 0; y < rgb.height(); y++) {
+                REQUIRE(memcmp(raw.constData() + y * rowSize, rgb.constScanLine(y), rowSize) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("LC_TiffStripWriter writes strips readable by offsets in IFD") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const std::vector<QImage> strips{makeStrip(37, 8, 1), makeStrip(37, 8, 2), makeStrip(37, 4, 3)};
+
+    const QByteArray data = writeImage(dir.filePath("strips.tif"), strips, 8, false);
+    REQUIRE(data.startsWith("II"));
+    REQUIRE(read16(data, 2) == 42);
+    auto ifd = readIFD(data);
+    REQUIRE(readValue(data, ifd.at(257)) == 20);
+    REQUIRE(readValue(data, ifd.at(278)) == 8);
+    REQUIRE(ifd.at(273).type == 4);
+    checkStrips(data, strips);
+}
+
+TEST_CASE("LC_TiffStripWriter writes BigTIFF with 64-bit offsets") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    SECTION("several strips") {
+        const std::vector<QImage> strips{makeStrip(21, 5, 4), makeStrip(21, 5, 5), makeStrip(21, 2, 6)};
+        const QByteArray data = writeImage(dir.filePath("big.tif"), strips, 5, true);
+        REQUIRE(data.startsWith("II"));
+        REQUIRE(read16(data, 2) == 43);
+        REQUIRE(read16(data, 4) == 8);
+        auto ifd = readIFD(data);
+        REQUIRE(ifd.size() == 13);
+        REQUIRE(ifd.at(273).type == 16);
+        REQUIRE(ifd.at(279).type == 16);
+        REQUIRE(readValue(data, ifd.at(257)) == 12);
+        checkStrips(data, strips);
+    }
+
+    SECTION("single strip keeps offsets inline") {
+        const std::vector<QImage> strips{makeStrip(16, 3, 7)};
+        const QByteArray data = writeImage(dir.filePath("single.tif"), strips, 3, true);
+        checkStrips(data, strips);
+    }
+}
+
+TEST_CASE("LC_TiffStripWriter chooses BigTIFF for images over 4 GB") {
+    REQUIRE_FALSE(LC_TiffStripWriter::requiresBigTiff(10000, 10000, 64));
+    // 3 bytes per pixel - 4.8 GB of uncompressed data
+    REQUIRE(LC_TiffStripWriter::requiresBigTiff(40000, 40000, 64));
+    REQUIRE_FALSE(LC_TiffStripWriter::requiresBigTiff(0, 40000, 64));
+}
+
+TEST_CASE("LC_TiffStripWriter fails incomplete images") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("incomplete.tif");
+
+    LC_TiffStripWriter writer;
+    REQUIRE(writer.open(fileName, 10, 16, 8));
+    // narrower strip is rejected
+    REQUIRE_FALSE(writer.writeStrip(makeStrip(9, 8, 0)));
+    REQUIRE(writer.writeStrip(makeStrip(10, 8, 0)));
+    // missing rows - the file is removed
+    REQUIRE_FALSE(writer.close());
+    REQUIRE_FALSE(QFile::exists(fileName));
+
+    REQUIRE_FALSE(writer.open(dir.filePath("missing/dir/file.tif"), 10, 16, 8));
+}
@@ -22,8 +22,13 @@
 
 #include "lc_printviewportrenderer.h"
 
+#include <QDataStream>
+#include <QTransform>
+
 #include "lc_graphicviewport.h"
+#include "lc_pdfwriter.h"
 #include "rs_entitycontainer.h"
+#include "rs_insert.h"
 #include "rs_math.h"
 #include "rs_painter.h"
 
@@ -39,6 +44,7 @@ LC_PrintViewportRenderer::LC_PrintViewportRenderer(LC_GraphicViewport *viewport,
 
 void LC_PrintViewportRenderer::doRender() {
     setupPainter(painter);
+    m_pdfWriter = dynamic_cast<LC_PdfWriter*>(painter->device());
     RS_EntityContainer *container = viewport->getContainer();
     container->draw(painter);
 }
@@ -72,9 +78,87 @@ void LC_PrintViewportRenderer::renderEntity(RS_Painter *painter, RS_Entity *e) {
         return;
     }
     setPenForPrintingEntity(painter, e);
+    if (m_pdfWriter != nullptr && e->rtti() == RS2::EntityInsert) {
+        drawInsertAsForm(painter, static_cast<RS_Insert*>(e), false);
+        return;
+    }
     justDrawEntity(painter, e);
 }
 
+void LC_PrintViewportRenderer::renderEntityAsChild(RS_Painter *painter, RS_Entity *e) {
+    // letters of texts are inserts of font glyphs, drawn as children of the text
+    if (m_pdfWriter != nullptr && e->rtti() == RS2::EntityInsert) {
+        drawInsertAsForm(painter, static_cast<RS_Insert*>(e), true);
+        return;
+    }
+    LC_GraphicViewportRenderer::renderEntityAsChild(painter, e);
+}
+
+/**
+ * Draws the insert as a reference to the PDF form recorded for an earlier occurrence of the same block
+ * with the same scale and pens. If there is no such form yet, the insert is drawn while a new form is recorded.
+ * Only inserts fully within the page are recorded, as painter may cut the geometry which is outside.
+ */
+void LC_PrintViewportRenderer::drawInsertAsForm(RS_Painter *painter, RS_Insert *insert, bool asChild) {
+    auto draw = [this, painter, insert, asChild]() {
+        if (asChild) {
+            LC_GraphicViewportRenderer::renderEntityAsChild(painter, insert);
+        } else {
+            justDrawEntity(painter, insert);
+        }
+    };
+    RS_Block* block = insert->getBlockForInsert();
+    if (block == nullptr || !painter->isFullyWithinBoundingRect(insert)) {
+        draw();
+        return;
+    }
+    QByteArray key = formKey(painter, insert, block, asChild);
+    QTransform frame = formFrame(painter, insert);
+    if (m_pdfWriter->drawForm(key, frame)) {
+        return;
+    }
+    m_pdfWriter->beginForm(key, frame);
+    draw();
+    m_pdfWriter->endForm();
+}
+
+/**
+ * Everything that affects the appearance of the insert, except its position and rotation.
+ */
+QByteArray LC_PrintViewportRenderer::formKey(RS_Painter *painter, RS_Insert *insert, RS_Block *block, bool asChild) const {
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+    RS_Vector scale = insert->getScale();
+    RS_Vector spacing = insert->getSpacing();
+    stream << quintptr(block) << asChild << scale.x << scale.y
+           << insert->getCols() << insert->getRows() << spacing.x << spacing.y;
+
+    // children with ByBlock/ByLayer attributes are resolved by the insert
+    RS_Pen pen = insert->getPenResolved();
+    stream << pen.getColor().rgba() << int(pen.getWidth()) << int(pen.getLineType())
+           << quintptr(insert->getLayer());
+
+    // children with the same pen as the insert are drawn by the pen already set to painter.
+    // Dash offset is not included - it only shifts dash patterns, while all other occurrences would miss the form
+    const QPen &qpen = painter->pen();
+    stream << qpen.color().rgba() << qpen.widthF() << int(qpen.style()) << int(qpen.capStyle())
+           << int(qpen.joinStyle()) << qpen.dashPattern();
+    return key;
+}
+
+/**
+ * Device transform of insert's coordinate system without scale. As the scale is part of the form key,
+ * occurrences sharing a form differ by position and rotation only, so line widths and dashes are kept.
+ */
+QTransform LC_PrintViewportRenderer::formFrame(RS_Painter *painter, RS_Insert *insert) const {
+    RS_Vector origin = insert->getInsertionPoint();
+    double angle = insert->getAngle();
+    RS_Vector o = painter->toGui(origin);
+    RS_Vector x = painter->toGui(origin + RS_Vector::polar(1.0, angle));
+    RS_Vector y = painter->toGui(origin + RS_Vector::polar(1.0, angle + M_PI_2));
+    return QTransform(x.x - o.x, x.y - o.y, y.x - o.x, y.y - o.y, o.x, o.y);
+}
+
 void LC_PrintViewportRenderer::setPenForPrintingEntity(RS_Painter *painter, RS_Entity *e) {
 #ifdef DEBUG_RENDERING
     setPenTimer.start();
@@ -25,12 +25,17 @@
 
 #include "lc_graphicviewportrenderer.h"
 
+class LC_PdfWriter;
 class QPaintDevice;
+class QTransform;
+class RS_Block;
+class RS_Insert;
 
 class LC_PrintViewportRenderer :public LC_GraphicViewportRenderer{
 public:
     explicit LC_PrintViewportRenderer(LC_GraphicViewport *viewport, RS_Painter* painter);
     void renderEntity(RS_Painter *painter, RS_Entity *entity) override;
+    void renderEntityAsChild(RS_Painter *painter, RS_Entity *e) override;
     RS2::DrawingMode getDrawingMode() {
         return drawingMode;
     }
@@ -48,7 +53,12 @@ protected:
     RS_Painter* painter {nullptr};
     double paperScale = 1.0;
     RS2::DrawingMode drawingMode = RS2::DrawingMode::ModeAuto;
+    // set if the output is a PDF file, so repeated inserts (blocks, font glyphs) are emitted as shared forms
+    LC_PdfWriter* m_pdfWriter {nullptr};
     void setPenForPrintingEntity(RS_Painter *painter, RS_Entity *e);
+    void drawInsertAsForm(RS_Painter *painter, RS_Insert *insert, bool asChild);
+    QByteArray formKey(RS_Painter *painter, RS_Insert *insert, RS_Block *block, bool asChild) const;
+    QTransform formFrame(RS_Painter *painter, RS_Insert *insert) const;
     void doRender() override;
 };
 
@@ -213,6 +213,20 @@ bool LC_GraphicViewportRenderer::isTextLineNotRenderable([[maybe_unused]]double
     return false;
 }
 
+LC_GraphicViewportRenderer::ContainerDetail LC_GraphicViewportRenderer::getContainerDetail([[maybe_unused]]double uiContainerSize) const {
+    return ContainerDetailFull;
+}
+
+LC_GraphicViewportRenderer::ContainerDetail LC_GraphicViewportRenderer::containerDetailForSize(
+    double uiContainerSize, double uiMinContainerSize, ContainerDetail smallContainerDetail) {
+    // false for NaN as well
+    return uiContainerSize < uiMinContainerSize ? smallContainerDetail : ContainerDetailFull;
+}
+
+bool LC_GraphicViewportRenderer::isHatchPatternNotRenderable([[maybe_unused]]double uiPatternSpacing) const {
+    return false;
+}
+
 void LC_GraphicViewportRenderer::updateAnglesBasis(RS_Graphic *g) {
     m_angleBasisBaseAngle = g->getAnglesBase();
     m_angleBasisCounterClockwise = g->areAnglesCounterClockWise();
@@ -43,17 +43,37 @@ class QPaintDevice;
 
 class LC_GraphicViewportRenderer{
   public:
+    /**
+     * Level of detail used for containers (inserts, dimensions) which are small on the screen.
+     */
+    enum ContainerDetail {
+        ContainerDetailFull,        // draw all child entities
+        ContainerDetailBoundingBox, // draw bounding box of the container only
+        ContainerDetailNone         // don't draw the container at all
+    };
+    static constexpr ContainerDetail DEFAULT_SMALL_CONTAINER_DETAIL = ContainerDetailBoundingBox;
+    static constexpr int DEFAULT_MIN_CONTAINER_SIZE_PX = 4;
+
+    /**
+     * @return the detail for small containers if the size of the container on the screen is below the minimal size,
+     * full detail otherwise or if the size is unknown.
+     */
+    static ContainerDetail containerDetailForSize(double uiContainerSize, double uiMinContainerSize,
+                                                  ContainerDetail smallContainerDetail);
+
     explicit LC_GraphicViewportRenderer(LC_GraphicViewport* viewport, QPaintDevice* painterDevice);
     virtual ~LC_GraphicViewportRenderer() = default;
     virtual void loadSettings();
     void render();
     virtual void renderEntity(RS_Painter* painter, RS_Entity* entity)  = 0;
-    void renderEntityAsChild(RS_Painter *painter, RS_Entity *e);
+    virtual void renderEntityAsChild(RS_Painter *painter, RS_Entity *e);
     void justDrawEntity(RS_Painter *painter, RS_Entity *e);
     void setBackground(const RS_Color &bg);
     const LC_Rect &getBoundingClipRect() const {return renderBoundingClipRect;}
 
     virtual bool isTextLineNotRenderable(double uiLineHeight) const = 0;
+    virtual ContainerDetail getContainerDetail(double uiContainerSize) const;
+    virtual bool isHatchPatternNotRenderable(double uiPatternSpacing) const;
 
     void setLineWidthScaling(bool state){
         m_scaleLineWidth = state;
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_SCREENPATH_H
+#define LC_SCREENPATH_H
+
+#include <QPainterPath>
+
+#include "lc_screentransform.h"
+
+/**
+ * Screen-space path of the entity, cached together with world-to-screen transform it was built for.
+ * If the view is just panned, the path may be drawn translated instead of rebuilding it.
+ */
+struct LC_ScreenPath {
+    LC_ScreenPath(const LC_ScreenTransform& t, QPainterPath&& p):
+        transform{t}, path{std::move(p)} {}
+    LC_ScreenTransform transform;
+    QPainterPath path;
+};
+
+#endif // LC_SCREENPATH_H
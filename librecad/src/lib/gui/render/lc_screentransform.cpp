@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_screentransform.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LC_SCREENTRANSFORM_SSE2
+#include <emmintrin.h>
+#endif
+
+LC_ScreenTransform::LC_ScreenTransform(double m11, double m12, double m21, double m22, double dx, double dy):
+    m_m11{m11}, m_m12{m12}, m_m21{m21}, m_m22{m22}, m_dx{dx}, m_dy{dy} {
+}
+
+void LC_ScreenTransform::map(const double* wcsXY, double* uiXY, std::size_t pointsCount) const {
+#ifdef LC_SCREENTRANSFORM_SSE2
+    // one point per register: [x, x] * [m11, m21] + [y, y] * [m12, m22] + [dx, dy]
+    const __m128d column1 = _mm_set_pd(m_m21, m_m11);
+    const __m128d column2 = _mm_set_pd(m_m22, m_m12);
+    const __m128d translation = _mm_set_pd(m_dy, m_dx);
+    std::size_t i = 0;
+    for (; i + 1 < pointsCount; i += 2) {
+        const __m128d p1 = _mm_loadu_pd(wcsXY + 2 * i);
+        const __m128d p2 = _mm_loadu_pd(wcsXY + 2 * i + 2);
+        const __m128d x1 = _mm_unpacklo_pd(p1, p1);
+        const __m128d y1 = _mm_unpackhi_pd(p1, p1);
+        const __m128d x2 = _mm_unpacklo_pd(p2, p2);
+        const __m128d y2 = _mm_unpackhi_pd(p2, p2);
+        const __m128d r1 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x1, column1), _mm_mul_pd(y1, column2)), translation);
+        const __m128d r2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x2, column1), _mm_mul_pd(y2, column2)), translation);
+        _mm_storeu_pd(uiXY + 2 * i, r1);
+        _mm_storeu_pd(uiXY + 2 * i + 2, r2);
+    }
+    if (i < pointsCount) {
+        map(wcsXY[2 * i], wcsXY[2 * i + 1], uiXY[2 * i], uiXY[2 * i + 1]);
+    }
+#else
+    for (std::size_t i = 0; i < pointsCount; i++) {
+        const double x = wcsXY[2 * i];
+        const double y = wcsXY[2 * i + 1];
+        uiXY[2 * i] = m_m11 * x + m_m12 * y + m_dx;
+        uiXY[2 * i + 1] = m_m21 * x + m_m22 * y + m_dy;
+    }
+#endif
+}
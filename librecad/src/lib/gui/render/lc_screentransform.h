@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_SCREENTRANSFORM_H
+#define LC_SCREENTRANSFORM_H
+
+#include <cstddef>
+
+/**
+ * Affine transformation from world (WCS) coordinates to screen coordinates, which combines UCS origin and rotation,
+ * viewport factor, offset and flipping of y axis. Used for converting of coordinates arrays in batch during
+ * rendering, instead of converting points one by one.
+ */
+class LC_ScreenTransform {
+public:
+    LC_ScreenTransform() = default;
+    LC_ScreenTransform(double m11, double m12, double m21, double m22, double dx, double dy);
+
+    /**
+     * Converts array of points to the screen coordinates.
+     * @param wcsXY interleaved x,y world coordinates
+     * @param uiXY interleaved x,y screen coordinates. May be the same as wcsXY for in-place conversion.
+     * @param pointsCount amount of points in the arrays
+     */
+    void map(const double* wcsXY, double* uiXY, std::size_t pointsCount) const;
+    void map(double wcsX, double wcsY, double& uiX, double& uiY) const {
+        uiX = m_m11 * wcsX + m_m12 * wcsY + m_dx;
+        uiY = m_m21 * wcsX + m_m22 * wcsY + m_dy;
+    }
+
+    /**
+     * @return true if transforms differ by translation only (i.e. the view was panned)
+     */
+    bool isTranslatedOf(const LC_ScreenTransform& other) const {
+        return m_m11 == other.m_m11 && m_m12 == other.m_m12 && m_m21 == other.m_m21 && m_m22 == other.m_m22;
+    }
+    double getDX() const {return m_dx;}
+    double getDY() const {return m_dy;}
+private:
+    double m_m11 = 1.0;
+    double m_m12 = 0.0;
+    double m_m21 = 0.0;
+    double m_m22 = 1.0;
+    double m_dx = 0.0;
+    double m_dy = 0.0;
+};
+
+#endif // LC_SCREENTRANSFORM_H
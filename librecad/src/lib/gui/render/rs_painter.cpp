@@ -27,7 +27,9 @@
 #include "dxf_format.h"
 #include "lc_graphicviewport.h"
 #include "lc_graphicviewportrenderer.h"
+#include "lc_imagecache.h"
 #include "lc_linemath.h"
+#include "lc_screenpath.h"
 #include "lc_splinepoints.h"
 #include "rs_arc.h"
 #include "rs_circle.h"
@@ -1057,7 +1059,75 @@ void RS_Painter::drawSplinePointsUI(const std::vector<RS_Vector> &uiControlPoint
     QPainter::drawPath(qPath);
 }
 
+namespace {
+    bool isPolylineOfLines(const RS_Polyline* polyline) {
+        return std::all_of(polyline->begin(), polyline->end(), [](const RS_Entity* entity) {
+            return entity->rtti() == RS2::EntityLine;
+        });
+    }
+}
+
+/**
+ * Draws cached screen path of the entity, if it was built for the same transform or the transform differs
+ * by translation only (the view was panned). In the latter case the path is drawn translated.
+ * @return false if the path does not match the transform and should be rebuilt
+ */
+bool RS_Painter::drawScreenPath(const LC_ScreenPath& screenPath, const LC_ScreenTransform& screenTransform) {
+    if (!screenTransform.isTranslatedOf(screenPath.transform)) {
+        return false;
+    }
+    double dx = screenTransform.getDX() - screenPath.transform.getDX();
+    double dy = screenTransform.getDY() - screenPath.transform.getDY();
+    if (dx == 0.0 && dy == 0.0) {
+        QPainter::drawPath(screenPath.path);
+    }
+    else {
+        QPainter::translate(dx, dy);
+        QPainter::drawPath(screenPath.path);
+        QPainter::translate(-dx, -dy);
+    }
+    return true;
+}
+
+/**
+ * Builds screen path for polyline that consists of lines only. Endpoints of all segments are converted in batch.
+ */
+QPainterPath RS_Painter::createPolylineLinesPath(const RS_Polyline& polyline, const LC_ScreenTransform& screenTransform) const {
+    std::vector<double> coordinates;
+    coordinates.reserve(polyline.count() * 4);
+    for (const RS_Entity* entity : polyline) {
+        const auto* line = static_cast<const RS_Line*>(entity);
+        const RS_Vector& start = line->getStartpoint();
+        const RS_Vector& end = line->getEndpoint();
+        coordinates.insert(coordinates.end(), {start.x, start.y, end.x, end.y});
+    }
+    const size_t pointsCount = coordinates.size() / 2;
+    screenTransform.map(coordinates.data(), coordinates.data(), pointsCount);
+
+    QPainterPath path;
+    path.reserve(static_cast<int>(pointsCount));
+    for (size_t i = 0; i + 1 < pointsCount; i += 2) {
+        path.moveTo(coordinates[2 * i], coordinates[2 * i + 1]);
+        path.lineTo(coordinates[2 * i + 2], coordinates[2 * i + 3]);
+    }
+    return path;
+}
+
 void RS_Painter::drawEntityPolyline(const RS_Polyline* polyline){
+    const LC_ScreenTransform screenTransform = getScreenTransform();
+    std::shared_ptr<const LC_ScreenPath> screenPath = polyline->getScreenPath();
+    if (screenPath != nullptr && drawScreenPath(*screenPath, screenTransform)) {
+        return;
+    }
+
+    if (isPolylineOfLines(polyline)) {
+        // path for lines depends on view transform only, so it's cached and reused while the view is not zoomed
+        screenPath = std::make_shared<const LC_ScreenPath>(screenTransform, createPolylineLinesPath(*polyline, screenTransform));
+        polyline->setScreenPath(screenPath);
+        QPainter::drawPath(screenPath->path);
+        return;
+    }
+
     QPainterPath path;
     path.moveTo(toGuiPointF(polyline->getStartpoint()));
 
@@ -1103,21 +1173,27 @@ void RS_Painter::drawSplineWCS(const RS_Spline& spline){
     QPainterPath path;
     unsigned int count = spline.count();
     if (count > 0) {
-        RS_Entity *child = spline.unsafeEntityAt(0);
-        double uiX, uiY;
-        toGui(child->getStartpoint(), uiX, uiY);
-        path.moveTo(uiX, uiY);
+        std::vector<double> coordinates;
+        coordinates.reserve((count + 1) * 2);
+        const RS_Vector& start = spline.unsafeEntityAt(0)->getStartpoint();
+        coordinates.insert(coordinates.end(), {start.x, start.y});
         for (unsigned int i = 0; i < count;i++) {
-            child = spline.unsafeEntityAt(i);
-            toGui(child->getEndpoint(), uiX, uiY);
-            path.lineTo(uiX, uiY);
+            const RS_Vector& end = spline.unsafeEntityAt(i)->getEndpoint();
+            coordinates.insert(coordinates.end(), {end.x, end.y});
+        }
+        getScreenTransform().map(coordinates.data(), coordinates.data(), count + 1);
+
+        path.reserve(static_cast<int>(count + 1));
+        path.moveTo(coordinates[0], coordinates[1]);
+        for (unsigned int i = 1; i <= count; i++) {
+            path.lineTo(coordinates[2 * i], coordinates[2 * i + 1]);
         }
     }
 
     QPainter::drawPath(path);
 }
 
-void RS_Painter::drawImgWCS(QImage& img, const RS_Vector& wcsInsertionPoint,
+void RS_Painter::drawImgWCS(LC_CachedImage& img, const RS_Vector& wcsInsertionPoint,
                            const RS_Vector& uVector, const RS_Vector& vVector) {
 
 //    if (viewport->hasUCS()) {
@@ -1137,7 +1213,19 @@ void RS_Painter::drawImgWCS(QImage& img, const RS_Vector& wcsInsertionPoint,
     double magnitudeV = vVector.magnitude(); // fixme - sand - render - cache?
     RS_Vector scale{toGuiDX(magnitudeU),toGuiDY(magnitudeV)};
     const RS_Vector uiInsert = toGui(wcsInsertionPoint);
-    drawImgUI(img, uiInsert, ucsUVector, ucsVVector, scale);
+
+    // when zoomed out, draw the level of the pyramid that is closest to the screen resolution instead of
+    // resampling the full image on each repaint. Printing always uses the full resolution.
+    int level = 0;
+    if (!(isPrinting() || isPrintPreview())) {
+        level = img.levelFor(std::min(std::abs(scale.x), std::abs(scale.y)));
+    }
+    QImage levelImage = img.getLevel(level);
+    if (level > 0) {
+        scale.x *= double(img.width()) / levelImage.width();
+        scale.y *= double(img.height()) / levelImage.height();
+    }
+    drawImgUI(levelImage, uiInsert, ucsUVector, ucsVVector, scale);
 }
 
 void RS_Painter::drawImgUI(QImage& img, const RS_Vector& uiInsert,
@@ -1590,6 +1678,42 @@ bool RS_Painter::isTextLineNotRenderable(double wcsLineHeight) const {
     return renderer->isTextLineNotRenderable(uiHeight);
 }
 
+/**
+ * Draws simplified representation of the container (insert, dimension) if it is too small
+ * on the screen for drawing its child entities, according to the level of detail set by the renderer.
+ * @param container container to draw
+ * @return true if the container was handled (drawn as placeholder or skipped), false if it should be drawn as usual
+ */
+bool RS_Painter::drawContainerReducedDetail(const RS_Entity* container) {
+    const RS_Vector wcsMin = container->getMin();
+    const RS_Vector wcsMax = container->getMax();
+    // borders of empty containers are reset, their size is unknown
+    if (!wcsMin.valid || !wcsMax.valid || wcsMin.x > wcsMax.x || wcsMin.y > wcsMax.y) {
+        return false;
+    }
+    double uiSize = std::max(toGuiDX(wcsMax.x - wcsMin.x), toGuiDY(wcsMax.y - wcsMin.y));
+    switch (renderer->getContainerDetail(uiSize)) {
+        case LC_GraphicViewportRenderer::ContainerDetailBoundingBox: {
+            const RS_Vector wcsCorner1{wcsMax.x, wcsMin.y};
+            const RS_Vector wcsCorner2{wcsMin.x, wcsMax.y};
+            drawLineWCS(wcsMin, wcsCorner1);
+            drawLineWCS(wcsCorner1, wcsMax);
+            drawLineWCS(wcsMax, wcsCorner2);
+            drawLineWCS(wcsCorner2, wcsMin);
+            return true;
+        }
+        case LC_GraphicViewportRenderer::ContainerDetailNone:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool RS_Painter::isHatchPatternNotRenderable(double wcsPatternSpacing) const {
+    double uiSpacing = toGuiDX(wcsPatternSpacing);
+    return renderer->isHatchPatternNotRenderable(uiSpacing);
+}
+
 void RS_Painter::setViewPort(LC_GraphicViewport *v) {
     viewport = v;
     apply(viewport);
@@ -1688,6 +1812,23 @@ QTransform RS_Painter::getToGuiTransform() const
 }
 
 
+/**
+ * @return world-to-screen transform equivalent to toGui(), for batch conversion of coordinates
+ */
+LC_ScreenTransform RS_Painter::getScreenTransform() const {
+    if (hasUCS()) {
+        const RS_Vector& ucsOrigin = getUcsOrigin();
+        const RS_Vector& ucsRotation = getUcsRotation();
+        const double cosA = ucsRotation.x;
+        const double sinA = ucsRotation.y;
+        return {viewPortFactorX * cosA, -viewPortFactorX * sinA,
+                -viewPortFactorY * sinA, -viewPortFactorY * cosA,
+                viewPortOffsetX - viewPortFactorX * (ucsOrigin.x * cosA - ucsOrigin.y * sinA),
+                viewPortHeight - viewPortOffsetY + viewPortFactorY * (ucsOrigin.x * sinA + ucsOrigin.y * cosA)};
+    }
+    return {viewPortFactorX, 0.0, 0.0, -viewPortFactorY, double(viewPortOffsetX), viewPortHeight - viewPortOffsetY};
+}
+
 QPointF RS_Painter::toGuiPointF(const RS_Vector& worldCoordinates) const{
     RS_Vector uiPos = toGui(worldCoordinates);
     return {uiPos.x, uiPos.y};
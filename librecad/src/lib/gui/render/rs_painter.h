@@ -32,8 +32,10 @@
 
 #include "lc_coordinates_mapper.h"
 #include "lc_rect.h"
+#include "lc_screentransform.h"
 #include "rs_pen.h"
 
+class LC_CachedImage;
 class RS_Arc;
 class RS_Circle;
 class RS_Color;
@@ -56,6 +58,7 @@ class QString;
 class LC_GraphicViewport;
 class LC_GraphicViewportRenderer;
 
+struct LC_ScreenPath;
 struct LC_SplinePointsData;
 
 /**
@@ -86,6 +89,7 @@ public:
     double toGuiDX(double d) const;
     double toGuiDY(double d) const;
     QTransform getToGuiTransform() const;
+    LC_ScreenTransform getScreenTransform() const;
 
     bool isPrinting() const
     {
@@ -139,7 +143,7 @@ public:
     void drawLineWCSScaled(const RS_Vector& wcsP1, const RS_Vector& wcsP2, double lineWidthFactor);
     void drawPolylineWCS(const RS_Polyline *polyline);
     void drawHandleWCS(const RS_Vector &wcsPosition, const RS_Color &c, int size = -1);
-    void drawImgWCS(QImage &img, const RS_Vector &wcsInsertionPoint, const RS_Vector &uVector, const RS_Vector &vVector);
+    void drawImgWCS(LC_CachedImage &img, const RS_Vector &wcsInsertionPoint, const RS_Vector &uVector, const RS_Vector &vVector);
 
     // drawing in screen coordinates
     void drawCircleUI(const RS_Vector& uiCenter, double uiRadius);
@@ -156,6 +160,7 @@ public:
     // methods invoked from entity containers and printing
     void drawEntity(RS_Entity* entity);
     void drawAsChild(RS_Entity* entity);
+    bool drawContainerReducedDetail(const RS_Entity* container);
     void drawInfiniteWCS(RS_Vector start, RS_Vector end);
 
     /**
@@ -228,6 +233,7 @@ public:
     void updatePointsScreenSize(double pdSize);
 
     bool isTextLineNotRenderable(double d) const;
+    bool isHatchPatternNotRenderable(double wcsPatternSpacing) const;
 
     void setRenderArcsInterpolate(bool value){ arcRenderInterpolate = value;}
     void setRenderArcsInterpolationAngleFixed(bool value){arcRenderInterpolationAngleFixed = value;}
@@ -478,6 +484,8 @@ private:
     // helper method: approximate a centered ellipse with lc_splinepoints
     void drawEllipseSegmentBySplinePointsUI(const RS_Vector& uiRadii, double startRad, double lenRad, QPainterPath &path, bool closed);
     void addSplinePointsToPath(const std::vector<RS_Vector> &uiControlPoints, bool closed, QPainterPath &path) const;
+    bool drawScreenPath(const LC_ScreenPath& screenPath, const LC_ScreenTransform& screenTransform);
+    QPainterPath createPolylineLinesPath(const RS_Polyline& polyline, const LC_ScreenTransform& screenTransform) const;
 };
 
 #endif
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <QImage>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_graphicviewport.h"
+#include "lc_screentransform.h"
+#include "rs_painter.h"
+
+namespace {
+// rotated UCS, zoomed view with flipped y axis
+const LC_ScreenTransform g_transforms[] = {
+    {},
+    {2.5, 0., 0., -2.5, 120., 480.},
+    {std::cos(0.3) * 3., -std::sin(0.3) * 3., -std::sin(0.3) * 3., -std::cos(0.3) * 3., -17.25, 1024.5},
+    {1e-6, 2e-7, -3e-7, -1e-6, 1e5, -1e5}
+};
+
+std::vector<double> makePoints(std::size_t count) {
+    std::vector<double> xy;
+    for (std::size_t i = 0; i < count; ++i) {
+        xy.push_back(std::sin(i * 0.7) * 1e3 + i);
+        xy.push_back(std::cos(i * 1.3) * 1e-2 - 1e4 * (i % 3));
+    }
+    return xy;
+}
+
+// the batch conversion, vectorized with SSE2 if available, against the scalar conversion of single points
+void compareWithScalar(const LC_ScreenTransform& transform, const double* wcsXY, const double* uiXY,
+                       std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        double x = 0.;
+        double y = 0.;
+        transform.map(wcsXY[2 * i], wcsXY[2 * i + 1], x, y);
+        REQUIRE(std::abs(uiXY[2 * i] - x) <= 1e-12 * (1. + std::abs(x)));
+        REQUIRE(std::abs(uiXY[2 * i + 1] - y) <= 1e-12 * (1. + std::abs(y)));
+    }
+}
+
+// viewport with UCS set directly, without zooming to the content of a drawing
+class UCSViewport: public LC_GraphicViewport {
+public:
+    void setTestUCS(const RS_Vector& origin, double angle) {
+        LC_CoordinatesMapper::update(origin, angle);
+        useUCS(true);
+    }
+};
+
+// screen transform of the painter against conversion of single points by the painter
+void compareWithPainter(const RS_Painter& painter, const std::vector<double>& wcsXY) {
+    const std::size_t count = wcsXY.size() / 2;
+    std::vector<double> uiXY(wcsXY.size());
+    painter.getScreenTransform().map(wcsXY.data(), uiXY.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const RS_Vector ui = painter.toGui(RS_Vector{wcsXY[2 * i], wcsXY[2 * i + 1]});
+        REQUIRE(std::abs(uiXY[2 * i] - ui.x) <= 1e-9 * (1. + std::abs(ui.x)));
+        REQUIRE(std::abs(uiXY[2 * i + 1] - ui.y) <= 1e-9 * (1. + std::abs(ui.y)));
+    }
+}
+}
+
+TEST_CASE("LC_ScreenTransform batch conversion matches the scalar one") {
+    // even and odd counts, to cover the remainder of the vectorized loop
+    for (std::size_t count : {0, 1, 2, 3, 4, 7, 64, 129}) {
+        const std::vector<double> wcsXY = makePoints(count);
+        for (const LC_ScreenTransform& transform : g_transforms) {
+            std::vector<double> uiXY(2 * count + 1, -1.);
+            transform.map(wcsXY.data(), uiXY.data(), count);
+            compareWithScalar(transform, wcsXY.data(), uiXY.data(), count);
+            // nothing is written past the end
+            REQUIRE(uiXY.back() == -1.);
+        }
+    }
+}
+
+TEST_CASE("LC_ScreenTransform converts unaligned arrays and in place") {
+    const std::size_t count = 33;
+    const std::vector<double> wcsXY = makePoints(count);
+    for (const LC_ScreenTransform& transform : g_transforms) {
+        // shifted by one double, so the points are not aligned to 16 bytes
+        std::vector<double> shifted(2 * count + 1);
+        std::copy(wcsXY.begin(), wcsXY.end(), shifted.begin() + 1);
+        std::vector<double> uiXY(2 * count + 1);
+        transform.map(shifted.data() + 1, uiXY.data() + 1, count);
+        compareWithScalar(transform, wcsXY.data(), uiXY.data() + 1, count);
+
+        std::vector<double> inPlace = wcsXY;
+        transform.map(inPlace.data(), inPlace.data(), count);
+        compareWithScalar(transform, wcsXY.data(), inPlace.data(), count);
+    }
+}
+
+TEST_CASE("RS_Painter screen transform matches the conversion of single points") {
+    QImage image(640, 480, QImage::Format_ARGB32);
+    const std::vector<double> wcsXY = makePoints(50);
+
+    SECTION("without UCS") {
+        LC_GraphicViewport viewport;
+        viewport.setSize(image.width(), image.height());
+        viewport.justSetOffsetAndFactor(-35, 120, 0.75);
+        RS_Painter painter(&image);
+        painter.setViewPort(&viewport);
+        compareWithPainter(painter, wcsXY);
+    }
+
+    SECTION("rotated UCS") {
+        UCSViewport viewport;
+        viewport.setSize(image.width(), image.height());
+        viewport.justSetOffsetAndFactor(210, -64, 3.5);
+        viewport.setTestUCS({125.5, -40.25}, 0.6);
+        RS_Painter painter(&image);
+        painter.setViewPort(&viewport);
+        compareWithPainter(painter, wcsXY);
+    }
+}
+
+TEST_CASE("LC_ScreenTransform benchmark", "[!benchmark]") {
+    QImage image(640, 480, QImage::Format_ARGB32);
+    UCSViewport viewport;
+    viewport.setSize(image.width(), image.height());
+    viewport.justSetOffsetAndFactor(210, -64, 3.5);
+    viewport.setTestUCS({125.5, -40.25}, 0.6);
+    RS_Painter painter(&image);
+    painter.setViewPort(&viewport);
+    // vertices of a large polyline
+    const std::vector<double> wcsXY = makePoints(100000);
+    std::vector<double> uiXY(wcsXY.size());
+
+    BENCHMARK("per-point toGui") {
+        for (std::size_t i = 0; i < wcsXY.size(); i += 2) {
+            const RS_Vector ui = painter.toGui(RS_Vector{wcsXY[i], wcsXY[i + 1]});
+            uiXY[i] = ui.x;
+            uiXY[i + 1] = ui.y;
+        }
+        return uiXY.back();
+    };
+
+    BENCHMARK("batch transform") {
+        painter.getScreenTransform().map(wcsXY.data(), uiXY.data(), wcsXY.size() / 2);
+        return uiXY.back();
+    };
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include <QColor>
+#include <QImage>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_graphicviewport.h"
+#include "lc_graphicviewportrenderer.h"
+#include "rs_entitycontainer.h"
+#include "rs_line.h"
+#include "rs_painter.h"
+
+namespace {
+constexpr double MIN_CONTAINER_SIZE = 10.;
+
+// renderer of the widget, with fixed minimal container size instead of the settings
+class DetailRenderer: public LC_GraphicViewportRenderer {
+public:
+    DetailRenderer(LC_GraphicViewport* viewport, QPaintDevice* device, ContainerDetail smallContainerDetail)
+        : LC_GraphicViewportRenderer(viewport, device)
+        , m_smallContainerDetail{smallContainerDetail} {
+    }
+    void renderEntity([[maybe_unused]] RS_Painter* painter, [[maybe_unused]] RS_Entity* entity) override {
+    }
+    bool isTextLineNotRenderable([[maybe_unused]] double uiLineHeight) const override {
+        return false;
+    }
+    ContainerDetail getContainerDetail(double uiContainerSize) const override {
+        m_queriedSizes.push_back(uiContainerSize);
+        return containerDetailForSize(uiContainerSize, MIN_CONTAINER_SIZE, m_smallContainerDetail);
+    }
+    const std::vector<double>& getQueriedSizes() const {
+        return m_queriedSizes;
+    }
+protected:
+    void doRender() override {
+    }
+private:
+    ContainerDetail m_smallContainerDetail;
+    mutable std::vector<double> m_queriedSizes;
+};
+
+// viewport of 100x100 pixels, 2 pixels per drawing unit
+struct Canvas {
+    QImage image{100, 100, QImage::Format_ARGB32};
+    LC_GraphicViewport viewport;
+
+    Canvas() {
+        image.fill(Qt::white);
+        viewport.setSize(image.width(), image.height());
+        viewport.justSetOffsetAndFactor(10, 10, 2.);
+    }
+
+    bool isBlank() const {
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                if (image.pixel(x, y) != qRgb(255, 255, 255)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+bool drawReducedDetail(Canvas& canvas, DetailRenderer& renderer, const RS_EntityContainer& container) {
+    RS_Painter painter(&canvas.image);
+    painter.setViewPort(&canvas.viewport);
+    painter.setRenderer(&renderer);
+    return painter.drawContainerReducedDetail(&container);
+}
+}
+
+TEST_CASE("LC_GraphicViewportRenderer reduces the detail of containers below the minimal size") {
+    using Renderer = LC_GraphicViewportRenderer;
+    REQUIRE(Renderer::containerDetailForSize(3.9, 4., Renderer::ContainerDetailBoundingBox)
+            == Renderer::ContainerDetailBoundingBox);
+    REQUIRE(Renderer::containerDetailForSize(0., 4., Renderer::ContainerDetailNone) == Renderer::ContainerDetailNone);
+    REQUIRE(Renderer::containerDetailForSize(4., 4., Renderer::ContainerDetailBoundingBox)
+            == Renderer::ContainerDetailFull);
+    REQUIRE(Renderer::containerDetailForSize(100., 4., Renderer::ContainerDetailNone) == Renderer::ContainerDetailFull);
+    // zero minimal size disables the reduced detail
+    REQUIRE(Renderer::containerDetailForSize(0., 0., Renderer::ContainerDetailNone) == Renderer::ContainerDetailFull);
+    REQUIRE(Renderer::containerDetailForSize(std::nan(""), 4., Renderer::ContainerDetailNone)
+            == Renderer::ContainerDetailFull);
+}
+
+TEST_CASE("RS_Painter draws small containers with the detail of the renderer") {
+    RS_EntityContainer small(nullptr, true);
+    small.addEntity(new RS_Line(&small, {0., 0.}, {3., 1.}));
+    RS_EntityContainer large(nullptr, true);
+    large.addEntity(new RS_Line(&large, {0., 0.}, {20., 1.}));
+
+    SECTION("bounding box") {
+        Canvas canvas;
+        DetailRenderer renderer(&canvas.viewport, &canvas.image, LC_GraphicViewportRenderer::ContainerDetailBoundingBox);
+        REQUIRE(drawReducedDetail(canvas, renderer, small));
+        // the larger side on the screen decides
+        REQUIRE(renderer.getQueriedSizes().size() == 1);
+        REQUIRE(std::abs(renderer.getQueriedSizes().front() - 6.) < 1e-9);
+        REQUIRE(!canvas.isBlank());
+    }
+
+    SECTION("skipped") {
+        Canvas canvas;
+        DetailRenderer renderer(&canvas.viewport, &canvas.image, LC_GraphicViewportRenderer::ContainerDetailNone);
+        REQUIRE(drawReducedDetail(canvas, renderer, small));
+        REQUIRE(canvas.isBlank());
+    }
+
+    SECTION("large containers are drawn as usual") {
+        Canvas canvas;
+        DetailRenderer renderer(&canvas.viewport, &canvas.image, LC_GraphicViewportRenderer::ContainerDetailBoundingBox);
+        REQUIRE(!drawReducedDetail(canvas, renderer, large));
+        REQUIRE(std::abs(renderer.getQueriedSizes().front() - 40.) < 1e-9);
+        REQUIRE(canvas.isBlank());
+    }
+
+    SECTION("empty containers are drawn as usual") {
+        Canvas canvas;
+        DetailRenderer renderer(&canvas.viewport, &canvas.image, LC_GraphicViewportRenderer::ContainerDetailNone);
+        RS_EntityContainer empty(nullptr, true);
+        REQUIRE(!drawReducedDetail(canvas, renderer, empty));
+        // reset borders don't give a size
+        REQUIRE(renderer.getQueriedSizes().empty());
+        REQUIRE(canvas.isBlank());
+    }
+}
@@ -27,6 +27,7 @@
 #include "rs_math.h"
 #include "rs_grid.h"
 #include "lc_graphicviewport.h"
+#include "lc_highlight.h"
 #include "rs_settings.h"
 #include "lc_overlayentitiescontainer.h"
 #include "lc_linemath.h"
@@ -91,7 +92,7 @@ void LC_GraphicViewRenderer::loadSettings() {
 
 void LC_GraphicViewRenderer::renderEntity(RS_Painter *painter, RS_Entity *e) {
     // check for selected entity drawing
-    if (/*!e->isContainer() && */(e->getFlag(RS2::FlagSelected) != painter->shouldDrawSelected())) {
+    if (/*!e->isContainer() && */(e->getFlag(RS2::FlagSelected) != painter->shouldDrawSelected()) && !m_highlightOverride) {
         return;
     }
 #ifdef DEBUG_RENDERING
@@ -185,7 +186,7 @@ void LC_GraphicViewRenderer::renderEntity(RS_Painter *painter, RS_Entity *e) {
     }
 
     // draw reference points:
-    if (e->getFlag(RS2::FlagSelected)) {
+    if (e->getFlag(RS2::FlagSelected) && !m_highlightOverride) {
         if (!e->isParentSelected()) {
             drawEntityReferencePoints(painter, e);
         }
@@ -280,6 +281,11 @@ void LC_GraphicViewRenderer::drawEntitiesInOverlay(LC_OverlaysManager *overlaysM
     RS_EntityContainer* overlayContainer = overlaysManager->entitiesAt(overlayType);
     if (overlayContainer != nullptr) {
         foreach (auto e, overlayContainer->getEntityList()) {
+            auto highlight = dynamic_cast<LC_Highlight*>(e);
+            if (highlight != nullptr) {
+                drawHighlight(painter, highlight);
+                continue;
+            }
             setPenForOverlayEntity(painter, e);
             bool selected = e->isSelected();
             // within overlays, we use temporary entities (or clones), os it's safe to modify selection state
@@ -292,6 +298,32 @@ void LC_GraphicViewRenderer::drawEntitiesInOverlay(LC_OverlaysManager *overlaysM
     }
 }
 
+/**
+ * Draws entities referenced by the highlight. They are document entities (or clones of nested ones), so they
+ * are drawn as they are with highlight pen override and their flags (like selection) are not touched.
+ */
+void LC_GraphicViewRenderer::drawHighlight(RS_Painter *painter, LC_Highlight *highlight) {
+    // referenced entities may be deleted by undo or redo after they were highlighted
+    if (!highlight->validate()) {
+        return;
+    }
+    m_highlightOverride = true;
+    for (RS_Entity* e: *highlight) {
+        // entity might be removed by undo after it was highlighted
+        if (e->isUndone() || !e->isVisible()) {
+            continue;
+        }
+        setPenForOverlayEntity(painter, e);
+        e->draw(painter);
+    }
+    m_highlightOverride = false;
+    for (RS_Entity* e: *highlight) {
+        if (highlight->isDrawRefPoints(e) && !e->isUndone() && e->isVisible()) {
+            drawEntityReferencePoints(painter, e);
+        }
+    }
+}
+
 void LC_GraphicViewRenderer::drawOverlayEntitiesInOverlay(LC_OverlaysManager *overlaysManager, RS_Painter *painter, RS2::OverlayGraphics overlayType){
     LC_OverlayDrawablesContainer* overlayContainer = overlaysManager->drawablesAt(overlayType);
     if (overlayContainer != nullptr) {
@@ -387,7 +419,7 @@ void LC_GraphicViewRenderer::setPenForEntity(RS_Painter *painter, RS_Entity *e,
     getPenTime += getPenTimer.nsecsElapsed();
 #endif
     RS_Pen originalPen = pen;
-    bool highlighted = e->getFlag(RS2::FlagHighlighted);
+    bool highlighted = m_highlightOverride || e->getFlag(RS2::FlagHighlighted);
     bool selected = e->getFlag(RS2::FlagSelected);
     bool overlayPaint = inOverlay || m_inOverlayDrawing;
     // try to avoid pen setup if the pen and entity flags are the same as for previous entity. This is important for performance reasons, so we'll reuse
@@ -497,7 +529,7 @@ void LC_GraphicViewRenderer::setPenForDraftEntity(RS_Painter *painter, RS_Entity
 #endif
     RS_Pen pen = e->getPenResolved();
     RS_Pen originalPen = pen;
-    bool highlighted = e->getFlag(RS2::FlagHighlighted);
+    bool highlighted = m_highlightOverride || e->getFlag(RS2::FlagHighlighted);
     bool selected = e->getFlag(RS2::FlagSelected);
     bool overlayPaint = inOverlay || m_inOverlayDrawing;
 // try to avoid pen setup if the pen and entity flags are the same as for previous entity. This is important for performance reasons, so we'll reuse
@@ -29,6 +29,7 @@
 #include "lc_widgetviewportrenderer.h"
 
 class RS_EntityContainer;
+class LC_Highlight;
 class LC_OverlaysManager;
 
 class LC_GraphicViewRenderer:public LC_WidgetViewPortRenderer
@@ -47,6 +48,14 @@ public:
     {
         return uiLineHeight <getMinRenderableTextHeightInPx();
     }
+    ContainerDetail getContainerDetail(double uiContainerSize) const override
+    {
+        return containerDetailForSize(uiContainerSize, getMinContainerSizeInPx(), getSmallContainerDetail());
+    }
+    bool isHatchPatternNotRenderable(double uiPatternSpacing) const override
+    {
+        return uiPatternSpacing < getMinHatchPatternSpacingInPx();
+    }
 
     LC_AnglesBaseMarkOptions* anglesBaseOptions() {return &m_anglesBaseOptions;}
     LC_OverlayUCSZeroOptions* absZeroOptions() {return &m_absZeroOptions;}
@@ -54,6 +63,8 @@ public:
     LC_UCSMarkOptions*  ucsMarkOptions() {return &m_ucsMarkOptions;}
 protected:
     bool m_inOverlayDrawing = false;
+    // original entities referenced by highlight are drawn with highlight pen regardless of their own flags
+    bool m_highlightOverride = false;
     bool m_isHiDpi = false;
 
     bool m_drawGrid = true;
@@ -113,6 +124,7 @@ protected:
     void drawDraftSign(RS_Painter *painter);
     void drawCoordinateSystems(RS_Painter *painter);
     void drawEntitiesInOverlay(LC_OverlaysManager *overlaysManager, RS_Painter *painter, RS2::OverlayGraphics overlayType);
+    void drawHighlight(RS_Painter *painter, LC_Highlight *highlight);
     void drawOverlayEntitiesInOverlay(LC_OverlaysManager *overlaysManager, RS_Painter *painter, RS2::OverlayGraphics overlayType);
     void drawEntityReferencePoints(RS_Painter *painter, const RS_Entity *e) const;
     void setPenForEntity(RS_Painter *painter, RS_Entity *e, bool inOverlay);
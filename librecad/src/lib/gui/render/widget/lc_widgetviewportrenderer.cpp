@@ -22,8 +22,10 @@
 #include "lc_widgetviewportrenderer.h"
 
 #include <QPixmap>
+#include <QTransform>
 
 #include "lc_graphicviewport.h"
+#include "lc_trace.h"
 #include "rs_entitycontainer.h"
 #include "rs_math.h"
 #include "rs_painter.h"
@@ -52,6 +54,17 @@ void LC_WidgetViewPortRenderer::loadSettings() {
     LC_GROUP("Render");
     {
         m_render_minRenderableTextHeightInPx = LC_GET_INT("MinRenderableTextHeightPx", 4);
+
+        int smallContainerDetail = LC_GET_INT("SmallContainerDetail", DEFAULT_SMALL_CONTAINER_DETAIL);
+        if (smallContainerDetail < ContainerDetailFull || smallContainerDetail > ContainerDetailNone) {
+            smallContainerDetail = DEFAULT_SMALL_CONTAINER_DETAIL;
+        }
+        m_render_smallContainerDetail = static_cast<ContainerDetail>(smallContainerDetail);
+        m_render_minContainerSizeInPx = LC_GET_INT("MinContainerSizePx", DEFAULT_MIN_CONTAINER_SIZE_PX);
+
+        int minHatchPatternSpacing100 = LC_GET_INT("MinHatchPatternSpacing", 200);
+        m_render_minHatchPatternSpacingInPx = minHatchPatternSpacing100 / 100.0;
+
         int minArcRadius100 = LC_GET_INT("MinArcRadius", 80);
         m_render_minArcDrawingRadius = minArcRadius100 / 100.0;
 
@@ -78,11 +91,14 @@ void LC_WidgetViewPortRenderer::loadSettings() {
         m_render_arcsInterpolateMaxSagitta = sagittaMax / 100.0;
 
         m_render_circlesSameAsArcs = LC_GET_BOOL("CircleRenderAsArcs", false);
+
+        m_render_progressiveZoomPan = LC_GET_BOOL("ProgressiveZoomPan", true);
     } // Render group
     LC_GROUP_END();
 }
 
 void LC_WidgetViewPortRenderer::doRender() {
+    LC_TRACE_SCOPE("render", "frame");
 
 #ifdef DEBUG_RENDERING
     QElapsedTimer timer;
@@ -122,6 +138,66 @@ void LC_WidgetViewPortRenderer::doRender() {
     redrawMethod=RS2::RedrawNone;
 }
 
+/**
+ * Invalidates the view after zoom or pan without re-rendering the drawing layer.
+ * Until the drawing layer is rendered again, the last completed frame is shown
+ * scaled and translated to the current viewport, while the grid and overlays are
+ * rendered as usual. So the cost of zoom and pan does not depend on the size of the drawing.
+ *
+ * @return false if the previous frame can't be reused (progressive mode is disabled,
+ * there is no completed frame, or the drawing layer is already invalidated),
+ * and the caller should request full redraw.
+ */
+bool LC_WidgetViewPortRenderer::invalidateProgressive() {
+    if (!m_render_progressiveZoomPan || !m_frameTransform.valid || (redrawMethod & RS2::RedrawDrawing)) {
+        return false;
+    }
+    // the sequential renderer paints entities over the background, so the frame can't be transformed separately
+    if (antialiasing && !classicRenderer) {
+        return false;
+    }
+    m_progressiveFrameShown = true;
+    invalidate(static_cast<RS2::RedrawMethod>(RS2::RedrawGrid | RS2::RedrawOverlay));
+    return true;
+}
+
+void LC_WidgetViewPortRenderer::storeFrameTransform() {
+    m_frameTransform = frameTransformOf(viewport);
+    m_progressiveFrameShown = false;
+}
+
+LC_WidgetViewPortRenderer::FrameTransform LC_WidgetViewPortRenderer::frameTransformOf(const LC_GraphicViewport* viewport) {
+    FrameTransform frame;
+    RS_Vector factor = viewport->getFactor();
+    frame.factorX = factor.x;
+    frame.factorY = factor.y;
+    frame.offsetX = viewport->getOffsetX();
+    frame.offsetY = viewport->getOffsetY();
+    frame.height = viewport->getHeight();
+    frame.valid = true;
+    return frame;
+}
+
+QTransform LC_WidgetViewPortRenderer::getProgressiveFrameTransform() const {
+    return getProgressiveFrameTransform(m_frameTransform, viewport);
+}
+
+/**
+ * Transformation from the screen coordinates of the frame to the screen coordinates of the
+ * viewport. As guiX = ucsX * factorX + offsetX and guiY = height - offsetY - ucsY * factorY,
+ * it is just scaling and translation.
+ */
+QTransform LC_WidgetViewPortRenderer::getProgressiveFrameTransform(const FrameTransform& frame,
+                                                                   const LC_GraphicViewport* viewport) {
+    RS_Vector factor = viewport->getFactor();
+    double scaleX = factor.x / frame.factorX;
+    double scaleY = factor.y / frame.factorY;
+    double dx = viewport->getOffsetX() - frame.offsetX * scaleX;
+    double frameBaseY = frame.height - frame.offsetY;
+    double dy = viewport->getHeight() - viewport->getOffsetY() - frameBaseY * scaleY;
+    return QTransform(scaleX, 0.0, 0.0, scaleY, dx, dy);
+}
+
 void LC_WidgetViewPortRenderer::paintSequental(QPaintDevice* pd) {
     int width = viewport->getWidth();
     int height = viewport->getHeight();
@@ -150,6 +226,7 @@ void LC_WidgetViewPortRenderer::paintSequental(QPaintDevice* pd) {
         drawLayerEntities(&painterLayerDrawing);
         drawLayerEntitiesOver(&painterLayerDrawing);
         painterLayerDrawing.end();
+        storeFrameTransform();
         redrawMethod=(RS2::RedrawMethod ) (redrawMethod | RS2::RedrawOverlay);
     }
 
@@ -194,6 +271,7 @@ void LC_WidgetViewPortRenderer::paintClassicalBuffered(QPaintDevice* pd) {
         setupPainter(&painterLayerDrawing);
         drawLayerEntities(&painterLayerDrawing);
         drawLayerEntitiesOver(&painterLayerDrawing);
+        storeFrameTransform();
     }
 
     if (redrawMethod & RS2::RedrawOverlay) {
@@ -206,7 +284,15 @@ void LC_WidgetViewPortRenderer::paintClassicalBuffered(QPaintDevice* pd) {
     // Finally paint the layers back on the screen, bitblk to the rescue!
     RS_Painter wPainter(pd);
     wPainter.drawPixmap(0, 0, *m_pixmapLayer1);
-    wPainter.drawPixmap(0, 0, *m_pixmapLayer2);
+    if (m_progressiveFrameShown) {
+        wPainter.save();
+        wPainter.setTransform(getProgressiveFrameTransform());
+        wPainter.drawPixmap(0, 0, *m_pixmapLayer2);
+        wPainter.restore();
+    }
+    else {
+        wPainter.drawPixmap(0, 0, *m_pixmapLayer2);
+    }
     wPainter.drawPixmap(0, 0, *m_pixmapLayer3);
 }
 
@@ -237,7 +323,10 @@ void LC_WidgetViewPortRenderer::drawLayerBackground(RS_Painter *painter) {
 #ifdef DEBUG_RENDERING_DETAILS
     drawLayerBackgroundTimer.start();
 #endif
-    doDrawLayerBackground(painter);
+    {
+        LC_TRACE_SCOPE("render", "background layer");
+        doDrawLayerBackground(painter);
+    }
 #ifdef DEBUG_RENDERING_DETAILS
     drawLayerBackgroundTime += drawLayerBackgroundTimer.elapsed();
 #endif
@@ -251,6 +340,7 @@ void LC_WidgetViewPortRenderer::drawLayerEntities(RS_Painter* painter) {
     drawLayerEntitiesTimer.start();
 #endif
 
+    LC_TRACE_SCOPE("render", "entities layer");
     RS_EntityContainer *container = viewport->getContainer();
     painter->setDrawSelectedOnly(false);
     doSetupBeforeContainerDraw();
@@ -275,7 +365,10 @@ void LC_WidgetViewPortRenderer::drawLayerOverlays(RS_Painter *painter) {
 #ifdef DEBUG_RENDERING_DETAILS
     drawLayerOverlaysTimer.start();
 #endif
-    doDrawLayerOverlays(painter);
+    {
+        LC_TRACE_SCOPE("render", "overlays layer");
+        doDrawLayerOverlays(painter);
+    }
 #ifdef DEBUG_RENDERING_DETAILS
     drawLayerOverlaysTime +=  drawLayerOverlaysTimer.elapsed();
 #endif
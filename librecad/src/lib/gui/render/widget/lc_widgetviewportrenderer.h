@@ -26,6 +26,7 @@
 #include "lc_graphicviewportrenderer.h"
 
 class QPixmap;
+class QTransform;
 
 class LC_WidgetViewPortRenderer:public LC_GraphicViewportRenderer
 {
@@ -36,12 +37,28 @@ public:
     void setupPainter(RS_Painter* painter) override;
     void setAntialiasing(bool state) {antialiasing = state;}
     void invalidate(RS2::RedrawMethod method) {redrawMethod = static_cast<RS2::RedrawMethod>(redrawMethod | method);}
+    bool invalidateProgressive();
+    bool isProgressiveFrameShown() const {return m_progressiveFrameShown;}
+
+    // viewport state the drawing layer was last fully rendered for, used to show it transformed on zoom and pan
+    struct FrameTransform {
+        double factorX = 1.0;
+        double factorY = 1.0;
+        int offsetX = 0;
+        int offsetY = 0;
+        int height = 0;
+        bool valid = false;
+    };
+    static FrameTransform frameTransformOf(const LC_GraphicViewport* viewport);
+    static QTransform getProgressiveFrameTransform(const FrameTransform& frame, const LC_GraphicViewport* viewport);
 protected:
     void doRender() override;
 
     virtual void doSetupBeforeContainerDraw();
     void paintClassicalBuffered(QPaintDevice* pd);
     void paintSequental(QPaintDevice* pd);
+    void storeFrameTransform();
+    QTransform getProgressiveFrameTransform() const;
 
     void drawLayerBackground(RS_Painter *painter);
     void drawLayerEntities(RS_Painter* painter);
@@ -53,6 +70,15 @@ protected:
     int getMinRenderableTextHeightInPx() const {
         return m_render_minRenderableTextHeightInPx;
     }
+    ContainerDetail getSmallContainerDetail() const {
+        return m_render_smallContainerDetail;
+    }
+    int getMinContainerSizeInPx() const {
+        return m_render_minContainerSizeInPx;
+    }
+    double getMinHatchPatternSpacingInPx() const {
+        return m_render_minHatchPatternSpacingInPx;
+    }
 
 #ifdef DEBUG_RENDERING
     QElapsedTimer drawLayerBackgroundTimer;
@@ -74,6 +100,9 @@ private:
     RS2::RedrawMethod redrawMethod = RS2::RedrawAll;
 
     int m_render_minRenderableTextHeightInPx = 4;
+    ContainerDetail m_render_smallContainerDetail = DEFAULT_SMALL_CONTAINER_DETAIL;
+    int m_render_minContainerSizeInPx = DEFAULT_MIN_CONTAINER_SIZE_PX;
+    double m_render_minHatchPatternSpacingInPx = 2.0;
     double m_render_minCircleDrawingRadius = 2.0;
     double m_render_minArcDrawingRadius = 0.5;
     double m_render_minEllipseMajorRadius = 2.;
@@ -85,6 +114,10 @@ private:
     double m_render_arcsInterpolateAngleValue = M_PI / 36;
     double m_render_arcsInterpolateMaxSagitta = 0.9;
     bool m_render_circlesSameAsArcs = false;
+    bool m_render_progressiveZoomPan = true;
+
+    FrameTransform m_frameTransform;
+    bool m_progressiveFrameShown = false;
 
     // Used for buffering different paint layers
     std::unique_ptr<QPixmap> m_pixmapLayer1;  // Used for grids and absolute 0
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <cmath>
+
+#include <QPointF>
+#include <QTransform>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_graphicviewport.h"
+#include "lc_widgetviewportrenderer.h"
+
+namespace {
+// the previous frame transformed for the current viewport has to show every point where the current viewport puts it
+void compareFrames(const LC_GraphicViewport& frameViewport, const LC_GraphicViewport& viewport) {
+    using Renderer = LC_WidgetViewPortRenderer;
+    const Renderer::FrameTransform frame = Renderer::frameTransformOf(&frameViewport);
+    REQUIRE(frame.valid);
+    const QTransform transform = Renderer::getProgressiveFrameTransform(frame, &viewport);
+    for (int i = 0; i < 20; ++i) {
+        const double x = std::sin(i * 0.7) * 500. + i * 13.;
+        const double y = std::cos(i * 1.3) * 300. - i * 7.;
+        const QPointF mapped = transform.map(QPointF(frameViewport.toGuiX(x), frameViewport.toGuiY(y)));
+        REQUIRE(std::abs(mapped.x() - viewport.toGuiX(x)) < 1e-6);
+        REQUIRE(std::abs(mapped.y() - viewport.toGuiY(y)) < 1e-6);
+    }
+}
+}
+
+TEST_CASE("LC_WidgetViewPortRenderer transforms the previous frame for the current viewport") {
+    LC_GraphicViewport frameViewport;
+    frameViewport.setSize(640, 480);
+    frameViewport.justSetOffsetAndFactor(-35, 120, 0.75);
+
+    LC_GraphicViewport viewport;
+
+    SECTION("unchanged") {
+        viewport.setSize(640, 480);
+        viewport.justSetOffsetAndFactor(-35, 120, 0.75);
+        compareFrames(frameViewport, viewport);
+        const QTransform transform = LC_WidgetViewPortRenderer::getProgressiveFrameTransform(
+            LC_WidgetViewPortRenderer::frameTransformOf(&frameViewport), &viewport);
+        REQUIRE(transform.isIdentity());
+    }
+
+    SECTION("pan") {
+        viewport.setSize(640, 480);
+        viewport.justSetOffsetAndFactor(48, -211, 0.75);
+        compareFrames(frameViewport, viewport);
+    }
+
+    SECTION("zoom in") {
+        viewport.setSize(640, 480);
+        viewport.justSetOffsetAndFactor(-190, 37, 2.5);
+        compareFrames(frameViewport, viewport);
+    }
+
+    SECTION("zoom out") {
+        viewport.setSize(640, 480);
+        viewport.justSetOffsetAndFactor(260, 301, 0.125);
+        compareFrames(frameViewport, viewport);
+    }
+
+    SECTION("resize") {
+        viewport.setSize(800, 333);
+        viewport.justSetOffsetAndFactor(-35, 120, 0.75);
+        compareFrames(frameViewport, viewport);
+    }
+
+    SECTION("resize and zoom") {
+        viewport.setSize(1024, 768);
+        viewport.justSetOffsetAndFactor(12, -64, 1.6);
+        compareFrames(frameViewport, viewport);
+    }
+}
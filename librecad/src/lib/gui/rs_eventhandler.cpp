@@ -511,9 +511,9 @@ void RS_EventHandler::debugActions() const{
         if (i == m_currentActions.size() - 1 ) {
             RS_DEBUG->print("Current");
         }
-        RS_DEBUG->print("Action %03d: %s [%s]",
-                        i, m_currentActions.at(i)->getName().toLatin1().data(),
-                        m_currentActions.at(i)->isFinished() ? "finished" : "active");
+        LC_DEBUG_PRINT("Action %03d: %s [%s]",
+                       i, m_currentActions.at(i)->getName().toLatin1().data(),
+                       m_currentActions.at(i)->isFinished() ? "finished" : "active");
     }
 }
 
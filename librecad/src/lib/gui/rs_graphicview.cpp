@@ -237,7 +237,7 @@ void RS_GraphicView::onViewportChanged() {
     adjustZoomControls();
     QString info = m_viewport->getGrid()->getInfo();
     updateGridStatusWidget(info);
-    redraw();
+    redrawOnViewportChange();
 }
 
 void RS_GraphicView::onViewportRedrawNeeded() {
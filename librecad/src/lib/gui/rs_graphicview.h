@@ -91,6 +91,9 @@ public:
 /** This virtual method must be overwritten to redraw
   the widget. */
     virtual void redraw(RS2::RedrawMethod method = RS2::RedrawAll) = 0;
+/** Redraws the widget after zoom or pan. May be overwritten to show
+  the previous frame until the drawing is rendered again */
+    virtual void redrawOnViewportChange() {redraw();}
 /** This virtual method must be overwritten and is then
   called whenever the view changed */
     virtual void adjustOffsetControls() = 0;
@@ -320,8 +320,8 @@ QString RS_Math::derationalize(const QString& expr) {
 
     QRegularExpressionMatch match = unitreg.match(expr);
     if (match.hasMatch()){
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING,
-                        "RS_Math::derationalize: matches = '%s'", match.capturedTexts().join(", ").toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING,
+                             "RS_Math::derationalize: matches = '%s'", match.capturedTexts().join(", ").toLatin1().data());
         double total = 0.0;
         int sign = (match.captured("sign").isNull() || match.captured("sign") == "") ? 1 : -1;
 
@@ -27,7 +27,7 @@
 #include <cfloat>
 
 #include "rs_entitycontainer.h"
-#include "lc_containertraverser.h"
+#include "lc_intersectionsweep.h"
 #include "lc_linemath.h"
 #include "rs_arc.h"
 #include "rs_circle.h"
@@ -501,30 +501,10 @@ LC_Division::CircleSegmentData* LC_Division::findCircleSegmentEdges(RS_Circle *c
  * @return vector of intersection points
  */
 QVector<RS_Vector> LC_Division::collectAllIntersectionsWithEntity(RS_Entity *entity){
-    QVector<RS_Vector> result;
-    RS_VectorSolutions sol;
-    // iterate over all entities
-    for (auto* e: *m_container) {
-        // consider only visible entities
-        if (e != nullptr && e->isVisible()){
-            // select containers / groups:
-            if (e->isContainer()){
-                // additional handling for containers
-                auto *ec = static_cast<RS_EntityContainer*>(e);
-
-                for(RS_Entity* e2: lc::LC_ContainerTraverser{*ec, RS2::ResolveAll}.entities()) {
-                    sol = RS_Information::getIntersection(entity, e2, true);
-                    addPointsFromSolutionToList(sol, result);
-                }
-            } else {
-                // just find intersections between entities
-                sol = RS_Information::getIntersection(entity, e, true);
-                // and collect them
-                addPointsFromSolutionToList(sol, result);
-            }
-        }
-    }
-    return result;
+    // single entity - bounding box of each other entity is checked before exact intersection
+    LC_IntersectionSweep sweep;
+    sweep.addContainer(m_container);
+    return sweep.findWith(entity);
 }
 
 /**
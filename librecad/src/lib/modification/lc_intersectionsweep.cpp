@@ -0,0 +1,177 @@
+/*
+ * ********************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * ********************************************************************************
+ */
+
+#include "lc_intersectionsweep.h"
+
+#include <algorithm>
+
+#include "lc_containertraverser.h"
+#include "rs_entity.h"
+#include "rs_entitycontainer.h"
+#include "rs_information.h"
+#include "rs_math.h"
+
+/**
+ * Adds atomic entity to the set
+ * @param entity entity
+ */
+void LC_IntersectionSweep::addEntity(RS_Entity *entity){
+    if (entity == nullptr){
+        return;
+    }
+    if (isUnbounded(entity)){
+        m_unbounded.push_back(entity);
+    }
+    else{
+        m_items.push_back(toItem(entity));
+    }
+}
+
+/**
+ * Adds visible entities of the container, with sub-containers resolved to atomic entities
+ * @param container container
+ */
+void LC_IntersectionSweep::addContainer(RS_EntityContainer *container){
+    for (auto* e: *container) {
+        if (e != nullptr && e->isVisible()){
+            if (e->isContainer()){
+                auto *ec = static_cast<RS_EntityContainer*>(e);
+                for(RS_Entity* e2: lc::LC_ContainerTraverser{*ec, RS2::ResolveAll}.entities()) {
+                    addEntity(e2);
+                }
+            } else {
+                addEntity(e);
+            }
+        }
+    }
+}
+
+bool LC_IntersectionSweep::isUnbounded(RS_Entity *entity){
+    return entity->isConstruction() || entity->rtti() == RS2::EntityConstructionLine;
+}
+
+LC_IntersectionSweep::Item LC_IntersectionSweep::toItem(RS_Entity *entity){
+    // boxes are expanded by tolerance, so touching entities are still checked
+    const RS_Vector &min = entity->getMin();
+    const RS_Vector &max = entity->getMax();
+    return Item{entity, min.x - RS_TOLERANCE, min.y - RS_TOLERANCE, max.x + RS_TOLERANCE, max.y + RS_TOLERANCE};
+}
+
+/**
+ * Finds intersections between all pairs of added entities.
+ * @param targets entities of interest. If not empty, only pairs with at least one of targets are solved
+ * @return intersection points for each entity which has them
+ */
+LC_IntersectionSweep::EntityIntersections LC_IntersectionSweep::findAll(const QSet<RS_Entity *> &targets) const{
+    EntityIntersections result;
+    bool allTargets = targets.isEmpty();
+
+    auto solve = [&result, &targets, allTargets](RS_Entity* first, RS_Entity* second){
+        bool firstIsTarget = allTargets || targets.contains(first);
+        bool secondIsTarget = allTargets || targets.contains(second);
+        if (!firstIsTarget && !secondIsTarget){
+            return;
+        }
+        RS_VectorSolutions sol = RS_Information::getIntersection(first, second, true);
+        for (const RS_Vector &v: sol) {
+            if (v.valid){
+                if (firstIsTarget){
+                    result[first].append(v);
+                }
+                if (secondIsTarget){
+                    result[second].append(v);
+                }
+            }
+        }
+    };
+
+    std::vector<const Item*> order;
+    order.reserve(m_items.size());
+    for (const Item &item: m_items) {
+        order.push_back(&item);
+    }
+    std::sort(order.begin(), order.end(), [](const Item* a, const Item* b){
+        return a->minX < b->minX;
+    });
+
+    // items which x-range still covers the sweep position
+    std::vector<const Item*> active;
+    for (const Item* item: order) {
+        double sweepX = item->minX;
+        active.erase(std::remove_if(active.begin(), active.end(), [sweepX](const Item* a){
+            return a->maxX < sweepX;
+        }), active.end());
+        for (const Item* a: active) {
+            if (a->minY <= item->maxY && item->minY <= a->maxY){
+                solve(a->entity, item->entity);
+            }
+        }
+        active.push_back(item);
+    }
+
+    size_t unboundedCount = m_unbounded.size();
+    for (size_t i = 0; i < unboundedCount; i++) {
+        RS_Entity* unbounded = m_unbounded[i];
+        for (const Item &item: m_items) {
+            solve(unbounded, item.entity);
+        }
+        for (size_t j = i + 1; j < unboundedCount; j++) {
+            solve(unbounded, m_unbounded[j]);
+        }
+    }
+    return result;
+}
+
+/**
+ * Finds intersections of the given entity with all added entities.
+ * @param entity entity to check, may be one of added ones
+ * @return intersection points
+ */
+QVector<RS_Vector> LC_IntersectionSweep::findWith(RS_Entity *entity) const{
+    QVector<RS_Vector> result;
+    auto solve = [&result, entity](RS_Entity* other){
+        RS_VectorSolutions sol = RS_Information::getIntersection(entity, other, true);
+        for (const RS_Vector &v: sol) {
+            if (v.valid){
+                result.append(v);
+            }
+        }
+    };
+    if (isUnbounded(entity)){
+        for (const Item &item: m_items) {
+            solve(item.entity);
+        }
+    }
+    else{
+        Item box = toItem(entity);
+        for (const Item &item: m_items) {
+            if (item.minX <= box.maxX && box.minX <= item.maxX && item.minY <= box.maxY && box.minY <= item.maxY){
+                solve(item.entity);
+            }
+        }
+    }
+    for (RS_Entity* unbounded: m_unbounded) {
+        solve(unbounded);
+    }
+    return result;
+}
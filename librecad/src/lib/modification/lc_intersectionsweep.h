@@ -0,0 +1,71 @@
+/*
+ * ********************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * ********************************************************************************
+ */
+
+#ifndef LC_INTERSECTIONSWEEP_H
+#define LC_INTERSECTIONSWEEP_H
+
+#include <vector>
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+#include "rs_vector.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Batch search of intersections among a set of entities.
+ * Bounding boxes of entities are swept along x axis, so exact intersection is calculated only
+ * for pairs which boxes overlap, instead of solving each entity against each other one.
+ * Construction entities are infinite, so they are checked against all other entities.
+ */
+class LC_IntersectionSweep{
+public:
+    using EntityIntersections = QHash<RS_Entity*, QVector<RS_Vector>>;
+
+    LC_IntersectionSweep() = default;
+
+    void addEntity(RS_Entity* entity);
+    void addContainer(RS_EntityContainer* container);
+    size_t size() const {return m_items.size() + m_unbounded.size();}
+
+    EntityIntersections findAll(const QSet<RS_Entity*>& targets = {}) const;
+    QVector<RS_Vector> findWith(RS_Entity* entity) const;
+protected:
+    struct Item{
+        RS_Entity* entity = nullptr;
+        double minX = 0.;
+        double minY = 0.;
+        double maxX = 0.;
+        double maxY = 0.;
+    };
+    static bool isUnbounded(RS_Entity* entity);
+    static Item toItem(RS_Entity* entity);
+private:
+    std::vector<Item> m_items;
+    std::vector<RS_Entity*> m_unbounded;
+};
+
+#endif // LC_INTERSECTIONSWEEP_H
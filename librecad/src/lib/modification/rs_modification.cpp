@@ -26,6 +26,8 @@
 **********************************************************************/
 // File: rs_modification.cpp
 #include <QSet>
+#include <QThread>
+#include <QThreadPool>
 
 #include "lc_containertraverser.h"
 #include "lc_graphicviewport.h"
@@ -230,6 +232,48 @@ namespace {
         } while (bl->find(candidate) != nullptr);
         return candidate;
     }
+
+    /**
+     * Minimal amount of clones for which cloning and transformation are spread over worker threads.
+     * For smaller lists the cost of threads hand-off is higher than the gain.
+     */
+    constexpr size_t PARALLEL_CLONES_THRESHOLD = 2048;
+
+    /**
+     * Entities which clone and transformations touch only own geometry (no fonts, blocks, settings or
+     * document lookups), so they may be processed outside of the main thread.
+     */
+    bool isParallelTransformSafe(const RS_Entity* e) {
+        switch (e->rtti()) {
+            case RS2::EntityPoint:
+            case RS2::EntityLine:
+            case RS2::EntityArc:
+            case RS2::EntityCircle:
+            case RS2::EntityEllipse:
+            case RS2::EntityPolyline:
+            case RS2::EntitySpline:
+            case RS2::EntitySplinePoints:
+            case RS2::EntityParabola:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    RS_Entity* cloneForModification(const RS_Entity* e, bool forPreviewOnly, bool drawTextAsDraftInPreview) {
+        if (forPreviewOnly) {
+            switch (e->rtti()) {
+                case RS2::EntityText:
+                case RS2::EntityMText:
+                    return drawTextAsDraftInPreview ? e->cloneProxy() : e->clone();
+                case RS2::EntityImage:
+                    return e->cloneProxy();
+                default:
+                    break;
+            }
+        }
+        return e->clone();
+    }
 } // namespace
 
 
@@ -629,7 +673,7 @@ void RS_Modification::copyBlocks(RS_Entity* e) {
     // add block of an insert
     QString bn = b->getName();
     if (!RS_CLIPBOARD->hasBlock(bn)) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: add block name: %s", bn.toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: add block name: %s", bn.toLatin1().data());
         RS_CLIPBOARD->addBlock((RS_Block*)b->clone());
     }
     //find insert into insert
@@ -786,7 +830,7 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
         QString ln = l->getName();
         if (!m_graphic->findLayer(ln)) {
             m_graphic->addLayer(l->clone());
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: layer added: %s", ln.toLatin1().data());
+            LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: layer added: %s", ln.toLatin1().data());
         }
     }
 
@@ -823,7 +867,7 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: block and insert names don't coincide");
         return false;
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: processing container: %s", name_old.toLatin1().data());
+    LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: processing container: %s", name_old.toLatin1().data());
     // rename if needed
     if (m_graphic->findBlock(name_old)) {
         if (insertBlock->getParent() == m_graphic) {
@@ -832,7 +876,7 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
             return true;
         } else {
             name_new = m_graphic->getBlockList()->newName(name_old);
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: new block name: %s", name_new.toLatin1().data());
+            LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: new block name: %s", name_new.toLatin1().data());
         }
     }
     blocksDict[name_old] = name_new;
@@ -851,7 +895,7 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
         return false;
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", layer->getName().toLatin1().data());
+    LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", layer->getName().toLatin1().data());
     insertClone->setLayer(layer);
     insertClone->setPen(entity->getPen(false));
 
@@ -871,7 +915,7 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
         }
 
         if (e->rtti() == RS2::EntityInsert) {
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: process sub-insert for %s", ((RS_Insert*)e)->getName().toLatin1().data());
+            LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: process sub-insert for %s", ((RS_Insert*)e)->getName().toLatin1().data());
             if (!pasteContainer(e, blockClone, blocksDict, ip)) {
                 RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to paste entity to sub-insert");
                 return false;
@@ -915,7 +959,7 @@ bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* contain
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
         return false;
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", layer->getName().toLatin1().data());
+    LC_DEBUG_PRINT_LEVEL(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", layer->getName().toLatin1().data());
     e->setLayer(layer);
     e->setPen(entity->getPen(false));
 
@@ -962,7 +1006,7 @@ bool RS_Modification::splitPolyline(RS_Polyline& polyline,
         return false;
     }
 
-    RS_Entity* firstEntity = polyline.firstEntity();
+    RS_Entity* firstEntity = polyline.first();
     RS_Vector firstPoint(false);
     if (firstEntity->rtti()==RS2::EntityLine) {
         firstPoint = ((RS_Line*)firstEntity)->getStartpoint();
@@ -1070,7 +1114,7 @@ RS_Polyline* RS_Modification::addPolylineNode(RS_Polyline& polyline,
 
     // copy polyline and add new node:
     bool first = true;
-    RS_Entity* lastEntity = polyline.lastEntity();
+    RS_Entity* lastEntity = polyline.last();
     for(auto e: polyline){
         if (e->isAtomic()) {
             auto ae = (RS_AtomicEntity*)e;
@@ -1170,7 +1214,7 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
 
     // check if the polyline is no longer there after deleting the node:
     if (polyline.count() == 1){
-        RS_Entity *e = polyline.firstEntity();
+        RS_Entity *e = polyline.first();
         if (e && e->isAtomic()){
             auto ae = dynamic_cast<RS_AtomicEntity *>(e);
             if (node.distanceTo(ae->getStartpoint()) < 1.0e-6 ||
@@ -1197,7 +1241,7 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
     // copy polyline and drop deleted node:
     bool first = true;
     bool lastDropped = false;
-    RS_Entity* lastEntity = polyline.lastEntity();
+    RS_Entity* lastEntity = polyline.last();
     for (auto e: polyline) {
         if (e->isAtomic()){
             auto ae = dynamic_cast<RS_AtomicEntity *>(e);
@@ -1335,16 +1379,17 @@ RS_Polyline *RS_Modification::deletePolylineNodesBetween(
         bool found = false;
         double length1 = 0.0;
         double length2 = 0.0;
-        RS_Entity *e = polyline.firstEntity();
+        lc::LC_ContainerTraverser traverser{polyline, RS2::ResolveNone};
+        RS_Entity *e = traverser.first();
 
         if (startpointInvolved){
             if (e->isAtomic()){
                 auto *ae = dynamic_cast<RS_AtomicEntity *>(e);
                 length1 += ae->getLength();
             }
-            e = polyline.nextEntity();
+            e = traverser.next();
         }
-        for (; e; e = polyline.nextEntity()) {
+        for (; e; e = traverser.next()) {
 
             if (e->isAtomic()){
                 auto *ae = dynamic_cast<RS_AtomicEntity *>(e);
@@ -1385,7 +1430,7 @@ RS_Polyline *RS_Modification::deletePolylineNodesBetween(
     bool removing = deleteStart;
     bool done = false;
     bool nextIsStraight = false;
-    RS_Entity *lastEntity = polyline.lastEntity();
+    RS_Entity *lastEntity = polyline.last();
     int i = 0;
     double bulge = 0.0;
 
@@ -1561,7 +1606,7 @@ RS_Polyline *RS_Modification::polylineTrim(
         bool first = true;
         bool removing = false;
         bool nextIsStraight = false;
-        RS_Entity *lastEntity = polyline.lastEntity();
+        RS_Entity *lastEntity = polyline.last();
         for (auto e: polyline) {
 
             if (e->isAtomic()){
@@ -1635,7 +1680,7 @@ RS_Polyline *RS_Modification::polylineTrim(
         //bool first = true;
         bool removing = true;
         bool nextIsStraight = false;
-        RS_Entity *lastEntity = polyline.lastEntity();
+        RS_Entity *lastEntity = polyline.last();
         for (auto e: polyline) {
 
             if (e->isAtomic()){
@@ -1741,14 +1786,11 @@ bool RS_Modification::move(RS_MoveData& data, const std::vector<RS_Entity*> &ent
     int numberOfCopies = data.obtainNumberOfCopies();
     std::vector<RS_Entity*> clonesList;
 
-    for(auto e: entitiesList){
-        // Create new entities
-        for (int num = 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-            ec->move(data.offset*num);
-            clonesList.push_back(ec);
-        }
-    }
+    // Create new entities
+    cloneAndTransform(entitiesList, numberOfCopies, forPreviewOnly, clonesList, [&data](RS_Entity* ec, int num) {
+        ec->move(data.offset*num);
+        return true;
+    });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
@@ -1758,35 +1800,97 @@ bool RS_Modification::move(RS_MoveData& data, const std::vector<RS_Entity*> &ent
 }
 
 RS_Entity *RS_Modification::getClone(bool forPreviewOnly, const RS_Entity *e) const {
-    RS_Entity* result = nullptr;
-    if (forPreviewOnly){
-        int rtti = e->rtti();
-        switch (rtti){
-            case RS2::EntityText:
-            case RS2::EntityMText:{
-                // fixme - sand - ucs - BAD dependency, rework.
-                bool  drawTextAsDraftInPreview = LC_GET_ONE_BOOL("Render","DrawTextsAsDraftInPreview", true);
-                if (drawTextAsDraftInPreview) {
-                    result = e->cloneProxy();
-                }
-                else{
-                    result = e->clone();
-                }
-                break;
+    bool drawTextAsDraftInPreview = false;
+    if (forPreviewOnly && (e->rtti() == RS2::EntityText || e->rtti() == RS2::EntityMText)) {
+        // fixme - sand - ucs - BAD dependency, rework.
+        drawTextAsDraftInPreview = LC_GET_ONE_BOOL("Render","DrawTextsAsDraftInPreview", true);
+    }
+    return cloneForModification(e, forPreviewOnly, drawTextAsDraftInPreview);
+}
+
+void RS_Modification::cloneAndTransform(const std::vector<RS_Entity*> &entitiesList, int numberOfCopies, bool forPreviewOnly,
+                                        std::vector<RS_Entity*> &clonesList,
+                                        const std::function<bool(RS_Entity*, int)> &transform) const {
+    if (numberOfCopies < 1) {
+        return;
+    }
+    // fixme - sand - ucs - BAD dependency, rework.
+    // settings are read once there, as they are not accessible from worker threads
+    bool drawTextAsDraftInPreview = forPreviewOnly && LC_GET_ONE_BOOL("Render","DrawTextsAsDraftInPreview", true);
+
+    size_t copies = static_cast<size_t>(numberOfCopies);
+    size_t entitiesCount = entitiesList.size();
+
+    // each clone has own slot, so the order of clones does not depend on threads scheduling
+    std::vector<RS_Entity*> slots(entitiesCount * copies, nullptr);
+
+    auto processEntity = [&](size_t index) {
+        RS_Entity* e = entitiesList[index];
+        // clones of pure geometry get the parent once all of them are done, so workers don't touch the document
+        RS_Entity::DetachedCloneGuard detachedClones(isParallelTransformSafe(e));
+        for (size_t num = 1; num <= copies; num++) {
+            RS_Entity* ec = cloneForModification(e, forPreviewOnly, drawTextAsDraftInPreview);
+            if (transform(ec, static_cast<int>(num))) {
+                slots[index * copies + num - 1] = ec;
             }
-            case RS2::EntityImage:{
-                result = e->cloneProxy();
-                break;
+            else {
+                delete ec;
             }
-            default:
-                result = e->clone();
+        }
+    };
+
+    int threadsCount = QThread::idealThreadCount();
+    if (threadsCount < 2 || slots.size() < PARALLEL_CLONES_THRESHOLD) {
+        for (size_t i = 0; i < entitiesCount; i++) {
+            processEntity(i);
         }
     }
-    else{
-        result = e->clone();
+    else {
+        std::vector<size_t> parallelIndexes;
+        std::vector<size_t> serialIndexes;
+        parallelIndexes.reserve(entitiesCount);
+        for (size_t i = 0; i < entitiesCount; i++) {
+            if (isParallelTransformSafe(entitiesList[i])) {
+                parallelIndexes.push_back(i);
+            }
+            else {
+                serialIndexes.push_back(i);
+            }
+        }
+
+        // workers allocate clones of their own chunk, the document is not touched until all of them are done
+        size_t chunksCount = std::min(static_cast<size_t>(threadsCount), parallelIndexes.size());
+        if (chunksCount > 0) {
+            size_t chunkSize = (parallelIndexes.size() + chunksCount - 1) / chunksCount;
+            QThreadPool pool;
+            pool.setMaxThreadCount(static_cast<int>(chunksCount));
+            for (size_t from = 0; from < parallelIndexes.size(); from += chunkSize) {
+                size_t to = std::min(from + chunkSize, parallelIndexes.size());
+                pool.start([&parallelIndexes, &processEntity, from, to]() {
+                    for (size_t i = from; i < to; i++) {
+                        processEntity(parallelIndexes[i]);
+                    }
+                });
+            }
+            pool.waitForDone();
+        }
+
+        for (size_t i : serialIndexes) {
+            processEntity(i);
+        }
     }
 
-    return result;
+    clonesList.reserve(clonesList.size() + slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+        RS_Entity* ec = slots[i];
+        if (ec != nullptr) {
+            if (ec->getParent() == nullptr) {
+                // not the container reparent, which would move children of the clone to the parent
+                ec->RS_Entity::reparent(entitiesList[i / copies]->getParent());
+            }
+            clonesList.push_back(ec);
+        }
+    }
 }
 
 void RS_Modification::setupModifiedClones(
@@ -1826,23 +1930,17 @@ bool RS_Modification::alignRef(LC_AlignRefData & data, const std::vector<RS_Enti
 
     RS_Vector offset = data.offset;
 
-    // too slow:
-    for(auto e: entitiesList){
-        // Create new entities
-        for (int num = 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
-            ec->rotate(data.rotationCenter, data.rotationAngle);
-
-            if (data.scale && LC_LineMath::isMeaningful(data.scaleFactor - 1.0)){
-                ec->scale(data.rotationCenter, data.scaleFactor);
-            }
-
-            ec->move(offset*num);
+    // Create new entities
+    cloneAndTransform(entitiesList, numberOfCopies, forPreviewOnly, clonesList, [&data, &offset](RS_Entity* ec, int num) {
+        ec->rotate(data.rotationCenter, data.rotationAngle);
 
-            clonesList.push_back(ec);
+        if (data.scale && LC_LineMath::isMeaningful(data.scaleFactor - 1.0)){
+            ec->scale(data.rotationCenter, data.scaleFactor);
         }
-    }
+
+        ec->move(offset*num);
+        return true;
+    });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
@@ -1873,22 +1971,12 @@ bool RS_Modification::offset(const RS_OffsetData& data, const std::vector<RS_Ent
 
     int numberOfCopies = data.obtainNumberOfCopies();
 
-    // Create new entities
-    // too slow:
-    for(auto e: entitiesList){
-        for (int num=1; num<= numberOfCopies; num++) {
-            auto ec = e->clone();
-            //highlight is used by trim actions. do not carry over flag
-            ec->setHighlighted(false);
-
-            if (!ec->offset(data.coord, num*data.distance)) {
-                delete ec;
-                continue;
-            }
-
-            clonesList.push_back(ec);
-        }
-    }
+    // Create new entities. Offset always works on full clones, so clones are not requested for preview
+    cloneAndTransform(entitiesList, numberOfCopies, false, clonesList, [&data](RS_Entity* ec, int num) {
+        //highlight is used by trim actions. do not carry over flag
+        ec->setHighlighted(false);
+        return ec->offset(data.coord, num*data.distance);
+    });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
@@ -1917,33 +2005,28 @@ bool RS_Modification::rotate(RS_RotateData& data, const std::vector<RS_Entity*>
     // Create new entities
 
     int numberOfCopies = data.obtainNumberOfCopies();
-    for (auto e: entitiesList) {
-        for (int num = 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
-            double rotationAngle = data.angle * num;
-            ec->rotate(data.center, rotationAngle);
+    cloneAndTransform(entitiesList, numberOfCopies, forPreviewOnly, clonesList, [&data](RS_Entity* ec, int num) {
+        double rotationAngle = data.angle * num;
+        ec->rotate(data.center, rotationAngle);
 
-            bool rotateTwice = data.twoRotations;
-            double distance = data.refPoint.distanceTo(data.center);
-            if (distance < RS_TOLERANCE){
-                rotateTwice = false;
-            }
+        bool rotateTwice = data.twoRotations;
+        double distance = data.refPoint.distanceTo(data.center);
+        if (distance < RS_TOLERANCE){
+            rotateTwice = false;
+        }
 
-            if (rotateTwice) {
-                RS_Vector rotatedRefPoint = data.refPoint;
-                rotatedRefPoint.rotate(data.center, rotationAngle);
+        if (rotateTwice) {
+            RS_Vector rotatedRefPoint = data.refPoint;
+            rotatedRefPoint.rotate(data.center, rotationAngle);
 
-                double secondRotationAngle = data.secondAngle;
-                if (data.secondAngleIsAbsolute){
-                    secondRotationAngle -= rotationAngle;
-                }
-                ec->rotate(rotatedRefPoint, secondRotationAngle);
+            double secondRotationAngle = data.secondAngle;
+            if (data.secondAngleIsAbsolute){
+                secondRotationAngle -= rotationAngle;
             }
-
-            clonesList.push_back(ec);
+            ec->rotate(rotatedRefPoint, secondRotationAngle);
         }
-    }
+        return true;
+    });
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
     deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
@@ -2005,15 +2088,10 @@ bool RS_Modification::scale(RS_ScaleData& data, const std::vector<RS_Entity*> &e
     int numberOfCopies = data.obtainNumberOfCopies();
 
     // Create new entities
-    for(RS_Entity* e: selectedList) {
-        if (e != nullptr) {
-            for (int num= 1; num <= numberOfCopies; num++) {
-                RS_Entity* ec = getClone(forPreviewOnly, e);
-                ec->scale(data.referencePoint, RS_Math::pow(data.factor, num));
-                clonesList.push_back(ec);
-            }
-        }
-    }
+    cloneAndTransform(selectedList, numberOfCopies, forPreviewOnly, clonesList, [&data](RS_Entity* ec, int num) {
+        ec->scale(data.referencePoint, RS_Math::pow(data.factor, num));
+        return true;
+    });
     selectedList.clear();
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
     deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
@@ -2045,13 +2123,10 @@ bool RS_Modification::mirror(RS_MirrorData& data, const std::vector<RS_Entity*>
 
     // Create new entities
 
-    for(auto e: entitiesList){
-        for (int num=1; num<=numberOfCopies; ++num) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-            ec->mirror(data.axisPoint1, data.axisPoint2);
-            clonesList.push_back(ec);
-        }
-    }
+    cloneAndTransform(entitiesList, numberOfCopies, forPreviewOnly, clonesList, [&data](RS_Entity* ec, [[maybe_unused]] int num) {
+        ec->mirror(data.axisPoint1, data.axisPoint2);
+        return true;
+    });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
@@ -2081,23 +2156,18 @@ bool RS_Modification::rotate2(RS_Rotate2Data& data, const std::vector<RS_Entity*
 
     // Create new entities
 
-    for(auto e: entitiesList){
-        for (int num= 1; num <= numberOfCopies; num++) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
-            double angle1ForCopy = /*data.sameAngle1ForCopies ?  data.angle1 :*/ data.angle1 * num;
-            double angle2ForCopy = data.sameAngle2ForCopies ?  data.angle2 : data.angle2 * num;
-
-            ec->rotate(data.center1, angle1ForCopy);
+    cloneAndTransform(entitiesList, numberOfCopies, forPreviewOnly, clonesList, [&data](RS_Entity* ec, int num) {
+        double angle1ForCopy = /*data.sameAngle1ForCopies ?  data.angle1 :*/ data.angle1 * num;
+        double angle2ForCopy = data.sameAngle2ForCopies ?  data.angle2 : data.angle2 * num;
 
-            RS_Vector center2 = data.center2;
-            center2.rotate(data.center1, angle1ForCopy);
+        ec->rotate(data.center1, angle1ForCopy);
 
-            ec->rotate(center2, angle2ForCopy);
+        RS_Vector center2 = data.center2;
+        center2.rotate(data.center1, angle1ForCopy);
 
-            clonesList.push_back(ec);
-        }
-    }
+        ec->rotate(center2, angle2ForCopy);
+        return true;
+    });
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
     deleteOriginalAndAddNewEntities(clonesList, entitiesList, forPreviewOnly, !data.keepOriginals);
@@ -2141,18 +2211,13 @@ bool RS_Modification::moveRotate(RS_MoveRotateData &data, const std::vector<RS_E
     int numberOfCopies = data.obtainNumberOfCopies();
 
     // Create new entities
-    for(auto e: entitiesList){
-        for (int num=1; num <= numberOfCopies; ++num) {
-            RS_Entity* ec = getClone(forPreviewOnly, e);
-
-            const RS_Vector &offset = data.offset * num;
-            ec->move(offset);
-            double angleForCopy = data.sameAngleForCopies ?  data.angle : data.angle * num;
-            ec->rotate(data.referencePoint + offset, angleForCopy);
-
-            clonesList.push_back(ec);
-        }
-    }
+    cloneAndTransform(entitiesList, numberOfCopies, forPreviewOnly, clonesList, [&data](RS_Entity* ec, int num) {
+        const RS_Vector &offset = data.offset * num;
+        ec->move(offset);
+        double angleForCopy = data.sameAngleForCopies ?  data.angle : data.angle * num;
+        ec->rotate(data.referencePoint + offset, angleForCopy);
+        return true;
+    });
 
     setupModifiedClones(clonesList, data, forPreviewOnly, keepSelected);
 
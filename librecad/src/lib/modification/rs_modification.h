@@ -26,6 +26,7 @@
 
 #ifndef RS_MODIFICATION_H
 #define RS_MODIFICATION_H
+#include <functional>
 #include <memory>
 #include <QString>
 
@@ -408,6 +409,15 @@ protected:
                              bool forPreviewOnly, bool keepSelected) const;
 
     RS_Entity* getClone(bool forPreviewOnly, const RS_Entity* e) const;
+
+    /**
+     * Clones each entity of the list numberOfCopies times and applies transform(clone, copyNumber) to the clone.
+     * Clones for which transform returns false are deleted. Entities with pure geometry are processed by worker
+     * threads for large lists, the order of resulting clones is the same as for sequential processing.
+     */
+    void cloneAndTransform(const std::vector<RS_Entity*>& entitiesList, int numberOfCopies, bool forPreviewOnly,
+                           std::vector<RS_Entity*>& clonesList,
+                           const std::function<bool(RS_Entity*, int)>& transform) const;
 };
 
 #endif
@@ -0,0 +1,161 @@
+/*
+ * ********************************************************************************
+ * This file is part of the LibreCAD project, a 2D CAD program
+ *
+ * Copyright (C) 2025 LibreCAD.org
+ * Copyright (C) 2025 sand1024
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * ********************************************************************************
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_division.h"
+#include "lc_intersectionsweep.h"
+#include "rs_circle.h"
+#include "rs_constructionline.h"
+#include "rs_entitycontainer.h"
+#include "rs_information.h"
+#include "rs_line.h"
+
+namespace {
+// grid of horizontal and vertical lines with a circle in each cell, like a hatched sheet.
+// Circles of every other cell cross the four lines of the cell.
+void fillSheet(RS_EntityContainer &container, int cells) {
+    double size = cells * 10.;
+    for (int i = 0; i <= cells; i++) {
+        double pos = i * 10.;
+        container.addEntity(new RS_Line(&container, {-1., pos}, {size + 1., pos}));
+        container.addEntity(new RS_Line(&container, {pos, -1.}, {pos, size + 1.}));
+    }
+    for (int x = 0; x < cells; x++) {
+        for (int y = 0; y < cells; y++) {
+            double radius = (x + y) % 2 == 0 ? 6. : 3.;
+            container.addEntity(new RS_Circle(&container, {{x * 10. + 5., y * 10. + 5.}, radius}));
+        }
+    }
+}
+
+// the loop used before the sweep - each entity is solved against each other one
+size_t countPairwise(RS_EntityContainer &container) {
+    size_t count = 0;
+    for (RS_Entity *e1: container) {
+        for (RS_Entity *e2: container) {
+            RS_VectorSolutions sol = RS_Information::getIntersection(e1, e2, true);
+            for (const RS_Vector &v: sol) {
+                if (v.valid) {
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+size_t countSweep(RS_EntityContainer &container) {
+    LC_IntersectionSweep sweep;
+    sweep.addContainer(&container);
+    size_t count = 0;
+    for (const QVector<RS_Vector> &points: sweep.findAll()) {
+        count += points.size();
+    }
+    return count;
+}
+}
+
+TEST_CASE("LC_IntersectionSweep finds the same intersections as pairwise check") {
+    RS_EntityContainer container(nullptr, true);
+    fillSheet(container, 6);
+
+    size_t pairwise = countPairwise(container);
+    // 7 horizontal lines cross 7 vertical ones, 18 large circles cross 4 lines twice,
+    // each point is counted for both entities
+    REQUIRE(pairwise == (7 * 7 + 18 * 4 * 2) * 2);
+    REQUIRE(countSweep(container) == pairwise);
+}
+
+TEST_CASE("LC_IntersectionSweep limits pairs to targets") {
+    RS_EntityContainer container(nullptr, true);
+    auto *horizontal = new RS_Line(&container, {0., 5.}, {10., 5.});
+    auto *vertical = new RS_Line(&container, {5., 0.}, {5., 10.});
+    auto *circle = new RS_Circle(&container, {{5., 5.}, 2.});
+    auto *far = new RS_Line(&container, {100., 100.}, {110., 100.});
+    container.addEntity(horizontal);
+    container.addEntity(vertical);
+    container.addEntity(circle);
+    container.addEntity(far);
+
+    LC_IntersectionSweep sweep;
+    sweep.addContainer(&container);
+    auto result = sweep.findAll({horizontal});
+    REQUIRE(result.size() == 1);
+    // crossing with vertical line and two points on the circle
+    REQUIRE(result.value(horizontal).size() == 3);
+    REQUIRE(sweep.findWith(far).isEmpty());
+    REQUIRE(sweep.findWith(circle).size() == 4);
+}
+
+TEST_CASE("LC_IntersectionSweep checks construction lines against all entities") {
+    RS_EntityContainer container(nullptr, true);
+    auto *line = new RS_Line(&container, {1000., -1.}, {1000., 1.});
+    auto *xline = new RS_ConstructionLine(&container, {{0., 0.}, {1., 0.}});
+    container.addEntity(line);
+    container.addEntity(xline);
+
+    LC_IntersectionSweep sweep;
+    sweep.addContainer(&container);
+    auto result = sweep.findAll();
+    REQUIRE(result.value(line).size() == 1);
+    REQUIRE(result.value(xline).size() == 1);
+}
+
+TEST_CASE("LC_Division finds the same intersections of single entities as the sweep") {
+    RS_EntityContainer container(nullptr, true);
+    fillSheet(container, 3);
+
+    LC_IntersectionSweep sweep;
+    sweep.addContainer(&container);
+    const auto all = sweep.findAll();
+    LC_Division division(&container);
+    for (RS_Entity *e: container) {
+        REQUIRE(division.collectAllIntersectionsWithEntity(e).size() == all.value(e).size());
+    }
+    // border line - 4 crossing lines, 2 large circles crossing it twice
+    REQUIRE(division.collectAllIntersectionsWithEntity(container.entityAt(0)).size() == 8);
+}
+
+TEST_CASE("LC_IntersectionSweep benchmark", "[!benchmark]") {
+    RS_EntityContainer container(nullptr, true);
+    fillSheet(container, 30);
+
+    BENCHMARK("per-entity loop") {
+        LC_Division division(&container);
+        size_t count = 0;
+        for (RS_Entity *e: container) {
+            count += division.collectAllIntersectionsWithEntity(e).size();
+        }
+        return count;
+    };
+
+    BENCHMARK("pairwise solve") {
+        return countPairwise(container);
+    };
+
+    BENCHMARK("sweep") {
+        return countSweep(container);
+    };
+}
@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright LibreCAD librecad.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <QStandardPaths>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "rs_graphic.h"
+#include "rs_line.h"
+#include "rs_modification.h"
+#include "rs_polyline.h"
+#include "rs_settings.h"
+
+namespace {
+void initSettings() {
+    if (RS_Settings::instance() == nullptr) {
+        // keeps settings of tests out of the user settings
+        QStandardPaths::setTestModeEnabled(true);
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+// more entities than the threshold of parallel cloning
+std::vector<RS_Entity*> fillDocument(RS_Graphic& graphic, int linesCount, int polylinesCount) {
+    std::vector<RS_Entity*> entities;
+    for (int i = 0; i < linesCount; i++) {
+        auto* line = new RS_Line(&graphic, {double(i), 0.}, {double(i), 10.});
+        graphic.addEntity(line);
+        entities.push_back(line);
+    }
+    for (int i = 0; i < polylinesCount; i++) {
+        auto* polyline = new RS_Polyline(&graphic);
+        polyline->addVertex({double(i), 20.});
+        polyline->addVertex({double(i) + 1., 21.});
+        polyline->addVertex({double(i) + 2., 20.});
+        graphic.addEntity(polyline);
+        entities.push_back(polyline);
+    }
+    return entities;
+}
+
+std::vector<RS_Entity*> movePreview(RS_EntityContainer& preview, const std::vector<RS_Entity*>& entities,
+                                    const RS_Vector& offset) {
+    RS_MoveData data;
+    data.offset = offset;
+    RS_Modification modification(preview, nullptr, false);
+    modification.move(data, entities, true, false);
+    return {preview.begin(), preview.end()};
+}
+}
+
+TEST_CASE("RS_Modification clones entities without touching the document") {
+    initSettings();
+    RS_Graphic graphic;
+    const std::vector<RS_Entity*> entities = fillDocument(graphic, 3000, 100);
+    graphic.calculateBorders();
+    const std::uint64_t revision = graphic.getRevision();
+
+    RS_EntityContainer preview(nullptr, true);
+    const std::vector<RS_Entity*> clones = movePreview(preview, entities, {0., 100.});
+
+    // clones were transformed without invalidation of the document they will be added to
+    REQUIRE(graphic.getRevision() == revision);
+    REQUIRE(clones.size() == entities.size());
+    for (size_t i = 0; i < clones.size(); i++) {
+        RS_Entity* clone = clones[i];
+        REQUIRE(clone->rtti() == entities[i]->rtti());
+        REQUIRE(clone->getParent() == &graphic);
+        REQUIRE(clone->getStartpoint() == entities[i]->getStartpoint() + RS_Vector(0., 100.));
+        if (clone->isContainer()) {
+            for (RS_Entity* segment : *static_cast<RS_EntityContainer*>(clone)) {
+                REQUIRE(segment->getParent() == clone);
+            }
+        }
+    }
+}
+
+TEST_CASE("RS_Modification benchmark", "[!benchmark]") {
+    initSettings();
+    RS_Graphic graphic;
+    const std::vector<RS_Entity*> entities = fillDocument(graphic, 100000, 0);
+
+    BENCHMARK("sequential clone and move of 100k lines") {
+        RS_EntityContainer preview(nullptr, true);
+        for (RS_Entity* e : entities) {
+            RS_Entity* clone = e->clone();
+            clone->move({0., 100.});
+            preview.addEntity(clone);
+        }
+        return preview.count();
+    };
+
+    BENCHMARK("move of 100k lines") {
+        RS_EntityContainer preview(nullptr, true);
+        return movePreview(preview, entities, {0., 100.}).size();
+    };
+}
@@ -0,0 +1,741 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_pdfwriter.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QPaintEngine>
+#include <QPainterPath>
+#include <QPixmap>
+
+#include "rs_debug.h"
+
+namespace {
+    // objects of the document structure, written when the document is finished
+    constexpr int CATALOG_ID = 1;
+    constexpr int PAGES_ID = 2;
+    constexpr int RESOURCES_ID = 3;
+    constexpr int FIRST_FREE_ID = 4;
+
+    QByteArray num(qreal value, int precision = 4) {
+        QByteArray result = QByteArray::number(value, 'f', precision);
+        while (result.endsWith('0')) {
+            result.chop(1);
+        }
+        if (result.endsWith('.')) {
+            result.chop(1);
+        }
+        if (result.isEmpty() || result == "-") {
+            return "0";
+        }
+        if (result == "-0") {
+            return "0";
+        }
+        return result;
+    }
+
+    QByteArray matrix(const QTransform &t) {
+        // rotation coefficients are kept more precise, as they are multiplied by coordinates
+        return num(t.m11(), 6) + ' ' + num(t.m12(), 6) + ' ' + num(t.m21(), 6) + ' ' + num(t.m22(), 6) + ' '
+               + num(t.dx()) + ' ' + num(t.dy());
+    }
+
+    QByteArray rect(const QRectF &r) {
+        return num(r.left()) + ' ' + num(r.top()) + ' ' + num(r.right()) + ' ' + num(r.bottom());
+    }
+
+    QByteArray deflate(const QByteArray &data) {
+        // qCompress() prepends the expected uncompressed size (4 bytes) to the zlib stream
+        return qCompress(data).mid(4);
+    }
+
+    QPaintEngine::PaintEngineFeatures pdfEngineFeatures() {
+        return QPaintEngine::PaintEngineFeatures(QPaintEngine::AllFeatures)
+               & ~(QPaintEngine::PorterDuff | QPaintEngine::PerspectiveTransform
+                   | QPaintEngine::LinearGradientFill | QPaintEngine::RadialGradientFill
+                   | QPaintEngine::ConicalGradientFill | QPaintEngine::ObjectBoundingModeGradients
+                   | QPaintEngine::BlendModes | QPaintEngine::RasterOpModes);
+    }
+}
+
+/**
+ * Paint engine of LC_PdfWriter. Paths are written in device coordinates (pixels at the resolution
+ * of the writer), and the page content stream maps them to PDF points once. Gradients, alpha
+ * and composition modes are not supported - they are not used by drawing rendering.
+ */
+class LC_PdfPaintEngine : public QPaintEngine {
+public:
+    explicit LC_PdfPaintEngine(LC_PdfWriter *writer);
+
+    bool begin(QPaintDevice *pdev) override;
+    bool end() override;
+    void updateState(const QPaintEngineState &state) override;
+    void drawPath(const QPainterPath &path) override;
+    void drawPolygon(const QPointF *points, int pointCount, PolygonDrawMode mode) override;
+    void drawLines(const QLineF *lines, int lineCount) override;
+    void drawPixmap(const QRectF &r, const QPixmap &pm, const QRectF &sr) override;
+    void drawImage(const QRectF &r, const QImage &image, const QRectF &sr, Qt::ImageConversionFlags flags) override;
+    Type type() const override {return QPaintEngine::User;}
+
+    using QPaintEngine::drawPolygon;
+    using QPaintEngine::drawLines;
+
+    bool newPage();
+    bool drawForm(const QByteArray &key, const QTransform &frame);
+    void beginForm(const QByteArray &key, const QTransform &frame);
+    void endForm();
+private:
+    /** graphics state already set in the content stream, so operators are not repeated */
+    struct EmittedState {
+        QColor strokeColor;
+        QColor fillColor;
+        qreal width = -1.0;
+        int capStyle = -1;
+        int joinStyle = -1;
+        QByteArray dash;
+    };
+
+    /** content of the current page, or of the form which is recorded now */
+    struct ContentStream {
+        QByteArray data;
+        EmittedState emitted;
+        QRectF bounds;
+        QByteArray formKey;
+        QTransform formFrame;
+    };
+
+    struct Form {
+        QByteArray name;
+        QTransform frame;
+        QRectF bounds;
+    };
+
+    LC_PdfWriter *m_writer = nullptr;
+    QFile m_file;
+    std::vector<qint64> m_offsets;
+    int m_nextId = FIRST_FREE_ID;
+    std::vector<int> m_pageIds;
+    // entries of the resources dictionary shared by all pages and forms
+    QByteArray m_xObjects;
+    QHash<QByteArray, Form> m_forms;
+    QHash<qint64, QByteArray> m_images;
+    int m_formsCount = 0;
+    int m_imagesCount = 0;
+    // page stream at the bottom, nested forms above it
+    std::vector<ContentStream> m_streams;
+
+    QPen m_pen;
+    QBrush m_brush;
+    QTransform m_transform;
+    // clip in device coordinates
+    QPainterPath m_clipPath;
+    bool m_clipEnabled = false;
+    bool m_clipOpen = false;
+    bool m_clipDirty = false;
+    QSizeF m_pageSizePt;
+    qreal m_pixelToPt = 1.0;
+
+    ContentStream &stream() {return m_streams.back();}
+    int allocateId();
+    void writeObject(int id, const QByteArray &body);
+    void writeStreamObject(int id, const QByteArray &dictionary, const QByteArray &data);
+    void startPage();
+    void finishPage();
+    void applyClip();
+    void emitPath(const QPainterPath &path, const QTransform &transform);
+    void applyPen();
+    void applyBrush();
+    qreal penWidth() const;
+    QByteArray colorOperator(const QColor &color, bool stroke) const;
+    void fillAndStroke(const QPainterPath &path, bool fill, bool stroke);
+    void addBounds(const QRectF &r);
+    void drawImageWithKey(const QRectF &r, const QImage &image, const QRectF &sr, qint64 cacheKey);
+    QByteArray imageResource(const QImage &image, qint64 cacheKey);
+};
+
+LC_PdfPaintEngine::LC_PdfPaintEngine(LC_PdfWriter *writer)
+    :QPaintEngine(pdfEngineFeatures())
+    ,m_writer{writer}{
+}
+
+bool LC_PdfPaintEngine::begin([[maybe_unused]] QPaintDevice *pdev) {
+    m_file.setFileName(m_writer->fileName());
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING, "LC_PdfPaintEngine::begin: can't open %s",
+                             m_writer->fileName().toLocal8Bit().constData());
+        return false;
+    }
+    m_file.write("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+    m_pageSizePt = m_writer->pageSizePoints();
+    m_pixelToPt = 72.0 / m_writer->resolution();
+    startPage();
+    return true;
+}
+
+bool LC_PdfPaintEngine::end() {
+    finishPage();
+
+    QByteArray kids;
+    for (int id: m_pageIds) {
+        kids += QByteArray::number(id) + " 0 R ";
+    }
+    writeObject(RESOURCES_ID, "<< /ProcSet [/PDF /ImageB /ImageC] /XObject << " + m_xObjects + ">> >>");
+    writeObject(PAGES_ID, "<< /Type /Pages /Kids [ " + kids + "] /Count "
+                          + QByteArray::number(static_cast<int>(m_pageIds.size())) + " >>");
+    writeObject(CATALOG_ID, "<< /Type /Catalog /Pages 2 0 R >>");
+    int infoId = allocateId();
+    QByteArray date = QDateTime::currentDateTimeUtc().toString("yyyyMMddHHmmss").toLatin1();
+    writeObject(infoId, "<< /Producer (LibreCAD) /CreationDate (D:" + date + "Z) >>");
+
+    qint64 xrefOffset = m_file.pos();
+    QByteArray xref = "xref\n0 " + QByteArray::number(m_nextId) + "\n0000000000 65535 f \n";
+    for (int id = 1; id < m_nextId; id++) {
+        xref += QByteArray::number(m_offsets[id]).rightJustified(10, '0') + " 00000 n \n";
+    }
+    xref += "trailer\n<< /Size " + QByteArray::number(m_nextId) + " /Root 1 0 R /Info "
+            + QByteArray::number(infoId) + " 0 R >>\nstartxref\n" + QByteArray::number(xrefOffset) + "\n%%EOF\n";
+    m_file.write(xref);
+    m_file.close();
+    return m_file.error() == QFileDevice::NoError;
+}
+
+bool LC_PdfPaintEngine::newPage() {
+    if (m_streams.empty()) {
+        return false;
+    }
+    finishPage();
+    startPage();
+    return true;
+}
+
+int LC_PdfPaintEngine::allocateId() {
+    return m_nextId++;
+}
+
+void LC_PdfPaintEngine::writeObject(int id, const QByteArray &body) {
+    if (m_offsets.size() <= static_cast<size_t>(id)) {
+        m_offsets.resize(id + 1, 0);
+    }
+    m_offsets[id] = m_file.pos();
+    m_file.write(QByteArray::number(id) + " 0 obj\n" + body + "\nendobj\n");
+}
+
+void LC_PdfPaintEngine::writeStreamObject(int id, const QByteArray &dictionary, const QByteArray &data) {
+    QByteArray compressed = deflate(data);
+    writeObject(id, "<< " + dictionary + " /Filter /FlateDecode /Length " + QByteArray::number(compressed.size())
+                    + " >>\nstream\n" + compressed + "\nendstream");
+}
+
+void LC_PdfPaintEngine::startPage() {
+    m_streams.clear();
+    m_streams.emplace_back();
+    // device pixels (y down) to PDF points (y up)
+    QTransform toPoints(m_pixelToPt, 0, 0, -m_pixelToPt, 0, m_pageSizePt.height());
+    stream().data = "q " + matrix(toPoints) + " cm\n";
+    m_clipOpen = false;
+    applyClip();
+}
+
+void LC_PdfPaintEngine::finishPage() {
+    if (m_streams.empty()) {
+        return;
+    }
+    while (m_streams.size() > 1) {
+        endForm();
+    }
+    QByteArray &data = stream().data;
+    if (m_clipOpen) {
+        data += "Q\n";
+    }
+    data += "Q\n";
+
+    int contentId = allocateId();
+    writeStreamObject(contentId, QByteArray(), data);
+    int pageId = allocateId();
+    writeObject(pageId, "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 " + num(m_pageSizePt.width()) + ' '
+                        + num(m_pageSizePt.height()) + "] /Resources 3 0 R /Contents "
+                        + QByteArray::number(contentId) + " 0 R >>");
+    m_pageIds.push_back(pageId);
+    m_streams.clear();
+    m_clipOpen = false;
+}
+
+void LC_PdfPaintEngine::applyClip() {
+    if (m_streams.size() > 1) {
+        // forms are clipped by the page they are placed on
+        m_clipDirty = true;
+        return;
+    }
+    m_clipDirty = false;
+    ContentStream &s = stream();
+    if (m_clipOpen) {
+        // clip may be only reduced within the graphics state, so restore the state without it
+        s.data += "Q\n";
+        s.emitted = EmittedState();
+        m_clipOpen = false;
+    }
+    if (m_clipEnabled) {
+        s.data += "q ";
+        if (m_clipPath.isEmpty()) {
+            s.data += "0 0 0 0 re ";
+        } else {
+            emitPath(m_clipPath, QTransform());
+        }
+        s.data += m_clipPath.fillRule() == Qt::OddEvenFill ? "W* n\n" : "W n\n";
+        m_clipOpen = true;
+    }
+}
+
+void LC_PdfPaintEngine::updateState(const QPaintEngineState &state) {
+    QPaintEngine::DirtyFlags flags = state.state();
+    if (flags & DirtyPen) {
+        m_pen = state.pen();
+    }
+    if (flags & DirtyBrush) {
+        m_brush = state.brush();
+    }
+    if (flags & DirtyTransform) {
+        m_transform = state.transform();
+    }
+
+    bool clipEnabled = m_clipEnabled;
+    QPainterPath clipPath = m_clipPath;
+    if (flags & DirtyClipEnabled) {
+        clipEnabled = state.isClipEnabled();
+    }
+    if (flags & (DirtyClipPath | DirtyClipRegion)) {
+        QPainterPath path;
+        if (flags & DirtyClipPath) {
+            path = m_transform.map(state.clipPath());
+        } else {
+            path.addRegion(state.clipRegion());
+            path = m_transform.map(path);
+        }
+        switch (state.clipOperation()) {
+            case Qt::NoClip:
+                clipEnabled = false;
+                clipPath = QPainterPath();
+                break;
+            case Qt::ReplaceClip:
+                clipEnabled = true;
+                clipPath = path;
+                break;
+            case Qt::IntersectClip:
+                clipPath = clipEnabled ? clipPath.intersected(path) : path;
+                clipEnabled = true;
+                break;
+        }
+    }
+    // painter replays the clip on each restore(), while it is the same usually
+    if (clipEnabled != m_clipEnabled || (clipEnabled && clipPath != m_clipPath)) {
+        m_clipEnabled = clipEnabled;
+        m_clipPath = clipPath;
+        applyClip();
+    }
+}
+
+void LC_PdfPaintEngine::emitPath(const QPainterPath &path, const QTransform &transform) {
+    QByteArray &data = stream().data;
+    int count = path.elementCount();
+    for (int i = 0; i < count; ++i) {
+        const QPainterPath::Element &e = path.elementAt(i);
+        QPointF p = transform.map(QPointF(e.x, e.y));
+        switch (e.type) {
+            case QPainterPath::MoveToElement:
+                data += num(p.x()) + ' ' + num(p.y()) + " m\n";
+                break;
+            case QPainterPath::LineToElement:
+                data += num(p.x()) + ' ' + num(p.y()) + " l\n";
+                break;
+            case QPainterPath::CurveToElement: {
+                if (i + 2 >= count) {
+                    return;
+                }
+                const QPainterPath::Element &c2 = path.elementAt(i + 1);
+                const QPainterPath::Element &last = path.elementAt(i + 2);
+                QPointF p2 = transform.map(QPointF(c2.x, c2.y));
+                QPointF p3 = transform.map(QPointF(last.x, last.y));
+                data += num(p.x()) + ' ' + num(p.y()) + ' ' + num(p2.x()) + ' ' + num(p2.y()) + ' '
+                        + num(p3.x()) + ' ' + num(p3.y()) + " c\n";
+                i += 2;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+qreal LC_PdfPaintEngine::penWidth() const {
+    qreal width = m_pen.widthF();
+    if (!m_pen.isCosmetic() && !m_transform.isIdentity()) {
+        width *= std::sqrt(std::abs(m_transform.determinant()));
+    }
+    return width;
+}
+
+QByteArray LC_PdfPaintEngine::colorOperator(const QColor &color, bool stroke) const {
+    if (m_writer->isGrayscale()) {
+        return num(qGray(color.rgb()) / 255.0, 3) + (stroke ? " G\n" : " g\n");
+    }
+    return num(color.redF(), 3) + ' ' + num(color.greenF(), 3) + ' ' + num(color.blueF(), 3)
+           + (stroke ? " RG\n" : " rg\n");
+}
+
+void LC_PdfPaintEngine::applyPen() {
+    ContentStream &s = stream();
+    EmittedState &emitted = s.emitted;
+
+    QColor color = m_pen.color();
+    if (color != emitted.strokeColor) {
+        s.data += colorOperator(color, true);
+        emitted.strokeColor = color;
+    }
+
+    qreal width = penWidth();
+    if (width != emitted.width) {
+        s.data += num(width) + " w\n";
+        emitted.width = width;
+    }
+
+    int cap = 0;
+    switch (m_pen.capStyle()) {
+        case Qt::RoundCap:
+            cap = 1;
+            break;
+        case Qt::SquareCap:
+            cap = 2;
+            break;
+        default:
+            break;
+    }
+    if (cap != emitted.capStyle) {
+        s.data += QByteArray::number(cap) + " J\n";
+        emitted.capStyle = cap;
+    }
+
+    int join = 0;
+    switch (m_pen.joinStyle()) {
+        case Qt::RoundJoin:
+            join = 1;
+            break;
+        case Qt::BevelJoin:
+            join = 2;
+            break;
+        default:
+            break;
+    }
+    if (join != emitted.joinStyle) {
+        s.data += QByteArray::number(join) + " j\n";
+        emitted.joinStyle = join;
+    }
+
+    QByteArray dash = "[] 0 d\n";
+    if (m_pen.style() != Qt::SolidLine) {
+        // dash pattern of the pen is in units of pen width
+        qreal unit = std::max(width, 1.0);
+        dash = "[";
+        for (qreal v: m_pen.dashPattern()) {
+            dash += num(v * unit) + ' ';
+        }
+        dash += "] " + num(m_pen.dashOffset() * unit) + " d\n";
+    }
+    if (dash != emitted.dash) {
+        s.data += dash;
+        emitted.dash = dash;
+    }
+}
+
+void LC_PdfPaintEngine::applyBrush() {
+    ContentStream &s = stream();
+    QColor color = m_brush.color();
+    if (color != s.emitted.fillColor) {
+        s.data += colorOperator(color, false);
+        s.emitted.fillColor = color;
+    }
+}
+
+void LC_PdfPaintEngine::addBounds(const QRectF &r) {
+    ContentStream &s = stream();
+    s.bounds = s.bounds.isNull() ? r : s.bounds.united(r);
+}
+
+void LC_PdfPaintEngine::fillAndStroke(const QPainterPath &path, bool fill, bool stroke) {
+    stroke = stroke && m_pen.style() != Qt::NoPen && m_pen.color().alpha() > 0;
+    fill = fill && m_brush.style() != Qt::NoBrush && m_brush.color().alpha() > 0;
+    if ((!stroke && !fill) || path.isEmpty()) {
+        return;
+    }
+    if (stroke) {
+        applyPen();
+    }
+    if (fill) {
+        applyBrush();
+    }
+    emitPath(path, m_transform);
+
+    bool evenOdd = path.fillRule() == Qt::OddEvenFill;
+    const char *op = stroke ? (fill ? (evenOdd ? "B*\n" : "B\n") : "S\n") : (evenOdd ? "f*\n" : "f\n");
+    stream().data += op;
+
+    QRectF bounds = m_transform.mapRect(path.controlPointRect());
+    // stroke may extend over the path by half of width, plus miters and square caps
+    qreal pad = stroke ? penWidth() + 1.0 : 1.0;
+    addBounds(bounds.adjusted(-pad, -pad, pad, pad));
+}
+
+void LC_PdfPaintEngine::drawPath(const QPainterPath &path) {
+    fillAndStroke(path, true, true);
+}
+
+void LC_PdfPaintEngine::drawPolygon(const QPointF *points, int pointCount, PolygonDrawMode mode) {
+    if (pointCount < 2) {
+        return;
+    }
+    QPainterPath path;
+    path.moveTo(points[0]);
+    for (int i = 1; i < pointCount; i++) {
+        path.lineTo(points[i]);
+    }
+    bool polyline = mode == PolylineMode;
+    if (!polyline) {
+        path.closeSubpath();
+        path.setFillRule(mode == OddEvenMode ? Qt::OddEvenFill : Qt::WindingFill);
+    }
+    fillAndStroke(path, !polyline, true);
+}
+
+void LC_PdfPaintEngine::drawLines(const QLineF *lines, int lineCount) {
+    QPainterPath path;
+    for (int i = 0; i < lineCount; i++) {
+        path.moveTo(lines[i].p1());
+        path.lineTo(lines[i].p2());
+    }
+    fillAndStroke(path, false, true);
+}
+
+void LC_PdfPaintEngine::drawPixmap(const QRectF &r, const QPixmap &pm, const QRectF &sr) {
+    drawImageWithKey(r, pm.toImage(), sr, pm.cacheKey());
+}
+
+void LC_PdfPaintEngine::drawImage(const QRectF &r, const QImage &image, const QRectF &sr,
+                                  [[maybe_unused]] Qt::ImageConversionFlags flags) {
+    drawImageWithKey(r, image, sr, image.cacheKey());
+}
+
+void LC_PdfPaintEngine::drawImageWithKey(const QRectF &r, const QImage &image, const QRectF &sr, qint64 cacheKey) {
+    QRect source = sr.toAlignedRect();
+    QByteArray name;
+    if (source == image.rect()) {
+        name = imageResource(image, cacheKey);
+    } else {
+        name = imageResource(image.copy(source), 0);
+    }
+    // image space is the unit square with the first row at the top
+    QTransform placement = QTransform(r.width(), 0, 0, -r.height(), r.x(), r.y() + r.height()) * m_transform;
+    stream().data += "q " + matrix(placement) + " cm /" + name + " Do Q\n";
+    addBounds(placement.mapRect(QRectF(0, 0, 1, 1)));
+}
+
+QByteArray LC_PdfPaintEngine::imageResource(const QImage &image, qint64 cacheKey) {
+    if (cacheKey != 0) {
+        auto it = m_images.constFind(cacheKey);
+        if (it != m_images.constEnd()) {
+            return it.value();
+        }
+    }
+    QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+    int width = argb.width();
+    int height = argb.height();
+    bool gray = m_writer->isGrayscale();
+    bool hasAlpha = argb.hasAlphaChannel() && image.hasAlphaChannel();
+
+    QByteArray pixels;
+    pixels.reserve(width * height * (gray ? 1 : 3));
+    QByteArray alpha;
+    if (hasAlpha) {
+        alpha.reserve(width * height);
+    }
+    for (int y = 0; y < height; y++) {
+        auto line = reinterpret_cast<const QRgb *>(argb.constScanLine(y));
+        for (int x = 0; x < width; x++) {
+            QRgb px = line[x];
+            if (gray) {
+                pixels += static_cast<char>(qGray(px));
+            } else {
+                pixels += static_cast<char>(qRed(px));
+                pixels += static_cast<char>(qGreen(px));
+                pixels += static_cast<char>(qBlue(px));
+            }
+            if (hasAlpha) {
+                alpha += static_cast<char>(qAlpha(px));
+            }
+        }
+    }
+
+    QByteArray size = "/Width " + QByteArray::number(width) + " /Height " + QByteArray::number(height)
+                      + " /BitsPerComponent 8";
+    QByteArray dictionary = "/Type /XObject /Subtype /Image " + size
+                            + (gray ? " /ColorSpace /DeviceGray" : " /ColorSpace /DeviceRGB");
+    if (hasAlpha) {
+        int maskId = allocateId();
+        writeStreamObject(maskId, "/Type /XObject /Subtype /Image " + size + " /ColorSpace /DeviceGray", alpha);
+        dictionary += " /SMask " + QByteArray::number(maskId) + " 0 R";
+    }
+    int id = allocateId();
+    writeStreamObject(id, dictionary, pixels);
+
+    QByteArray name = "Im" + QByteArray::number(++m_imagesCount);
+    m_xObjects += '/' + name + ' ' + QByteArray::number(id) + " 0 R ";
+    if (cacheKey != 0) {
+        m_images.insert(cacheKey, name);
+    }
+    return name;
+}
+
+bool LC_PdfPaintEngine::drawForm(const QByteArray &key, const QTransform &frame) {
+    if (m_streams.empty()) {
+        return false;
+    }
+    auto it = m_forms.constFind(key);
+    if (it == m_forms.constEnd()) {
+        return false;
+    }
+    bool invertible = false;
+    QTransform fromRecorded = it->frame.inverted(&invertible);
+    if (!invertible) {
+        return false;
+    }
+    QTransform placement = fromRecorded * frame;
+    stream().data += "q " + matrix(placement) + " cm /" + it->name + " Do Q\n";
+    addBounds(placement.mapRect(it->bounds));
+    return true;
+}
+
+void LC_PdfPaintEngine::beginForm(const QByteArray &key, const QTransform &frame) {
+    if (m_streams.empty()) {
+        return;
+    }
+    ContentStream form;
+    form.formKey = key;
+    form.formFrame = frame;
+    m_streams.push_back(std::move(form));
+}
+
+void LC_PdfPaintEngine::endForm() {
+    if (m_streams.size() < 2) {
+        return;
+    }
+    ContentStream form = std::move(m_streams.back());
+    m_streams.pop_back();
+    if (!form.data.isEmpty() && !form.bounds.isNull()) {
+        // form content is in device coordinates of the recorded occurrence, so it is placed as is
+        int id = allocateId();
+        writeStreamObject(id, "/Type /XObject /Subtype /Form /BBox [" + rect(form.bounds) + "] /Resources 3 0 R",
+                          form.data);
+        QByteArray name = "Fm" + QByteArray::number(++m_formsCount);
+        m_xObjects += '/' + name + ' ' + QByteArray::number(id) + " 0 R ";
+        m_forms.insert(form.formKey, Form{name, form.formFrame, form.bounds});
+        stream().data += '/' + name + " Do\n";
+        addBounds(form.bounds);
+    }
+    if (m_streams.size() == 1 && m_clipDirty) {
+        applyClip();
+    }
+}
+
+LC_PdfWriter::LC_PdfWriter(const QString &fileName)
+    :m_fileName{fileName}
+    ,m_pageLayout{QPageSize(QPageSize::A4), QPageLayout::Portrait, QMarginsF()}
+    ,m_engine{std::make_unique<LC_PdfPaintEngine>(this)}{
+}
+
+LC_PdfWriter::~LC_PdfWriter() = default;
+
+void LC_PdfWriter::setPageSize(const QPageSize &pageSize) {
+    m_pageLayout.setPageSize(pageSize);
+}
+
+void LC_PdfWriter::setPageOrientation(QPageLayout::Orientation orientation) {
+    m_pageLayout.setOrientation(orientation);
+}
+
+void LC_PdfWriter::setResolution(int dpi) {
+    m_resolution = std::max(dpi, 1);
+}
+
+QSizeF LC_PdfWriter::pageSizePoints() const {
+    return m_pageLayout.fullRect(QPageLayout::Point).size();
+}
+
+bool LC_PdfWriter::newPage() {
+    return m_engine->newPage();
+}
+
+bool LC_PdfWriter::drawForm(const QByteArray &key, const QTransform &frame) {
+    return m_engine->drawForm(key, frame);
+}
+
+void LC_PdfWriter::beginForm(const QByteArray &key, const QTransform &frame) {
+    m_engine->beginForm(key, frame);
+}
+
+void LC_PdfWriter::endForm() {
+    m_engine->endForm();
+}
+
+QPaintEngine *LC_PdfWriter::paintEngine() const {
+    return m_engine.get();
+}
+
+int LC_PdfWriter::metric(PaintDeviceMetric metric) const {
+    QSizeF size = pageSizePoints();
+    switch (metric) {
+        case PdmWidth:
+            return qRound(size.width() * m_resolution / 72.0);
+        case PdmHeight:
+            return qRound(size.height() * m_resolution / 72.0);
+        case PdmWidthMM:
+            return qRound(size.width() * 25.4 / 72.0);
+        case PdmHeightMM:
+            return qRound(size.height() * 25.4 / 72.0);
+        case PdmDpiX:
+        case PdmDpiY:
+        case PdmPhysicalDpiX:
+        case PdmPhysicalDpiY:
+            return m_resolution;
+        case PdmNumColors:
+            return INT_MAX;
+        case PdmDepth:
+            return 32;
+        default:
+            return QPaintDevice::metric(metric);
+    }
+}
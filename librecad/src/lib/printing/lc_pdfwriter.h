@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_PDFWRITER_H
+#define LC_PDFWRITER_H
+
+#include <memory>
+
+#include <QPageLayout>
+#include <QPaintDevice>
+
+class LC_PdfPaintEngine;
+class QTransform;
+
+/**
+ * Vector PDF output device, used for PDF export instead of QPrinter.
+ *
+ * Each page is written to the output file as soon as it is finished, so memory usage does not
+ * grow with the number of pages. Content that repeats over the drawing (font glyphs, block
+ * definitions) may be recorded once as a Form XObject between beginForm() and endForm(), and
+ * any further occurrence is then emitted by drawForm() as a single reference to it.
+ *
+ * Forms are addressed by a caller-provided key. The frame passed with the key is the device
+ * transform of the occurrence's local coordinate system; placement of a later occurrence is
+ * derived from the frame of the recorded one, so the caller is responsible for putting into
+ * the key everything that may change the appearance of the content except that frame.
+ */
+class LC_PdfWriter : public QPaintDevice {
+public:
+    explicit LC_PdfWriter(const QString& fileName);
+    ~LC_PdfWriter() override;
+
+    void setPageSize(const QPageSize& pageSize);
+    void setPageOrientation(QPageLayout::Orientation orientation);
+    void setResolution(int dpi);
+    int resolution() const {return m_resolution;}
+    void setGrayscale(bool grayscale) {m_grayscale = grayscale;}
+    bool isGrayscale() const {return m_grayscale;}
+    const QString& fileName() const {return m_fileName;}
+
+    bool newPage();
+
+    bool drawForm(const QByteArray& key, const QTransform& frame);
+    void beginForm(const QByteArray& key, const QTransform& frame);
+    void endForm();
+
+    QPaintEngine* paintEngine() const override;
+    /** page size in PDF points (1/72 inch), according to orientation */
+    QSizeF pageSizePoints() const;
+protected:
+    int metric(PaintDeviceMetric metric) const override;
+private:
+    QString m_fileName;
+    QPageLayout m_pageLayout;
+    int m_resolution = 1200;
+    bool m_grayscale = false;
+    std::unique_ptr<LC_PdfPaintEngine> m_engine;
+};
+
+#endif // LC_PDFWRITER_H
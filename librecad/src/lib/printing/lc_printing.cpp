@@ -22,6 +22,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "lc_printing.h"
 
+#include <memory>
+
 #include <QApplication>
 #include <QFileDialog>
 #include <QFileInfo>
@@ -31,6 +33,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <QRegularExpression>
 
 #include "lc_graphicviewport.h"
+#include "lc_pdfwriter.h"
 #include "lc_printpreviewview.h"
 #include "lc_printviewportrenderer.h"
 #include "qc_mdiwindow.h"
@@ -249,7 +252,18 @@ void LC_Printing::Print(QC_MDIWindow &mdiWindow, PrinterType printerType)
         RS_DEBUG->print(RS_Debug::D_INFORMATIONAL, "QC_ApplicationWindow::slotFilePrint: resolution is %d", printer.resolution());
         QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
-        RS_Painter painter(&printer);
+        // PDF is written by own writer, which shares repeated blocks and glyphs within the file
+        std::unique_ptr<LC_PdfWriter> pdfWriter;
+        QPaintDevice* device = &printer;
+        if (printerType == PrinterType::PDF) {
+            pdfWriter = std::make_unique<LC_PdfWriter>(printer.outputFileName());
+            pdfWriter->setPageSize(printer.pageLayout().pageSize());
+            pdfWriter->setPageOrientation(printer.pageLayout().orientation());
+            pdfWriter->setResolution(printer.resolution());
+            device = pdfWriter.get();
+        }
+
+        RS_Painter painter(device);
         // RAII style to restore cursor. Not really a shared pointer for ownership
         std::shared_ptr<RS_Painter> painterPtr{&painter, []([[maybe_unused]] RS_Painter *painter) {
             QApplication::restoreOverrideCursor();
@@ -269,11 +283,11 @@ void LC_Printing::Print(QC_MDIWindow &mdiWindow, PrinterType printerType)
         QMarginsF margins = printer.pageLayout().margins(QPageLayout::Millimeter);
 //        LC_ERR << "Printer margins (mm): " << margins.left()<<": "<<margins.top()<<" : "<<margins.right()<<" : "<<margins.bottom();
 
-        double printerWidth = printer.width();
-        double printerHeight = printer.height();
+        double printerWidth = device->width();
+        double printerHeight = device->height();
 
-        double printerFx = (double) printerWidth / printer.widthMM();
-        double printerFy = (double) printerHeight / printer.heightMM();
+        double printerFx = (double) printerWidth / device->widthMM();
+        double printerFy = (double) printerHeight / device->heightMM();
 
         painter.setClipRect(margins.left() * printerFx, margins.top() * printerFy,
                             printerWidth - (margins.left() + margins.right()) * printerFx,
@@ -317,7 +331,11 @@ void LC_Printing::Print(QC_MDIWindow &mdiWindow, PrinterType printerType)
                 // First page is created automatically.
                 // Extra pages must be created manually.
                 if (pX > 0 || pY > 0) {
-                    printer.newPage();
+                    if (pdfWriter != nullptr) {
+                        pdfWriter->newPage();
+                    } else {
+                        printer.newPage();
+                    }
                 }
 
                 viewport.justSetOffsetAndFactor((int) ((baseX - offsetX) * f),
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <QFile>
+#include <QHash>
+#include <QPainter>
+#include <QTemporaryDir>
+#include <QTransform>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_pdfwriter.h"
+
+namespace {
+struct PdfObject {
+    QByteArray dictionary;
+    QByteArray stream;
+};
+
+// content of the form, drawn in local coordinates of the occurrence
+void drawBlock(QPainter& painter, const QTransform& frame) {
+    painter.setTransform(frame);
+    painter.drawLine(QLineF(0., 0., 100., 0.));
+    painter.drawRect(QRectF(10., 10., 50., 30.));
+}
+
+// emits the block as a reference to its form, or records the form on the first occurrence
+void drawBlockOccurrence(LC_PdfWriter& writer, QPainter& painter, const QByteArray& key, const QTransform& frame) {
+    if (!writer.drawForm(key, frame)) {
+        writer.beginForm(key, frame);
+        drawBlock(painter, frame);
+        writer.endForm();
+    }
+}
+
+QByteArray inflate(const QByteArray& data) {
+    // qUncompress() expects the uncompressed size (4 bytes, big endian) before the zlib stream, the buffer grows if needed
+    const qsizetype hint = data.size() * 8;
+    QByteArray prefixed;
+    prefixed.append(static_cast<char>((hint >> 24) & 0xff));
+    prefixed.append(static_cast<char>((hint >> 16) & 0xff));
+    prefixed.append(static_cast<char>((hint >> 8) & 0xff));
+    prefixed.append(static_cast<char>(hint & 0xff));
+    prefixed.append(data);
+    return qUncompress(prefixed);
+}
+
+/**
+ * Reads objects of the file by its cross-reference table, checking that each entry points to its object.
+ */
+QHash<int, PdfObject> readObjects(const QByteArray& pdf) {
+    REQUIRE(pdf.startsWith("%PDF-1.4\n"));
+    REQUIRE(pdf.endsWith("%%EOF\n"));
+    const qsizetype startXref = pdf.lastIndexOf("startxref\n");
+    REQUIRE(startXref > 0);
+    bool ok = false;
+    const qsizetype xrefOffset = pdf.mid(startXref + 10).split('\n').constFirst().toLongLong(&ok);
+    REQUIRE(ok);
+    REQUIRE(pdf.mid(xrefOffset, 5) == "xref\n");
+
+    const QList<QByteArray> subsection = pdf.mid(xrefOffset + 5).split('\n').constFirst().split(' ');
+    REQUIRE(subsection.size() == 2);
+    REQUIRE(subsection[0] == "0");
+    const int size = subsection[1].toInt();
+    REQUIRE(size > 1);
+    const qsizetype entries = pdf.indexOf('\n', xrefOffset + 5) + 1;
+    REQUIRE(pdf.indexOf("/Size " + QByteArray::number(size) + ' ', xrefOffset) > 0);
+    // entries are 20 bytes long, including the end of line
+    REQUIRE(pdf.mid(entries, 20) == "0000000000 65535 f \n");
+
+    QHash<int, PdfObject> objects;
+    for (int id = 1; id < size; id++) {
+        const QByteArray entry = pdf.mid(entries + id * 20, 20);
+        REQUIRE(entry.size() == 20);
+        REQUIRE(entry.mid(10) == " 00000 n \n");
+        const qsizetype offset = entry.left(10).toLongLong(&ok);
+        REQUIRE(ok);
+        const QByteArray header = QByteArray::number(id) + " 0 obj\n";
+        REQUIRE(pdf.mid(offset, header.size()) == header);
+
+        // compressed data may contain any bytes, so the stream is read by its length
+        const qsizetype bodyStart = offset + header.size();
+        const qsizetype objectEnd = pdf.indexOf("\nendobj\n", bodyStart);
+        const qsizetype streamStart = pdf.indexOf(">>\nstream\n", bodyStart);
+        REQUIRE(objectEnd > bodyStart);
+        PdfObject object;
+        if (streamStart < 0 || objectEnd < streamStart) {
+            object.dictionary = pdf.mid(bodyStart, objectEnd - bodyStart);
+        }
+        else {
+            object.dictionary = pdf.mid(bodyStart, streamStart + 2 - bodyStart);
+            const qsizetype lengthStart = object.dictionary.indexOf("/Length ");
+            REQUIRE(lengthStart > 0);
+            const int length = object.dictionary.mid(lengthStart + 8).split(' ').constFirst().toInt();
+            const qsizetype dataStart = streamStart + 10;
+            REQUIRE(pdf.mid(dataStart + length, 18) == "\nendstream\nendobj\n");
+            const QByteArray data = pdf.mid(dataStart, length);
+            object.stream = object.dictionary.contains("/FlateDecode") ? inflate(data) : data;
+            REQUIRE(!object.stream.isEmpty());
+        }
+        objects.insert(id, object);
+    }
+    return objects;
+}
+}
+
+TEST_CASE("LC_PdfWriter writes repeated blocks as a single form") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("forms.pdf");
+    {
+        LC_PdfWriter writer(fileName);
+        writer.setResolution(300);
+        QPainter painter;
+        REQUIRE(painter.begin(&writer));
+        painter.setPen(QPen(Qt::black, 2.));
+        for (int page = 0; page < 2; page++) {
+            if (page > 0) {
+                REQUIRE(writer.newPage());
+            }
+            for (int i = 0; i < 3; i++) {
+                QTransform frame;
+                frame.translate(100. + i * 200., 100. + page * 50.);
+                frame.rotate(i * 30.);
+                drawBlockOccurrence(writer, painter, "block", frame);
+            }
+            // other scale is recorded as another form
+            drawBlockOccurrence(writer, painter, "block scaled", QTransform::fromScale(2., 2.).translate(300., 500.));
+            painter.resetTransform();
+            painter.drawLine(QLineF(0., 0., 500., 500.));
+        }
+        REQUIRE(painter.end());
+    }
+
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    const QHash<int, PdfObject> objects = readObjects(file.readAll());
+
+    int forms = 0;
+    int pages = 0;
+    int blockReferences = 0;
+    int scaledReferences = 0;
+    for (const PdfObject& object: objects) {
+        if (object.dictionary.contains("/Subtype /Form")) {
+            forms++;
+        }
+        if (object.dictionary.contains("/Type /Page ")) {
+            pages++;
+        }
+        if (!object.dictionary.contains("/Type /XObject")) {
+            blockReferences += static_cast<int>(object.stream.count("/Fm1 Do"));
+            scaledReferences += static_cast<int>(object.stream.count("/Fm2 Do"));
+        }
+    }
+    REQUIRE(forms == 2);
+    REQUIRE(pages == 2);
+    REQUIRE(blockReferences == 6);
+    REQUIRE(scaledReferences == 2);
+
+    // the resources dictionary, shared by pages, refers to the forms
+    bool resourcesFound = false;
+    for (const PdfObject& object: objects) {
+        if (object.dictionary.contains("/XObject << ")) {
+            resourcesFound = true;
+            REQUIRE(object.dictionary.contains("/Fm1 "));
+            REQUIRE(object.dictionary.contains("/Fm2 "));
+        }
+    }
+    REQUIRE(resourcesFound);
+}
@@ -57,14 +57,14 @@ void RS_ScriptList::init() {
 
     for ( QStringList::Iterator it = list.begin();
             it != list.end(); ++it ) {
-        RS_DEBUG->print("script: %s:", (*it).toLatin1().data());
+        LC_DEBUG_PRINT("script: %s:", (*it).toLatin1().data());
 
         QFileInfo fi(*it);
         script = new RS_Script(fi.baseName(), fi.absoluteFilePath());
         scripts.append(script);
 
-        RS_DEBUG->print("base: %s", fi.baseName().toLatin1().data());
-        RS_DEBUG->print("path: %s", fi.absoluteFilePath().toLatin1().data());
+        LC_DEBUG_PRINT("base: %s", fi.baseName().toLatin1().data());
+        LC_DEBUG_PRINT("path: %s", fi.absoluteFilePath().toLatin1().data());
     }
 
     //RS_Script* f = new RS_Script("normal");
@@ -110,12 +110,12 @@ void RS_ScriptList::removeScript(RS_Script* script) {
  * memory if it's not already.
  */
 RS_Script* RS_ScriptList::requestScript(const QString& name) {
-    RS_DEBUG->print("RS_ScriptList::requestScript %s",  name.toLatin1().data());
+    LC_DEBUG_PRINT("RS_ScriptList::requestScript %s",  name.toLatin1().data());
 
     QString name2 = name.toLower();
     RS_Script* foundScript = NULL;
 
-    RS_DEBUG->print("name2: %s", name2.toLatin1().data());
+    LC_DEBUG_PRINT("name2: %s", name2.toLatin1().data());
 
     // Search our list of available scripts:
     for (int i = 0; i < scripts.size(); ++i) {
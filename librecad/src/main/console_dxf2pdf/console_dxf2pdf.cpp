@@ -27,6 +27,7 @@
 #include <QCoreApplication>
 #include <QApplication>
 
+#include "lc_trace.h"
 #include "rs_debug.h"
 #include "rs_fontlist.h"
 #include "rs_patternlist.h"
@@ -125,6 +126,10 @@ int console_dxf2pdf(int argc, char* argv[])
         QObject::tr( "Target output directory."), "path");
     parser.addOption(outDirOpt);
 
+    QCommandLineOption traceOpt(QStringList() << "trace",
+        QObject::tr( "Write Chrome trace-event JSON with timings to the file."), "file");
+    parser.addOption(traceOpt);
+
     parser.addPositionalArgument(QObject::tr( "<dxf_files>"), QObject::tr( "Input DXF file(s)"));
 
     parser.process(app);
@@ -176,6 +181,9 @@ int console_dxf2pdf(int argc, char* argv[])
         }
     }
 
+    QString traceFile = parser.value(traceOpt);
+    LC_Trace::setEnabled(!traceFile.isEmpty());
+
     RS_FONTLIST->init();
     RS_PATTERNLIST->init();
 
@@ -185,7 +193,11 @@ int console_dxf2pdf(int argc, char* argv[])
 
     QTimer::singleShot(0, loop, SLOT(run()));
 
-    return app.exec();
+    int result = app.exec();
+    if (!traceFile.isEmpty()) {
+        LC_Trace::writeChromeTrace(traceFile);
+    }
+    return result;
 }
 
 
@@ -27,6 +27,7 @@
 #include "rs.h"
 #include "rs_graphic.h"
 #include "rs_painter.h"
+#include "lc_pdfwriter.h"
 #include "lc_printing.h"
 #include "rs_units.h"
 #include "lc_graphicviewport.h"
@@ -34,10 +35,11 @@
 #include "pdf_print_loop.h"
 
 #include "lc_documentsstorage.h"
+#include "lc_trace.h"
 static bool openDocAndSetGraphic(RS_Document**, RS_Graphic**, const QString&);
 static void touchGraphic(RS_Graphic*, PdfPrintParams&);
-static void setupPrinterAndPaper(RS_Graphic*, QPrinter&, PdfPrintParams&);
-static void drawGraphic(RS_Graphic *graphic, QPrinter &printer, RS_Painter &painter);
+static void setupPrinterAndPaper(RS_Graphic*, LC_PdfWriter&, PdfPrintParams&);
+static void drawGraphic(RS_Graphic *graphic, LC_PdfWriter &printer, RS_Painter &painter);
 
 void PdfPrintLoop::run(){
     if (params.outFile.isEmpty()) {
@@ -72,7 +74,7 @@ void PdfPrintLoop::printOneDxfToOnePdf(const QString& dxfFile) {
 
     touchGraphic(graphic, params);
 
-    QPrinter printer(QPrinter::HighResolution);
+    LC_PdfWriter printer(params.outFile);
 
     setupPrinterAndPaper(graphic, printer, params);
 
@@ -109,7 +111,7 @@ void PdfPrintLoop::printManyDxfToOnePdf() {
 
     // FIXME: Should probably open and print all dxf files in one 'for' loop.
     // Tried but failed to do this. It looks like some 'chicken and egg'
-    // situation for the QPrinter and RS_PainterQt. Therefore, first open
+    // situation for the output device and RS_PainterQt. Therefore, first open
     // all dxf files and apply required actions. Then run another 'for'
     // loop for actual printing.
     for (auto dxfFile : params.dxfFiles) {
@@ -125,7 +127,7 @@ void PdfPrintLoop::printManyDxfToOnePdf() {
         nrPages++;
     }
 
-    QPrinter printer(QPrinter::HighResolution);
+    LC_PdfWriter printer(params.outFile);
 
     if (nrPages > 0) {
         // FIXME: Is it possible to set up printer and paper for every
@@ -205,7 +207,7 @@ static void touchGraphic(RS_Graphic* graphic, PdfPrintParams& params){
     }
 }
 
-static void setupPrinterAndPaper(RS_Graphic* graphic, QPrinter& printer,
+static void setupPrinterAndPaper(RS_Graphic* graphic, LC_PdfWriter& printer,
     PdfPrintParams& params){
     bool landscape = false;
 
@@ -218,35 +220,20 @@ static void setupPrinterAndPaper(RS_Graphic* graphic, QPrinter& printer,
             RS2::Millimeter);
         if (landscape)
             s = s.flipXY();
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
         printer.setPageSize(QPageSize{QSizeF{s.x,s.y}, QPageSize::Millimeter});
-#else
-        printer.setPaperSize(QSizeF{s.x,s.y}, QPrinter::Millimeter);
-#endif
     } else {
-        printer.setPageSize(paperSize);
+        printer.setPageSize(QPageSize{paperSize});
     }
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
     printer.setPageOrientation(landscape ? QPageLayout::Landscape : QPageLayout::Portrait);
-#else
-    printer.setOrientation(landscape ? QPrinter::Landscape : QPrinter::Portrait);
-#endif
-
-    printer.setOutputFileName(params.outFile);
-    printer.setOutputFormat(QPrinter::PdfFormat);
     printer.setResolution(params.resolution);
-    printer.setFullPage(true);
-
-    if (params.grayscale)
-        printer.setColorMode(QPrinter::GrayScale);
-    else
-        printer.setColorMode(QPrinter::Color);
+    printer.setGrayscale(params.grayscale);
 }
 
 // fixme - sand - printing - refactor to separate class?
-static void drawGraphic(RS_Graphic* graphic, QPrinter& printer,
+static void drawGraphic(RS_Graphic* graphic, LC_PdfWriter& printer,
                         RS_Painter& painter){
+    LC_TRACE_SCOPE("export", "pdf page");
     double printerFx = (double)printer.width() / printer.widthMM();
     double printerFy = (double)printer.height() / printer.heightMM();
 
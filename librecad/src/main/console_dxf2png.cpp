@@ -50,6 +50,7 @@
 #include "rs_settings.h"
 #include "rs_system.h"
 #include "lc_printviewportrenderer.h"
+#include "lc_trace.h"
 
 
 ///////////////////////////////////////////////////////////////////////
@@ -138,6 +139,10 @@ int console_dxf2png(int argc, char* argv[])
         "Output PNG size (Width x Height) in pixels.", "WxH");
     parser.addOption(pngSizeOpt);
 
+    QCommandLineOption traceOpt(QStringList() << "trace",
+        "Write Chrome trace-event JSON with timings to the file.", "file");
+    parser.addOption(traceOpt);
+
     parser.addPositionalArgument("<dxf_files>", "Input DXF file");
 
     parser.process(app);
@@ -146,6 +151,9 @@ int console_dxf2png(int argc, char* argv[])
 
     if (args.isEmpty() || (args.size() == 1 && (args[0] == "dxf2png" || args[0] == "dxf2svg")))
         parser.showHelp(EXIT_FAILURE);
+    QString traceFile = parser.value(traceOpt);
+    LC_Trace::setEnabled(!traceFile.isEmpty());
+
     // Set PNG size from user input
     QSize pngSize = parsePngSizeArg(parser.value(pngSizeOpt)); // If nothing, use default values.
 
@@ -207,17 +215,25 @@ int console_dxf2png(int argc, char* argv[])
     }
 
     bool ret = false;
-    if (format.compare("SVG", Qt::CaseInsensitive) == 0) {
-        ret = LC_ActionFileExportMakerCam::writeSvg(outFile, *graphic);
-    } else {
-        QSize borders = QSize(5, 5);
-        bool black = false;
-        bool bw = false;
-        ret = slotFileExport(graphic, outFile, format, pngSize, borders,
-                       black, bw);
+    {
+        // the span must be closed before the trace is written
+        LC_TRACE_SCOPE("export", "image export");
+        LC_TRACE_COUNTER("export", "entities", graphic->count());
+        if (format.compare("SVG", Qt::CaseInsensitive) == 0) {
+            ret = LC_ActionFileExportMakerCam::writeSvg(outFile, *graphic);
+        } else {
+            QSize borders = QSize(5, 5);
+            bool black = false;
+            bool bw = false;
+            ret = slotFileExport(graphic, outFile, format, pngSize, borders,
+                           black, bw);
+        }
     }
 
     qDebug() << "Printing" << dxfFile << "to" << outFile << (ret ? "Done" : "Failed");
+    if (!traceFile.isEmpty()) {
+        LC_Trace::writeChromeTrace(traceFile);
+    }
     return 0;
 }
 
@@ -36,6 +36,7 @@
 #include "lc_actioncontext.h"
 #include "lc_containertraverser.h"
 #include "lc_documentsstorage.h"
+#include "lc_pluginbulkdata.h"
 #include "lc_splinepoints.h"
 #include "lc_undosection.h"
 #include "rs_actioninterface.h"
@@ -665,7 +666,8 @@ void Plugin_Entity::getPolylineData(QList<Plug_VertexData> *data){
 
     RS_Entity* nextEntity = 0;
 	RS_AtomicEntity* ae = nullptr;
-    RS_Entity* v = l->firstEntity(RS2::ResolveNone);
+    lc::LC_ContainerTraverser traverser{*l, RS2::ResolveNone};
+    RS_Entity* v = traverser.first();
     double bulge=0.0;
 //bad polyline without vertex
 	if (!v) return;
@@ -678,8 +680,7 @@ void Plugin_Entity::getPolylineData(QList<Plug_VertexData> *data){
     data->append(Plug_VertexData(QPointF(ae->getStartpoint().x,
                                          ae->getStartpoint().y),bulge));
 
-    lc::LC_ContainerTraverser traverser{*l, RS2::ResolveNone};
-    for (v=traverser.first(); v != nullptr; v=traverser.next()) {
+    for (; v != nullptr; v=nextEntity) {
         nextEntity = traverser.next();
         bulge = 0.0;
         if (!v->isAtomic()) {
@@ -788,6 +789,9 @@ Doc_plugin_interface::Doc_plugin_interface(LC_ActionContext* actionContext, QWid
 {
 }
 
+// defined here, as LC_UndoSection is incomplete in the header. An unbalanced transaction is finished here.
+Doc_plugin_interface::~Doc_plugin_interface() = default;
+
 bool Doc_plugin_interface::addToUndo(RS_Entity* current, RS_Entity* modified,
 				     DPI::Disposition how) {
     if (doc) {
@@ -1044,8 +1048,8 @@ QString Doc_plugin_interface::addBlockfromFromdisk(QString fullName){
         LC_DocumentsStorage storage;
         if (!storage.loadDocument(&g, fi.absoluteFilePath(), RS2::FormatUnknown)) {
         // if (!g.open(fi.absoluteFilePath(), RS2::FormatUnknown)) {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
-                            "Doc_plugin_interface::addBlockfromFromdisk: Cannot open file: %s", fullName.toStdString().c_str());
+            LC_DEBUG_PRINT_LEVEL(RS_Debug::D_WARNING,
+                                 "Doc_plugin_interface::addBlockfromFromdisk: Cannot open file: %s", fullName.toStdString().c_str());
             delete b;
 			return nullptr;
         }
@@ -1445,3 +1449,80 @@ QString Doc_plugin_interface::realToStr(const qreal num, const int units, const
     QString msg = RS_Units::formatLinear(num,RS2::None,lf,pr);
     return msg;
 }
+
+void Doc_plugin_interface::beginTransaction(){
+    if (doc == nullptr) {
+        RS_DEBUG->print("Doc_plugin_interface::beginTransaction: currentContainer is nullptr");
+        return;
+    }
+    if (m_transactionLevel++ == 0) {
+        m_transaction = std::make_unique<LC_UndoSection>(doc, gView->getViewPort());
+    }
+}
+
+void Doc_plugin_interface::commitTransaction(){
+    if (m_transactionLevel == 0) {
+        RS_DEBUG->print(RS_Debug::D_WARNING, "Doc_plugin_interface::commitTransaction: no transaction started");
+        return;
+    }
+    if (--m_transactionLevel == 0) {
+        m_transaction.reset();
+        gView->redraw(RS2::RedrawDrawing);
+    }
+}
+
+void Doc_plugin_interface::addBulkPoints(const Plug_BulkPoints& points){
+    if (doc == nullptr) {
+        RS_DEBUG->print("%s: currentContainer is nullptr", __func__);
+        return;
+    }
+    addBulkEntities(LC_PluginBulkData::createPoints(doc, docGr, points));
+}
+
+void Doc_plugin_interface::addBulkLines(const Plug_BulkLines& lines){
+    if (doc == nullptr) {
+        RS_DEBUG->print("%s: currentContainer is nullptr", __func__);
+        return;
+    }
+    addBulkEntities(LC_PluginBulkData::createLines(doc, docGr, lines));
+}
+
+void Doc_plugin_interface::addBulkPolylines(const Plug_BulkPolylines& polylines){
+    if (doc == nullptr) {
+        RS_DEBUG->print("%s: currentContainer is nullptr", __func__);
+        return;
+    }
+    addBulkEntities(LC_PluginBulkData::createPolylines(doc, docGr, polylines));
+}
+
+void Doc_plugin_interface::addBulkEntities(const std::vector<RS_Entity*>& entities){
+    LC_UndoSection undo(doc, gView->getViewPort());
+    for (RS_Entity* entity: entities) {
+        doc->addEntity(entity);
+        undo.addUndoable(entity);
+    }
+}
+
+void Doc_plugin_interface::getBulkPoints(Plug_BulkPoints* points, bool visible){
+    if (doc == nullptr) {
+        RS_DEBUG->print("%s: currentContainer is nullptr", __func__);
+        return;
+    }
+    LC_PluginBulkData::readPoints(*doc, points, visible);
+}
+
+void Doc_plugin_interface::getBulkLines(Plug_BulkLines* lines, bool visible){
+    if (doc == nullptr) {
+        RS_DEBUG->print("%s: currentContainer is nullptr", __func__);
+        return;
+    }
+    LC_PluginBulkData::readLines(*doc, lines, visible);
+}
+
+void Doc_plugin_interface::getBulkPolylines(Plug_BulkPolylines* polylines, bool visible){
+    if (doc == nullptr) {
+        RS_DEBUG->print("%s: currentContainer is nullptr", __func__);
+        return;
+    }
+    LC_PluginBulkData::readPolylines(*doc, polylines, visible);
+}
@@ -26,12 +26,15 @@
 #ifndef DOC_PLUGIN_INTERFACE_H
 #define DOC_PLUGIN_INTERFACE_H
 
+#include <memory>
+
 #include <QObject>
 
 #include "document_interface.h"
 #include "rs_graphic.h"
 
 class LC_ActionContext;
+class LC_UndoSection;
 class Doc_plugin_interface;
 
 class convLTW
@@ -77,6 +80,7 @@ class Doc_plugin_interface : public Document_Interface
 {
 public:
     Doc_plugin_interface(LC_ActionContext* actionContext, QWidget* parent);
+    ~Doc_plugin_interface() override;
     void updateView() override;
     void addPoint(QPointF *start) override;
     void addLine(QPointF *start, QPointF *end) override;
@@ -129,6 +133,15 @@ public:
     bool getString(QString *txt, const QString& message, const QString& title) override;
     QString realToStr(const qreal num, const int units = 0, const int prec = 0) override;
 
+    void beginTransaction() override;
+    void commitTransaction() override;
+    void addBulkPoints(const Plug_BulkPoints& points) override;
+    void addBulkLines(const Plug_BulkLines& lines) override;
+    void addBulkPolylines(const Plug_BulkPolylines& polylines) override;
+    void getBulkPoints(Plug_BulkPoints* points, bool visible = false) override;
+    void getBulkLines(Plug_BulkLines* lines, bool visible = false) override;
+    void getBulkPolylines(Plug_BulkPolylines* polylines, bool visible = false) override;
+
     //method to handle undo in Plugin_Entity 
     bool addToUndo(RS_Entity* current, RS_Entity* modified, DPI::Disposition how);
 private:
@@ -140,12 +153,17 @@ private:
     // Usage: Call with QC_ActionGetSelect instance, type, message, and sel list.
     // Example: performSelect(a, RS2::EntityType::EntityLine, "Select lines", sel);
     bool  performSelect(RS2::EntityType typeToSelect, const QString& message, QList<Plug_Entity *>* sel, bool clearSel = true);
+    // adds entities created from bulk data as a single undo step
+    void addBulkEntities(const std::vector<RS_Entity*>& entities);
 
     RS_Document *doc;
     RS_Graphic *docGr;
     RS_GraphicView *gView;
     QWidget* main_window;
     LC_ActionContext* m_actionContext;
+    // undo cycle of the outermost open transaction
+    std::unique_ptr<LC_UndoSection> m_transaction;
+    int m_transactionLevel = 0;
 };
 
 /*void addArc(QPointF *start);			->Without start
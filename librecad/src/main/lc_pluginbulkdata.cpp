@@ -0,0 +1,235 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_pluginbulkdata.h"
+
+#include <algorithm>
+
+#include "document_interface.h"
+#include "rs_arc.h"
+#include "rs_graphic.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_point.h"
+#include "rs_polyline.h"
+
+std::vector<RS_Layer*> LC_PluginBulkData::resolveLayers(RS_Graphic* graphic, const QStringList& names) {
+    std::vector<RS_Layer*> layers;
+    if (graphic == nullptr) {
+        return layers;
+    }
+    layers.reserve(names.size());
+    RS_LayerList* layerList = graphic->getLayerList();
+    for (const QString& name: names) {
+        RS_Layer* layer = layerList->find(name);
+        if (layer == nullptr) {
+            layer = new RS_Layer(name);
+            graphic->addLayer(layer);
+        }
+        layers.push_back(layer);
+    }
+    return layers;
+}
+
+void LC_PluginBulkData::applyAttributes(RS_Entity* entity, const Plug_BulkAttributes& attributes, size_t index,
+                                        const std::vector<RS_Layer*>& layers) {
+    if (index < attributes.layer.size()) {
+        int layerIndex = attributes.layer[index];
+        if (layerIndex >= 0 && layerIndex < static_cast<int>(layers.size())) {
+            entity->setLayer(layers[layerIndex]);
+        }
+    }
+    bool hasColor = index < attributes.color.size();
+    bool hasWidth = index < attributes.lineWidth.size();
+    bool hasType = index < attributes.lineType.size();
+    if (hasColor || hasWidth || hasType) {
+        RS_Pen pen = entity->getPen(false);
+        if (hasColor) {
+            RS_Color color;
+            color.fromIntColor(attributes.color[index]);
+            pen.setColor(color);
+        }
+        if (hasWidth) {
+            pen.setWidth(static_cast<RS2::LineWidth>(attributes.lineWidth[index]));
+        }
+        if (hasType) {
+            pen.setLineType(static_cast<RS2::LineType>(attributes.lineType[index]));
+        }
+        entity->setPen(pen);
+    }
+}
+
+void LC_PluginBulkData::readAttributes(const RS_Entity* entity, Plug_BulkAttributes* attributes,
+                                       QHash<RS_Layer*, int>& layerIndexes) {
+    RS_Layer* layer = entity->getLayer();
+    int layerIndex = -1;
+    if (layer != nullptr) {
+        auto it = layerIndexes.constFind(layer);
+        if (it == layerIndexes.cend()) {
+            layerIndex = attributes->layerNames.size();
+            attributes->layerNames.append(layer->getName());
+            layerIndexes.insert(layer, layerIndex);
+        }
+        else {
+            layerIndex = it.value();
+        }
+    }
+    attributes->layer.push_back(layerIndex);
+    const RS_Pen& pen = entity->getPen(false);
+    attributes->color.push_back(pen.getColor().toIntColor());
+    attributes->lineWidth.push_back(static_cast<int>(pen.getWidth()));
+    attributes->lineType.push_back(static_cast<int>(pen.getLineType()));
+    attributes->id.push_back(entity->getId());
+}
+
+bool LC_PluginBulkData::isReadable(const RS_Entity* entity, int rtti, bool visible) {
+    return entity->rtti() == rtti && !entity->isUndone() && (!visible || entity->isVisible());
+}
+
+std::vector<RS_Entity*> LC_PluginBulkData::createPoints(RS_EntityContainer* parent, RS_Graphic* graphic,
+                                                        const Plug_BulkPoints& points) {
+    size_t count = std::min(points.x.size(), points.y.size());
+    std::vector<RS_Layer*> layers = resolveLayers(graphic, points.layerNames);
+    std::vector<RS_Entity*> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto* entity = new RS_Point(parent, RS_PointData(RS_Vector(points.x[i], points.y[i])));
+        applyAttributes(entity, points, i, layers);
+        result.push_back(entity);
+    }
+    return result;
+}
+
+std::vector<RS_Entity*> LC_PluginBulkData::createLines(RS_EntityContainer* parent, RS_Graphic* graphic,
+                                                       const Plug_BulkLines& lines) {
+    size_t count = std::min({lines.startX.size(), lines.startY.size(), lines.endX.size(), lines.endY.size()});
+    std::vector<RS_Layer*> layers = resolveLayers(graphic, lines.layerNames);
+    std::vector<RS_Entity*> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto* entity = new RS_Line{parent, RS_Vector(lines.startX[i], lines.startY[i]),
+                                   RS_Vector(lines.endX[i], lines.endY[i])};
+        applyAttributes(entity, lines, i, layers);
+        result.push_back(entity);
+    }
+    return result;
+}
+
+std::vector<RS_Entity*> LC_PluginBulkData::createPolylines(RS_EntityContainer* parent, RS_Graphic* graphic,
+                                                           const Plug_BulkPolylines& polylines) {
+    size_t verticesCount = std::min(polylines.x.size(), polylines.y.size());
+    std::vector<RS_Layer*> layers = resolveLayers(graphic, polylines.layerNames);
+    std::vector<RS_Entity*> result;
+    result.reserve(polylines.size());
+    for (size_t i = 0; i < polylines.size(); ++i) {
+        size_t first = polylines.vertexStart[i];
+        size_t last = i + 1 < polylines.size() ? polylines.vertexStart[i + 1] : verticesCount;
+        last = std::min(last, verticesCount);
+        if (first >= last) {
+            continue;
+        }
+        RS_PolylineData data;
+        bool closed = i < polylines.closed.size() && polylines.closed[i];
+        if (closed) {
+            data.setFlag(RS2::FlagClosed);
+        }
+        auto* entity = new RS_Polyline(parent, data);
+        for (size_t v = first; v < last; ++v) {
+            double bulge = v < polylines.bulge.size() ? polylines.bulge[v] : 0.0;
+            entity->addVertex(RS_Vector(polylines.x[v], polylines.y[v]), bulge);
+        }
+        if (closed) {
+            entity->endPolyline();
+        }
+        applyAttributes(entity, polylines, i, layers);
+        result.push_back(entity);
+    }
+    return result;
+}
+
+void LC_PluginBulkData::readPoints(const RS_EntityContainer& container, Plug_BulkPoints* points, bool visible) {
+    QHash<RS_Layer*, int> layerIndexes;
+    for (RS_Entity* e: container) {
+        if (!isReadable(e, RS2::EntityPoint, visible)) {
+            continue;
+        }
+        const RS_Vector& pos = static_cast<RS_Point*>(e)->getPos();
+        points->x.push_back(pos.x);
+        points->y.push_back(pos.y);
+        readAttributes(e, points, layerIndexes);
+    }
+}
+
+void LC_PluginBulkData::readLines(const RS_EntityContainer& container, Plug_BulkLines* lines, bool visible) {
+    QHash<RS_Layer*, int> layerIndexes;
+    for (RS_Entity* e: container) {
+        if (!isReadable(e, RS2::EntityLine, visible)) {
+            continue;
+        }
+        const RS_LineData& data = static_cast<RS_Line*>(e)->getData();
+        lines->startX.push_back(data.startpoint.x);
+        lines->startY.push_back(data.startpoint.y);
+        lines->endX.push_back(data.endpoint.x);
+        lines->endY.push_back(data.endpoint.y);
+        readAttributes(e, lines, layerIndexes);
+    }
+}
+
+void LC_PluginBulkData::readPolylines(const RS_EntityContainer& container, Plug_BulkPolylines* polylines,
+                                      bool visible) {
+    QHash<RS_Layer*, int> layerIndexes;
+    auto bulgeOf = [](RS_Entity* segment) {
+        return segment->rtti() == RS2::EntityArc ? static_cast<RS_Arc*>(segment)->getBulge() : 0.0;
+    };
+    for (RS_Entity* e: container) {
+        if (!isReadable(e, RS2::EntityPolyline, visible)) {
+            continue;
+        }
+        auto* polyline = static_cast<RS_Polyline*>(e);
+        std::vector<RS_Entity*> segments;
+        segments.reserve(polyline->count());
+        for (RS_Entity* segment: *polyline) {
+            if (segment->isAtomic()) {
+                segments.push_back(segment);
+            }
+        }
+        if (segments.empty()) {
+            continue;
+        }
+        polylines->vertexStart.push_back(polylines->x.size());
+        polylines->closed.push_back(polyline->isClosed());
+
+        // same layout as Plugin_Entity::getPolylineData(): bulge of a vertex belongs to the segment starting there
+        RS_Vector start = segments.front()->getStartpoint();
+        polylines->x.push_back(start.x);
+        polylines->y.push_back(start.y);
+        polylines->bulge.push_back(bulgeOf(segments.front()));
+        size_t lastVertex = polyline->isClosed() ? segments.size() - 1 : segments.size();
+        for (size_t i = 0; i < lastVertex; ++i) {
+            RS_Vector end = segments[i]->getEndpoint();
+            polylines->x.push_back(end.x);
+            polylines->y.push_back(end.y);
+            polylines->bulge.push_back(i + 1 < segments.size() ? bulgeOf(segments[i + 1]) : 0.0);
+        }
+        readAttributes(e, polylines, layerIndexes);
+    }
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_PLUGINBULKDATA_H
+#define LC_PLUGINBULKDATA_H
+
+#include <vector>
+
+#include <QHash>
+#include <QStringList>
+
+class Plug_BulkAttributes;
+class Plug_BulkLines;
+class Plug_BulkPoints;
+class Plug_BulkPolylines;
+class RS_Entity;
+class RS_EntityContainer;
+class RS_Graphic;
+class RS_Layer;
+
+/**
+ * Conversion between entities and columnar bulk data of the plugin interface.
+ *
+ * Entities are created for the given parent, but are not added to it, so the caller decides how they are
+ * added and undone. Layers referenced by bulk attributes are resolved once per call, missing layers are
+ * added to the graphic. Reading collects direct children of the container only.
+ */
+class LC_PluginBulkData {
+public:
+    static std::vector<RS_Entity*> createPoints(RS_EntityContainer* parent, RS_Graphic* graphic,
+                                                const Plug_BulkPoints& points);
+    static std::vector<RS_Entity*> createLines(RS_EntityContainer* parent, RS_Graphic* graphic,
+                                               const Plug_BulkLines& lines);
+    static std::vector<RS_Entity*> createPolylines(RS_EntityContainer* parent, RS_Graphic* graphic,
+                                                   const Plug_BulkPolylines& polylines);
+
+    static void readPoints(const RS_EntityContainer& container, Plug_BulkPoints* points, bool visible);
+    static void readLines(const RS_EntityContainer& container, Plug_BulkLines* lines, bool visible);
+    static void readPolylines(const RS_EntityContainer& container, Plug_BulkPolylines* polylines, bool visible);
+
+private:
+    static std::vector<RS_Layer*> resolveLayers(RS_Graphic* graphic, const QStringList& names);
+    static void applyAttributes(RS_Entity* entity, const Plug_BulkAttributes& attributes, size_t index,
+                                const std::vector<RS_Layer*>& layers);
+    static void readAttributes(const RS_Entity* entity, Plug_BulkAttributes* attributes,
+                               QHash<RS_Layer*, int>& layerIndexes);
+    static bool isReadable(const RS_Entity* entity, int rtti, bool visible);
+};
+
+#endif // LC_PLUGINBULKDATA_H
@@ -49,6 +49,7 @@
 #include "main.h"
 
 #include "lc_iconcolorsoptions.h"
+#include "lc_trace.h"
 #include "qc_applicationwindow.h"
 #include "qg_dlginitial.h"
 #include "rs_debug.h"
@@ -103,6 +104,7 @@ int showHelpMessage() {
     qDebug()<<"";
     qDebug()<<"  -h, --help\tdisplay this message";
     qDebug()<<"  -d, --debug <level>";
+    qDebug()<<"  --trace <file>\twrite Chrome trace-event JSON with timings to the file on exit";
     qDebug()<<"";
     RS_DEBUG->print( RS_Debug::D_NOTHING, "possible debug levels:");
     RS_DEBUG->print( RS_Debug::D_NOTHING, "    %d Nothing", RS_Debug::D_NOTHING);
@@ -179,7 +181,7 @@ void loadIconsStylingOptions() {
     iconColorsOptions.applyOptions();
 }
 
-int execApplication(LC_Application& app) {
+int execApplication(LC_Application& app, const QString& traceFile) {
     RS_DEBUG->print("main: entering Qt event loop");
     QCoreApplication::processEvents();
 
@@ -187,6 +189,10 @@ int execApplication(LC_Application& app) {
 
     RS_DEBUG->print("main: exited Qt event loop");
 
+    if (!traceFile.isEmpty()) {
+        LC_Trace::writeChromeTrace(traceFile);
+    }
+
     // Destroy the singleton
     QC_ApplicationWindow::getAppWindow().reset();
     return return_code;
@@ -303,6 +309,7 @@ int main(int argc, char** argv) {
 
     bool allowOptions=true;
     QList<int> argClean;
+    QString traceFile;
 
     for (int i=0; i<argc; i++)   {
         QString argstr(argv[i]);
@@ -315,6 +322,22 @@ int main(int argc, char** argv) {
                              help1.compare(argstr, Qt::CaseInsensitive)==0 )) {
             return showHelpMessage();
         }
+        const QString traceSwitch("--trace"), traceAssign("--trace=");
+        if (allowOptions && (traceSwitch.compare(argstr, Qt::CaseInsensitive)==0 ||
+                             argstr.startsWith(traceAssign, Qt::CaseInsensitive))) {
+            // --trace <file> or --trace=<file>
+            argClean<<i;
+            if (argstr.size() > traceSwitch.size()) {
+                traceFile = argstr.mid(traceAssign.size());
+            }
+            else if (i+1<argc) {
+                ++i;
+                traceFile = QFile::decodeName(argv[i]);
+                argClean<<i;
+            }
+            LC_Trace::setEnabled(!traceFile.isEmpty());
+            continue;
+        }
         const QString lpDebugSwitch0("-d"),lpDebugSwitch1("--debug") ;
 
         if (allowOptions&& (argstr.startsWith(lpDebugSwitch0, Qt::CaseInsensitive) ||
@@ -447,7 +470,7 @@ int main(int argc, char** argv) {
     }
     LC_GROUP_END();
 
-    return execApplication(app);
+    return execApplication(app, traceFile);
 #    endif
 }
 #endif // BUILD_TESTS
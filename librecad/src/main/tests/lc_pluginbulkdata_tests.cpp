@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include <QStandardPaths>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "document_interface.h"
+#include "lc_pluginbulkdata.h"
+#include "rs_graphic.h"
+#include "rs_layer.h"
+#include "rs_settings.h"
+
+namespace {
+void initSettings() {
+    if (RS_Settings::instance() == nullptr) {
+        // keeps settings of tests out of the user settings
+        QStandardPaths::setTestModeEnabled(true);
+        RS_Settings::init("LibreCAD", "librecad_tests");
+    }
+}
+
+void requireClose(const std::vector<double>& actual, const std::vector<double>& expected) {
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        REQUIRE(std::abs(actual[i] - expected[i]) < 1e-9);
+    }
+}
+
+void addAll(RS_Graphic& graphic, const std::vector<RS_Entity*>& entities) {
+    for (RS_Entity* entity : entities) {
+        graphic.addEntity(entity);
+    }
+}
+}
+
+TEST_CASE("LC_PluginBulkData creates and reads points and lines", "[LC_PluginBulkData]") {
+    initSettings();
+    RS_Graphic graphic;
+
+    Plug_BulkPoints points;
+    points.x = {1., 2., 3.};
+    points.y = {4., 5., 6.};
+    points.layerNames = {"survey"};
+    points.layer = {0, 0, 0};
+    points.color = {0x102030, -1, -2};
+    std::vector<RS_Entity*> created = LC_PluginBulkData::createPoints(&graphic, &graphic, points);
+    REQUIRE(created.size() == 3);
+    // missing layers are added
+    RS_Layer* survey = graphic.findLayer("survey");
+    REQUIRE(survey != nullptr);
+    REQUIRE(created.front()->getLayer() == survey);
+    addAll(graphic, created);
+
+    Plug_BulkLines lines;
+    lines.startX = {0., 10.};
+    lines.startY = {0., 10.};
+    lines.endX = {5., 15.};
+    // shortest array limits the number of entities
+    lines.endY = {5.};
+    addAll(graphic, LC_PluginBulkData::createLines(&graphic, &graphic, lines));
+
+    Plug_BulkPoints readPoints;
+    LC_PluginBulkData::readPoints(graphic, &readPoints, false);
+    REQUIRE(readPoints.size() == 3);
+    REQUIRE(readPoints.x == points.x);
+    REQUIRE(readPoints.y == points.y);
+    REQUIRE(readPoints.layerNames == QStringList{"survey"});
+    REQUIRE(readPoints.layer == std::vector<int>{0, 0, 0});
+    REQUIRE(readPoints.color == points.color);
+    REQUIRE(readPoints.id.size() == 3);
+    REQUIRE(readPoints.id.front() == created.front()->getId());
+
+    Plug_BulkLines readLines;
+    LC_PluginBulkData::readLines(graphic, &readLines, false);
+    REQUIRE(readLines.size() == 1);
+    REQUIRE(readLines.startX.front() == 0.);
+    REQUIRE(readLines.endX.front() == 5.);
+    REQUIRE(readLines.endY.front() == 5.);
+
+    SECTION("undone and invisible entities") {
+        created[0]->setUndoState(true);
+        created[1]->setVisible(false);
+        Plug_BulkPoints visiblePoints;
+        LC_PluginBulkData::readPoints(graphic, &visiblePoints, true);
+        REQUIRE(visiblePoints.x == std::vector<double>{3.});
+        Plug_BulkPoints allPoints;
+        LC_PluginBulkData::readPoints(graphic, &allPoints, false);
+        REQUIRE(allPoints.x == std::vector<double>{2., 3.});
+    }
+}
+
+TEST_CASE("LC_PluginBulkData round trips polylines", "[LC_PluginBulkData]") {
+    initSettings();
+    RS_Graphic graphic;
+
+    Plug_BulkPolylines polylines;
+    // open polyline with an arc segment, closed square and two polylines without vertices
+    polylines.vertexStart = {0, 3, 7, 7};
+    polylines.closed = {false, true, false, false};
+    polylines.x = {0., 10., 20., 0., 10., 10., 0.};
+    polylines.y = {0., 0., 0., 0., 0., 10., 10.};
+    polylines.bulge = {0., 1., 0., 0., 0., 0., 0.};
+    polylines.lineWidth = {static_cast<int>(RS2::Width05), static_cast<int>(RS2::Width10)};
+    std::vector<RS_Entity*> created = LC_PluginBulkData::createPolylines(&graphic, &graphic, polylines);
+    // polylines without vertices are skipped
+    REQUIRE(created.size() == 2);
+    addAll(graphic, created);
+
+    Plug_BulkPolylines read;
+    LC_PluginBulkData::readPolylines(graphic, &read, false);
+    REQUIRE(read.size() == 2);
+    REQUIRE(read.vertexStart == std::vector<size_t>{0, 3});
+    REQUIRE(read.closed == std::vector<bool>{false, true});
+    requireClose(read.x, polylines.x);
+    requireClose(read.y, polylines.y);
+    requireClose(read.bulge, polylines.bulge);
+    REQUIRE(read.lineWidth == polylines.lineWidth);
+}
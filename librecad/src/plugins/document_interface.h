@@ -27,6 +27,7 @@
 #define DOCUMENT_INTERFACE_H
 
 #include <QPointF>
+#include <QStringList>
 #include <QVariant>
 #include<vector>
 //#include <QColor>
@@ -198,6 +199,68 @@ public:
     double bulge;
 };
 
+//! Per-entity attributes of bulk data.
+/*!
+ *  Each array is either empty or has one value per entity. When adding entities,
+ *  an empty array means the current layer and attributes are used.
+ *  When reading, all arrays are filled.
+ */
+class Plug_BulkAttributes
+{
+public:
+    //! names of layers referenced by layer
+    QStringList layerNames;
+    //! index of entity layer in layerNames
+    std::vector<int> layer;
+    //! -1 ByLayer, -2 ByBlock, other 24 bit RGB color
+    std::vector<int> color;
+    //! DPI::LineWidth values
+    std::vector<int> lineWidth;
+    //! DPI::LineType values
+    std::vector<int> lineType;
+    //! entity identifiers, filled on reading only
+    std::vector<qulonglong> id;
+};
+
+//! Point entities as flat coordinate arrays.
+class Plug_BulkPoints : public Plug_BulkAttributes
+{
+public:
+    size_t size() const {return x.size();}
+    std::vector<double> x;
+    std::vector<double> y;
+};
+
+//! Line entities as flat coordinate arrays.
+class Plug_BulkLines : public Plug_BulkAttributes
+{
+public:
+    size_t size() const {return startX.size();}
+    std::vector<double> startX;
+    std::vector<double> startY;
+    std::vector<double> endX;
+    std::vector<double> endY;
+};
+
+//! Polyline entities as flat vertex arrays.
+/*!
+ *  Vertices of polyline i are stored in x, y and bulge from vertexStart[i]
+ *  up to vertexStart[i+1] (or the end of arrays for the last polyline).
+ *  Attributes and closed flags are per polyline.
+ */
+class Plug_BulkPolylines : public Plug_BulkAttributes
+{
+public:
+    size_t size() const {return vertexStart.size();}
+    std::vector<size_t> vertexStart;
+    //! empty means all polylines are open
+    std::vector<bool> closed;
+    std::vector<double> x;
+    std::vector<double> y;
+    //! empty means all segments are straight
+    std::vector<double> bulge;
+};
+
 //! Wrapper for access entities from plugins.
  /*!
  *  Wrapper class for create, access and modify entities from plugins.
@@ -526,6 +589,52 @@ public:
     * \return a string with the converted number.
     */
     virtual QString realToStr(const qreal num, const int units = 0, const int prec = 0) = 0;
+
+    //! Start a transaction.
+    /*! All entities added or removed until commitTransaction() form a single undo step
+    *  and the view is updated once on commit. Transactions may be nested, only the
+    *  outermost commitTransaction() finishes the undo step.
+    */
+    virtual void beginTransaction() = 0;
+
+    //! Commit the transaction started by beginTransaction().
+    virtual void commitTransaction() = 0;
+
+    //! Add point entities to current document.
+    /*! All points are added as a single undo step.
+    *  \param points coordinates and optional attributes of points
+    */
+    virtual void addBulkPoints(const Plug_BulkPoints& points) = 0;
+
+    //! Add line entities to current document.
+    /*! All lines are added as a single undo step.
+    *  \param lines coordinates and optional attributes of lines
+    */
+    virtual void addBulkLines(const Plug_BulkLines& lines) = 0;
+
+    //! Add polyline entities to current document.
+    /*! All polylines are added as a single undo step.
+    *  \param polylines vertices and optional attributes of polylines
+    */
+    virtual void addBulkPolylines(const Plug_BulkPolylines& polylines) = 0;
+
+    //! Read all point entities of current document.
+    /*! \param points receives coordinates and attributes of points
+    *  \param visible if true, only visible entities are read
+    */
+    virtual void getBulkPoints(Plug_BulkPoints* points, bool visible = false) = 0;
+
+    //! Read all line entities of current document.
+    /*! \param lines receives coordinates and attributes of lines
+    *  \param visible if true, only visible entities are read
+    */
+    virtual void getBulkLines(Plug_BulkLines* lines, bool visible = false) = 0;
+
+    //! Read all polyline entities of current document.
+    /*! \param polylines receives vertices and attributes of polylines
+    *  \param visible if true, only visible entities are read
+    */
+    virtual void getBulkPolylines(Plug_BulkPolylines* polylines, bool visible = false) = 0;
 };
 
 
@@ -338,13 +338,17 @@ HEADERS += \
     actions/drawing/selection/lc_actionsingleentityselectbase.h \
     lib/actions/lc_actioninfomessagebuilder.h \
     lib/actions/lc_overlayboxaction.h \
+    lib/actions/lc_snapengine.h \
     lib/engine/document/container/lc_pathbuilder.h \
+    lib/engine/document/container/lc_regenscheduler.h \
     lib/engine/document/dimstyles/lc_dimstyle.h \
     lib/engine/document/dimstyles/lc_dimstyleslist.h \
+    lib/engine/document/dimstyles/lc_dimregencontext.h \
     lib/engine/document/dimstyles/lc_dimarrowregistry.h \
     lib/engine/document/dimstyles/lc_dimstyletovariablesmapper.h \
     lib/engine/document/entities/lc_extentitydata.h \
     lib/engine/document/container/lc_containertraverser.h \
+    lib/engine/document/container/lc_contourclassifier.h \
     lib/engine/document/entities/lc_mleader.h \
     lib/engine/document/entities/lc_splinehelper.h \
     lib/engine/document/entities/lc_tolerance.h \
@@ -362,6 +366,7 @@ HEADERS += \
     lib/engine/document/entities/support/lc_dimarrowblock.h \
     lib/engine/document/entities/support/lc_dimarrowblockpoly.h \
     lib/engine/document/lc_graphicvariables.h \
+    lib/engine/document/lc_selectionregistry.h \
     lib/engine/document/textstyles/lc_textstyle.h \
     lib/engine/document/textstyles/lc_textstylelist.h \
     lib/engine/document/ucs/lc_ucslist.h \
@@ -378,6 +383,7 @@ HEADERS += \
     lib/actions/rs_snapper.h \
     lib/creation/rs_creation.h \
     lib/debug/rs_debug.h \
+    lib/debug/lc_trace.h \
     lib/engine/document/ucs/lc_ucs.h \
     lib/engine/document/views/lc_view.h \
     lib/engine/document/views/lc_viewslist.h \
@@ -451,13 +457,16 @@ HEADERS += \
     lib/engine/undo/rs_undocycle.h \
     lib/engine/rs_units.h \
     lib/engine/lc_drawable.h \
+    lib/engine/utils/lc_imagecache.h \
     lib/engine/utils/lc_rectregion.h \
     lib/engine/utils/rs_utility.h \
     lib/engine/document/variables/rs_variable.h \
     lib/engine/document/variables/rs_variabledict.h \
     lib/engine/rs_vector.h \
     lib/fileio/rs_fileio.h \
+    lib/fileio/lc_documentcache.h \
     lib/fileio/lc_filenameselectionservice.h \
+    lib/fileio/lc_importmonitor.h \
     lib/filters/lc_hyperbolaspline.h \
     lib/filters/rs_filtercxf.h \
     lib/filters/rs_filterdxfrw.h \
@@ -467,6 +476,8 @@ HEADERS += \
     lib/filters/rs_filterinterface.h \
     lib/generators/layers/lc_layersexporter.h \
     lib/generators/image/lc_imageexporter.h \
+    lib/generators/image/lc_pngstripwriter.h \
+    lib/generators/image/lc_tiffstripwriter.h \
     lib/gui/lc_coordinates_parser.h \
     lib/gui/lc_eventhandler.h \
     lib/gui/lc_graphicviewport.h \
@@ -474,8 +485,11 @@ HEADERS += \
     lib/gui/lc_latecompletionrequestor.h \
     lib/gui/render/headless/lc_printviewportrenderer.h \
     lib/gui/render/lc_graphicviewportrenderer.h \
+    lib/gui/render/lc_screenpath.h \
+    lib/gui/render/lc_screentransform.h \
     lib/math/lc_quadraticutils.h \
     lib/modification/lc_division.h \
+    lib/modification/lc_intersectionsweep.h \
     plugins/lc_plugininvoker.h \
     lib/actions/lc_actioncontext.h \
     ui/components/creators/lc_creatorinvoker.h \
@@ -522,6 +536,8 @@ HEADERS += \
     ui/dock_widgets/lc_graphicviewawarewidget.h \
     ui/dock_widgets/lc_widgets_common.h \
     #ui/dock_widgets/library_widget/lc_librarywidget.h \
+    ui/dock_widgets/library_widget/lc_librarythumbnailcache.h \
+    ui/dock_widgets/library_widget/lc_librarythumbnailgenerator.h \
     ui/lc_actionhandlerfactory.h \
     ui/lc_graphicviewaware.h \
     ui/lc_snapmanager.h \
@@ -531,6 +547,7 @@ HEADERS += \
     ui/main/support/lc_appwindowdialogsinvoker.h \
     ui/main/lc_appwindowaware.h \
     ui/main/lc_defaultactioncontext.h \
+    ui/main/persistence/lc_documentloader.h \
     ui/main/persistence/lc_documentsstorage.h \
     lib/gui/render/widget/lc_graphicviewrenderer.cpp \
     lib/gui/render/widget/lc_printpreviewviewrenderer.cpp \
@@ -606,7 +623,9 @@ HEADERS += \
     lib/generators/makercamsvg/lc_xmlwriterqxmlstreamwriter.h \
     lib/engine/document/entities/lc_rect.h \
     lib/engine/utils/lc_rtree.h \
+    lib/engine/utils/lc_segmentindex.h \
     lib/engine/undo/lc_undosection.h \
+    lib/printing/lc_pdfwriter.h \
     lib/printing/lc_printing.h \
     main/lc_application.h \
     ui/action_options/curve/lc_ellipsearcoptions.h \
@@ -655,13 +674,17 @@ SOURCES += \
     actions/drawing/selection/lc_actionsingleentityselectbase.cpp \
     lib/actions/lc_actioninfomessagebuilder.cpp \
     lib/actions/lc_overlayboxaction.cpp \
+    lib/actions/lc_snapengine.cpp \
     lib/engine/document/container/lc_pathbuilder.cpp \
+    lib/engine/document/container/lc_regenscheduler.cpp \
     lib/engine/document/dimstyles/lc_dimstyle.cpp \
     lib/engine/document/dimstyles/lc_dimstyleslist.cpp \
+    lib/engine/document/dimstyles/lc_dimregencontext.cpp \
     lib/engine/document/dimstyles/lc_dimarrowregistry.cpp \
     lib/engine/document/dimstyles/lc_dimstyletovariablesmapper.cpp \
     lib/engine/document/entities/lc_extentitydata.cpp \
     lib/engine/document/container/lc_containertraverser.cpp \
+    lib/engine/document/container/lc_contourclassifier.cpp \
     lib/engine/document/entities/lc_mleader.cpp \
     lib/engine/document/entities/lc_splinehelper.cpp \
     lib/engine/document/entities/lc_tolerance.cpp \
@@ -679,6 +702,7 @@ SOURCES += \
     lib/engine/document/entities/support/lc_dimarrowblock.cpp \
     lib/engine/document/entities/support/lc_dimarrowblockpoly.cpp \
     lib/engine/document/lc_graphicvariables.cpp \
+    lib/engine/document/lc_selectionregistry.cpp \
     lib/engine/document/textstyles/lc_textstyle.cpp \
     lib/engine/document/textstyles/lc_textstylelist.cpp \
     lib/engine/document/ucs/lc_ucslist.cpp \
@@ -693,10 +717,13 @@ SOURCES += \
     lib/engine/overlays/ucs_mark/lc_ucs_mark.cpp \
     lib/engine/settings/lc_settingsexporter.cpp \
     lib/engine/undo/lc_undoablerelzero.cpp \
+    lib/engine/utils/lc_imagecache.cpp \
     lib/engine/utils/lc_rectregion.cpp \
     lib/filters/lc_hyperbolaspline.cpp \
     lib/generators/layers/lc_layersexporter.cpp \
     lib/generators/image/lc_imageexporter.cpp \
+    lib/generators/image/lc_pngstripwriter.cpp \
+    lib/generators/image/lc_tiffstripwriter.cpp \
     lib/gui/lc_coordinates_parser.cpp \
     lib/gui/lc_eventhandler.cpp \
     lib/gui/lc_graphicviewport.cpp \
@@ -705,6 +732,7 @@ SOURCES += \
     lib/gui/render/headless/lc_printviewportrenderer.cpp \
     lib/math/lc_quadraticutils.cpp \
     lib/modification/lc_division.cpp \
+    lib/modification/lc_intersectionsweep.cpp \
     plugins/lc_plugininvoker.cpp \
     lib/actions/lc_actioncontext.cpp \
     ui/components/creators/lc_creatorinvoker.cpp \
@@ -748,6 +776,8 @@ SOURCES += \
     ui/dialogs/settings/options_widget/lc_dlgiconssetup.cpp \
     ui/dialogs/file/export/layers/lc_layerexportoptions.cpp \
     #ui/dock_widgets/library_widget/lc_librarywidget.cpp \
+    ui/dock_widgets/library_widget/lc_librarythumbnailcache.cpp \
+    ui/dock_widgets/library_widget/lc_librarythumbnailgenerator.cpp \
     ui/dock_widgets/cad/lc_caddockwidget.cpp \
     ui/dock_widgets/lc_dockwidget.cpp \
     ui/dock_widgets/lc_graphicviewawarewidget.cpp \
@@ -759,8 +789,10 @@ SOURCES += \
     ui/main/support/lc_appwindowdialogsinvoker.cpp \
     ui/main/lc_appwindowaware.cpp \
     ui/main/lc_defaultactioncontext.cpp \
+    ui/main/persistence/lc_documentloader.cpp \
     ui/main/persistence/lc_documentsstorage.cpp \
     lib/gui/render/lc_graphicviewportrenderer.cpp \
+    lib/gui/render/lc_screentransform.cpp \
     lib/gui/render/widget/lc_graphicviewrenderer.cpp \
     lib/gui/render/widget/lc_printpreviewviewrenderer.cpp \
     lib/gui/render/widget/lc_widgetviewportrenderer.cpp \
@@ -788,6 +820,7 @@ SOURCES += \
     lib/actions/rs_snapper.cpp \
     lib/creation/rs_creation.cpp \
     lib/debug/rs_debug.cpp \
+    lib/debug/lc_trace.cpp \
     lib/engine/document/ucs/lc_ucs.cpp \
     lib/engine/document/views/lc_view.cpp \
     lib/engine/document/views/lc_viewslist.cpp \
@@ -849,7 +882,9 @@ SOURCES += \
     lib/engine/document/variables/rs_variabledict.cpp \
     lib/engine/rs_vector.cpp \
     lib/fileio/rs_fileio.cpp \
+    lib/fileio/lc_documentcache.cpp \
     lib/fileio/lc_filenameselectionservice.cpp \
+    lib/fileio/lc_importmonitor.cpp \
     lib/filters/rs_filtercxf.cpp \
     lib/filters/rs_filterdxfrw.cpp \
     lib/filters/rs_filterdxf1.cpp \
@@ -918,8 +953,10 @@ SOURCES += \
     lib/engine/rs_flags.cpp \
     lib/engine/document/entities/lc_rect.cpp \
     lib/engine/utils/lc_rtree.cpp \
+    lib/engine/utils/lc_segmentindex.cpp \
     lib/engine/undo/lc_undosection.cpp \
     lib/engine/rs.cpp \
+    lib/printing/lc_pdfwriter.cpp \
     lib/printing/lc_printing.cpp \
     main/lc_application.cpp \
     ui/action_options/curve/lc_ellipsearcoptions.cpp \
@@ -1823,6 +1860,7 @@ FORMS = ui/action_options/circle/lc_circlebyarcoptions.ui \
 HEADERS += \
     main/qc_dialogfactory.h \
     main/doc_plugin_interface.h \
+    main/lc_pluginbulkdata.h \
     plugins/document_interface.h \
     plugins/qc_plugininterface.h \
     plugins/intern/qc_actiongetpoint.h \
@@ -1835,6 +1873,7 @@ HEADERS += \
 SOURCES += \
     main/qc_dialogfactory.cpp \
     main/doc_plugin_interface.cpp \
+    main/lc_pluginbulkdata.cpp \
     plugins/intern/qc_actiongetpoint.cpp \
     plugins/intern/qc_actiongetselect.cpp \
     plugins/intern/qc_actiongetent.cpp \
@@ -64,7 +64,7 @@ void QG_FontBox::init() {
  * Sets the currently selected width item to the given width.
  */
 void QG_FontBox::setFont(const QString& fName) {
-    RS_DEBUG->print("QG_FontBox::setFont %s\n", fName.toLatin1().data());
+    LC_DEBUG_PRINT("QG_FontBox::setFont %s\n", fName.toLatin1().data());
     setItemText(currentIndex(),fName);
     slotFontChanged(currentIndex());
 }
@@ -81,8 +81,8 @@ void QG_FontBox::slotFontChanged(int index) {
     RS_DEBUG->print("QG_FontBox::slotFontChanged %d\n", index);
     m_currentFont = RS_FONTLIST->requestFont(currentText());
 	if (m_currentFont) {
-        RS_DEBUG->print("Current font is (%d): %s\n",
-                        index, m_currentFont->getFileName().toLatin1().data());
+        LC_DEBUG_PRINT("Current font is (%d): %s\n",
+                       index, m_currentFont->getFileName().toLatin1().data());
     }
     emit fontChanged(m_currentFont);
 }
@@ -66,7 +66,7 @@ void QG_PatternBox::init() {
  * Sets the currently selected width item to the given width.
  */
 void QG_PatternBox::setPattern(const QString& pName) {
-    RS_DEBUG->print("QG_PatternBox::setPattern %s\n", pName.toLatin1().data());
+    LC_DEBUG_PRINT("QG_PatternBox::setPattern %s\n", pName.toLatin1().data());
     setCurrentIndex(findText(pName));
     slotPatternChanged(currentIndex());
 }
@@ -87,8 +87,8 @@ void QG_PatternBox::slotPatternChanged(int index) {
     m_currentPattern = RS_PATTERNLIST->requestPattern(currentText());
 
     if (m_currentPattern) {
-        RS_DEBUG->print("Current pattern is (%d): %s\n",
-                        index, m_currentPattern->getFileName().toLatin1().data());
+        LC_DEBUG_PRINT("Current pattern is (%d): %s\n",
+                       index, m_currentPattern->getFileName().toLatin1().data());
     }
 	emit patternChanged();
 }
@@ -146,7 +146,7 @@ QString QG_FileDialog::getOpenFile(RS2::FormatType* type){
     QString open_filter = LC_GET_STR("OpenFilter", fDxfrw);
     LC_GROUP_END();
 
-    RS_DEBUG->print("defDir: %s", defDir.toLatin1().data());
+    LC_DEBUG_PRINT("defDir: %s", defDir.toLatin1().data());
     QString fn = "";
     QStringList filters;
 #ifdef DWGSUPPORT
@@ -161,7 +161,7 @@ QString QG_FileDialog::getOpenFile(RS2::FormatType* type){
     setFileMode(QFileDialog::ExistingFile);
     selectNameFilter(open_filter);
     ftype= RS2::FormatDXFRW;
-    RS_DEBUG->print("defFilter: %s", fDxfrw.toLatin1().data());
+    LC_DEBUG_PRINT("defFilter: %s", fDxfrw.toLatin1().data());
 
     /* preview RVT PORT preview is currently not supported by QT4
     RS_Graphic* gr = new RS_Graphic;
@@ -190,7 +190,7 @@ QString QG_FileDialog::getOpenFile(RS2::FormatType* type){
         }
     }
 
-    RS_DEBUG->print("QG_FileDialog::getOpenFileName: fileName: %s", fn.toLatin1().data());
+    LC_DEBUG_PRINT("QG_FileDialog::getOpenFileName: fileName: %s", fn.toLatin1().data());
     RS_DEBUG->print("QG_FileDialog::getOpenFileName: OK");
 
     // RVT PORT delete prev;
@@ -207,7 +207,7 @@ QString QG_FileDialog::getSaveFile(RS2::FormatType* type, const QString& current
     if(!defDir.endsWith("/") && !defDir.endsWith("\\"))
         defDir += QDir::separator();
 
-    RS_DEBUG->print("defDir: %s", defDir.toLatin1().data());
+    LC_DEBUG_PRINT("defDir: %s", defDir.toLatin1().data());
 
     // setup filters
     QStringList filters;
@@ -219,7 +219,7 @@ QString QG_FileDialog::getSaveFile(RS2::FormatType* type, const QString& current
 #endif
 
     ftype = RS2::FormatDXFRW;
-    RS_DEBUG->print("defFilter: %s", fDxfrw2007.toLatin1().data());
+    LC_DEBUG_PRINT("defFilter: %s", fDxfrw2007.toLatin1().data());
 
     // when defFilter is added the below should use the default extension.
     // generate an untitled name
@@ -437,8 +437,8 @@ QString QG_FileDialog::getOpenFileName(QWidget* parent, RS2::FormatType* type) {
     QString defFilter = "Drawing Exchange (*.dxf)";
     LC_GROUP_END();
 
-    RS_DEBUG->print("defDir: %s", defDir.toLatin1().data());
-    RS_DEBUG->print("defFilter: %s", defFilter.toLatin1().data());
+    LC_DEBUG_PRINT("defDir: %s", defDir.toLatin1().data());
+    LC_DEBUG_PRINT("defFilter: %s", defFilter.toLatin1().data());
 
     QString fDxfOld(QObject::tr("Old Drawing Exchange %1").arg("(*.dxf *.DXF)"));
     QString fDxfrw(QObject::tr("Drawing Exchange %1").arg("(*.dxf)"));
@@ -451,10 +451,10 @@ QString QG_FileDialog::getOpenFileName(QWidget* parent, RS2::FormatType* type) {
     QString fCxf(QObject::tr("Font %1").arg("(*.cxf)"));
     QString fJww(QObject::tr("Jww %1").arg("(*.jww)"));
 
-    RS_DEBUG->print("fDxfrw: %s", fDxfrw.toLatin1().data());
-    RS_DEBUG->print("fDxf1: %s", fDxf1.toLatin1().data());
-    RS_DEBUG->print("fCxf: %s", fCxf.toLatin1().data());
-    RS_DEBUG->print("fJww: %s", fJww.toLatin1().data());
+    LC_DEBUG_PRINT("fDxfrw: %s", fDxfrw.toLatin1().data());
+    LC_DEBUG_PRINT("fDxf1: %s", fDxf1.toLatin1().data());
+    LC_DEBUG_PRINT("fCxf: %s", fCxf.toLatin1().data());
+    LC_DEBUG_PRINT("fJww: %s", fJww.toLatin1().data());
 
     QString fn = "";
     bool cancel = false;
@@ -519,7 +519,7 @@ QString QG_FileDialog::getOpenFileName(QWidget* parent, RS2::FormatType* type) {
         LC_GROUP_END();
     }
 
-    RS_DEBUG->print("QG_FileDialog::getOpenFileName: fileName: %s", fn.toLatin1().data());
+    LC_DEBUG_PRINT("QG_FileDialog::getOpenFileName: fileName: %s", fn.toLatin1().data());
     RS_DEBUG->print("QG_FileDialog::getOpenFileName: OK");
 
     // RVT PORT delete prev;
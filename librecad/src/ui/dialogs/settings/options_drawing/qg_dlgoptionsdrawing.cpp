@@ -1424,8 +1424,8 @@ void QG_DlgOptionsDrawing::validateSplinesTab() {
     // splines:
     m_graphic->addVariable("$SPLINESEGS",(int) RS_Math::eval(cbSplineSegs->currentText()), 70);
 
-    RS_DEBUG->print("QG_DlgOptionsDrawing::validate: splinesegs is: %s",
-                    cbSplineSegs->currentText().toLatin1().data());
+    LC_DEBUG_PRINT("QG_DlgOptionsDrawing::validate: splinesegs is: %s",
+                   cbSplineSegs->currentText().toLatin1().data());
 
     m_graphic->addVariable("$JOINSTYLE", cbLineJoin ->currentIndex(), DXF_FORMAT_GC_JoinStyle);
     m_graphic->addVariable("$ENDCAPS", cbLineCap->currentIndex(), DXF_FORMAT_GC_Endcaps);
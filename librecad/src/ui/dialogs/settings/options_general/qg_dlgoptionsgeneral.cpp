@@ -30,6 +30,7 @@
 
 #include "dxf_format.h"
 #include "lc_defaults.h"
+#include "lc_graphicviewportrenderer.h"
 #include "lc_settingsexporter.h"
 #include "main.h"
 #include "qc_applicationwindow.h"
@@ -120,11 +121,11 @@ void QG_DlgOptionsGeneral::init(){
     languageList.sort();
     languageList.prepend("en");
     for (auto const &lang: languageList) {
-        RS_DEBUG->print("QG_DlgOptionsGeneral::init: adding %s to combobox",
-                        lang.toLatin1().data());
+        LC_DEBUG_PRINT("QG_DlgOptionsGeneral::init: adding %s to combobox",
+                       lang.toLatin1().data());
 
         if (QString l = RS_SYSTEM->symbolToLanguage(lang); !l.isEmpty() && cbLanguage->findData(lang) == -1) {
-            RS_DEBUG->print("QG_DlgOptionsGeneral::init: %s", l.toLatin1().data());
+            LC_DEBUG_PRINT("QG_DlgOptionsGeneral::init: %s", l.toLatin1().data());
             cbLanguage->addItem(l, lang);
             cbLanguageCmd->addItem(l, lang);
         }
@@ -442,12 +443,28 @@ void QG_DlgOptionsGeneral::init(){
         double minEllipseMinor = minEllipseMinor100 / 100.0;
         sbRenderMinEllipseMinor->setValue(minEllipseMinor);
 
+        // items of the combobox follow LC_GraphicViewportRenderer::ContainerDetail
+        int smallContainerDetail = LC_GET_INT("SmallContainerDetail", LC_GraphicViewportRenderer::DEFAULT_SMALL_CONTAINER_DETAIL);
+        if (smallContainerDetail < 0 || smallContainerDetail >= cbRenderSmallContainerDetail->count()) {
+            smallContainerDetail = LC_GraphicViewportRenderer::DEFAULT_SMALL_CONTAINER_DETAIL;
+        }
+        cbRenderSmallContainerDetail->setCurrentIndex(smallContainerDetail);
+
+        int minContainerSize = LC_GET_INT("MinContainerSizePx", LC_GraphicViewportRenderer::DEFAULT_MIN_CONTAINER_SIZE_PX);
+        sbRenderMinContainerSize->setValue(minContainerSize);
+
+        int minHatchPatternSpacing100 = LC_GET_INT("MinHatchPatternSpacing", 200);
+        sbRenderMinHatchPatternSpacing->setValue(minHatchPatternSpacing100 / 100.0);
+
         bool drawTextsAsDraftInPanning = LC_GET_BOOL("DrawTextsAsDraftInPanning", true);
         cbTextDraftOnPanning->setChecked(drawTextsAsDraftInPanning);
 
         bool drawTextsAsDraftInPreview = LC_GET_BOOL("DrawTextsAsDraftInPreview", true);
         cbTextDraftInPreview->setChecked(drawTextsAsDraftInPreview);
 
+        bool progressiveZoomPan = LC_GET_BOOL("ProgressiveZoomPan", true);
+        cbProgressiveZoomPan->setChecked(progressiveZoomPan);
+
         bool drawInterpolate = LC_GET_BOOL("ArcRenderInterpolate", false);
         rbRenderArcInterpolate->setChecked(drawInterpolate);
         rbRenderArcQT->setChecked(!drawInterpolate);
@@ -549,6 +566,7 @@ void QG_DlgOptionsGeneral::init(){
         cbAutoBackup->setChecked(autoBackup);
         cbAutoSaveTime->setEnabled(autoBackup);
         cbUseQtFileOpenDialog->setChecked(LC_GET_BOOL("UseQtFileOpenDialog", true));
+        cbDocumentCache->setChecked(LC_GET_BOOL("DocumentCache", false));
         cbWheelScrollInvertH->setChecked(LC_GET_BOOL("WheelScrollInvertH"));
         cbWheelScrollInvertV->setChecked(LC_GET_BOOL("WheelScrollInvertV"));
         cbInvertZoomDirection->setChecked(LC_GET_BOOL("InvertZoomDirection"));
@@ -794,8 +812,12 @@ void QG_DlgOptionsGeneral::ok(){
             LC_SET("MinLineLen", (int) (sbRenderMinLineLen->value() * 100));
             LC_SET("MinEllipseMajor", (int) (sbRenderMinEllipseMajor->value() * 100));
             LC_SET("MinEllipseMinor", (int) (sbRenderMinEllipseMinor->value() * 100));
+            LC_SET("SmallContainerDetail", cbRenderSmallContainerDetail->currentIndex());
+            LC_SET("MinContainerSizePx", sbRenderMinContainerSize->value());
+            LC_SET("MinHatchPatternSpacing", (int) (sbRenderMinHatchPatternSpacing->value() * 100));
             LC_SET("DrawTextsAsDraftInPanning", cbTextDraftOnPanning->isChecked());
             LC_SET("DrawTextsAsDraftInPreview", cbTextDraftInPreview->isChecked());
+            LC_SET("ProgressiveZoomPan", cbProgressiveZoomPan->isChecked());
 
             LC_SET("ArcRenderInterpolate", rbRenderArcInterpolate->isChecked());
             LC_SET("ArcRenderInterpolateSegmentFixed", rbRenderArcMethodFixed->isChecked());
@@ -867,6 +889,7 @@ void QG_DlgOptionsGeneral::ok(){
             LC_SET("BackupFileSuffix", backupFileNameSuffix);
 
             LC_SET("UseQtFileOpenDialog", cbUseQtFileOpenDialog->isChecked());
+            LC_SET("DocumentCache", cbDocumentCache->isChecked());
             LC_SET("WheelScrollInvertH", cbWheelScrollInvertH->isChecked());
             LC_SET("WheelScrollInvertV", cbWheelScrollInvertV->isChecked());
             LC_SET("InvertZoomDirection", cbInvertZoomDirection->isChecked());
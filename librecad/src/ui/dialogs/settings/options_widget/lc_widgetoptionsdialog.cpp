@@ -105,6 +105,9 @@ LC_WidgetOptionsDialog::LC_WidgetOptionsDialog(QWidget* parent)
         int docWidgetsIconSize = LC_GET_INT("DockWidgetsIconSize", 16);
         sbDocWidgtetIconSize->setValue(docWidgetsIconSize);
 
+        int libraryThumbnailSize = LC_GET_INT("LibraryThumbnailSize", 64);
+        sbLibraryThumbnailSize->setValue(libraryThumbnailSize);
+
         bool allowDockNesting = LC_GET_BOOL("DockAllowNested", true);
         cbDockingAllowNested->setChecked(allowDockNesting);
 
@@ -374,6 +377,7 @@ void LC_WidgetOptionsDialog::accept() {
 
         LC_SET("DockWidgetsFlatIcons", cbDockWidgetsFlatButtons->isChecked());
         LC_SET("DockWidgetsIconSize", sbDocWidgtetIconSize->value());
+        LC_SET("LibraryThumbnailSize", sbLibraryThumbnailSize->value());
 
 
         bool allowDockNesting =cbDockingAllowNested->isChecked();
@@ -790,7 +790,7 @@ void LC_QuickInfoEntityData::collectPolylineProperties(RS_Polyline *l){
 
     addProperty(tr("Closed"), closed ? tr("Yes") : tr("No"), OTHER);
 
-    RS_Entity *v = l->firstEntity(RS2::ResolveNone);
+    RS_Entity *v = l->entityAt(0);
     //bad polyline without vertex
     if (!v) return;
 
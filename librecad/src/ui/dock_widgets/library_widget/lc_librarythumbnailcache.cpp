@@ -0,0 +1,185 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_librarythumbnailcache.h"
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+    constexpr quint32 CACHE_MAGIC = 0x544c434c; // "LCLT"
+    constexpr quint32 CACHE_VERSION = 1;
+    // magic, version and size of index
+    constexpr qint64 HEADER_SIZE = 16;
+}
+
+LC_LibraryThumbnailCache::LC_LibraryThumbnailCache(){
+    QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheLocation.isEmpty()) {
+        m_fileName = cacheLocation + QLatin1String("/library/thumbnails.lclt");
+        load();
+    }
+}
+
+LC_LibraryThumbnailCache::~LC_LibraryThumbnailCache(){
+    save();
+    close();
+}
+
+QString LC_LibraryThumbnailCache::entryKey(const QFileInfo &dxfFile, int size){
+    return dxfFile.absoluteFilePath() + QLatin1Char('|') + QString::number(size);
+}
+
+bool LC_LibraryThumbnailCache::find(const QFileInfo &dxfFile, int size, QImage &image) const{
+    auto it = m_entries.constFind(entryKey(dxfFile, size));
+    if (it == m_entries.cend()) {
+        return false;
+    }
+    if (it->modified != dxfFile.lastModified().toMSecsSinceEpoch() || it->fileSize != dxfFile.size()) {
+        return false;
+    }
+    // decoded image does not refer to the mapped file
+    return image.loadFromData(it->png, "PNG");
+}
+
+void LC_LibraryThumbnailCache::insert(const QFileInfo &dxfFile, int size, const QImage &image){
+    if (m_fileName.isEmpty() || image.isNull()) {
+        return;
+    }
+    Entry entry;
+    entry.modified = dxfFile.lastModified().toMSecsSinceEpoch();
+    entry.fileSize = dxfFile.size();
+    QBuffer buffer(&entry.png);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "PNG")) {
+        return;
+    }
+    m_entries.insert(entryKey(dxfFile, size), entry);
+    m_modified = true;
+}
+
+void LC_LibraryThumbnailCache::load(){
+    m_file.setFileName(m_fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    qint64 fileSize = m_file.size();
+    if (fileSize >= HEADER_SIZE) {
+        m_mapped = m_file.map(0, fileSize);
+    }
+    if (m_mapped == nullptr) {
+        m_file.close();
+        return;
+    }
+
+    QDataStream header(QByteArray::fromRawData(reinterpret_cast<const char*>(m_mapped), HEADER_SIZE));
+    header.setByteOrder(QDataStream::LittleEndian);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 indexSize = 0;
+    header >> magic >> version >> indexSize;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || indexSize <= 0 || indexSize > fileSize - HEADER_SIZE) {
+        close();
+        return;
+    }
+
+    QDataStream index(QByteArray::fromRawData(reinterpret_cast<const char*>(m_mapped) + HEADER_SIZE, indexSize));
+    index.setVersion(QDataStream::Qt_6_0);
+    qint32 count = 0;
+    index >> count;
+    for (qint32 i = 0; i < count && index.status() == QDataStream::Ok; i++) {
+        QString key;
+        Entry entry;
+        qint64 offset = 0;
+        qint32 length = 0;
+        index >> key >> entry.modified >> entry.fileSize >> offset >> length;
+        if (index.status() != QDataStream::Ok || length <= 0 ||
+            offset < HEADER_SIZE + indexSize || offset + length > fileSize) {
+            break;
+        }
+        entry.png = QByteArray::fromRawData(reinterpret_cast<const char*>(m_mapped) + offset, length);
+        m_entries.insert(key, entry);
+    }
+    if (index.status() != QDataStream::Ok || m_entries.size() != count) {
+        close();
+    }
+}
+
+void LC_LibraryThumbnailCache::close(){
+    m_entries.clear();
+    m_modified = false;
+    if (m_mapped != nullptr) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    m_file.close();
+}
+
+void LC_LibraryThumbnailCache::save(){
+    if (!m_modified || !QDir().mkpath(QFileInfo(m_fileName).absolutePath())) {
+        return;
+    }
+
+    const QStringList keys = m_entries.keys();
+    auto writeIndex = [this, &keys](qint64 dataStart){
+        QByteArray result;
+        QDataStream index(&result, QIODevice::WriteOnly);
+        index.setVersion(QDataStream::Qt_6_0);
+        index << qint32(keys.size());
+        qint64 offset = dataStart;
+        for (const QString &key: keys) {
+            const Entry &entry = m_entries[key];
+            index << key << entry.modified << entry.fileSize << offset << qint32(entry.png.size());
+            offset += entry.png.size();
+        }
+        return result;
+    };
+    // all fields of the index except keys have fixed size, so offsets do not change its size
+    qint64 indexSize = writeIndex(0).size();
+    qint64 dataStart = HEADER_SIZE + indexSize;
+    QByteArray index = writeIndex(dataStart);
+
+    QSaveFile out(m_fileName);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QByteArray header;
+    QDataStream headerStream(&header, QIODevice::WriteOnly);
+    headerStream.setByteOrder(QDataStream::LittleEndian);
+    headerStream << CACHE_MAGIC << CACHE_VERSION << indexSize;
+    out.write(header);
+    out.write(index);
+    for (const QString &key: keys) {
+        out.write(m_entries[key].png);
+    }
+
+    // the mapping has to be released before the file is replaced
+    close();
+    out.commit();
+    load();
+}
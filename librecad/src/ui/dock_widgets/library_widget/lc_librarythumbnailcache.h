@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#ifndef LC_LIBRARYTHUMBNAILCACHE_H
+#define LC_LIBRARYTHUMBNAILCACHE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+class QFileInfo;
+class QImage;
+
+/**
+ * Persistent cache of thumbnails for the block library browser.
+ *
+ * All thumbnails are kept in a single file with an index at its start. Entries are keyed by the
+ * path of the library file and thumbnail size, so several resolutions of the same file may be
+ * stored. Modification time and size of the library file are stored with the entry; if they
+ * don't match the file on disk, the entry is considered outdated.
+ * The file is memory-mapped on load, and thumbnails are stored as PNG.
+ */
+class LC_LibraryThumbnailCache{
+public:
+    LC_LibraryThumbnailCache();
+    ~LC_LibraryThumbnailCache();
+
+    bool find(const QFileInfo &dxfFile, int size, QImage &image) const;
+    void insert(const QFileInfo &dxfFile, int size, const QImage &image);
+    /**
+     * Writes the cache file if thumbnails were added since the last save.
+     */
+    void save();
+private:
+    struct Entry {
+        qint64 modified = 0;
+        qint64 fileSize = 0;
+        QByteArray png; // either refers to mapped data or owns encoded image
+    };
+
+    static QString entryKey(const QFileInfo &dxfFile, int size);
+    void load();
+    void close();
+
+    QString m_fileName;
+    QFile m_file;
+    uchar* m_mapped = nullptr;
+    QHash<QString, Entry> m_entries;
+    bool m_modified = false;
+};
+
+#endif // LC_LIBRARYTHUMBNAILCACHE_H
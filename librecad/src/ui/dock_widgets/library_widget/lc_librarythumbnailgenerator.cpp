@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_librarythumbnailgenerator.h"
+
+#include <algorithm>
+
+#include <QThread>
+
+#include "lc_containertraverser.h"
+#include "lc_graphicviewport.h"
+#include "lc_importmonitor.h"
+#include "lc_printviewportrenderer.h"
+#include "rs_debug.h"
+#include "rs_fileio.h"
+#include "rs_graphic.h"
+#include "rs_painter.h"
+
+namespace {
+    // thumbnails are drawn at larger size and scaled down for smoother lines
+    constexpr int RENDER_SCALE = 2;
+}
+
+LC_LibraryThumbnailGenerator::LC_LibraryThumbnailGenerator(QObject* parent)
+    :QObject(parent)
+    , m_monitor{std::make_shared<LC_ImportMonitor>()}{
+    // leave one core for the GUI thread
+    m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+}
+
+LC_LibraryThumbnailGenerator::~LC_LibraryThumbnailGenerator(){
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+void LC_LibraryThumbnailGenerator::request(const QString &dxfPath, int size){
+    m_pending++;
+    unsigned generation = m_generation;
+    std::shared_ptr<LC_ImportMonitor> monitor = m_monitor;
+    m_pool.start([this, generation, monitor, dxfPath, size]() {
+        QImage image;
+        if (!monitor->isCancelled()) {
+            image = renderThumbnail(dxfPath, size, monitor.get());
+        }
+        QMetaObject::invokeMethod(this, [this, generation, dxfPath, size, image]() {
+            onThumbnailRendered(generation, dxfPath, size, image);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void LC_LibraryThumbnailGenerator::cancelAll(){
+    m_pool.clear();
+    m_monitor->cancel();
+    m_monitor = std::make_shared<LC_ImportMonitor>();
+    m_generation++;
+    m_pending = 0;
+}
+
+void LC_LibraryThumbnailGenerator::onThumbnailRendered(unsigned generation, const QString &dxfPath, int size,
+                                                       const QImage &image){
+    if (generation != m_generation) {
+        return;
+    }
+    m_pending--;
+    if (!image.isNull()) {
+        emit thumbnailReady(dxfPath, size, image);
+    }
+    if (m_pending == 0) {
+        emit finished();
+    }
+}
+
+/**
+ * Loads the given file and draws it to an image of the given size. Called on worker threads.
+ * @return thumbnail image, or null image if the file can't be loaded
+ */
+QImage LC_LibraryThumbnailGenerator::renderThumbnail(const QString &dxfPath, int size, LC_ImportMonitor* monitor){
+    RS_Graphic graphic;
+    graphic.newDoc();
+    QString errorMessage;
+    if (!RS_FileIO::instance()->importFile(graphic, dxfPath, RS2::FormatUnknown, errorMessage, monitor)) {
+        if (!monitor->isCancelled()) {
+            LC_DEBUG_PRINT_LEVEL(RS_Debug::D_ERROR,
+                                 "LC_LibraryThumbnailGenerator::renderThumbnail: Cannot open file: '%s'",
+                                 dxfPath.toLatin1().data());
+        }
+        return {};
+    }
+    graphic.onLoadingCompleted();
+
+    int renderSize = size * RENDER_SCALE;
+    QImage buffer(renderSize, renderSize, QImage::Format_ARGB32_Premultiplied);
+    buffer.fill(Qt::white);
+
+    RS_Painter painter(&buffer);
+
+    LC_GraphicViewport viewport;
+    viewport.setSize(renderSize, renderSize);
+    viewport.setContainer(&graphic);
+    viewport.initAfterDocumentOpen();
+    viewport.zoomAuto(false);
+
+    LC_PrintViewportRenderer renderer(&viewport, &painter);
+    renderer.loadSettings();
+    renderer.setupPainter(&painter);
+
+    for(RS_Entity* e: lc::LC_ContainerTraverser{graphic, RS2::ResolveAll}.entities()) {
+        if (e != nullptr && e->rtti() != RS2::EntityHatch) {
+            RS_Pen pen = e->getPen();
+            pen.setColor(Qt::black);
+            e->setPen(pen);
+            renderer.justDrawEntity(&painter, e);
+        }
+    }
+    painter.end();
+
+    return buffer.scaled(size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
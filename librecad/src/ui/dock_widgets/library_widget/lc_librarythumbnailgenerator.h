@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+#ifndef LC_LIBRARYTHUMBNAILGENERATOR_H
+#define LC_LIBRARYTHUMBNAILGENERATOR_H
+
+#include <memory>
+
+#include <QImage>
+#include <QObject>
+#include <QThreadPool>
+
+class LC_ImportMonitor;
+
+/**
+ * Renders thumbnails of library files on a pool of worker threads.
+ *
+ * Each requested file is loaded and drawn on a worker thread, and the result is delivered
+ * on the GUI thread by thumbnailReady(). Requests that are no longer needed (for example,
+ * if another library directory was selected) may be discarded by cancelAll().
+ */
+class LC_LibraryThumbnailGenerator: public QObject{
+    Q_OBJECT
+public:
+    explicit LC_LibraryThumbnailGenerator(QObject* parent = nullptr);
+    ~LC_LibraryThumbnailGenerator() override;
+
+    void request(const QString &dxfPath, int size);
+    void cancelAll();
+    bool isBusy() const {return m_pending > 0;}
+
+    static QImage renderThumbnail(const QString &dxfPath, int size, LC_ImportMonitor* monitor);
+signals:
+    void thumbnailReady(const QString &dxfPath, int size, const QImage &image);
+    /**
+     * Emitted once all requested thumbnails are delivered.
+     */
+    void finished();
+private:
+    void onThumbnailRendered(unsigned generation, const QString &dxfPath, int size, const QImage &image);
+
+    QThreadPool m_pool;
+    // cancels file imports of requests that were discarded
+    std::shared_ptr<LC_ImportMonitor> m_monitor;
+    // results of requests made before cancelAll() are ignored
+    unsigned m_generation = 0;
+    int m_pending = 0;
+};
+
+#endif // LC_LIBRARYTHUMBNAILGENERATOR_H
@@ -26,52 +26,27 @@
 **********************************************************************/
 
 
-#include <QApplication>
 #include <QDir>
 #include <QFileInfo>
-#include <QImageWriter>
 #include <QKeyEvent>
 #include <QListView>
 #include <QPushButton>
 #include <QStandardItemModel>
-#include <QStandardPaths>
 #include <QToolButton>
 #include <QTreeView>
 #include <QVBoxLayout>
 #include <QAbstractItemView>
 
 #include "qg_librarywidget.h"
-#include "lc_containertraverser.h"
-#include "lc_documentsstorage.h"
-#include "lc_graphicviewport.h"
-#include "lc_printviewportrenderer.h"
+#include "lc_librarythumbnailcache.h"
+#include "lc_librarythumbnailgenerator.h"
 #include "qg_actionhandler.h"
 #include "rs_actioninterface.h"
 #include "rs_actionlibraryinsert.h"
 #include "rs_debug.h"
-#include "rs_graphic.h"
-#include "rs_painter.h"
 #include "rs_settings.h"
 #include "rs_system.h"
 
-namespace {
-    // fixme - sand - rework, use reusable class
-    void writePng(const QString& pngPath, QPixmap pixmap)
-    {
-        QImageWriter iio;
-        QImage img = pixmap.toImage();
-        img = img.scaled(64,64, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
-        // iio.setImage(img);
-        iio.setFileName(pngPath);
-        iio.setFormat("PNG");
-        if (!iio.write(img)) {
-            RS_DEBUG->print(RS_Debug::D_ERROR,
-                            "QG_LibraryWidget::getPathToPixmap: Cannot write thumbnail: '%s'",
-                            pngPath.toLatin1().data());
-        }
-    }
-}
-
 /*
  *  Constructs a QG_LibraryWidget as a child of 'parent', with the
  *  name 'name' and widget flags set to 'f'.
@@ -100,6 +75,11 @@ QG_LibraryWidget::QG_LibraryWidget(QG_ActionHandler *action_handler, QWidget* pa
     refreshButtonsLayout->addWidget(bRebuild);
     vboxLayout->addLayout(refreshButtonsLayout);
 
+    m_thumbnailCache = std::make_unique<LC_LibraryThumbnailCache>();
+    m_thumbnailGenerator = new LC_LibraryThumbnailGenerator(this);
+    connect(m_thumbnailGenerator, &LC_LibraryThumbnailGenerator::thumbnailReady, this, &QG_LibraryWidget::onThumbnailReady);
+    connect(m_thumbnailGenerator, &LC_LibraryThumbnailGenerator::finished, this, &QG_LibraryWidget::onThumbnailsFinished);
+
     buildTree();
 
     connect(dirView, &QTreeView::expanded, this, &QG_LibraryWidget::expandView);
@@ -112,7 +92,10 @@ QG_LibraryWidget::QG_LibraryWidget(QG_ActionHandler *action_handler, QWidget* pa
     updateWidgetSettings();
 }
 
-QG_LibraryWidget::~QG_LibraryWidget() = default;
+QG_LibraryWidget::~QG_LibraryWidget(){
+    // workers have to stop before the items they fill are destroyed
+    cancelThumbnails();
+}
 
 void QG_LibraryWidget::setGraphicView([[maybe_unused]]RS_GraphicView* gview) {
     // todo - add further processing later
@@ -164,8 +147,8 @@ void QG_LibraryWidget::insert() {
             }
         }
     } else {
-        RS_DEBUG->print(RS_Debug::D_ERROR,
-                        "QG_LibraryWidget::insert: Can't read file: '%s'", dxfPath.toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_ERROR,
+                             "QG_LibraryWidget::insert: Can't read file: '%s'", dxfPath.toLatin1().data());
     }
 }
 
@@ -201,6 +184,7 @@ void QG_LibraryWidget::scanTree() {
  * (Re)build dirModel and iconModel from scratch
  */
 void QG_LibraryWidget::buildTree() {
+    cancelThumbnails();
     dirModel = std::make_unique<QStandardItemModel>();
     iconModel = std::make_unique<QStandardItemModel>();
     scanTree();
@@ -287,10 +271,9 @@ void QG_LibraryWidget::updatePreview(QModelIndex idx) {
         return;
     }
 
-    QApplication::setOverrideCursor( QCursor(Qt::WaitCursor) );
-
     // dir from the point of view of the library browser (e.g. /mechanical/screws)
     QString directory = getItemDir(item); //RLZ change to do-while
+    cancelThumbnails();
     iconModel->clear();
 
     // List of all directories that contain part libraries:
@@ -314,14 +297,40 @@ void QG_LibraryWidget::updatePreview(QModelIndex idx) {
     // Sort entries:
     itemPathList.sort();
 
-    // Fill items into icon view:
+    // Fill items into icon view, missing thumbnails are generated in background and set as they are ready:
     for (int i = 0; i < itemPathList.size(); ++i) {
-        QString label = QFileInfo(itemPathList.at(i)).completeBaseName();
-        QIcon icon = getIcon(directory, QFileInfo(itemPathList.at(i)).fileName(), itemPathList.at(i));
+        const QString &itemPath = itemPathList.at(i);
+        QString label = QFileInfo(itemPath).completeBaseName();
+        QIcon icon = getIcon(directory, QFileInfo(itemPath).fileName(), itemPath);
         auto newItem = new QStandardItem(icon, label);
         iconModel->setItem(i, newItem);
+        if (icon.isNull()) {
+            QPixmap placeholder(m_thumbnailSize, m_thumbnailSize);
+            placeholder.fill(Qt::white);
+            newItem->setIcon(QIcon(placeholder));
+            m_pendingThumbnails.insert(itemPath, newItem);
+            m_thumbnailGenerator->request(itemPath, m_thumbnailSize);
+        }
+    }
+}
+
+void QG_LibraryWidget::cancelThumbnails() {
+    m_thumbnailGenerator->cancelAll();
+    m_pendingThumbnails.clear();
+    m_thumbnailCache->save();
+}
+
+void QG_LibraryWidget::onThumbnailReady(const QString &dxfPath, int size, const QImage &image) {
+    m_thumbnailCache->insert(QFileInfo(dxfPath), size, image);
+    QStandardItem* item = m_pendingThumbnails.take(dxfPath);
+    if (item != nullptr && size == m_thumbnailSize) {
+        item->setIcon(QIcon(QPixmap::fromImage(image)));
     }
-    QApplication::restoreOverrideCursor();
+}
+
+void QG_LibraryWidget::onThumbnailsFinished() {
+    m_pendingThumbnails.clear();
+    m_thumbnailCache->save();
 }
 
  //RLZ change to do-while
@@ -366,8 +375,8 @@ QString QG_LibraryWidget::getItemPath(QStandardItem* item) {
 }
 
 /**
- * @return Pixmap that serves as icon for the given DXF File.
- * The existing PNG file is returned or created and returned..
+ * @return Icon for the given DXF File, either a thumbnail shipped with the library or
+ * one generated before. Null icon is returned if the thumbnail should be generated.
  *
  * @param dir Library directory (e.g. "/mechanical/screws")
  * @param dxfFile File name (e.g. "screw1.dxf")
@@ -377,38 +386,33 @@ QString QG_LibraryWidget::getItemPath(QStandardItem* item) {
 QIcon QG_LibraryWidget::getIcon(const QString& dir, const QString& dxfFile,
                                     const QString& dxfPath) {
     QString pngFile = getPathToPixmap(dir, dxfFile, dxfPath);
-    QFileInfo fiPng(pngFile);
 
     // found existing thumbnail:
-    if (fiPng.isFile()) {
+    if (!pngFile.isEmpty()) {
         return QIcon(pngFile);
     }
-    // default thumbnail:
-    else {
-        return QIcon(QPixmap(64,64));
+
+    QImage image;
+    if (m_thumbnailCache->find(QFileInfo(dxfPath), m_thumbnailSize, image)) {
+        return QIcon(QPixmap::fromImage(image));
     }
+    return {};
 }
 
-// fixme - sand - files - generation of thumbnails should be extracted!!! Do this on general rework of the library
-
 /**
- * @return Path to the thumbnail of the given DXF file. If no thumbnail exists, one is
- * created in the user's home. If no thumbnail can be created, an empty string is returned.
+ * @return Path to the thumbnail shipped with the library for the given DXF file, or an empty
+ * string if there is no up-to-date thumbnail.
  */
 QString QG_LibraryWidget::getPathToPixmap(const QString& dir,
         const QString& dxfFile,
         const QString& dxfPath) {
 
-    // the thumbnail must be created in the user's home.
-    QString iconCacheLocation=QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QDir::separator() + "iconCache" + QDir::separator();
-
-    RS_DEBUG->print("QG_LibraryWidget::getPathToPixmap: "
-                    "dir: '%s' dxfFile: '%s' dxfPath: '%s'",
-                    dir.toLatin1().data(), dxfFile.toLatin1().data(), dxfPath.toLatin1().data());
+    LC_DEBUG_PRINT("QG_LibraryWidget::getPathToPixmap: "
+                   "dir: '%s' dxfFile: '%s' dxfPath: '%s'",
+                   dir.toLatin1().data(), dxfFile.toLatin1().data(), dxfPath.toLatin1().data());
 
     // List of all directories that contain part libraries:
     QStringList directoryList = RS_SYSTEM->getDirectoryList("library");
-    directoryList.prepend(iconCacheLocation);
 
     QFileInfo fiDxf(dxfPath);
 
@@ -417,76 +421,29 @@ QString QG_LibraryWidget::getPathToPixmap(const QString& dir,
     foreach (QString path, directoryList) {
         QString itemDir = path + dir;
         QString pngPath = itemDir + QDir::separator() + fiDxf.baseName() + ".png";
-        RS_DEBUG->print("QG_LibraryWidget::getPathToPixmap: checking: '%s'",
-                        pngPath.toLatin1().data());
+        LC_DEBUG_PRINT("QG_LibraryWidget::getPathToPixmap: checking: '%s'",
+                       pngPath.toLatin1().data());
         QFileInfo fiPng(pngPath);
 
         // the thumbnail exists:
         if (fiPng.isFile()) {
-            RS_DEBUG->print("QG_LibraryWidget::getPathToPixmap: dxf date: %s, png date: %s",
-                            fiDxf.lastModified().toString().toLatin1().data(), fiPng.lastModified().toString().toLatin1().data());
+            LC_DEBUG_PRINT("QG_LibraryWidget::getPathToPixmap: dxf date: %s, png date: %s",
+                           fiDxf.lastModified().toString().toLatin1().data(), fiPng.lastModified().toString().toLatin1().data());
             if (fiPng.lastModified() > fiDxf.lastModified()) {
-                RS_DEBUG->print("QG_LibraryWidget::getPathToPixmap: thumbnail found: '%s'",
-                                pngPath.toLatin1().data());
+                LC_DEBUG_PRINT("QG_LibraryWidget::getPathToPixmap: thumbnail found: '%s'",
+                               pngPath.toLatin1().data());
                 return pngPath;
             } else {
-                RS_DEBUG->print("QG_LibraryWidget::getPathToPixmap: thumbnail needs to be updated: '%s'",
-                                pngPath.toLatin1().data());
+                LC_DEBUG_PRINT("QG_LibraryWidget::getPathToPixmap: thumbnail needs to be updated: '%s'",
+                               pngPath.toLatin1().data());
             }
         }
     }
-
-    // create all directories needed:
-    RS_SYSTEM->createPaths(iconCacheLocation + dir);
-
-    QString pngPath = iconCacheLocation + dir + QDir::separator() + fiDxf.baseName() + ".png";
-
-    QPixmap buffer(128,128); // fixme - sand - add settings for thumbnail size, generate per setting!
-    RS_Painter painter(&buffer);
-    painter.setBackground(RS_Color(255,255,255));
-    painter.eraseRect(0,0, 128,128);
-
-    LC_GraphicViewport viewport;
-    viewport.setSize(128,128);
-
-    RS_Graphic graphic;
-
-    LC_DocumentsStorage storage;
-
-    if (!storage.loadDocument(&graphic, dxfPath, RS2::FormatUnknown)) {
-        RS_DEBUG->print(RS_Debug::D_ERROR,
-                        "QG_LibraryWidget::getPathToPixmap: Cannot open file: '%s'",
-                        dxfPath.toLatin1().data());
-        return {};
-    }
-
-    viewport.setContainer(&graphic);
-    viewport.initAfterDocumentOpen();
-    viewport.zoomAuto(false);
-
-    LC_PrintViewportRenderer renderer(&viewport, &painter);
-    renderer.loadSettings();
-    renderer.setupPainter(&painter);
-
-    for(RS_Entity* e: lc::LC_ContainerTraverser{graphic, RS2::ResolveAll}.entities()) {
-        if (e != nullptr && e->rtti() != RS2::EntityHatch) {
-            RS_Pen pen = e->getPen();
-            pen.setColor(Qt::black);
-            e->setPen(pen);
-            renderer.justDrawEntity(&painter, e);
-        }
-    }
-
-    // GraphicView deletes painter
-    painter.end();
-
-    // Write to PNG
-    writePng(pngPath, std::move(buffer));
-    LC_LOG << "Writing to " << pngPath << " OK";
-    return pngPath;
+    return {};
 }
 
 void QG_LibraryWidget::updateWidgetSettings(){
+    bool thumbnailSizeChanged = false;
     LC_GROUP("Widgets"); {
         bool flatIcons = LC_GET_BOOL("DockWidgetsFlatIcons", true);
         int iconSize = LC_GET_INT("DockWidgetsIconSize", 16);
@@ -498,6 +455,15 @@ void QG_LibraryWidget::updateWidgetSettings(){
             w->setAutoRaise(flatIcons);
             w->setIconSize(size);
         }
+
+        int thumbnailSize = LC_GET_INT("LibraryThumbnailSize", 64);
+        thumbnailSizeChanged = thumbnailSize != m_thumbnailSize;
+        m_thumbnailSize = thumbnailSize;
+        ivPreview->setIconSize(QSize(m_thumbnailSize, m_thumbnailSize));
     }
     LC_GROUP_END();
+
+    if (thumbnailSizeChanged) {
+        updatePreview(dirView->selectionModel()->currentIndex());
+    }
 }
@@ -28,8 +28,12 @@
 
 #include <memory>
 #include "lc_graphicviewawarewidget.h"
+#include <QHash>
+#include <QImage>
 #include <QModelIndex>
 
+class LC_LibraryThumbnailCache;
+class LC_LibraryThumbnailGenerator;
 class QG_ActionHandler;
 class QListView;
 class QPushButton;
@@ -54,6 +58,7 @@ private:
     QString getItemPath( QStandardItem * item );
     QIcon getIcon( const QString & dir, const QString & dxfFile, const QString & dxfPath );
     QString getPathToPixmap( const QString & dir, const QString & dxfFile, const QString & dxfPath );
+    void cancelThumbnails();
 public slots:
     void setActionHandler( QG_ActionHandler * ah );
     void keyPressEvent( QKeyEvent *e ) override;
@@ -66,6 +71,9 @@ public slots:
     void expandView( QModelIndex idx );
     void collapseView( QModelIndex idx );
     void updateWidgetSettings();
+protected slots:
+    void onThumbnailReady(const QString &dxfPath, int size, const QImage &image);
+    void onThumbnailsFinished();
 signals:
     void escape();private:
     QG_ActionHandler* actionHandler = nullptr;
@@ -75,6 +83,11 @@ signals:
     QListView *ivPreview = nullptr;
     QPushButton *bRefresh = nullptr;
     QPushButton *bRebuild = nullptr;
+    std::unique_ptr<LC_LibraryThumbnailCache> m_thumbnailCache;
+    LC_LibraryThumbnailGenerator* m_thumbnailGenerator = nullptr;
+    // items of the icon view that wait for generated thumbnails, by path of the file
+    QHash<QString, QStandardItem*> m_pendingThumbnails;
+    int m_thumbnailSize = 64;
 };
 
 #endif // QG_LIBRARYWIDGET_H
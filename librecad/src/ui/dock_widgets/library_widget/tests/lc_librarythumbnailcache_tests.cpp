@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include <memory>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lc_librarythumbnailcache.h"
+
+namespace {
+std::unique_ptr<LC_LibraryThumbnailCache> makeCache() {
+    // keeps the cache file of tests out of the user cache
+    QStandardPaths::setTestModeEnabled(true);
+    return std::make_unique<LC_LibraryThumbnailCache>();
+}
+
+void writeFile(const QString& path, const QByteArray& content) {
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    REQUIRE(file.write(content) == content.size());
+}
+
+void setModified(const QString& path, const QDateTime& time) {
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadWrite));
+    REQUIRE(file.setFileTime(time, QFileDevice::FileModificationTime));
+}
+
+QImage makeThumbnail(int size, QRgb color) {
+    QImage image(size, size, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+// thumbnails are stored as PNG, which may be decoded to another format
+bool isSame(const QImage& found, const QImage& expected) {
+    return found.convertToFormat(expected.format()) == expected;
+}
+}
+
+TEST_CASE("LC_LibraryThumbnailCache finds thumbnails of unchanged files") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("part.dxf");
+    writeFile(path, "0\nEOF\n");
+    const QImage small = makeThumbnail(32, qRgba(255, 0, 0, 255));
+    const QImage large = makeThumbnail(64, qRgba(0, 0, 255, 255));
+
+    auto cache = makeCache();
+    QImage found;
+    REQUIRE(!cache->find(QFileInfo(path), 32, found));
+    cache->insert(QFileInfo(path), 32, small);
+    cache->insert(QFileInfo(path), 64, large);
+    REQUIRE(cache->find(QFileInfo(path), 32, found));
+    REQUIRE(isSame(found, small));
+    REQUIRE(cache->find(QFileInfo(path), 64, found));
+    REQUIRE(isSame(found, large));
+    REQUIRE(!cache->find(QFileInfo(path), 48, found));
+
+    // read back from the mapped cache file
+    cache->save();
+    cache = makeCache();
+    REQUIRE(cache->find(QFileInfo(path), 32, found));
+    REQUIRE(isSame(found, small));
+}
+
+TEST_CASE("LC_LibraryThumbnailCache drops thumbnails of changed files") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("part.dxf");
+    writeFile(path, "0\nEOF\n");
+    const QDateTime modified = QFileInfo(path).lastModified();
+    const QImage thumbnail = makeThumbnail(32, qRgba(0, 255, 0, 255));
+
+    auto cache = makeCache();
+    cache->insert(QFileInfo(path), 32, thumbnail);
+    QImage found;
+    REQUIRE(cache->find(QFileInfo(path), 32, found));
+
+    SECTION("modification time") {
+        setModified(path, modified.addSecs(60));
+        REQUIRE(!cache->find(QFileInfo(path), 32, found));
+
+        // stays outdated after reloading
+        cache->save();
+        cache = makeCache();
+        REQUIRE(!cache->find(QFileInfo(path), 32, found));
+
+        setModified(path, modified);
+        REQUIRE(cache->find(QFileInfo(path), 32, found));
+        REQUIRE(isSame(found, thumbnail));
+    }
+
+    SECTION("size") {
+        // same modification time, so only the size differs
+        writeFile(path, "0\nSECTION\n0\nEOF\n");
+        setModified(path, modified);
+        REQUIRE(!cache->find(QFileInfo(path), 32, found));
+
+        cache->save();
+        cache = makeCache();
+        REQUIRE(!cache->find(QFileInfo(path), 32, found));
+    }
+
+    SECTION("replaced by a new thumbnail") {
+        setModified(path, modified.addSecs(60));
+        const QImage updated = makeThumbnail(32, qRgba(255, 255, 0, 255));
+        cache->insert(QFileInfo(path), 32, updated);
+        REQUIRE(cache->find(QFileInfo(path), 32, found));
+        REQUIRE(isSame(found, updated));
+
+        cache->save();
+        cache = makeCache();
+        REQUIRE(cache->find(QFileInfo(path), 32, found));
+        REQUIRE(isSame(found, updated));
+    }
+}
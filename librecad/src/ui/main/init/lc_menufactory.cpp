@@ -33,6 +33,7 @@
 
 #include "lc_actiongroupmanager.h"
 #include "lc_graphicviewport.h"
+#include "lc_trace.h"
 #include "muParserDef.h"
 #include "qc_applicationwindow.h"
 #include "qc_mdiwindow.h"
@@ -157,6 +158,11 @@ void LC_MenuFactory::createHelpMenu(QMenuBar* menu_bar, QList<QMenu*>& topMenuMe
     auto license = new QAction(QObject::tr("License"), m_appWin);
     connect(license, &QAction::triggered, m_appWin, &QC_ApplicationWindow::invokeLicenseWindow);
 
+    auto trace = new QAction(tr("Performance &Trace"), m_appWin);
+    trace->setCheckable(true);
+    trace->setChecked(LC_Trace::isEnabled());
+    connect(trace, &QAction::toggled, m_appWin, &QC_ApplicationWindow::slotToggleTracing);
+
     m_menuHelp->addSeparator();
     m_menuHelp->QWidget::addAction(urlActionTR(tr("&Forum"), "https://forum.librecad.org/"));
     m_menuHelp->QWidget::addAction(urlActionTR(tr("Zulip &Chat"), "https://librecad.zulipchat.com/"));
@@ -164,6 +170,7 @@ void LC_MenuFactory::createHelpMenu(QMenuBar* menu_bar, QList<QMenu*>& topMenuMe
     m_menuHelp->QWidget::addAction(urlActionTR(tr("&Submit Error"), "https://github.com/LibreCAD/LibreCAD/issues/new"));
     m_menuHelp->QWidget::addAction(urlActionTR(tr("&Request Feature"), "https://github.com/LibreCAD/LibreCAD/issues"));
     m_menuHelp->QWidget::addAction(urlActionTR(tr("&Releases Page"), "https://github.com/LibreCAD/LibreCAD/releases"));
+    m_menuHelp->QWidget::addAction(trace);
     m_menuHelp->addSeparator();
     m_menuHelp->QWidget::addAction(help_about);
     m_menuHelp->QWidget::addAction(license);
@@ -0,0 +1,110 @@
+/*******************************************************************************
+*
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#include "lc_documentloader.h"
+
+#include <QThread>
+#include <QTimer>
+
+#include "lc_documentcache.h"
+#include "lc_documentsstorage.h"
+#include "rs_fileio.h"
+#include "rs_graphic.h"
+
+namespace {
+    constexpr int PROGRESS_INTERVAL_MS = 200;
+}
+
+LC_DocumentLoader::LC_DocumentLoader(const QString &fileName, RS2::FormatType type, QObject* parent)
+    :QObject(parent)
+    , m_fileName{fileName}
+    , m_type{type}{
+    m_progressTimer = new QTimer(this);
+    m_progressTimer->setInterval(PROGRESS_INTERVAL_MS);
+    connect(m_progressTimer, &QTimer::timeout, this, &LC_DocumentLoader::onProgressTimer);
+}
+
+LC_DocumentLoader::~LC_DocumentLoader() {
+    if (m_thread != nullptr) {
+        // the graphic is destroyed together with the loader, so the import has to stop first
+        m_monitor.cancel();
+        m_thread->wait();
+        delete m_thread;
+    }
+}
+
+/**
+ * Starts import of the file. The graphic is created there, on the GUI thread,
+ * as it reads defaults from settings.
+ */
+void LC_DocumentLoader::start() {
+    m_graphic = std::make_unique<RS_Graphic>();
+    m_graphic->newDoc();
+    m_thread = QThread::create([this]() {
+        LC_DocumentCache cache(m_fileName);
+        bool useCache = cache.isEnabled();
+        if (useCache) {
+            if (cache.load(*m_graphic, &m_monitor)) {
+                m_success = true;
+                return;
+            }
+            // the cached copy might be imported partially
+            m_graphic->newDoc();
+        }
+        m_success = RS_FileIO::instance()->importFile(*m_graphic, m_fileName, m_type, m_errorMessage, &m_monitor);
+        m_storeInCache = useCache;
+    });
+    connect(m_thread, &QThread::finished, this, &LC_DocumentLoader::onThreadFinished);
+    m_thread->start();
+    m_progressTimer->start();
+}
+
+void LC_DocumentLoader::cancel() {
+    m_monitor.cancel();
+}
+
+bool LC_DocumentLoader::isCancelled() const {
+    return m_monitor.isCancelled();
+}
+
+std::unique_ptr<RS_Graphic> LC_DocumentLoader::takeGraphic() {
+    return std::move(m_graphic);
+}
+
+void LC_DocumentLoader::onProgressTimer() {
+    emit progress(m_monitor.getSectionName(), static_cast<qint64>(m_monitor.getEntitiesCount()));
+}
+
+void LC_DocumentLoader::onThreadFinished() {
+    m_progressTimer->stop();
+    m_thread->deleteLater();
+    m_thread = nullptr;
+    bool success = m_success && !m_monitor.isCancelled();
+    if (success) {
+        LC_DocumentsStorage storage;
+        storage.completeLoading(m_graphic.get(), m_fileName);
+        if (m_storeInCache) {
+            LC_DocumentCache::storeInBackground(m_fileName, m_type);
+        }
+    }
+    emit finished(success);
+}
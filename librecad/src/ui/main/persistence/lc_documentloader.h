@@ -0,0 +1,82 @@
+/*******************************************************************************
+*
+ This file is part of the LibreCAD project, a 2D CAD program
+
+ Copyright (C) 2025 LibreCAD.org
+ Copyright (C) 2025 sand1024
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ******************************************************************************/
+
+#ifndef LC_DOCUMENTLOADER_H
+#define LC_DOCUMENTLOADER_H
+
+#include <memory>
+
+#include <QObject>
+
+#include "lc_importmonitor.h"
+#include "rs.h"
+
+class QThread;
+class QTimer;
+class RS_Graphic;
+
+/**
+ * Loads a drawing file into a detached graphic on a worker thread.
+ *
+ * The application stays responsive while the file is imported. Progress is
+ * reported periodically by the progress() signal, and the import may be
+ * cancelled. Once finished() is emitted, the loaded graphic may be taken
+ * and attached to a drawing window.
+ */
+class LC_DocumentLoader: public QObject{
+    Q_OBJECT
+public:
+    LC_DocumentLoader(const QString &fileName, RS2::FormatType type, QObject* parent = nullptr);
+    ~LC_DocumentLoader() override;
+    void start();
+    void cancel();
+    bool isCancelled() const;
+    const QString &getFileName() const {return m_fileName;}
+    /**
+     * Error reported by the filter, null if the file could not be imported by any filter.
+     */
+    const QString &getErrorMessage() const {return m_errorMessage;}
+    /**
+     * Passes ownership of loaded graphic to the caller.
+     */
+    std::unique_ptr<RS_Graphic> takeGraphic();
+signals:
+    void progress(const QString &section, qint64 entitiesCount);
+    void finished(bool success);
+protected slots:
+    void onProgressTimer();
+    void onThreadFinished();
+private:
+    QString m_fileName;
+    RS2::FormatType m_type;
+    std::unique_ptr<RS_Graphic> m_graphic;
+    LC_ImportMonitor m_monitor;
+    QThread* m_thread = nullptr;
+    QTimer* m_progressTimer = nullptr;
+    // written by the worker thread, read after the thread finished
+    bool m_success = false;
+    // the file was imported, not loaded from the document cache, so a copy is written to the cache
+    bool m_storeInCache = false;
+    QString m_errorMessage;
+};
+
+#endif // LC_DOCUMENTLOADER_H
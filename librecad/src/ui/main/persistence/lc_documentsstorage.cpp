@@ -160,16 +160,23 @@ bool LC_DocumentsStorage::loadGraphic(RS_Graphic* graphic,  const QString &filen
     bool ret = RS_FileIO::instance()->fileImport(*graphic, filename, type);
 
     if (ret) {
-        graphic->onLoadingCompleted();
-        QFileInfo finfo(filename);
-        auto autosaveFileName = createAutoSaveFileName(finfo);
-        graphic->setAutosaveFileName(autosaveFileName);
-        graphic->setFilename(filename);
-        graphic->markSaved(finfo.lastModified());
+        completeLoading(graphic, filename);
     }
     return ret;
 }
 
+/**
+ * Finishes setup of the graphic imported from the given file.
+ */
+void LC_DocumentsStorage::completeLoading(RS_Graphic* graphic, const QString &filename) const {
+    graphic->onLoadingCompleted();
+    QFileInfo finfo(filename);
+    auto autosaveFileName = createAutoSaveFileName(finfo);
+    graphic->setAutosaveFileName(autosaveFileName);
+    graphic->setFilename(filename);
+    graphic->markSaved(finfo.lastModified());
+}
+
 bool LC_DocumentsStorage::doSave(RS_Graphic* graphic, bool sameFile) {
     bool result = false;
     RS2::FormatType actualType = graphic->getFormatType();
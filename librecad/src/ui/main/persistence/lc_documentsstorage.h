@@ -43,6 +43,7 @@ public:
     bool loadDocument(const RS_Document *document, const QString &fileName, RS2::FormatType type) const;
     bool loadDocument(const RS_Document *document, const QString &fileName) const;
     bool loadDocumentFromTemplate(const RS_Document *document, RS_GraphicView *graphicView, const QString &fileName, RS2::FormatType type) const;
+    void completeLoading(RS_Graphic *graphic, const QString &filename) const;
 protected:
     bool doSaveGraphicAs(RS_Graphic* graphic, RS_GraphicView *graphicView, bool &cancelled, const QString& currentFileName = "");
     bool autoSaveGraphic(RS_Graphic *graphic, QString& fileName);
@@ -34,10 +34,12 @@
 #include <QMdiArea>
 #include <QMessageBox>
 #include <QMimeData>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QStatusBar>
 #include <QTimer>
 #include <QDockWidget>
+#include <QFileDialog>
 
 #include "lc_actiongroupmanager.h"
 #include "lc_actionoptionsmanager.h"
@@ -48,6 +50,8 @@
 #include "lc_creatorinvoker.h"
 #include "lc_customstylehelper.h"
 #include "lc_defaultactioncontext.h"
+#include "lc_documentloader.h"
+#include "lc_documentsstorage.h"
 #include "lc_exporttoimageservice.h"
 #include "lc_graphicviewport.h"
 #include "lc_gridviewinvoker.h"
@@ -66,6 +70,7 @@
 #include "lc_relzerocoordinateswidget.h"
 #include "lc_snapoptionswidgetsholder.h"
 #include "lc_snapmanager.h"
+#include "lc_trace.h"
 #include "lc_ucslistwidget.h"
 #include "lc_ucsstatewidget.h"
 #include "lc_workspacesinvoker.h"
@@ -91,6 +96,8 @@
 #include "rs_actionlibraryinsert.h"
 #include "rs_actionprintpreview.h"
 #include "rs_debug.h"
+#include "rs_fileio.h"
+#include "rs_graphic.h"
 #include "rs_settings.h"
 #include "rs_units.h"
 #include "twostackedlabels.h"
@@ -410,7 +417,7 @@ void QC_ApplicationWindow::dropEvent(QDropEvent *event) {
     for (QUrl const &url: event->mimeData()->urls()) {
         const QString &fileName = url.toLocalFile();
         if (isAcceptableDragNDropFileName(fileName)) {
-            openFile(fileName);
+            openFileInBackground(fileName);
             if (++counts > 32) return;
         }
     }
@@ -892,7 +899,7 @@ void QC_ApplicationWindow::slotFileOpen() {
     QPair<QString, RS2::FormatType> info = m_dlgHelpr->requestDrawingFileName(RS2::FormatUnknown);
     QString fileName = info.first;
     if (!fileName.isEmpty()) {
-        openFile(fileName, info.second);
+        openFileInBackground(fileName, info.second);
     }
 }
 
@@ -942,7 +949,7 @@ void QC_ApplicationWindow::slotFileOpenRecent(const QAction *action){
     if (variant.isValid()) {
         showStatusMessage(tr("Opening recent file..."));
         QString fileName = variant.toString();
-        openFile(fileName, RS2::FormatUnknown);
+        openFileInBackground(fileName, RS2::FormatUnknown);
     }
 }
 
@@ -1021,6 +1028,92 @@ void QC_ApplicationWindow::openFile(const QString &fileName, RS2::FormatType typ
         return;
     }
 
+    showLoadedDocument(w, fileName);
+
+    QApplication::restoreOverrideCursor();
+}
+
+/**
+ * Opens the given file, loading it on a worker thread. The window for the
+ * drawing is created once the file is loaded, meanwhile the application stays
+ * responsive and the progress of loading is shown in a dialog that allows to
+ * cancel it.
+ */
+void QC_ApplicationWindow::openFileInBackground(const QString &fileName, RS2::FormatType type) {
+    if (!QFileInfo::exists(fileName)) {
+        m_commandWidget->appendHistory(tr("File '%1' does not exist. Opening aborted").arg(fileName));
+        showStatusMessage(tr("Opening aborted"), 2000);
+        return;
+    }
+
+    if (openedFiles.indexOf(fileName) >= 0) {
+        QString message = tr("Warning: File already opened : ") + fileName;
+        notificationMessage(message, 2000);
+    }
+
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    RS_FileIO::showImportWarning(fileName);
+    QApplication::restoreOverrideCursor();
+
+    auto loader = new LC_DocumentLoader(fileName, type, this);
+    QString labelText = tr("Loading %1").arg(getFileNameFromFullPath(fileName));
+    auto progressDialog = new QProgressDialog(labelText, tr("Cancel"), 0, 0, this);
+    progressDialog->setWindowModality(Qt::NonModal);
+    progressDialog->setMinimumDuration(500);
+
+    connect(progressDialog, &QProgressDialog::canceled, loader, &LC_DocumentLoader::cancel);
+    connect(loader, &LC_DocumentLoader::progress, progressDialog, [progressDialog, labelText](const QString &section, qint64 entitiesCount) {
+        progressDialog->setLabelText(tr("%1\n%2, entities: %3").arg(labelText, section).arg(entitiesCount));
+    });
+    connect(loader, &LC_DocumentLoader::finished, this, [this, loader, progressDialog](bool success) {
+        progressDialog->deleteLater();
+        onBackgroundLoadingFinished(loader, success);
+        loader->deleteLater();
+    });
+
+    showStatusMessage(labelText);
+    loader->start();
+}
+
+void QC_ApplicationWindow::onBackgroundLoadingFinished(LC_DocumentLoader *loader, bool success) {
+    const QString fileName = loader->getFileName();
+    if (loader->isCancelled()) {
+        showStatusMessage(tr("Opening cancelled"), 2000);
+        return;
+    }
+
+    std::unique_ptr<RS_Graphic> graphic = loader->takeGraphic();
+    if (!success) {
+        bool openAnyway = false;
+        if (!loader->getErrorMessage().isNull()) {
+            QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+            openAnyway = RS_FileIO::reportImportError(*graphic, fileName, loader->getErrorMessage());
+            QApplication::restoreOverrideCursor();
+        }
+        if (!openAnyway) {
+            showStatusMessage(tr("Opening aborted"), 2000);
+            return;
+        }
+        LC_DocumentsStorage storage;
+        storage.completeLoading(graphic.get(), fileName);
+    }
+
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+
+    auto w = createNewDrawingWindow(graphic.get(), fileName);
+    w->setDocumentOwner(true);
+    graphic.release();
+    w->onDocumentLoaded(fileName);
+
+    showLoadedDocument(w, fileName);
+
+    QApplication::restoreOverrideCursor();
+}
+
+/**
+ * Activates the window with just loaded document and updates widgets for it.
+ */
+void QC_ApplicationWindow::showLoadedDocument(QC_MDIWindow *w, const QString &fileName) {
     // update recent files menu:
     m_recentFilesList->add(fileName);
     openedFiles.push_back(fileName);
@@ -1045,8 +1138,6 @@ void QC_ApplicationWindow::openFile(const QString &fileName, RS2::FormatType typ
 
     QString message = tr("Loaded document: ") + fileName;
     notificationMessage(message, 2000);
-
-    QApplication::restoreOverrideCursor();
 }
 
 void QC_ApplicationWindow::changeDrawingOptions(int tabToShow){
@@ -1545,8 +1636,8 @@ void QC_ApplicationWindow::slotImportBlock() {
             }
         }
     } else {
-        RS_DEBUG->print(RS_Debug::D_ERROR,
-                        "QC_ApplicationWindow::slotImportBlock: Can't read file: '%s'", dxfPath.toLatin1().data());
+        LC_DEBUG_PRINT_LEVEL(RS_Debug::D_ERROR,
+                             "QC_ApplicationWindow::slotImportBlock: Can't read file: '%s'", dxfPath.toLatin1().data());
     }
 }
 
@@ -1714,7 +1805,7 @@ void QC_ApplicationWindow::reloadStyleSheet() {
 bool QC_ApplicationWindow::eventFilter(QObject *obj, QEvent *event) {
     if (QEvent::FileOpen == event->type()) {
         auto *openEvent = static_cast<QFileOpenEvent *>(event);
-        openFile(openEvent->file(), RS2::FormatUnknown);
+        openFileInBackground(openEvent->file(), RS2::FormatUnknown);
         return true;
     }
     return QObject::eventFilter(obj, event);
@@ -1832,6 +1923,23 @@ void QC_ApplicationWindow::invokeLicenseWindow() const {
     m_dlgHelpr-> showLicenseWindow();
 }
 
+void QC_ApplicationWindow::slotToggleTracing(bool toggle) {
+    if (toggle) {
+        LC_Trace::clear();
+        LC_Trace::setEnabled(true);
+        return;
+    }
+    LC_Trace::setEnabled(false);
+    const QString fileName = QFileDialog::getSaveFileName(this, tr("Save Performance Trace"), QString(),
+                                                          tr("Chrome Trace (*.json)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (!LC_Trace::writeChromeTrace(fileName)) {
+        QMessageBox::warning(this, tr("Performance Trace"), tr("Cannot write the trace to %1").arg(fileName));
+    }
+}
+
 void QC_ApplicationWindow::showBlockActivated(const RS_Block *block) const {
     if (block != nullptr) {
         m_blockWidget->activateBlock(const_cast<RS_Block *>(block));
@@ -41,6 +41,7 @@ class LC_AppWindowDialogsInvoker;
 class LC_CreatorInvoker;
 class LC_CustomStyleHelper;
 class LC_DefaultActionContext;
+class LC_DocumentLoader;
 class LC_GridViewInvoker;
 class LC_InfoCursorSettingsManager;
 class LC_LastOpenFilesOpener;
@@ -234,6 +235,8 @@ public slots:
     void checkForNewVersion();
     void forceCheckForNewVersion();
     void slotShowEntityDescriptionOnHover(bool toggle);
+    /** starts collecting performance trace, on stop asks for the file to write the trace to*/
+    void slotToggleTracing(bool toggle);
 signals:
     void gridChanged(bool on);
     void draftChanged(bool on);
@@ -303,6 +306,7 @@ public:
  * opens the given file.
  */
     void openFile(const QString& fileName, RS2::FormatType type);
+    void openFileInBackground(const QString& fileName, RS2::FormatType type = RS2::FormatUnknown);
     void changeDrawingOptions(int tabIndex);
     void closeWindow(QC_MDIWindow* w) override;
     QG_LibraryWidget* getLibraryWidget() const {return m_libraryWidget;}
@@ -324,6 +328,8 @@ protected:
     void updateCoordinateWidgetFormat();
     void updateWidgetsAsDocumentLoaded(const QC_MDIWindow *w);
     void autoZoomAfterLoad(QG_GraphicView *graphicView);
+    void showLoadedDocument(QC_MDIWindow *w, const QString &fileName);
+    void onBackgroundLoadingFinished(LC_DocumentLoader *loader, bool success);
     bool newDrawingFromTemplate(const QString &fileName, QC_MDIWindow* w = nullptr);
 	void doActivate(QMdiSubWindow* w) override;
     void enableFileActions(const QC_MDIWindow* w);
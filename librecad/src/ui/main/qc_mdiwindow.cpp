@@ -284,31 +284,44 @@ bool QC_MDIWindow::loadDocument(const QString& fileName, RS2::FormatType type) {
     bool loaded = m_documentsStorage->loadDocument(m_document, fileName, type);
     addWidgetsListeners();
     if (loaded) {
-        RS_Graphic* graphic = m_document->getGraphic();
-        if (graphic != nullptr) {
-            RS_GraphicView *gv = graphic->getGraphicView(); // fixme - eliminate this dependency!
-            if (gv != nullptr) {
-                // fixme - sand - review and probably move initialization of UCS - as normal support of VIEWPORT will be available
-                // todo - not sure whether this is right place for setting up current wcs.
-                // Actually, it seems that it's better to rely on reading viewport (were setting for the offset and zoom are set.
-                // however, must probably with proper support of VIEW, they will be reworked too..
-                // So let it have here for now so far
-                LC_GraphicViewport* viewport = gv->getViewPort();
-                viewport->initAfterDocumentOpen();
-            }
+        onDocumentLoaded(fileName);
+    }
+    return loaded;
+}
+
+/**
+ * Prepares the view for the document just loaded from given file.
+ */
+void QC_MDIWindow::onDocumentLoaded(const QString& fileName) {
+    RS_Graphic* graphic = m_document->getGraphic();
+    if (graphic != nullptr) {
+        RS_GraphicView *gv = graphic->getGraphicView(); // fixme - eliminate this dependency!
+        if (gv != nullptr) {
+            // fixme - sand - review and probably move initialization of UCS - as normal support of VIEWPORT will be available
+            // todo - not sure whether this is right place for setting up current wcs.
+            // Actually, it seems that it's better to rely on reading viewport (were setting for the offset and zoom are set.
+            // however, must probably with proper support of VIEW, they will be reworked too..
+            // So let it have here for now so far
+            LC_GraphicViewport* viewport = gv->getViewPort();
+            viewport->initAfterDocumentOpen();
         }
+    }
 
-        // fixme - sand - move support of fonts in some separate space?
-        if (fileName.endsWith(".lff") || fileName.endsWith(".cxf")) {
-            // fixme - sand - move to upper layer
-            drawChars();
-            m_graphicView->zoomAuto(false);
-        } else
-            m_graphicView->redraw();
-    } else {
+    // fixme - sand - move support of fonts in some separate space?
+    if (fileName.endsWith(".lff") || fileName.endsWith(".cxf")) {
+        // fixme - sand - move to upper layer
+        drawChars();
+        m_graphicView->zoomAuto(false);
+    } else
+        m_graphicView->redraw();
+}
 
-    }
-    return loaded;
+/**
+ * Transfers ownership of the document passed to the constructor to this window,
+ * so it's deleted with the window.
+ */
+void QC_MDIWindow::setDocumentOwner(bool owner) {
+    m_owner = owner;
 }
 
 /**
@@ -45,11 +45,13 @@ public:
     QC_MDIWindow(RS_Document *doc,QWidget *parent,bool printPreview, LC_ActionContext* actionContext);
     void removeWidgetsListeners() const;
     ~QC_MDIWindow() override;
+    void setDocumentOwner(bool owner);
 public slots:
     void slotPenChanged(const RS_Pen &p);
     void slotFileNew();
     bool loadDocumentFromTemplate(const QString &fileName, RS2::FormatType type);
     bool loadDocument(const QString &fileName, RS2::FormatType type);
+    void onDocumentLoaded(const QString &fileName);
     bool saveDocument(bool &cancelled, bool isAutoSave = false);
     bool autoSaveDocument(QString &autosaveFileName);
     bool saveDocumentAs(bool &cancelled);
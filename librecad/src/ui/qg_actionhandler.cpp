@@ -168,7 +168,7 @@ bool QG_ActionHandler::command(const QString& cmd){
         return true;
     }
 
-    RS_DEBUG->print("QG_ActionHandler::command: %s", cmd.toLatin1().data());
+    LC_DEBUG_PRINT("QG_ActionHandler::command: %s", cmd.toLatin1().data());
     QString c = cmd.toLower().trimmed();
 
     if (c==tr("escape", "escape, go back from action steps"))    {
@@ -315,6 +315,7 @@ QG_GraphicView::QG_GraphicView(QWidget* parent, RS_Document* doc, LC_ActionConte
     , m_ucsMarkOptions{std::make_unique<LC_UCSMarkOptions>()}
     , m_panData{std::make_unique<AutoPanData>()}
     , m_ucsHighlightData{std::make_unique<UCSHighlightData>()}
+    , m_progressiveRedrawTimer{std::make_unique<QTimer>(this)}
 {
     RS_DEBUG->print("QG_GraphicView::QG_GraphicView()..");
 
@@ -333,6 +334,9 @@ QG_GraphicView::QG_GraphicView(QWidget* parent, RS_Document* doc, LC_ActionConte
     setMouseTracking(true);
     setFocusPolicy(Qt::NoFocus);
 
+    m_progressiveRedrawTimer->setSingleShot(true);
+    connect(m_progressiveRedrawTimer.get(), &QTimer::timeout, this, &QG_GraphicView::completeProgressiveRedraw);
+
     // SourceForge issue 45 (Left-mouse drag shrinks window)
     setAttribute(Qt::WA_NoMousePropagation);
 
@@ -503,6 +507,27 @@ void QG_GraphicView::redraw(RS2::RedrawMethod method) {
     update(); // Paint when reeady to pain
 }
 
+/**
+ * Redraws the widget after zoom or pan. If possible, the previous frame
+ * is shown transformed to the new viewport immediately, and the drawing is
+ * rendered again only when the view was not changed for a while.
+ */
+void QG_GraphicView::redrawOnViewportChange() {
+    if (getRenderer()->invalidateProgressive()) {
+        m_progressiveRedrawTimer->start(); // restarts, so intermediate views are never rendered fully
+        update();
+    }
+    else {
+        redraw();
+    }
+}
+
+void QG_GraphicView::completeProgressiveRedraw() {
+    if (getRenderer()->isProgressiveFrameShown()) {
+        redraw(RS2::RedrawDrawing);
+    }
+}
+
 void QG_GraphicView::resizeEvent(QResizeEvent* e) {
     RS_GraphicView::resizeEvent(e);
     RS_DEBUG->print("QG_GraphicView::resizeEvent begin");
@@ -1332,6 +1357,8 @@ void QG_GraphicView::loadSettings() {
         m_ucsHighlightData->m_timerInterval =  LC_GET_INT("UCSHighlightBlinkDelay",250);
     }
 
+    m_progressiveRedrawTimer->setInterval(LC_GET_ONE_INT("Render", "ProgressiveRedrawDelay", 150));
+
     {
         LC_GROUP_GUARD("Defaults");
         m_invertZoomDirection = LC_GET_ONE_BOOL("Defaults", "InvertZoomDirection");
@@ -46,6 +46,7 @@ class QGridLayout;
 class QLabel;
 class QMenu;
 class QMouseEvent;
+class QTimer;
 class LC_ActionContext;
 
 /**
@@ -68,6 +69,7 @@ public:
     int getWidth() const override;
     int getHeight() const override;
     void redraw(RS2::RedrawMethod method=RS2::RedrawAll) override;
+    void redrawOnViewportChange() override;
     void adjustOffsetControls() override;
     void adjustZoomControls() override;
     void setMouseCursor(RS2::CursorType c) override;
@@ -143,6 +145,7 @@ protected:
     void autoPanStep();
     void highlightUCSLocation(LC_UCS *ucs) override;
     void ucsHighlightStep();
+    void completeProgressiveRedraw();
 
     virtual void createViewRenderer();
     // For auto panning by the cursor close to the view border
@@ -193,6 +196,9 @@ private:
     struct UCSHighlightData;
     std::unique_ptr<UCSHighlightData> m_ucsHighlightData;
 
+    //! Delays full render of the drawing after zoom and pan until the view is idle
+    std::unique_ptr<QTimer> m_progressiveRedrawTimer;
+
     LC_ActionContext* m_actionContext {nullptr};
 
     void showEntityPropertiesDialog(RS_Entity *entity);
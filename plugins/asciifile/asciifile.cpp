@@ -374,6 +374,9 @@ void dibPunto::procesFile(Document_Interface *doc)
     infile.close ();
     QString currlay = currDoc->getCurrentLayer();
 
+    // all entities created from the file form a single undo step
+    currDoc->beginTransaction();
+
     if (pt2d->checkOn() == true)
         draw2D();
     if (pt3d->checkOn() == true)
@@ -390,12 +393,14 @@ void dibPunto::procesFile(Document_Interface *doc)
     if ( connectPoints->isChecked() )
         drawLine();
 
+    currDoc->commitTransaction();
     currDoc = nullptr;
 
 }
 
 void dibPunto::drawLine()
 {
+    Plug_BulkLines lines;
     QPointF prevP, nextP;
     int i;
 
@@ -412,39 +417,43 @@ void dibPunto::drawLine()
         if (!pd->x.isEmpty() && !pd->y.isEmpty()){
             nextP.setX(pd->x.toDouble());
             nextP.setY(pd->y.toDouble());
-            currDoc->addLine(&prevP, &nextP);
+            lines.startX.push_back(prevP.x());
+            lines.startY.push_back(prevP.y());
+            lines.endX.push_back(nextP.x());
+            lines.endY.push_back(nextP.y());
             prevP = nextP;
         }
     }
+    currDoc->addBulkLines(lines);
 }
 
 void dibPunto::draw2D()
 {
-    QPointF pt;
+    Plug_BulkPoints points;
     currDoc->setLayer(pt2d->getLayer());
     for (int i = 0; i < dataList.size(); ++i) {
         PointData *pd = dataList.at(i);
         if (!pd->x.isEmpty() && !pd->y.isEmpty()){
-            pt.setX(pd->x.toDouble());
-            pt.setY(pd->y.toDouble());
-            currDoc->addPoint(&pt);
+            points.x.push_back(pd->x.toDouble());
+            points.y.push_back(pd->y.toDouble());
         }
     }
+    currDoc->addBulkPoints(points);
 }
 void dibPunto::draw3D()
 {
-    QPointF pt;
+    Plug_BulkPoints points;
     currDoc->setLayer(pt3d->getLayer());
     for (int i = 0; i < dataList.size(); ++i) {
         PointData *pd = dataList.at(i);
         if (!pd->x.isEmpty() && !pd->y.isEmpty()){
-            pt.setX(pd->x.toDouble());
-            pt.setY(pd->y.toDouble());
 /*RLZ:3d support            if (pd->z.isEmpty()) pt.setZ(0.0);
             else  pt.setZ(pd->z.toDouble());*/
-            currDoc->addPoint(&pt);
+            points.x.push_back(pd->x.toDouble());
+            points.y.push_back(pd->y.toDouble());
         }
     }
+    currDoc->addBulkPoints(points);
 }
 
 void dibPunto::calcPos(DPI::VAlign *v, DPI::HAlign *h, double sep,
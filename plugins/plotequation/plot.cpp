@@ -1,23 +1,45 @@
 //This plugin allows the user to plot mathematical equations.
 //It uses muParser for parsing the mathematical equations.
 //
+//Equations are evaluated through the bulk interface of muParser by PlotSampler:
+//the curve is sampled at the user step size first, then every step interval is
+//bisected while its midpoint deviates from the chord by more than the chord
+//tolerance. Finally vertices which are not needed to keep within the tolerance
+//are dropped, so the step size sets the initial grid only, not the spacing of
+//the plotted vertices.
+//
 //ToDo: *set max and min value for step size?
 
-
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "document_interface.h"
 #include "plot.h"
 #include "plotdialog.h"
+#include "plotsampler.h"
 #include <muParser.h>
 #include <QDebug>
 
-mu::string_type toMUPString(const QString &str)
+namespace {
+
+//splits the samples at invalid points into runs of at least two vertices
+std::vector<std::vector<QPointF>> toRuns(const std::vector<PlotPoint>& points)
 {
-#if defined(_UNICODE)
-  return str.toStdWString();
-#else
-  return str.toStdString();
-#endif
+    std::vector<std::vector<QPointF>> runs(1);
+    for (const PlotPoint& p: points) {
+        if (p.isValid()) {
+            runs.back().emplace_back(p.x, p.y);
+        } else if (!runs.back().empty()) {
+            runs.emplace_back();
+        }
+    }
+    runs.erase(std::remove_if(runs.begin(), runs.end(),
+                              [](const std::vector<QPointF>& run) { return run.size() < 2; }),
+               runs.end());
+    return runs;
+}
+
 }
 
 plot::plot(QObject *parent) :
@@ -47,78 +69,74 @@ void plot::execComm([[maybe_unused]] Document_Interface *doc, QWidget *parent, [
     QString endValue;
     double stepSize;
 
-    QList<double> xValues;
-    QList<double> yValues1;
-    QList<double> yValues2;
+    std::vector<PlotPoint> samples;
     plotDialog::EntityType lineType=plotDialog::Polyline;
 
     plotDialog plotDlg(parent);
     int result =  plotDlg.exec();
-    if (result == QDialog::Accepted)
-    {
-        double equationVariable = 0.0;
+    if (result != QDialog::Accepted)
+        return;
+
+    plotDlg.getValues(equation1, equation2, startValue, endValue, stepSize);
+    lineType=plotDlg.getEntityType();
+
+    try{
         double startVal = 0.0;
         double endVal = 0.0;
-        plotDlg.getValues(equation1, equation2, startValue, endValue, stepSize);
-        lineType=plotDlg.getEntityType();
-
-        try{
-            mu::Parser p;
-            p.DefineConst(_T("pi"),M_PI);
-            p.DefineConst(_T("e"),M_E);
-            p.DefineVar(_T("x"), &equationVariable);
-            p.DefineVar(_T("t"), &equationVariable);
-            p.SetExpr(toMUPString(startValue));
-            startVal = p.Eval();
-
-            p.SetExpr(toMUPString(endValue));
-            endVal = p.Eval();
-
-            p.SetExpr(toMUPString(equation1));
-
-            for(equationVariable = startVal; equationVariable <= endVal; equationVariable += stepSize)
-            {//calculate the values of the first equation
-                xValues.append(equationVariable);
-                yValues1.append(p.Eval());
-            }
-
-            if(!equation2.isEmpty())
-            {//calculate the values of the second equation
-                p.SetExpr(toMUPString(equation2));
-                for(int i = 0; i < xValues.size(); ++i)
-                {
-                    equationVariable = xValues.at(i);
-                    yValues2.append(p.Eval());
-                }
-            }
-        }
-        catch (mu::Parser::exception_type &e)
-        {
-            mu::console() << e.GetMsg() << std::endl;
+        mu::Parser p;
+        p.DefineConst(_T("pi"),M_PI);
+        p.DefineConst(_T("e"),M_E);
+        p.SetExpr(toMUPString(startValue));
+        startVal = p.Eval();
+
+        p.SetExpr(toMUPString(endValue));
+        endVal = p.Eval();
+
+        if (!(stepSize > 0.) || !(startVal <= endVal)) {
+            qDebug("invalid range or step size");
+            return;
         }
 
-        QList<double> const& xpoints=(equation2.isEmpty())?xValues:yValues1;
-        QList<double> const& ypoints=(equation2.isEmpty())?yValues1:yValues2;
+        PlotSampler sampler(equation1, equation2);
+        samples = sampler.sample(startVal, endVal, stepSize, plotDlg.getTolerance());
+    }
+    catch (mu::Parser::exception_type &e)
+    {
+        mu::console() << e.GetMsg() << std::endl;
+        return;
+    }
 
-        if (lineType == plotDialog::LineSegments || lineType == plotDialog::SplinePoints){
-            std::vector<QPointF> points;
-            for(int i=0; i< xpoints.size(); ++i){
-                points.emplace_back(QPointF(xpoints[i], ypoints[i]));
+    std::vector<std::vector<QPointF>> runs = toRuns(samples);
+    if (runs.empty())
+        return;
+
+    doc->beginTransaction();
+    if (lineType == plotDialog::SplinePoints) {
+        //TODO add option for splinepoints: closed
+        //hardcoded to false now
+        for (const std::vector<QPointF>& run: runs)
+            doc->addSplinePoints(run, false);
+    } else if (lineType == plotDialog::LineSegments) {
+        Plug_BulkLines lines;
+        for (const std::vector<QPointF>& run: runs) {
+            for (size_t i = 1; i < run.size(); ++i) {
+                lines.startX.push_back(run[i - 1].x());
+                lines.startY.push_back(run[i - 1].y());
+                lines.endX.push_back(run[i].x());
+                lines.endY.push_back(run[i].y());
             }
-            if (lineType == plotDialog::SplinePoints){
-                //TODO add option for splinepoints: closed
-                //hardcoded to false now
-                doc->addSplinePoints(points, false);
-            } else
-                doc->addLines(points, false);
-        } else { //default plotDialog::Polyline
-            std::vector<Plug_VertexData> points;
-            for(int i=0; i< xpoints.size(); ++i){
-                points.emplace_back(Plug_VertexData(QPointF(xpoints[i], ypoints[i]), 0.0));
+        }
+        doc->addBulkLines(lines);
+    } else { //default plotDialog::Polyline
+        Plug_BulkPolylines polylines;
+        for (const std::vector<QPointF>& run: runs) {
+            polylines.vertexStart.push_back(polylines.x.size());
+            for (const QPointF& point: run) {
+                polylines.x.push_back(point.x());
+                polylines.y.push_back(point.y());
             }
-            doc->addPolyline(points, false);
         }
-
+        doc->addBulkPolylines(polylines);
     }
-
+    doc->commitTransaction();
 }
@@ -27,6 +27,8 @@ public:
     ~plotDialog()=default;
     void getValues(QString& eq1, QString& eq2, QString &start, QString &end, double& step) const;
     EntityType getEntityType() const;
+    //! chord tolerance of the plot, 0 to derive it from the size of the plot
+    double getTolerance() const;
 
 public slots:
     void slotDrawButtonClicked();
@@ -37,6 +39,7 @@ private:
     QString startValue;
     QString endValue;
     double stepSize;
+    double tolerance;
     QGridLayout *mainLayout;
     QHBoxLayout* buttonLayout;
     QLabel* description;
@@ -47,9 +50,11 @@ private:
     QLabel* lblStartValue;
     QLabel* lblEndValue;
     QLabel* lblStepSize;
+    QLabel* lblTolerance;
     QLineEdit* lnedStartValue;
     QLineEdit* lnedEndValue;
     QLineEdit* lnedStepSize;
+    QLineEdit* lnedTolerance;
     QPushButton* btnAccept;
     QPushButton* btnCancel;
     QSpacerItem* space;
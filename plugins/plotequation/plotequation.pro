@@ -15,11 +15,13 @@ INCLUDEPATH    += $$DEPENDPATH
 
 SOURCES += \
     plot.cpp \
-    plotdialog.cpp
+    plotdialog.cpp \
+    plotsampler.cpp
 
 HEADERS += \
     plotdialog.h \
-    plot.h
+    plot.h \
+    plotsampler.h
 
 # Installation Directory
 win32 {
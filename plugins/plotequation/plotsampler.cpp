@@ -0,0 +1,232 @@
+#include "plotsampler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <muParser.h>
+
+mu::string_type toMUPString(const QString &str)
+{
+#if defined(_UNICODE)
+  return str.toStdWString();
+#else
+  return str.toStdString();
+#endif
+}
+
+namespace {
+
+//distance of point p from the chord (a, b)
+double chordDeviation(const PlotPoint& a, const PlotPoint& b, const PlotPoint& p)
+{
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double length = std::hypot(dx, dy);
+    if (length < 1e-12)
+        return std::hypot(p.x - a.x, p.y - a.y);
+    return std::abs(dx * (p.y - a.y) - dy * (p.x - a.x)) / length;
+}
+
+}
+
+//Evaluates one expression for many parameter values in a single call to the
+//bulk interface of muParser. The variables x and t are bound to the parameter
+//buffer, muParser reads the value for sample i at offset i of the buffer.
+//With MUP_USE_OPENMP defined muParser spreads the samples over threads.
+class BulkEvaluator {
+public:
+    explicit BulkEvaluator(const QString& expression)
+    {
+        m_parser.DefineConst(_T("pi"), M_PI);
+        m_parser.DefineConst(_T("e"), M_E);
+        bind(1);
+        m_parser.SetExpr(toMUPString(expression));
+    }
+
+    void evaluate(const std::vector<double>& params, std::vector<double>& results)
+    {
+        results.resize(params.size());
+        if (params.empty())
+            return;
+        bind(params.size());
+        std::copy(params.begin(), params.end(), m_params.begin());
+        m_parser.Eval(results.data(), static_cast<int>(params.size()));
+    }
+
+private:
+    void bind(size_t size)
+    {
+        if (m_params.size() >= size)
+            return;
+        //variables have to be bound again once the buffer moves
+        m_params.resize(std::max(size, 2 * m_params.size()));
+        m_parser.DefineVar(_T("x"), m_params.data());
+        m_parser.DefineVar(_T("t"), m_params.data());
+    }
+
+    mu::Parser m_parser;
+    std::vector<double> m_params;
+};
+
+PlotSampler::PlotSampler(const QString& equation1, const QString& equation2):
+    m_equation1(std::make_unique<BulkEvaluator>(equation1))
+{
+    if (!equation2.isEmpty())
+        m_equation2 = std::make_unique<BulkEvaluator>(equation2);
+}
+
+PlotSampler::~PlotSampler() = default;
+
+std::vector<PlotPoint> PlotSampler::sample(double startVal, double endVal, double stepSize, double tolerance)
+{
+    std::vector<double> params;
+    //the initial samples are bounded as the refined ones, a tiny step widens to fit
+    double stepsCount = std::floor((endVal - startVal) / stepSize);
+    if (!(stepsCount < MAX_SAMPLES - 1)) {
+        stepsCount = MAX_SAMPLES - 2;
+        stepSize = (endVal - startVal) / stepsCount;
+    }
+    size_t steps = static_cast<size_t>(stepsCount);
+    params.reserve(steps + 2);
+    for (size_t i = 0; i <= steps; ++i)
+        params.push_back(startVal + i * stepSize);
+    if (endVal - params.back() > stepSize * 1e-9)
+        params.push_back(endVal);
+
+    std::vector<PlotPoint> points = evaluate(params);
+    if (tolerance <= 0.)
+        tolerance = autoTolerance(points);
+    refine(points, tolerance);
+    return simplify(points, tolerance);
+}
+
+std::vector<PlotPoint> PlotSampler::evaluate(const std::vector<double>& params)
+{
+    m_equation1->evaluate(params, m_values1);
+    if (m_equation2 != nullptr)
+        m_equation2->evaluate(params, m_values2);
+
+    std::vector<PlotPoint> points(params.size());
+    for (size_t i = 0; i < params.size(); ++i) {
+        points[i].t = params[i];
+        if (m_equation2 != nullptr) {
+            points[i].x = m_values1[i];
+            points[i].y = m_values2[i];
+        } else {
+            points[i].x = params[i];
+            points[i].y = m_values1[i];
+        }
+    }
+    return points;
+}
+
+double PlotSampler::autoTolerance(const std::vector<PlotPoint>& points)
+{
+    double minX = HUGE_VAL, minY = HUGE_VAL;
+    double maxX = -HUGE_VAL, maxY = -HUGE_VAL;
+    for (const PlotPoint& p: points) {
+        if (!p.isValid())
+            continue;
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+    double size = (minX <= maxX) ? std::hypot(maxX - minX, maxY - minY) : 0.;
+    return (size > 0.) ? size * AUTO_TOLERANCE_FACTOR : 1e-6;
+}
+
+//bisects the intervals breadth first, so all midpoints of one level are
+//evaluated by a single bulk call
+void PlotSampler::refine(std::vector<PlotPoint>& points, double tolerance)
+{
+    std::vector<bool> pending(points.size() > 1 ? points.size() - 1 : 0, true);
+    std::vector<double> params;
+    for (int depth = 0; depth < MAX_REFINE_DEPTH; ++depth) {
+        params.clear();
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (pending[i])
+                params.push_back(0.5 * (points[i].t + points[i + 1].t));
+        }
+        if (params.empty() || points.size() + params.size() > MAX_SAMPLES)
+            break;
+        std::vector<PlotPoint> middles = evaluate(params);
+
+        std::vector<PlotPoint> refined;
+        std::vector<bool> refinedPending;
+        refined.reserve(points.size() + middles.size());
+        refinedPending.reserve(pending.size() + middles.size());
+        size_t middle = 0;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            refined.push_back(points[i]);
+            if (!pending[i]) {
+                refinedPending.push_back(false);
+                continue;
+            }
+            const PlotPoint& a = points[i];
+            const PlotPoint& b = points[i + 1];
+            const PlotPoint& m = middles[middle++];
+            bool split;
+            if (a.isValid() && b.isValid() && m.isValid())
+                split = chordDeviation(a, b, m) > tolerance;
+            else //locate the border of the domain
+                split = a.isValid() || b.isValid() || m.isValid();
+            if (split) {
+                refined.push_back(m);
+                refinedPending.push_back(true);
+                refinedPending.push_back(true);
+            } else {
+                refinedPending.push_back(false);
+            }
+        }
+        refined.push_back(points.back());
+        points.swap(refined);
+        pending.swap(refinedPending);
+    }
+}
+
+//drops vertices within tolerance of the chord of their neighbours
+//(Douglas-Peucker), invalid samples are kept to separate the runs
+std::vector<PlotPoint> PlotSampler::simplify(const std::vector<PlotPoint>& points, double tolerance)
+{
+    std::vector<bool> keep(points.size(), false);
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t runStart = 0;
+    for (size_t i = 0; i <= points.size(); ++i) {
+        if (i < points.size() && points[i].isValid())
+            continue;
+        if (i > runStart) {
+            keep[runStart] = keep[i - 1] = true;
+            ranges.emplace_back(runStart, i - 1);
+        }
+        if (i < points.size())
+            keep[i] = true;
+        runStart = i + 1;
+    }
+
+    while (!ranges.empty()) {
+        auto [first, last] = ranges.back();
+        ranges.pop_back();
+        double maxDeviation = -1.;
+        size_t farthest = first;
+        for (size_t i = first + 1; i < last; ++i) {
+            double deviation = chordDeviation(points[first], points[last], points[i]);
+            if (deviation > maxDeviation) {
+                maxDeviation = deviation;
+                farthest = i;
+            }
+        }
+        if (maxDeviation > tolerance) {
+            keep[farthest] = true;
+            ranges.emplace_back(first, farthest);
+            ranges.emplace_back(farthest, last);
+        }
+    }
+
+    std::vector<PlotPoint> result;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (keep[i])
+            result.push_back(points[i]);
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+#ifndef PLOTSAMPLER_H
+#define PLOTSAMPLER_H
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <QString>
+#include <muParserDef.h>
+
+mu::string_type toMUPString(const QString &str);
+
+struct PlotPoint {
+    double t = 0.;
+    double x = 0.;
+    double y = 0.;
+
+    bool isValid() const
+    {
+        return std::isfinite(x) && std::isfinite(y);
+    }
+};
+
+class BulkEvaluator;
+
+//Samples the curve y = eq1(x), or the parametric curve (eq1(t), eq2(t)) when
+//the second equation is given.
+//
+//The step size only sets the initial grid, features narrower than one step
+//may be missed. The chord tolerance bounds the deviation of the result from
+//the curve, vertices are dropped where the curve is straight, so the spacing
+//of the result may exceed the step size. Invalid samples are kept in the
+//result to separate the runs.
+//Parse errors are thrown as mu::Parser::exception_type.
+class PlotSampler {
+public:
+    //maximum number of bisections of a single step interval
+    static constexpr int MAX_REFINE_DEPTH = 10;
+    //upper limit of samples of a single plot, stops refinement of noisy curves
+    static constexpr size_t MAX_SAMPLES = 1000000;
+    //chord tolerance relative to the size of the plot when not given by the user
+    static constexpr double AUTO_TOLERANCE_FACTOR = 1e-3;
+
+    PlotSampler(const QString& equation1, const QString& equation2);
+    ~PlotSampler();
+
+    //tolerance <= 0 selects a tolerance relative to the size of the plot
+    std::vector<PlotPoint> sample(double startVal, double endVal, double stepSize, double tolerance);
+
+private:
+    std::vector<PlotPoint> evaluate(const std::vector<double>& params);
+    static double autoTolerance(const std::vector<PlotPoint>& points);
+    void refine(std::vector<PlotPoint>& points, double tolerance);
+    static std::vector<PlotPoint> simplify(const std::vector<PlotPoint>& points, double tolerance);
+
+    std::unique_ptr<BulkEvaluator> m_equation1;
+    std::unique_ptr<BulkEvaluator> m_equation2;
+    std::vector<double> m_values1;
+    std::vector<double> m_values2;
+};
+
+#endif // PLOTSAMPLER_H
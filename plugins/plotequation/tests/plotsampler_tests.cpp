@@ -0,0 +1,115 @@
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <muParser.h>
+
+#include "plotsampler.h"
+
+namespace {
+
+//largest vertical distance of the curve from the plotted polyline, checked at
+//points between the vertices
+template<typename F>
+double maxDeviation(const std::vector<PlotPoint>& points, F function)
+{
+    double deviation = 0.;
+    for (size_t i = 1; i < points.size(); ++i) {
+        const PlotPoint& a = points[i - 1];
+        const PlotPoint& b = points[i];
+        if (!a.isValid() || !b.isValid())
+            continue;
+        for (int j = 1; j < 16; ++j) {
+            double x = a.x + (b.x - a.x) * j / 16.;
+            double y = a.y + (b.y - a.y) * j / 16.;
+            deviation = std::max(deviation, std::abs(function(x) - y));
+        }
+    }
+    return deviation;
+}
+
+}
+
+TEST_CASE("PlotSampler reduces a straight line to its end points", "[PlotSampler]")
+{
+    PlotSampler sampler("2*x+1", "");
+    std::vector<PlotPoint> points = sampler.sample(0., 10., 0.1, 1e-6);
+
+    //the step only sets the initial grid, the vertices are far wider apart
+    REQUIRE(points.size() == 2);
+    REQUIRE(points.front().x == 0.);
+    REQUIRE(points.front().y == 1.);
+    REQUIRE(std::abs(points.back().x - 10.) < 1e-12);
+    REQUIRE(std::abs(points.back().y - 21.) < 1e-12);
+}
+
+TEST_CASE("PlotSampler keeps a curved plot within the tolerance", "[PlotSampler]")
+{
+    constexpr double tolerance = 1e-3;
+    PlotSampler sampler("sin(x)", "");
+
+    SECTION("coarse step is refined")
+    {
+        std::vector<PlotPoint> points = sampler.sample(0., 4. * M_PI, 1., tolerance);
+        REQUIRE(points.size() > 13);
+        REQUIRE(maxDeviation(points, [](double x) { return std::sin(x); }) < 3. * tolerance);
+    }
+
+    SECTION("fine step is simplified")
+    {
+        std::vector<PlotPoint> points = sampler.sample(0., 4. * M_PI, 1e-3, tolerance);
+        REQUIRE(points.size() < 4. * M_PI / 1e-3 / 10.);
+        REQUIRE(maxDeviation(points, [](double x) { return std::sin(x); }) < 3. * tolerance);
+    }
+
+    SECTION("end value is the last vertex")
+    {
+        std::vector<PlotPoint> points = sampler.sample(0., 1.05, 0.1, tolerance);
+        REQUIRE(points.back().t == 1.05);
+    }
+}
+
+TEST_CASE("PlotSampler samples parametric curves", "[PlotSampler]")
+{
+    PlotSampler sampler("cos(t)", "sin(t)");
+    std::vector<PlotPoint> points = sampler.sample(0., 2. * M_PI, 0.5, 1e-4);
+
+    REQUIRE(points.size() > 10);
+    for (const PlotPoint& p: points) {
+        REQUIRE(std::abs(p.x - std::cos(p.t)) < 1e-12);
+        REQUIRE(std::abs(p.y - std::sin(p.t)) < 1e-12);
+    }
+    REQUIRE(std::hypot(points.back().x - 1., points.back().y) < 1e-9);
+}
+
+TEST_CASE("PlotSampler locates the border of the domain", "[PlotSampler]")
+{
+    PlotSampler sampler("sqrt(x-0.3)", "");
+    std::vector<PlotPoint> points = sampler.sample(-1., 1., 0.5, 1e-3);
+
+    size_t firstValid = 0;
+    while (firstValid < points.size() && !points[firstValid].isValid())
+        ++firstValid;
+    REQUIRE(firstValid > 0);
+    REQUIRE(firstValid < points.size());
+    //bisected down to the maximum depth
+    double resolution = 0.5 / (1 << PlotSampler::MAX_REFINE_DEPTH);
+    REQUIRE(points[firstValid].x >= 0.3);
+    REQUIRE(points[firstValid].x - 0.3 <= resolution);
+    REQUIRE(0.3 - points[firstValid - 1].x <= resolution);
+}
+
+TEST_CASE("PlotSampler caps the number of samples", "[PlotSampler]")
+{
+    PlotSampler sampler("sin(1/x)", "");
+    std::vector<PlotPoint> points = sampler.sample(1e-3, 1., 1e-9, 1e-9);
+
+    REQUIRE(!points.empty());
+    REQUIRE(points.size() <= PlotSampler::MAX_SAMPLES);
+}
+
+TEST_CASE("PlotSampler reports parse errors", "[PlotSampler]")
+{
+    PlotSampler sampler("sin(x", "");
+    REQUIRE_THROWS_AS(sampler.sample(0., 1., 0.1, 1e-3), mu::Parser::exception_type);
+}